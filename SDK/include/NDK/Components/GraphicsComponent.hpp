@@ -41,6 +41,7 @@ namespace Ndk
 			void OnDetached() override;
 			void OnNodeInvalidated(const Nz::Node* node);
 
+			void UpdateLods(const Nz::Vector3f* eyePositions, const Nz::Frustumf* frustums, const Nz::Matrix4f* projectionMatrices, std::size_t viewerCount);
 			void UpdateTransformMatrix() const;
 
 			NazaraSlot(Nz::Node, OnNodeInvalidation, m_nodeInvalidationSlot);
@@ -49,7 +50,8 @@ namespace Ndk
 			{
 				Renderable(Nz::Matrix4f& transformMatrix) :
 				data(transformMatrix),
-				dataUpdated(false)
+				dataUpdated(false),
+				volumeUpdated(false)
 				{
 				}
 
@@ -58,6 +60,7 @@ namespace Ndk
 				mutable Nz::InstancedRenderable::InstanceData data;
 				Nz::InstancedRenderableRef renderable;
 				mutable bool dataUpdated;
+				bool volumeUpdated;
 			};
 
 			std::vector<Renderable> m_renderables;
@@ -50,7 +50,10 @@ namespace Ndk
 	inline void GraphicsComponent::InvalidateRenderables()
 	{
 		for (Renderable& r : m_renderables)
+		{
 			r.dataUpdated = false;
+			r.volumeUpdated = false;
+		}
 	}
 
 	inline void GraphicsComponent::InvalidateTransformMatrix()
@@ -4,11 +4,16 @@
 
 #include <Nazara/Audio/SoundBuffer.hpp>
 #include <Nazara/Lua/LuaInstance.hpp>
+#include <Nazara/Math/Vector2.hpp>
 #include <Nazara/Math/Vector3.hpp>
 #include <algorithm>
 
 namespace Nz
 {
+	// Scripts create a lot of temporary vectors, store them directly in their userdata
+	template<> struct LuaInlineStorage<Vector2d> : std::true_type {};
+	template<> struct LuaInlineStorage<Vector3d> : std::true_type {};
+
 	inline unsigned int LuaImplQueryArg(const LuaInstance& instance, int index, SoundBufferParams* params, TypeTag<SoundBufferParams>)
 	{
 		instance.CheckType(index, Nz::LuaType_Table);
@@ -34,7 +39,7 @@ namespace Nz
 				return 3;
 
 			default:
-				vec->Set(*(*static_cast<Vector3d**>(lua.CheckUserdata(index, "Vector3"))));
+				vec->Set(*static_cast<Vector3d*>(lua.CheckUserdata(index, "Vector3")));
 				return 1;
 		}
 	}
@@ -0,0 +1,63 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Development Kit"
+// For conditions of distribution and use, see copyright notice in Prerequesites.hpp
+
+#pragma once
+
+#ifndef NDK_REPLICATIONRECEIVER_HPP
+#define NDK_REPLICATIONRECEIVER_HPP
+
+#include <NDK/EntityHandle.hpp>
+#include <NDK/StateSnapshot.hpp>
+#include <deque>
+#include <vector>
+
+namespace Ndk
+{
+	class World;
+
+	class NDK_API ReplicationReceiver
+	{
+		public:
+			ReplicationReceiver(World& world);
+			ReplicationReceiver(const ReplicationReceiver&) = delete;
+			ReplicationReceiver(ReplicationReceiver&&) = default;
+			~ReplicationReceiver();
+
+			void Clear();
+
+			const EntityHandle& GetEntity(EntityId remoteId) const;
+			inline std::size_t GetHistorySize() const;
+			inline SnapshotId GetLastSnapshotId() const;
+			inline std::size_t GetMaxEntityCount() const;
+			inline World& GetWorld() const;
+
+			bool ReadSnapshot(Nz::ByteStream& stream);
+
+			void SetHistorySize(std::size_t historySize);
+			void SetMaxEntityCount(std::size_t maxEntityCount);
+
+			ReplicationReceiver& operator=(const ReplicationReceiver&) = delete;
+			ReplicationReceiver& operator=(ReplicationReceiver&&) = default;
+
+		private:
+			void Apply(const StateSnapshot::EntityState& state);
+			const StateSnapshot* FindSnapshot(SnapshotId snapshotId) const;
+
+			struct ReplicatedEntity
+			{
+				EntityHandle entity;
+				Nz::UInt16 generation;
+			};
+
+			std::deque<StateSnapshot> m_snapshots;
+			std::size_t m_historySize;
+			std::size_t m_maxEntityCount; //< Remote entity ids must be lower than this
+			std::vector<ReplicatedEntity> m_entities; //< Indexed by remote entity id
+			World* m_world;
+	};
+}
+
+#include <NDK/ReplicationReceiver.inl>
+
+#endif // NDK_REPLICATIONRECEIVER_HPP
@@ -0,0 +1,26 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Development Kit"
+// For conditions of distribution and use, see copyright notice in Prerequesites.hpp
+
+namespace Ndk
+{
+	inline std::size_t ReplicationReceiver::GetHistorySize() const
+	{
+		return m_historySize;
+	}
+
+	inline SnapshotId ReplicationReceiver::GetLastSnapshotId() const
+	{
+		return (!m_snapshots.empty()) ? m_snapshots.back().GetId() : StateSnapshot::InvalidId;
+	}
+
+	inline std::size_t ReplicationReceiver::GetMaxEntityCount() const
+	{
+		return m_maxEntityCount;
+	}
+
+	inline World& ReplicationReceiver::GetWorld() const
+	{
+		return *m_world;
+	}
+}
@@ -0,0 +1,77 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Development Kit"
+// For conditions of distribution and use, see copyright notice in Prerequesites.hpp
+
+#pragma once
+
+#ifndef NDK_STATESNAPSHOT_HPP
+#define NDK_STATESNAPSHOT_HPP
+
+#include <Nazara/Core/ByteStream.hpp>
+#include <Nazara/Math/Quaternion.hpp>
+#include <Nazara/Math/Vector3.hpp>
+#include <NDK/Prerequesites.hpp>
+#include <vector>
+
+namespace Ndk
+{
+	class Entity;
+
+	using SnapshotId = Nz::UInt32;
+
+	class NDK_API StateSnapshot
+	{
+		public:
+			enum ReplicatedComponent : Nz::UInt8
+			{
+				ReplicatedComponent_Node     = 0x01,
+				ReplicatedComponent_Velocity = 0x02
+			};
+
+			struct EntityState
+			{
+				EntityId id;
+				Nz::Quaternionf rotation;
+				Nz::UInt16 generation;
+				Nz::UInt8 components; //< ReplicatedComponent flags
+				Nz::Vector3f linearVelocity;
+				Nz::Vector3f position;
+				Nz::Vector3f scale;
+			};
+
+			inline StateSnapshot(SnapshotId id = InvalidId);
+			StateSnapshot(const StateSnapshot&) = default;
+			StateSnapshot(StateSnapshot&&) = default;
+			~StateSnapshot() = default;
+
+			void Capture(Entity* entity, Nz::UInt16 generation);
+			inline void Clear();
+
+			const EntityState* FindEntity(EntityId id) const;
+
+			inline const std::vector<EntityState>& GetEntities() const;
+			inline SnapshotId GetId() const;
+
+			bool ReadDelta(Nz::ByteStream& stream, const StateSnapshot* baseline);
+
+			inline void SetId(SnapshotId id);
+			void Sort();
+
+			bool WriteDelta(Nz::ByteStream& stream, const StateSnapshot* baseline) const;
+
+			StateSnapshot& operator=(const StateSnapshot&) = default;
+			StateSnapshot& operator=(StateSnapshot&&) = default;
+
+			static bool ReadHeader(Nz::ByteStream& stream, SnapshotId* snapshotId, SnapshotId* baselineId);
+
+			static constexpr SnapshotId InvalidId = 0;
+
+		private:
+			std::vector<EntityState> m_entities; //< Sorted by entity id
+			SnapshotId m_id;
+	};
+}
+
+#include <NDK/StateSnapshot.inl>
+
+#endif // NDK_STATESNAPSHOT_HPP
@@ -0,0 +1,31 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Development Kit"
+// For conditions of distribution and use, see copyright notice in Prerequesites.hpp
+
+namespace Ndk
+{
+	inline StateSnapshot::StateSnapshot(SnapshotId id) :
+	m_id(id)
+	{
+	}
+
+	inline void StateSnapshot::Clear()
+	{
+		m_entities.clear();
+	}
+
+	inline const std::vector<StateSnapshot::EntityState>& StateSnapshot::GetEntities() const
+	{
+		return m_entities;
+	}
+
+	inline SnapshotId StateSnapshot::GetId() const
+	{
+		return m_id;
+	}
+
+	inline void StateSnapshot::SetId(SnapshotId id)
+	{
+		m_id = id;
+	}
+}
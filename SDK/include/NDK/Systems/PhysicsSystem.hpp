@@ -10,6 +10,7 @@
 #include <Nazara/Physics/PhysWorld.hpp>
 #include <NDK/EntityList.hpp>
 #include <NDK/System.hpp>
+#include <vector>
 
 namespace Ndk
 {
@@ -20,18 +21,28 @@ namespace Ndk
 			PhysicsSystem(const PhysicsSystem& system);
 			~PhysicsSystem() = default;
 
+			void EnableInterpolation(bool interpolation);
+
 			Nz::PhysWorld& GetWorld();
 			const Nz::PhysWorld& GetWorld() const;
 
+			bool IsInterpolationEnabled() const;
+
 			static SystemIndex systemIndex;
 
 		private:
+			void InterpolateNodes();
+			void OnEntityRemoved(Entity* entity) override;
 			void OnEntityValidation(Entity* entity, bool justAdded) override;
 			void OnUpdate(float elapsedTime) override;
+			void SynchronizeNode(Entity* entity);
 
+			std::vector<Entity*> m_restingObjects;
 			EntityList m_dynamicObjects;
+			EntityList m_interpolatedObjects; //< Dynamic objects moved by the last step, their nodes are interpolated until they rest
 			EntityList m_staticObjects;
 			Nz::PhysWorld m_world;
+			bool m_interpolationEnabled;
 	};
 }
 
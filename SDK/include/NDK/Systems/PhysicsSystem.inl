@@ -13,4 +13,9 @@ namespace Ndk
 	{
 		return m_world;
 	}
+
+	inline bool PhysicsSystem::IsInterpolationEnabled() const
+	{
+		return m_interpolationEnabled;
+	}
 }
@@ -7,6 +7,7 @@
 #ifndef NDK_SYSTEMS_RENDERSYSTEM_HPP
 #define NDK_SYSTEMS_RENDERSYSTEM_HPP
 
+#include <Nazara/Core/FrameAllocator.hpp>
 #include <Nazara/Graphics/AbstractBackground.hpp>
 #include <Nazara/Graphics/ForwardRenderTechnique.hpp>
 #include <NDK/EntityList.hpp>
@@ -17,6 +18,7 @@
 namespace Ndk
 {
 	class GraphicsComponent;
+	class LightComponent;
 
 	class NDK_API RenderSystem : public System<RenderSystem>
 	{
@@ -39,6 +41,12 @@ namespace Ndk
 			static SystemIndex systemIndex;
 
 		private:
+			struct LightData
+			{
+				LightComponent* component;
+				Nz::Matrix4f transformMatrix;
+			};
+
 			inline void InvalidateCoordinateSystem();
 
 			void OnEntityRemoved(Entity* entity) override;
@@ -50,6 +58,7 @@ namespace Ndk
 			EntityList m_lights;
 			Nz::BackgroundRef m_background;
 			Nz::ForwardRenderTechnique m_renderTechnique;
+			Nz::FrameAllocator m_frameAllocator;
 			Nz::Matrix4f m_coordinateSystemMatrix;
 			bool m_coordinateSystemInvalidated;
 	};
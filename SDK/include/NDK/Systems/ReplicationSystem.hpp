@@ -0,0 +1,65 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Development Kit"
+// For conditions of distribution and use, see copyright notice in Prerequesites.hpp
+
+#pragma once
+
+#ifndef NDK_SYSTEMS_REPLICATIONSYSTEM_HPP
+#define NDK_SYSTEMS_REPLICATIONSYSTEM_HPP
+
+#include <NDK/StateSnapshot.hpp>
+#include <NDK/System.hpp>
+#include <deque>
+#include <vector>
+
+namespace Ndk
+{
+	class NDK_API ReplicationSystem : public System<ReplicationSystem>
+	{
+		public:
+			using ClientId = Nz::UInt32;
+
+			ReplicationSystem();
+			~ReplicationSystem() = default;
+
+			bool AcknowledgeSnapshot(ClientId clientId, SnapshotId snapshotId);
+			ClientId AddClient();
+
+			const StateSnapshot* FindSnapshot(SnapshotId snapshotId) const;
+
+			inline SnapshotId GetAcknowledgedSnapshot(ClientId clientId) const;
+			inline std::size_t GetHistorySize() const;
+			inline SnapshotId GetLastSnapshotId() const;
+
+			inline bool IsClientValid(ClientId clientId) const;
+
+			void RemoveClient(ClientId clientId);
+
+			void SetHistorySize(std::size_t historySize);
+
+			bool WriteSnapshot(ClientId clientId, Nz::ByteStream& stream) const;
+
+			static SystemIndex systemIndex;
+
+		private:
+			void OnEntityAdded(Entity* entity) override;
+			void OnUpdate(float elapsedTime) override;
+
+			struct ClientState
+			{
+				SnapshotId acknowledgedSnapshot;
+				bool isValid;
+			};
+
+			std::deque<StateSnapshot> m_snapshots;
+			std::size_t m_historySize;
+			std::vector<ClientId> m_freeClientIds;
+			std::vector<ClientState> m_clients;
+			std::vector<Nz::UInt16> m_generations;
+			SnapshotId m_nextSnapshotId;
+	};
+}
+
+#include <NDK/Systems/ReplicationSystem.inl>
+
+#endif // NDK_SYSTEMS_REPLICATIONSYSTEM_HPP
@@ -0,0 +1,30 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Development Kit"
+// For conditions of distribution and use, see copyright notice in Prerequesites.hpp
+
+#include <Nazara/Core/Error.hpp>
+
+namespace Ndk
+{
+	inline SnapshotId ReplicationSystem::GetAcknowledgedSnapshot(ClientId clientId) const
+	{
+		NazaraAssert(IsClientValid(clientId), "Invalid client");
+
+		return m_clients[clientId].acknowledgedSnapshot;
+	}
+
+	inline std::size_t ReplicationSystem::GetHistorySize() const
+	{
+		return m_historySize;
+	}
+
+	inline SnapshotId ReplicationSystem::GetLastSnapshotId() const
+	{
+		return (!m_snapshots.empty()) ? m_snapshots.back().GetId() : StateSnapshot::InvalidId;
+	}
+
+	inline bool ReplicationSystem::IsClientValid(ClientId clientId) const
+	{
+		return clientId < m_clients.size() && m_clients[clientId].isValid;
+	}
+}
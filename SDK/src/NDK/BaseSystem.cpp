@@ -19,12 +19,11 @@ namespace Ndk
 
 		const Nz::Bitset<>& components = entity->GetComponentBits();
 
-		m_filterResult.PerformsAND(m_requiredComponents, components);
-		if (m_filterResult !=  m_requiredComponents)
+		m_filterResult.PerformsANDNOT(m_requiredComponents, components);
+		if (m_filterResult.TestAny())
 			return false; // Au moins un component requis n'est pas présent
 
-		m_filterResult.PerformsAND(m_excludedComponents, components);
-		if (m_filterResult.TestAny())
+		if (m_excludedComponents.Intersects(components))
 			return false; // Au moins un component exclu est présent
 
 		// Si nous avons une liste de composants nécessaires
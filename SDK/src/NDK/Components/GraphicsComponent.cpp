@@ -6,6 +6,8 @@
 #include <NDK/World.hpp>
 #include <NDK/Systems/RenderSystem.hpp>
 #include <NDK/Components/NodeComponent.hpp>
+#include <algorithm>
+#include <limits>
 
 namespace Ndk
 {
@@ -16,6 +18,7 @@ namespace Ndk
 
 		Renderable& r = m_renderables[index];
 		r.dataUpdated = false;
+		r.volumeUpdated = false;
 		r.renderable->InvalidateData(&r.data, flags);
 	}
 
@@ -63,6 +66,55 @@ namespace Ndk
 		InvalidateTransformMatrix();
 	}
 
+	void GraphicsComponent::UpdateLods(const Nz::Vector3f* eyePositions, const Nz::Frustumf* frustums, const Nz::Matrix4f* projectionMatrices, std::size_t viewerCount)
+	{
+		// Most renderables have no level of detail and don't need anything from the viewers
+		if (std::none_of(m_renderables.begin(), m_renderables.end(), [](const Renderable& object) { return object.renderable->IsLodEnabled(); }))
+			return;
+
+		EnsureTransformMatrixUpdate();
+
+		Nz::Vector3f position = m_transformMatrix.GetTranslation();
+
+		// Renderables get the distance to the closest viewer, and whether any viewer can see them
+		float distance = std::numeric_limits<float>::infinity();
+		for (std::size_t i = 0; i < viewerCount; ++i)
+			distance = std::min(distance, eyePositions[i].Distance(position));
+
+		for (Renderable& object : m_renderables)
+		{
+			if (!object.renderable->IsLodEnabled())
+				continue;
+
+			// The culling volume of the instance is kept until the renderable or the transform changes
+			if (!object.volumeUpdated)
+			{
+				object.data.volume = object.renderable->GetBoundingVolume();
+				object.renderable->UpdateBoundingVolume(&object.data);
+				object.volumeUpdated = true;
+			}
+
+			bool visible = false;
+			for (std::size_t i = 0; i < viewerCount && !visible; ++i)
+				visible = object.renderable->Cull(frustums[i], object.data);
+
+			// Fraction of the screen height covered by an unit at the renderable, for the viewer seeing it the largest
+			Nz::Vector3f center = object.data.volume.aabb.GetCenter();
+			float screenScale = 0.f;
+			for (std::size_t i = 0; i < viewerCount; ++i)
+			{
+				const Nz::Matrix4f& projectionMatrix = projectionMatrices[i];
+
+				// A perspective projection divides by the depth, an orthographic one doesn't
+				float depth = (projectionMatrix.m44 == 0.f) ? std::max(eyePositions[i].Distance(center), 0.0001f) : 1.f;
+				screenScale = std::max(screenScale, projectionMatrix.m22 * 0.5f / depth);
+			}
+
+			object.data.screenScale = screenScale;
+			object.renderable->UpdateLod(distance, visible);
+		}
+	}
+
 	void GraphicsComponent::UpdateTransformMatrix() const
 	{
 		NazaraAssert(m_entity && m_entity->HasComponent<NodeComponent>(), "GraphicsComponent requires NodeComponent");
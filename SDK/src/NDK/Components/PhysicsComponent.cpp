@@ -31,6 +31,7 @@ namespace Ndk
 
 		m_object.reset(new Nz::PhysObject(&world, geom, matrix));
 		m_object->SetMass(1.f);
+		m_object->SetUserdata(this); //< Allows the physics system to find back the entity of a moved object
 	}
 
 	void PhysicsComponent::OnComponentAttached(BaseComponent& component)
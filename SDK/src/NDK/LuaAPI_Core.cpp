@@ -258,10 +258,11 @@ namespace Ndk
 		instance.SetGlobal("CursorPosition");
 
 		// Nz::HashType
-		static_assert(Nz::HashType_Max + 1 == 9, "Nz::HashType has been updated but change was not reflected to Lua binding");
-		instance.PushTable(0, 9);
+		static_assert(Nz::HashType_Max + 1 == 11, "Nz::HashType has been updated but change was not reflected to Lua binding");
+		instance.PushTable(0, 11);
 		{
 			instance.SetField("CRC32", Nz::HashType_CRC32);
+			instance.SetField("CRC32C", Nz::HashType_CRC32C);
 			instance.SetField("Fletcher16", Nz::HashType_Fletcher16);
 			instance.SetField("MD5", Nz::HashType_MD5);
 			instance.SetField("SHA1", Nz::HashType_SHA1);
@@ -270,6 +271,7 @@ namespace Ndk
 			instance.SetField("SHA384", Nz::HashType_SHA384);
 			instance.SetField("SHA512", Nz::HashType_SHA512);
 			instance.SetField("Whirlpool", Nz::HashType_Whirlpool);
+			instance.SetField("XXHash64", Nz::HashType_XXHash64);
 		}
 		instance.SetGlobal("HashType");
 
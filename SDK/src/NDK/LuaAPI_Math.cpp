@@ -1,6 +1,7 @@
 // This file was automatically generated on 26 May 2014 at 01:05:31
 
 #include <NDK/LuaAPI.hpp>
+#include <Nazara/Core/MemoryHelper.hpp>
 #include <Nazara/Math.hpp>
 #include <Nazara/Lua/LuaClass.hpp>
 
@@ -11,28 +12,35 @@ namespace Ndk
 		/*********************************** Nz::Vector2 **********************************/
 		Nz::LuaClass<Nz::Vector2d> vector2dClass("Vector2");
 
-		vector2dClass.SetConstructor([](Nz::LuaInstance& lua) -> Nz::Vector2d* 
+		vector2dClass.SetConstructor([](Nz::LuaInstance& lua, Nz::Vector2d* vector) -> bool
 		{
 			unsigned int argCount = std::min(lua.GetStackTop(), 2U);
 			switch (argCount)
 			{
 				case 0:
 				case 2:
-					return new Nz::Vector2d(lua.CheckNumber(1, 0.0), lua.CheckNumber(2, 0.0));
+					Nz::PlacementNew<Nz::Vector2d>(vector, lua.CheckNumber(1, 0.0), lua.CheckNumber(2, 0.0));
+					return true;
 
 				case 1:
 				{
 					if (lua.IsOfType(1, Nz::LuaType_Number))
-						return new Nz::Vector2d(lua.CheckNumber(1));
+					{
+						Nz::PlacementNew<Nz::Vector2d>(vector, lua.CheckNumber(1));
+						return true;
+					}
 					else if (lua.IsOfType(1, "Vector2"))
-						return new Nz::Vector2d(*(*static_cast<Nz::Vector2d*>(lua.ToUserdata(1))));
+					{
+						Nz::PlacementNew<Nz::Vector2d>(vector, *static_cast<Nz::Vector2d*>(lua.ToUserdata(1)));
+						return true;
+					}
 
 					break;
 				}
 			}
 
 			lua.Error("No matching overload for Vector2 constructor");
-			return nullptr;
+			return false;
 		});
 
 		vector2dClass.SetMethod("__tostring", &Nz::Vector2d::ToString);
@@ -116,23 +124,33 @@ namespace Ndk
 		/*********************************** Nz::Vector3 **********************************/
 		Nz::LuaClass<Nz::Vector3d> vector3dClass("Vector3");
 
-		vector3dClass.SetConstructor([] (Nz::LuaInstance& lua) -> Nz::Vector3d*
+		vector3dClass.SetConstructor([] (Nz::LuaInstance& lua, Nz::Vector3d* vector) -> bool
 		{
 			unsigned int argCount = std::min(lua.GetStackTop(), 3U);
 			switch (argCount)
 			{
 				case 0:
 				case 3:
-					return new Nz::Vector3d(lua.CheckNumber(1, 0.0), lua.CheckNumber(2, 0.0), lua.CheckNumber(3, 0.0));
+					Nz::PlacementNew<Nz::Vector3d>(vector, lua.CheckNumber(1, 0.0), lua.CheckNumber(2, 0.0), lua.CheckNumber(3, 0.0));
+					return true;
 
 				case 1:
 				{
 					if (lua.IsOfType(1, Nz::LuaType_Number))
-						return new Nz::Vector3d(lua.CheckNumber(1), *static_cast<Nz::Vector2d*>(lua.ToUserdata(1)));
+					{
+						Nz::PlacementNew<Nz::Vector3d>(vector, lua.CheckNumber(1));
+						return true;
+					}
 					else if (lua.IsOfType(1, "Vector2"))
-						return new Nz::Vector3d(*(*static_cast<Nz::Vector2d*>(lua.ToUserdata(1))));
+					{
+						Nz::PlacementNew<Nz::Vector3d>(vector, *static_cast<Nz::Vector2d*>(lua.ToUserdata(1)));
+						return true;
+					}
 					else if (lua.IsOfType(1, "Vector3"))
-						return new Nz::Vector3d(*(*static_cast<Nz::Vector3d*>(lua.ToUserdata(1))));
+					{
+						Nz::PlacementNew<Nz::Vector3d>(vector, *static_cast<Nz::Vector3d*>(lua.ToUserdata(1)));
+						return true;
+					}
 
 					break;
 				}
@@ -140,16 +158,22 @@ namespace Ndk
 				case 2:
 				{
 					if (lua.IsOfType(1, Nz::LuaType_Number))
-						return new Nz::Vector3d(lua.CheckNumber(1), *static_cast<Nz::Vector2d*>(lua.CheckUserdata(1, "Vector2")));
+					{
+						Nz::PlacementNew<Nz::Vector3d>(vector, lua.CheckNumber(1), *static_cast<Nz::Vector2d*>(lua.CheckUserdata(2, "Vector2")));
+						return true;
+					}
 					else if (lua.IsOfType(1, "Vector2"))
-						return new Nz::Vector3d(*(*static_cast<Nz::Vector2d**>(lua.ToUserdata(1))), lua.CheckNumber(2));
+					{
+						Nz::PlacementNew<Nz::Vector3d>(vector, *static_cast<Nz::Vector2d*>(lua.ToUserdata(1)), lua.CheckNumber(2));
+						return true;
+					}
 
 					break;
 				}
 			}
 
 			lua.Error("No matching overload for constructor");
-			return nullptr;
+			return false;
 		});
 
 		vector3dClass.SetMethod("__tostring", &Nz::Vector3d::ToString);
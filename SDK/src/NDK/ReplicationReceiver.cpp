@@ -0,0 +1,197 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Development Kit"
+// For conditions of distribution and use, see copyright notice in Prerequesites.hpp
+
+#include <NDK/ReplicationReceiver.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <NDK/Components/NodeComponent.hpp>
+#include <NDK/Components/VelocityComponent.hpp>
+#include <NDK/World.hpp>
+#include <algorithm>
+
+namespace Ndk
+{
+	namespace
+	{
+		// Nodes are only touched when the replicated value really differs, to prevent useless invalidations
+		bool IsDifferent(const Nz::Quaternionf& lhs, const Nz::Quaternionf& rhs)
+		{
+			return lhs.w != rhs.w || lhs.x != rhs.x || lhs.y != rhs.y || lhs.z != rhs.z;
+		}
+
+		bool IsDifferent(const Nz::Vector3f& lhs, const Nz::Vector3f& rhs)
+		{
+			return lhs.x != rhs.x || lhs.y != rhs.y || lhs.z != rhs.z;
+		}
+	}
+
+	ReplicationReceiver::ReplicationReceiver(World& world) :
+	m_historySize(32),
+	m_maxEntityCount(65536),
+	m_world(&world)
+	{
+	}
+
+	ReplicationReceiver::~ReplicationReceiver()
+	{
+		Clear();
+	}
+
+	void ReplicationReceiver::Clear()
+	{
+		for (ReplicatedEntity& replicated : m_entities)
+		{
+			if (replicated.entity)
+				replicated.entity->Kill();
+		}
+
+		m_entities.clear();
+		m_snapshots.clear();
+	}
+
+	const EntityHandle& ReplicationReceiver::GetEntity(EntityId remoteId) const
+	{
+		if (remoteId < m_entities.size())
+			return m_entities[remoteId].entity;
+		else
+			return EntityHandle::InvalidHandle;
+	}
+
+	bool ReplicationReceiver::ReadSnapshot(Nz::ByteStream& stream)
+	{
+		SnapshotId baselineId;
+		SnapshotId snapshotId;
+		if (!StateSnapshot::ReadHeader(stream, &snapshotId, &baselineId))
+		{
+			NazaraError("Failed to read snapshot header");
+			return false;
+		}
+
+		// Snapshots may arrive out of order, a more recent state has already been applied
+		if (snapshotId <= GetLastSnapshotId())
+			return true;
+
+		const StateSnapshot* baseline = nullptr;
+		if (baselineId != StateSnapshot::InvalidId)
+		{
+			baseline = FindSnapshot(baselineId);
+			if (!baseline)
+			{
+				NazaraError("Baseline snapshot #" + Nz::String::Number(baselineId) + " is not part of the history");
+				return false;
+			}
+		}
+
+		StateSnapshot snapshot(snapshotId);
+		if (!snapshot.ReadDelta(stream, baseline))
+		{
+			NazaraError("Failed to read snapshot #" + Nz::String::Number(snapshotId));
+			return false;
+		}
+
+		// Remote ids index our entity array, they come from the network and must be bounded (entities are sorted by id)
+		const std::vector<StateSnapshot::EntityState>& entities = snapshot.GetEntities();
+		if (!entities.empty() && entities.back().id >= m_maxEntityCount)
+		{
+			NazaraError("Snapshot #" + Nz::String::Number(snapshotId) + " references entity #" + Nz::String::Number(entities.back().id) + " (max entity count: " + Nz::String::Number(m_maxEntityCount) + ')');
+			return false;
+		}
+
+		// Kill entities which are not part of the new state anymore
+		if (!m_snapshots.empty())
+		{
+			for (const StateSnapshot::EntityState& state : m_snapshots.back().GetEntities())
+			{
+				ReplicatedEntity& replicated = m_entities[state.id];
+				if (!snapshot.FindEntity(state.id) && replicated.entity)
+				{
+					replicated.entity->Kill();
+					replicated.entity.Reset();
+				}
+			}
+		}
+
+		for (const StateSnapshot::EntityState& state : entities)
+			Apply(state);
+
+		if (m_snapshots.size() >= m_historySize)
+			m_snapshots.pop_front();
+
+		m_snapshots.emplace_back(std::move(snapshot));
+
+		return true;
+	}
+
+	void ReplicationReceiver::SetHistorySize(std::size_t historySize)
+	{
+		NazaraAssert(historySize > 0, "History must be able to store at least one snapshot");
+
+		m_historySize = historySize;
+		while (m_snapshots.size() > m_historySize)
+			m_snapshots.pop_front();
+	}
+
+	void ReplicationReceiver::SetMaxEntityCount(std::size_t maxEntityCount)
+	{
+		NazaraAssert(maxEntityCount > 0, "Max entity count must be over zero");
+
+		m_maxEntityCount = maxEntityCount;
+	}
+
+	void ReplicationReceiver::Apply(const StateSnapshot::EntityState& state)
+	{
+		if (state.id >= m_entities.size())
+			m_entities.resize(state.id + 1);
+
+		ReplicatedEntity& replicated = m_entities[state.id];
+		if (!replicated.entity || replicated.generation != state.generation)
+		{
+			// The remote entity id has been reused by another entity
+			if (replicated.entity)
+				replicated.entity->Kill();
+
+			replicated.entity = m_world->CreateEntity();
+			replicated.generation = state.generation;
+		}
+
+		Entity* entity = replicated.entity;
+
+		if (state.components & StateSnapshot::ReplicatedComponent_Node)
+		{
+			if (!entity->HasComponent<NodeComponent>())
+				entity->AddComponent<NodeComponent>();
+
+			NodeComponent& node = entity->GetComponent<NodeComponent>();
+			if (IsDifferent(node.GetPosition(Nz::CoordSys_Local), state.position))
+				node.SetPosition(state.position);
+
+			if (IsDifferent(node.GetRotation(Nz::CoordSys_Local), state.rotation))
+				node.SetRotation(state.rotation);
+
+			if (IsDifferent(node.GetScale(Nz::CoordSys_Local), state.scale))
+				node.SetScale(state.scale);
+		}
+		else if (entity->HasComponent<NodeComponent>())
+			entity->RemoveComponent<NodeComponent>();
+
+		if (state.components & StateSnapshot::ReplicatedComponent_Velocity)
+		{
+			if (!entity->HasComponent<VelocityComponent>())
+				entity->AddComponent<VelocityComponent>();
+
+			entity->GetComponent<VelocityComponent>().linearVelocity = state.linearVelocity;
+		}
+		else if (entity->HasComponent<VelocityComponent>())
+			entity->RemoveComponent<VelocityComponent>();
+	}
+
+	const StateSnapshot* ReplicationReceiver::FindSnapshot(SnapshotId snapshotId) const
+	{
+		// Received snapshots are sorted but not necessarily consecutive
+		auto it = std::lower_bound(m_snapshots.begin(), m_snapshots.end(), snapshotId, [](const StateSnapshot& snapshot, SnapshotId id) { return snapshot.GetId() < id; });
+		if (it != m_snapshots.end() && it->GetId() == snapshotId)
+			return &*it;
+		else
+			return nullptr;
+	}
+}
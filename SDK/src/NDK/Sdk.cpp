@@ -18,6 +18,7 @@
 #include <NDK/Components/PhysicsComponent.hpp>
 #include <NDK/Components/VelocityComponent.hpp>
 #include <NDK/Systems/PhysicsSystem.hpp>
+#include <NDK/Systems/ReplicationSystem.hpp>
 #include <NDK/Systems/VelocitySystem.hpp>
 
 #ifndef NDK_SERVER
@@ -79,6 +80,7 @@ namespace Ndk
 
 			// Shared systems
 			InitializeSystem<PhysicsSystem>();
+			InitializeSystem<ReplicationSystem>();
 			InitializeSystem<VelocitySystem>();
 
 			#ifndef NDK_SERVER
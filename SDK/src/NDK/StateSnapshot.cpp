@@ -0,0 +1,402 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Development Kit"
+// For conditions of distribution and use, see copyright notice in Prerequesites.hpp
+
+#include <NDK/StateSnapshot.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <NDK/Components/NodeComponent.hpp>
+#include <NDK/Components/VelocityComponent.hpp>
+#include <NDK/Entity.hpp>
+#include <algorithm>
+
+namespace Ndk
+{
+	namespace
+	{
+		// Deltas must be exact, an epsilon would let the receiver drift away from the sender's baselines
+		bool HasChanged(const Nz::Quaternionf& lhs, const Nz::Quaternionf& rhs)
+		{
+			return lhs.w != rhs.w || lhs.x != rhs.x || lhs.y != rhs.y || lhs.z != rhs.z;
+		}
+
+		bool HasChanged(const Nz::Vector3f& lhs, const Nz::Vector3f& rhs)
+		{
+			return lhs.x != rhs.x || lhs.y != rhs.y || lhs.z != rhs.z;
+		}
+
+		void Read(Nz::ByteStream& stream, Nz::Quaternionf* quat)
+		{
+			stream >> quat->w >> quat->x >> quat->y >> quat->z;
+		}
+
+		void Read(Nz::ByteStream& stream, Nz::Vector3f* vec)
+		{
+			stream >> vec->x >> vec->y >> vec->z;
+		}
+
+		void Write(Nz::ByteStream& stream, const Nz::Quaternionf& quat)
+		{
+			stream << quat.w << quat.x << quat.y << quat.z;
+		}
+
+		void Write(Nz::ByteStream& stream, const Nz::Vector3f& vec)
+		{
+			stream << vec.x << vec.y << vec.z;
+		}
+
+		bool CheckRead(const Nz::ByteStream& stream)
+		{
+			// A truncated packet leaves the values untouched, they must not be used
+			if (stream.HasFailed())
+			{
+				NazaraError("Malformed delta: unexpected end of data");
+				return false;
+			}
+
+			return true;
+		}
+
+		bool IsFullState(const StateSnapshot::EntityState& state, const StateSnapshot::EntityState* baseState)
+		{
+			return !baseState || baseState->generation != state.generation;
+		}
+
+		bool HasChanged(const StateSnapshot::EntityState& state, const StateSnapshot::EntityState& baseState)
+		{
+			if (state.generation != baseState.generation || state.components != baseState.components)
+				return true;
+
+			if (state.components & StateSnapshot::ReplicatedComponent_Node)
+			{
+				if (HasChanged(state.position, baseState.position) || HasChanged(state.rotation, baseState.rotation) || HasChanged(state.scale, baseState.scale))
+					return true;
+			}
+
+			if (state.components & StateSnapshot::ReplicatedComponent_Velocity)
+			{
+				if (HasChanged(state.linearVelocity, baseState.linearVelocity))
+					return true;
+			}
+
+			return false;
+		}
+	}
+
+	constexpr SnapshotId StateSnapshot::InvalidId;
+
+	void StateSnapshot::Capture(Entity* entity, Nz::UInt16 generation)
+	{
+		NazaraAssert(entity && entity->IsValid(), "Invalid entity");
+
+		EntityState state;
+		state.components = 0;
+		state.generation = generation;
+		state.id = entity->GetId();
+
+		if (entity->HasComponent<NodeComponent>())
+		{
+			const NodeComponent& node = entity->GetComponent<NodeComponent>();
+
+			state.components |= ReplicatedComponent_Node;
+			state.position = node.GetPosition(Nz::CoordSys_Local);
+			state.rotation = node.GetRotation(Nz::CoordSys_Local);
+			state.scale = node.GetScale(Nz::CoordSys_Local);
+		}
+		else
+		{
+			state.position = Nz::Vector3f::Zero();
+			state.rotation = Nz::Quaternionf::Identity();
+			state.scale = Nz::Vector3f::Unit();
+		}
+
+		if (entity->HasComponent<VelocityComponent>())
+		{
+			state.components |= ReplicatedComponent_Velocity;
+			state.linearVelocity = entity->GetComponent<VelocityComponent>().linearVelocity;
+		}
+		else
+			state.linearVelocity = Nz::Vector3f::Zero();
+
+		m_entities.push_back(state);
+	}
+
+	const StateSnapshot::EntityState* StateSnapshot::FindEntity(EntityId id) const
+	{
+		auto it = std::lower_bound(m_entities.begin(), m_entities.end(), id, [](const EntityState& state, EntityId entityId) { return state.id < entityId; });
+		if (it != m_entities.end() && it->id == id)
+			return &*it;
+		else
+			return nullptr;
+	}
+
+	bool StateSnapshot::ReadDelta(Nz::ByteStream& stream, const StateSnapshot* baseline)
+	{
+		static const std::vector<EntityState> emptyBaseline;
+		const std::vector<EntityState>& baseEntities = (baseline) ? baseline->m_entities : emptyBaseline;
+
+		m_entities.clear();
+
+		Nz::UInt32 entryCount;
+		stream >> entryCount;
+		if (!CheckRead(stream))
+			return false;
+
+		// Each entry starts with an entity id, which bounds the entry count before reading them
+		Nz::UInt64 remainingSize = stream.GetSize() - stream.GetStream()->GetCursorPos();
+		if (entryCount > remainingSize / sizeof(EntityId))
+		{
+			NazaraError("Malformed delta: " + Nz::String::Number(entryCount) + " entries cannot fit in " + Nz::String::Number(remainingSize) + " bytes");
+			return false;
+		}
+
+		std::size_t baseIndex = 0;
+		for (Nz::UInt32 i = 0; i < entryCount; ++i)
+		{
+			EntityId id;
+			stream >> id;
+			if (!CheckRead(stream))
+				return false;
+
+			if (!m_entities.empty() && m_entities.back().id >= id)
+			{
+				NazaraError("Malformed delta: entity ids are not sorted");
+				return false;
+			}
+
+			// Entities without any entry are unchanged since the baseline
+			while (baseIndex < baseEntities.size() && baseEntities[baseIndex].id < id)
+				m_entities.push_back(baseEntities[baseIndex++]);
+
+			const EntityState* baseState = nullptr;
+			if (baseIndex < baseEntities.size() && baseEntities[baseIndex].id == id)
+				baseState = &baseEntities[baseIndex++];
+
+			bool removed;
+			stream >> removed;
+			if (!CheckRead(stream))
+				return false;
+
+			if (removed)
+				continue;
+
+			bool fullState;
+			bool hasNode;
+			bool hasVelocity;
+			stream >> fullState >> hasNode >> hasVelocity;
+			if (!CheckRead(stream))
+				return false;
+
+			EntityState state;
+			if (fullState)
+			{
+				state.id = id;
+				state.position = Nz::Vector3f::Zero();
+				state.rotation = Nz::Quaternionf::Identity();
+				state.scale = Nz::Vector3f::Unit();
+				state.linearVelocity = Nz::Vector3f::Zero();
+			}
+			else
+			{
+				if (!baseState)
+				{
+					NazaraError("Malformed delta: entity #" + Nz::String::Number(id) + " has no baseline");
+					return false;
+				}
+
+				state = *baseState;
+
+				// Like Capture, components removed since the baseline get back their default values
+				if (!hasNode)
+				{
+					state.position = Nz::Vector3f::Zero();
+					state.rotation = Nz::Quaternionf::Identity();
+					state.scale = Nz::Vector3f::Unit();
+				}
+
+				if (!hasVelocity)
+					state.linearVelocity = Nz::Vector3f::Zero();
+			}
+
+			state.components = 0;
+			if (hasNode)
+				state.components |= ReplicatedComponent_Node;
+
+			if (hasVelocity)
+				state.components |= ReplicatedComponent_Velocity;
+
+			if (fullState)
+			{
+				stream >> state.generation;
+
+				if (hasNode)
+				{
+					Read(stream, &state.position);
+					Read(stream, &state.rotation);
+					Read(stream, &state.scale);
+				}
+
+				if (hasVelocity)
+					Read(stream, &state.linearVelocity);
+			}
+			else
+			{
+				// A component missing from the baseline is sent as a whole
+				bool nodeAdded = hasNode && (baseState->components & ReplicatedComponent_Node) == 0;
+				bool velocityAdded = hasVelocity && (baseState->components & ReplicatedComponent_Velocity) == 0;
+
+				bool positionChanged = nodeAdded;
+				bool rotationChanged = nodeAdded;
+				bool scaleChanged = nodeAdded;
+				bool velocityChanged = velocityAdded;
+
+				if (hasNode && !nodeAdded)
+					stream >> positionChanged >> rotationChanged >> scaleChanged;
+
+				if (hasVelocity && !velocityAdded)
+					stream >> velocityChanged;
+
+				if (!CheckRead(stream))
+					return false;
+
+				if (positionChanged)
+					Read(stream, &state.position);
+
+				if (rotationChanged)
+					Read(stream, &state.rotation);
+
+				if (scaleChanged)
+					Read(stream, &state.scale);
+
+				if (velocityChanged)
+					Read(stream, &state.linearVelocity);
+			}
+
+			if (!CheckRead(stream))
+				return false;
+
+			m_entities.push_back(state);
+		}
+
+		while (baseIndex < baseEntities.size())
+			m_entities.push_back(baseEntities[baseIndex++]);
+
+		return true;
+	}
+
+	void StateSnapshot::Sort()
+	{
+		std::sort(m_entities.begin(), m_entities.end(), [](const EntityState& lhs, const EntityState& rhs) { return lhs.id < rhs.id; });
+	}
+
+	bool StateSnapshot::WriteDelta(Nz::ByteStream& stream, const StateSnapshot* baseline) const
+	{
+		static const std::vector<EntityState> emptyBaseline;
+		const std::vector<EntityState>& baseEntities = (baseline) ? baseline->m_entities : emptyBaseline;
+
+		// First pass: find out which entities need an entry (both arrays are sorted by id)
+		std::vector<std::pair<const EntityState*, const EntityState*>> entries; //< current state (null if removed), base state
+		std::size_t baseIndex = 0;
+		std::size_t index = 0;
+		while (index < m_entities.size() || baseIndex < baseEntities.size())
+		{
+			const EntityState* state = (index < m_entities.size()) ? &m_entities[index] : nullptr;
+			const EntityState* baseState = (baseIndex < baseEntities.size()) ? &baseEntities[baseIndex] : nullptr;
+
+			if (state && baseState && state->id == baseState->id)
+			{
+				if (HasChanged(*state, *baseState))
+					entries.emplace_back(state, baseState);
+
+				index++;
+				baseIndex++;
+			}
+			else if (state && (!baseState || state->id < baseState->id))
+			{
+				entries.emplace_back(state, nullptr);
+				index++;
+			}
+			else
+			{
+				entries.emplace_back(nullptr, baseState);
+				baseIndex++;
+			}
+		}
+
+		stream << m_id << ((baseline) ? baseline->GetId() : InvalidId);
+		stream << static_cast<Nz::UInt32>(entries.size());
+
+		for (const auto& entry : entries)
+		{
+			const EntityState* state = entry.first;
+			const EntityState* baseState = entry.second;
+
+			stream << ((state) ? state->id : baseState->id);
+			stream << (state == nullptr);
+			if (!state)
+				continue;
+
+			bool fullState = IsFullState(*state, baseState);
+			bool hasNode = (state->components & ReplicatedComponent_Node) != 0;
+			bool hasVelocity = (state->components & ReplicatedComponent_Velocity) != 0;
+
+			stream << fullState << hasNode << hasVelocity;
+
+			if (fullState)
+			{
+				stream << state->generation;
+
+				if (hasNode)
+				{
+					Write(stream, state->position);
+					Write(stream, state->rotation);
+					Write(stream, state->scale);
+				}
+
+				if (hasVelocity)
+					Write(stream, state->linearVelocity);
+			}
+			else
+			{
+				bool nodeAdded = hasNode && (baseState->components & ReplicatedComponent_Node) == 0;
+				bool velocityAdded = hasVelocity && (baseState->components & ReplicatedComponent_Velocity) == 0;
+
+				bool positionChanged = nodeAdded || (hasNode && HasChanged(state->position, baseState->position));
+				bool rotationChanged = nodeAdded || (hasNode && HasChanged(state->rotation, baseState->rotation));
+				bool scaleChanged = nodeAdded || (hasNode && HasChanged(state->scale, baseState->scale));
+				bool velocityChanged = velocityAdded || (hasVelocity && HasChanged(state->linearVelocity, baseState->linearVelocity));
+
+				if (hasNode && !nodeAdded)
+					stream << positionChanged << rotationChanged << scaleChanged;
+
+				if (hasVelocity && !velocityAdded)
+					stream << velocityChanged;
+
+				if (positionChanged)
+					Write(stream, state->position);
+
+				if (rotationChanged)
+					Write(stream, state->rotation);
+
+				if (scaleChanged)
+					Write(stream, state->scale);
+
+				if (velocityChanged)
+					Write(stream, state->linearVelocity);
+			}
+		}
+
+		return stream.FlushBits();
+	}
+
+	bool StateSnapshot::ReadHeader(Nz::ByteStream& stream, SnapshotId* snapshotId, SnapshotId* baselineId)
+	{
+		NazaraAssert(snapshotId, "Invalid snapshot id pointer");
+		NazaraAssert(baselineId, "Invalid baseline id pointer");
+
+		stream >> *snapshotId >> *baselineId;
+		if (stream.HasFailed())
+			return false;
+
+		return *snapshotId != InvalidId;
+	}
+}
@@ -10,7 +10,8 @@
 
 namespace Ndk
 {
-	PhysicsSystem::PhysicsSystem()
+	PhysicsSystem::PhysicsSystem() :
+	m_interpolationEnabled(false)
 	{
 		Requires<NodeComponent>();
 		RequiresAny<CollisionComponent, PhysicsComponent>();
@@ -18,10 +19,66 @@ namespace Ndk
 
 	PhysicsSystem::PhysicsSystem(const PhysicsSystem& system) :
 	System(system),
-	m_world()
+	m_world(),
+	m_interpolationEnabled(system.m_interpolationEnabled)
 	{
 	}
 
+	void PhysicsSystem::EnableInterpolation(bool interpolation)
+	{
+		if (m_interpolationEnabled == interpolation)
+			return;
+
+		// Les objets en cours d'interpolation sont ramenés à leur état courant
+		if (!interpolation)
+		{
+			for (const Ndk::EntityHandle& entity : m_interpolatedObjects)
+			{
+				if (m_dynamicObjects.Has(entity.GetEntity()))
+					SynchronizeNode(entity);
+			}
+
+			m_interpolatedObjects.Clear();
+		}
+
+		m_interpolationEnabled = interpolation;
+	}
+
+	void PhysicsSystem::InterpolateNodes()
+	{
+		float interpolation = m_world.GetInterpolationFactor();
+
+		m_restingObjects.clear();
+		for (const Ndk::EntityHandle& entity : m_interpolatedObjects)
+		{
+			if (!m_dynamicObjects.Has(entity.GetEntity()))
+			{
+				m_restingObjects.push_back(entity);
+				continue;
+			}
+
+			NodeComponent& node = entity->GetComponent<NodeComponent>();
+			Nz::PhysObject& physObj = entity->GetComponent<PhysicsComponent>().GetPhysObject();
+
+			node.SetRotation(physObj.GetInterpolatedRotation(interpolation), Nz::CoordSys_Global);
+			node.SetPosition(physObj.GetInterpolatedPosition(interpolation), Nz::CoordSys_Global);
+
+			// Un objet n'ayant pas bougé lors du dernier pas est au repos, son noeud est dans son état final
+			if (!physObj.IsInterpolated())
+				m_restingObjects.push_back(entity);
+		}
+
+		for (Entity* entity : m_restingObjects)
+			m_interpolatedObjects.Remove(entity);
+	}
+
+	void PhysicsSystem::OnEntityRemoved(Entity* entity)
+	{
+		m_dynamicObjects.Remove(entity);
+		m_interpolatedObjects.Remove(entity);
+		m_staticObjects.Remove(entity);
+	}
+
 	void PhysicsSystem::OnEntityValidation(Entity* entity, bool justAdded)
 	{
 		// Si l'entité ne vient pas d'être ajoutée au système, il est possible qu'elle fasse partie du mauvais tableau
@@ -34,21 +91,36 @@ namespace Ndk
 
 		auto& entities = (entity->HasComponent<PhysicsComponent>()) ? m_dynamicObjects : m_staticObjects;
 		entities.Insert(entity);
+
+		// Les noeuds ne sont ensuite synchronisés que lorsque l'objet physique bouge
+		if (entity->HasComponent<PhysicsComponent>())
+			SynchronizeNode(entity);
 	}
 
 	void PhysicsSystem::OnUpdate(float elapsedTime)
 	{
 		m_world.Step(elapsedTime);
 
-		for (const Ndk::EntityHandle& entity : m_dynamicObjects)
+		// Seuls les objets ayant bougé sont synchronisés, les objets endormis n'invalident pas leurs noeuds
+		for (Nz::PhysObject* physObj : m_world.GetMovedObjects())
 		{
-			NodeComponent& node = entity->GetComponent<NodeComponent>();
-			PhysicsComponent& phys = entity->GetComponent<PhysicsComponent>();
+			PhysicsComponent* phys = static_cast<PhysicsComponent*>(physObj->GetUserdata());
+			if (!phys) // Corps statique d'un CollisionComponent
+				continue;
 
-			Nz::PhysObject& physObj = phys.GetPhysObject();
-			node.SetRotation(physObj.GetRotation(), Nz::CoordSys_Global);
-			node.SetPosition(physObj.GetPosition(), Nz::CoordSys_Global);
+			Entity* entity = phys->m_entity;
+			if (m_dynamicObjects.Has(entity))
+			{
+				if (m_interpolationEnabled)
+					m_interpolatedObjects.Insert(entity);
+				else
+					SynchronizeNode(entity);
+			}
 		}
+		m_world.ClearMovedObjects();
+
+		if (m_interpolationEnabled)
+			InterpolateNodes();
 
 		float invElapsedTime = 1.f / elapsedTime;
 		for (const Ndk::EntityHandle& entity : m_staticObjects)
@@ -89,5 +161,14 @@ namespace Ndk
 		}
 	}
 
+	void PhysicsSystem::SynchronizeNode(Entity* entity)
+	{
+		NodeComponent& node = entity->GetComponent<NodeComponent>();
+		Nz::PhysObject& physObj = entity->GetComponent<PhysicsComponent>().GetPhysObject();
+
+		node.SetRotation(physObj.GetRotation(), Nz::CoordSys_Global);
+		node.SetPosition(physObj.GetPosition(), Nz::CoordSys_Global);
+	}
+
 	SystemIndex PhysicsSystem::systemIndex;
 }
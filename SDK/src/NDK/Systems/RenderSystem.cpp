@@ -68,6 +68,48 @@ namespace Ndk
 			m_coordinateSystemInvalidated = false;
 		}
 
+		// Per-frame data is gathered once for every camera, in frame memory
+		m_frameAllocator.Reset();
+
+		Nz::FrameVector<const GraphicsComponent*> graphicsComponents{Nz::FrameAllocatorAdaptor<const GraphicsComponent*>(m_frameAllocator)};
+		graphicsComponents.reserve(m_drawables.size());
+
+		for (const Ndk::EntityHandle& drawable : m_drawables)
+			graphicsComponents.push_back(&drawable->GetComponent<GraphicsComponent>());
+
+		// Renderables adapt their level of detail (animation rate, ...) to the cameras, before being drawn by any of them
+		if (!m_cameras.empty())
+		{
+			Nz::FrameVector<Nz::Vector3f> eyePositions{Nz::FrameAllocatorAdaptor<Nz::Vector3f>(m_frameAllocator)};
+			Nz::FrameVector<Nz::Frustumf> frustums{Nz::FrameAllocatorAdaptor<Nz::Frustumf>(m_frameAllocator)};
+			Nz::FrameVector<Nz::Matrix4f> projectionMatrices{Nz::FrameAllocatorAdaptor<Nz::Matrix4f>(m_frameAllocator)};
+			eyePositions.reserve(m_cameras.size());
+			frustums.reserve(m_cameras.size());
+			projectionMatrices.reserve(m_cameras.size());
+
+			for (const Ndk::EntityHandle& camera : m_cameras)
+			{
+				CameraComponent& camComponent = camera->GetComponent<CameraComponent>();
+				eyePositions.push_back(camComponent.GetEyePosition());
+				frustums.push_back(camComponent.GetFrustum());
+				projectionMatrices.push_back(camComponent.GetProjectionMatrix());
+			}
+
+			for (const Ndk::EntityHandle& drawable : m_drawables)
+				drawable->GetComponent<GraphicsComponent>().UpdateLods(eyePositions.data(), frustums.data(), projectionMatrices.data(), eyePositions.size());
+		}
+
+		Nz::FrameVector<LightData> lights{Nz::FrameAllocatorAdaptor<LightData>(m_frameAllocator)};
+		lights.reserve(m_lights.size());
+
+		for (const Ndk::EntityHandle& light : m_lights)
+		{
+			LightComponent& lightComponent = light->GetComponent<LightComponent>();
+			NodeComponent& lightNode = light->GetComponent<NodeComponent>();
+
+			lights.push_back(LightData{&lightComponent, Nz::Matrix4f::ConcatenateAffine(m_coordinateSystemMatrix, lightNode.GetTransformMatrix())});
+		}
+
 		for (const Ndk::EntityHandle& camera : m_cameras)
 		{
 			CameraComponent& camComponent = camera->GetComponent<CameraComponent>();
@@ -77,22 +119,11 @@ namespace Ndk
 			renderQueue->Clear();
 
 			//TODO: Culling
-			for (const Ndk::EntityHandle& drawable : m_drawables)
-			{
-				GraphicsComponent& graphicsComponent = drawable->GetComponent<GraphicsComponent>();
-				NodeComponent& drawableNode = drawable->GetComponent<NodeComponent>();
+			for (const GraphicsComponent* graphicsComponent : graphicsComponents)
+				graphicsComponent->AddToRenderQueue(renderQueue);
 
-				graphicsComponent.AddToRenderQueue(renderQueue);
-			}
-
-			for (const Ndk::EntityHandle& light : m_lights)
-			{
-				LightComponent& lightComponent = light->GetComponent<LightComponent>();
-				NodeComponent& drawableNode = light->GetComponent<NodeComponent>();
-
-				///TODO: Cache somehow?
-				lightComponent.AddToRenderQueue(renderQueue, Nz::Matrix4f::ConcatenateAffine(m_coordinateSystemMatrix, drawableNode.GetTransformMatrix()));
-			}
+			for (const LightData& light : lights)
+				light.component->AddToRenderQueue(renderQueue, light.transformMatrix);
 
 			Nz::SceneData sceneData;
 			sceneData.ambientColor = Nz::Color(25, 25, 25);
@@ -0,0 +1,135 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Development Kit"
+// For conditions of distribution and use, see copyright notice in Prerequesites.hpp
+
+#include <NDK/Systems/ReplicationSystem.hpp>
+#include <NDK/Components/NodeComponent.hpp>
+#include <NDK/Components/VelocityComponent.hpp>
+
+namespace Ndk
+{
+	ReplicationSystem::ReplicationSystem() :
+	m_historySize(32),
+	m_nextSnapshotId(1)
+	{
+		RequiresAny<NodeComponent, VelocityComponent>();
+	}
+
+	bool ReplicationSystem::AcknowledgeSnapshot(ClientId clientId, SnapshotId snapshotId)
+	{
+		NazaraAssert(IsClientValid(clientId), "Invalid client");
+
+		// Ignore late acknowledgments, the client already has a more recent baseline
+		ClientState& client = m_clients[clientId];
+		if (snapshotId <= client.acknowledgedSnapshot)
+			return true;
+
+		if (!FindSnapshot(snapshotId))
+			return false;
+
+		client.acknowledgedSnapshot = snapshotId;
+		return true;
+	}
+
+	ReplicationSystem::ClientId ReplicationSystem::AddClient()
+	{
+		ClientId clientId;
+		if (!m_freeClientIds.empty())
+		{
+			clientId = m_freeClientIds.back();
+			m_freeClientIds.pop_back();
+		}
+		else
+		{
+			clientId = static_cast<ClientId>(m_clients.size());
+			m_clients.emplace_back();
+		}
+
+		ClientState& client = m_clients[clientId];
+		client.acknowledgedSnapshot = StateSnapshot::InvalidId;
+		client.isValid = true;
+
+		return clientId;
+	}
+
+	const StateSnapshot* ReplicationSystem::FindSnapshot(SnapshotId snapshotId) const
+	{
+		if (m_snapshots.empty() || snapshotId == StateSnapshot::InvalidId)
+			return nullptr;
+
+		// Snapshot ids are consecutive in the history
+		SnapshotId firstId = m_snapshots.front().GetId();
+		if (snapshotId < firstId || snapshotId - firstId >= m_snapshots.size())
+			return nullptr;
+
+		return &m_snapshots[snapshotId - firstId];
+	}
+
+	void ReplicationSystem::RemoveClient(ClientId clientId)
+	{
+		NazaraAssert(IsClientValid(clientId), "Invalid client");
+
+		m_clients[clientId].isValid = false;
+		m_freeClientIds.push_back(clientId);
+	}
+
+	void ReplicationSystem::SetHistorySize(std::size_t historySize)
+	{
+		NazaraAssert(historySize > 0, "History must be able to store at least one snapshot");
+
+		m_historySize = historySize;
+		while (m_snapshots.size() > m_historySize)
+			m_snapshots.pop_front();
+	}
+
+	bool ReplicationSystem::WriteSnapshot(ClientId clientId, Nz::ByteStream& stream) const
+	{
+		NazaraAssert(IsClientValid(clientId), "Invalid client");
+
+		if (m_snapshots.empty())
+		{
+			NazaraError("No snapshot has been captured yet");
+			return false;
+		}
+
+		// Falls back to a full state if the client never acknowledged anything or if its baseline went out of the history
+		const StateSnapshot* baseline = FindSnapshot(m_clients[clientId].acknowledgedSnapshot);
+
+		return m_snapshots.back().WriteDelta(stream, baseline);
+	}
+
+	void ReplicationSystem::OnEntityAdded(Entity* entity)
+	{
+		// A new generation allows receivers to tell a reused entity id from the previous entity
+		EntityId id = entity->GetId();
+		if (id >= m_generations.size())
+			m_generations.resize(id + 1, 0);
+
+		m_generations[id]++;
+	}
+
+	void ReplicationSystem::OnUpdate(float elapsedTime)
+	{
+		NazaraUnused(elapsedTime);
+
+		if (m_snapshots.size() >= m_historySize)
+		{
+			// Recycle the oldest snapshot memory
+			m_snapshots.push_back(std::move(m_snapshots.front()));
+			m_snapshots.pop_front();
+		}
+		else
+			m_snapshots.emplace_back();
+
+		StateSnapshot& snapshot = m_snapshots.back();
+		snapshot.Clear();
+		snapshot.SetId(m_nextSnapshotId++);
+
+		for (const Ndk::EntityHandle& entity : GetEntities())
+			snapshot.Capture(entity, m_generations[entity->GetId()]);
+
+		snapshot.Sort();
+	}
+
+	SystemIndex ReplicationSystem::systemIndex;
+}
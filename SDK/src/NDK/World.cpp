@@ -94,7 +94,7 @@ namespace Ndk
 	void World::Update()
 	{
 		// Gestion des entités tuées depuis le dernier appel
-		for (unsigned int i = m_killedEntities.FindFirst(); i != m_killedEntities.npos; i = m_killedEntities.FindNext(i))
+		m_killedEntities.ForEachSetBit([this](unsigned int i)
 		{
 			EntityBlock& block = m_entities[i];
 			Entity& entity = block.entity;
@@ -123,11 +123,11 @@ namespace Ndk
 				m_entities[myHandle->GetId()].aliveIndex = block.aliveIndex;
 			}
 			m_aliveEntities.pop_back();
-		}
+		});
 		m_killedEntities.Reset();
 
 		// Gestion des entités nécessitant une mise à jour de leurs systèmes
-		for (unsigned int i = m_dirtyEntities.FindFirst(); i != m_dirtyEntities.npos; i = m_dirtyEntities.FindNext(i))
+		m_dirtyEntities.ForEachSetBit([this](unsigned int i)
 		{
 			NazaraAssert(i < m_entities.size(), "Entity index out of range");
 
@@ -135,7 +135,7 @@ namespace Ndk
 
 			// Check entity validity (as it could have been reported as dirty and killed during the same iteration)
 			if (!entity->IsValid())
-				continue;
+				return;
 
 			for (auto& system : m_systems)
 			{
@@ -162,7 +162,7 @@ namespace Ndk
 						system->RemoveEntity(entity);
 				}
 			}
-		}
+		});
 		m_dirtyEntities.Reset();
 	}
 }
@@ -7,12 +7,14 @@ TOOL.Defines = {
 }
 
 TOOL.Includes = {
-	"../include"
+	"../include",
+	"../SDK/include"
 }
 
 TOOL.Files = {
 	"../tests/main.cpp",
-	"../tests/Engine/**.cpp"
+	"../tests/Engine/**.cpp",
+	"../tests/SDK/**.cpp"
 }
 
 TOOL.Libraries = {
@@ -23,5 +25,6 @@ TOOL.Libraries = {
 	"NazaraPhysics",
 	"NazaraUtility",
 	"NazaraRenderer",
-	"NazaraGraphics"
+	"NazaraGraphics",
+	"NazaraSDK"
 }
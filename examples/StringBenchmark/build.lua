@@ -0,0 +1,11 @@
+EXAMPLE.Name = "StringBenchmark"
+
+EXAMPLE.Console = true
+
+EXAMPLE.Files = {
+	"main.cpp"
+}
+
+EXAMPLE.Libraries = {
+	"NazaraCore"
+}
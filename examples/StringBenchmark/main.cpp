@@ -0,0 +1,111 @@
+/*
+** Nz::String - Mesure des performances des chaînes de caractères
+** Prérequis: Aucun
+** Utilisation du noyau
+** Présente:
+** - Le coût de construction, de copie, de comparaison et de hachage de Nz::String, comparé à std::string
+** - La différence entre chaînes courtes (stockées dans l'objet) et longues (partagées par copy-on-write)
+*/
+
+#include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/String.hpp>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+	const unsigned int iterationCount = 1000000;
+
+	// Empêche le compilateur d'éliminer le travail mesuré
+	volatile std::size_t sink;
+
+	std::size_t GetSize(const Nz::String& str)
+	{
+		return str.GetSize();
+	}
+
+	std::size_t GetSize(const std::string& str)
+	{
+		return str.size();
+	}
+
+	template<typename F>
+	void Measure(const char* name, F&& func)
+	{
+		Nz::Clock clock;
+		func();
+		Nz::UInt64 elapsed = clock.GetMicroseconds();
+
+		std::cout << std::left << std::setw(40) << name << std::right << std::setw(8) << (elapsed * 1000 / iterationCount) << " ns/op" << std::endl;
+	}
+
+	template<typename T>
+	void Run(const char* typeName, const char* value)
+	{
+		std::cout << "-- " << typeName << " \"" << value << "\" --" << std::endl;
+
+		Measure("Construction", [value]()
+		{
+			for (unsigned int i = 0; i < iterationCount; ++i)
+			{
+				T str(value);
+				sink = sink + GetSize(str);
+			}
+		});
+
+		T source(value);
+		Measure("Copie", [&source]()
+		{
+			for (unsigned int i = 0; i < iterationCount; ++i)
+			{
+				T copy(source);
+				sink = sink + GetSize(copy);
+			}
+		});
+
+		T other(value);
+		Measure("Comparaison", [&source, &other]()
+		{
+			for (unsigned int i = 0; i < iterationCount; ++i)
+				sink = sink + (source == other);
+		});
+
+		std::hash<T> hasher;
+		Measure("Hachage", [&source, &hasher]()
+		{
+			for (unsigned int i = 0; i < iterationCount; ++i)
+				sink = sink + hasher(source);
+		});
+
+		Measure("Ajout caractère par caractère (x16)", [value]()
+		{
+			for (unsigned int i = 0; i < iterationCount; ++i)
+			{
+				T str;
+				for (unsigned int j = 0; j < 16; ++j)
+					str += value[j % 4];
+
+				sink = sink + GetSize(str);
+			}
+		});
+
+		std::cout << std::endl;
+	}
+}
+
+int main()
+{
+	const char* shortString = "DiffuseMap";
+	const char* longString = "Textures/Characters/Hero/DiffuseMap.png";
+
+	Run<Nz::String>("Nz::String", shortString);
+	Run<std::string>("std::string", shortString);
+
+	Run<Nz::String>("Nz::String", longString);
+	Run<std::string>("std::string", longString);
+
+	return 0;
+}
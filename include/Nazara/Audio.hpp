@@ -35,6 +35,7 @@
 #include <Nazara/Audio/Enums.hpp>
 #include <Nazara/Audio/Music.hpp>
 #include <Nazara/Audio/OpenAL.hpp>
+#include <Nazara/Audio/SoftwareMixer.hpp>
 #include <Nazara/Audio/Sound.hpp>
 #include <Nazara/Audio/SoundBuffer.hpp>
 #include <Nazara/Audio/SoundEmitter.hpp>
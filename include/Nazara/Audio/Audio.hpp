@@ -16,6 +16,8 @@
 
 namespace Nz
 {
+	class SoftwareMixer;
+
 	class NAZARA_AUDIO_API Audio
 	{
 		public:
@@ -23,15 +25,17 @@ namespace Nz
 			~Audio() = delete;
 
 			static AudioFormat GetAudioFormat(unsigned int channelCount);
+			static AudioBackend GetBackend();
 			static float GetDopplerFactor();
 			static float GetGlobalVolume();
 			static Vector3f GetListenerDirection();
 			static Vector3f GetListenerPosition();
 			static Quaternionf GetListenerRotation();
 			static Vector3f GetListenerVelocity();
+			static SoftwareMixer* GetSoftwareMixer();
 			static float GetSpeedOfSound();
 
-			static bool Initialize();
+			static bool Initialize(AudioBackend backend = AudioBackend_OpenAL);
 
 			static bool IsFormatSupported(AudioFormat format);
 			static bool IsInitialized();
@@ -50,6 +54,7 @@ namespace Nz
 			static void Uninitialize();
 
 		private:
+			static AudioBackend s_backend;
 			static unsigned int s_moduleReferenceCounter;
 	};
 }
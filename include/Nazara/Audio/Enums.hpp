@@ -9,6 +9,14 @@
 
 namespace Nz
 {
+	enum AudioBackend
+	{
+		AudioBackend_OpenAL,
+		AudioBackend_Software, // Mixed by the engine, without any audio device
+
+		AudioBackend_Max = AudioBackend_Software
+	};
+
 	enum AudioFormat
 	{
 		AudioFormat_Unknown = -1,
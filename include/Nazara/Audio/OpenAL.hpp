@@ -59,6 +59,8 @@ using OpenALDetail::ALCvoid;
 
 namespace Nz
 {
+	class SoftwareMixer;
+
 	using OpenALFunc = void(*)();
 
 	class NAZARA_AUDIO_API OpenAL
@@ -66,10 +68,12 @@ namespace Nz
 		public:
 			static OpenALFunc GetEntry(const String& entryPoint);
 			static String GetRendererName();
+			static SoftwareMixer* GetSoftwareMixer();
 			static String GetVendorName();
 			static unsigned int GetVersion();
 
 			static bool Initialize(bool openDevice = true);
+			static bool InitializeSoftware(unsigned int sampleRate = 44100);
 
 			static bool IsInitialized();
 
@@ -86,6 +90,7 @@ namespace Nz
 			static void CloseDevice();
 			static bool OpenDevice();
 			static OpenALFunc LoadEntry(const char* name, bool throwException = false);
+			static void LoadSoftwareEntries(SoftwareMixer* mixer);
 	};
 }
 
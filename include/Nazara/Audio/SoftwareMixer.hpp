@@ -0,0 +1,145 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Audio module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_SOFTWAREMIXER_HPP
+#define NAZARA_SOFTWAREMIXER_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Audio/Config.hpp>
+#include <Nazara/Audio/Enums.hpp>
+#include <Nazara/Core/Mutex.hpp>
+#include <Nazara/Core/String.hpp>
+#include <Nazara/Math/Vector3.hpp>
+#include <limits>
+#include <vector>
+
+namespace Nz
+{
+	class Stream;
+
+	// Mixes sources into an interleaved stereo output without any audio device, this is what the software backend
+	// of the audio module plays into (the output is then only rendered on demand, into memory or into a WAV file)
+	class NAZARA_AUDIO_API SoftwareMixer
+	{
+		public:
+			struct ListenerParameters
+			{
+				Vector3f forward = Vector3f::Forward();
+				Vector3f position = Vector3f::Zero();
+				Vector3f up = Vector3f::Up();
+				Vector3f velocity = Vector3f::Zero();
+				float gain = 1.f;
+			};
+
+			struct SourceParameters
+			{
+				Vector3f position = Vector3f::Zero();
+				Vector3f velocity = Vector3f::Zero();
+				float attenuation = 1.f; //< Rolloff factor
+				float gain = 1.f;
+				float maxDistance = std::numeric_limits<float>::max();
+				float minDistance = 1.f; //< Distance under which the source is not attenuated
+				float pitch = 1.f;
+				bool looping = false;
+				bool spatialized = true; //< If false, the position is relative to the listener
+			};
+
+			SoftwareMixer(unsigned int sampleRate = 44100);
+			SoftwareMixer(const SoftwareMixer&) = delete;
+			SoftwareMixer(SoftwareMixer&&) = delete;
+			~SoftwareMixer() = default;
+
+			unsigned int CreateBuffer();
+			unsigned int CreateSource();
+
+			bool DestroyBuffer(unsigned int buffer);
+			void DestroySource(unsigned int source);
+
+			float GetDopplerFactor() const;
+			ListenerParameters GetListener() const;
+			UInt64 GetRenderedFrameCount() const;
+			unsigned int GetSampleRate() const;
+			float GetSourceOffset(unsigned int source) const;
+			SourceParameters GetSourceParameters(unsigned int source) const;
+			unsigned int GetSourceProcessedBufferCount(unsigned int source) const;
+			unsigned int GetSourceQueuedBufferCount(unsigned int source) const;
+			SoundStatus GetSourceStatus(unsigned int source) const;
+			float GetSpeedOfSound() const;
+
+			bool IsBuffer(unsigned int buffer) const;
+			bool IsSource(unsigned int source) const;
+
+			void PauseSource(unsigned int source);
+			void PlaySource(unsigned int source);
+
+			bool QueueSourceBuffers(unsigned int source, unsigned int count, const unsigned int* buffers);
+
+			void Render(float* output, UInt32 frameCount);
+			void Render(Int16* output, UInt32 frameCount);
+			bool RenderToFile(const String& filePath, UInt32 frameCount);
+			bool RenderToStream(Stream& stream, UInt32 frameCount);
+
+			void SetDopplerFactor(float dopplerFactor);
+			void SetListener(const ListenerParameters& listener);
+			bool SetSourceBuffer(unsigned int source, unsigned int buffer);
+			void SetSourceOffset(unsigned int source, float offset);
+			void SetSourceParameters(unsigned int source, const SourceParameters& parameters);
+			void SetSpeedOfSound(float speed);
+			void StopSource(unsigned int source);
+
+			bool UnqueueSourceBuffers(unsigned int source, unsigned int count, unsigned int* buffers);
+			bool UpdateBuffer(unsigned int buffer, unsigned int channelCount, const Int16* samples, UInt32 sampleCount, UInt32 sampleRate);
+
+			SoftwareMixer& operator=(const SoftwareMixer&) = delete;
+			SoftwareMixer& operator=(SoftwareMixer&&) = delete;
+
+			static constexpr unsigned int ChannelCount = 2;
+			static constexpr unsigned int InvalidId = 0;
+
+		private:
+			struct Buffer
+			{
+				std::vector<Int16> samples;
+				UInt32 frameCount = 0;
+				UInt32 sampleRate = 0;
+				unsigned int channelCount = 0;
+				unsigned int queueCount = 0; //< Number of sources using it
+				bool used = false;
+			};
+
+			struct Source
+			{
+				SourceParameters parameters;
+				SoundStatus status;
+				std::vector<unsigned int> queue;
+				double cursor; //< In frames of the current buffer
+				std::size_t currentBuffer; //< Also the number of processed buffers
+				bool used = false;
+			};
+
+			void ComputeGains(const Source& source, const Buffer& buffer, float* leftGain, float* rightGain, double* step) const;
+			Buffer* GetBufferInternal(unsigned int buffer);
+			Source* GetSourceInternal(unsigned int source);
+			const Source* GetSourceInternal(unsigned int source) const;
+			void MixSource(Source& source, float* output, UInt32 frameCount);
+			void ReleaseQueue(Source& source);
+			void RenderInternal(float* output, UInt32 frameCount);
+
+			std::vector<Buffer> m_buffers;
+			std::vector<Source> m_sources;
+			std::vector<float> m_mixBuffer;
+			std::vector<unsigned int> m_freeBuffers;
+			std::vector<unsigned int> m_freeSources;
+			mutable Mutex m_mutex;
+			ListenerParameters m_listener;
+			UInt64 m_renderedFrameCount;
+			float m_dopplerFactor;
+			float m_speedOfSound;
+			unsigned int m_sampleRate;
+	};
+}
+
+#endif // NAZARA_SOFTWAREMIXER_HPP
@@ -41,10 +41,28 @@ namespace Nz
 	template<typename T>
 	std::enable_if_t<std::is_arithmetic<T>::value, bool> Serialize(SerializationContext& context, T value);
 
+	template<typename T>
+	std::enable_if_t<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value, bool> Serialize(SerializationContext& context, const T* values, std::size_t count);
+
+	inline bool SerializeBits(SerializationContext& context, UInt64 value, unsigned int bitCount);
+	inline bool SerializeQuantized(SerializationContext& context, float value, float min, float max, unsigned int bitCount);
+
+	template<typename T>
+	std::enable_if_t<std::is_integral<T>::value, bool> SerializeVarInt(SerializationContext& context, T value);
+
 	inline bool Unserialize(SerializationContext& context, bool* value);
 
 	template<typename T>
 	std::enable_if_t<std::is_arithmetic<T>::value, bool> Unserialize(SerializationContext& context, T* value);
+
+	template<typename T>
+	std::enable_if_t<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value, bool> Unserialize(SerializationContext& context, T* values, std::size_t count);
+
+	inline bool UnserializeBits(SerializationContext& context, UInt64* value, unsigned int bitCount);
+	inline bool UnserializeQuantized(SerializationContext& context, float* value, float min, float max, unsigned int bitCount);
+
+	template<typename T>
+	std::enable_if_t<std::is_integral<T>::value, bool> UnserializeVarInt(SerializationContext& context, T* value);
 }
 
 #include <Nazara/Core/Algorithm.inl>
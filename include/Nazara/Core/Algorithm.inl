@@ -10,6 +10,9 @@
 #include <Nazara/Core/ByteArray.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/Stream.hpp>
+#include <algorithm>
+#include <cstring>
+#include <limits>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
@@ -28,6 +31,69 @@ namespace Nz
 		{
 			return (object .* std::forward<F>(fn))(std::get<S>(std::forward<Tuple>(t))...);
 		}
+
+		inline float Dequantize(UInt64 value, float min, float max, unsigned int bitCount)
+		{
+			UInt64 maxValue = (UInt64(1) << bitCount) - 1;
+
+			return static_cast<float>(min + (max - min) * (static_cast<double>(value) / maxValue));
+		}
+
+		// LEB128 encoding: seven bits per byte, the highest bit tells if another byte follows
+		inline std::size_t EncodeVarInt(UInt64 value, UInt8* buffer)
+		{
+			std::size_t size = 0;
+			while (value >= 0x80)
+			{
+				buffer[size++] = static_cast<UInt8>(value | 0x80);
+				value >>= 7;
+			}
+			buffer[size++] = static_cast<UInt8>(value);
+
+			return size;
+		}
+
+		inline UInt64 Quantize(float value, float min, float max, unsigned int bitCount)
+		{
+			UInt64 maxValue = (UInt64(1) << bitCount) - 1;
+			double normalized = (static_cast<double>(std::max(min, std::min(value, max))) - min) / (static_cast<double>(max) - min);
+
+			return static_cast<UInt64>(normalized * maxValue + 0.5);
+		}
+
+		// ZigZag encoding maps signed integers to unsigned ones so small negative numbers stay small (0, -1, 1, -2, ... => 0, 1, 2, 3, ...)
+		template<typename T>
+		std::enable_if_t<std::is_signed<T>::value, UInt64> ZigZagEncode(T value)
+		{
+			return (static_cast<UInt64>(value) << 1) ^ static_cast<UInt64>(static_cast<Int64>(value) >> 63);
+		}
+
+		template<typename T>
+		std::enable_if_t<!std::is_signed<T>::value, UInt64> ZigZagEncode(T value)
+		{
+			return static_cast<UInt64>(value);
+		}
+
+		template<typename T>
+		std::enable_if_t<std::is_signed<T>::value, bool> ZigZagDecode(UInt64 value, T* result)
+		{
+			Int64 decoded = static_cast<Int64>(value >> 1) ^ -static_cast<Int64>(value & 1);
+			if (decoded < std::numeric_limits<T>::min() || decoded > std::numeric_limits<T>::max())
+				return false;
+
+			*result = static_cast<T>(decoded);
+			return true;
+		}
+
+		template<typename T>
+		std::enable_if_t<!std::is_signed<T>::value, bool> ZigZagDecode(UInt64 value, T* result)
+		{
+			if (value > std::numeric_limits<T>::max())
+				return false;
+
+			*result = static_cast<T>(value);
+			return true;
+		}
 	}
 
 	template<typename F, typename Tuple>
@@ -131,6 +197,90 @@ namespace Nz
 		return context.stream->Write(&value, sizeof(T)) == sizeof(T);
 	}
 
+	template<typename T>
+	std::enable_if_t<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value, bool> Serialize(SerializationContext& context, const T* values, std::size_t count)
+	{
+		NazaraAssert(values || count == 0, "Invalid data pointer");
+
+		// Flush bits if a writing is in progress
+		if (context.currentBitPos != 8)
+		{
+			context.currentBitPos = 8;
+
+			if (!Serialize<UInt8>(context, context.currentByte))
+				NazaraWarning("Failed to flush bits");
+		}
+
+		if (sizeof(T) == 1 || context.endianness == Endianness_Unknown || context.endianness == GetPlatformEndianness())
+			return context.stream->Write(values, count * sizeof(T)) == count * sizeof(T);
+
+		// Swap bytes by batches in a local buffer, so the stream is only called once per batch
+		constexpr std::size_t BatchSize = 1024 / sizeof(T);
+		T buffer[BatchSize];
+
+		while (count > 0)
+		{
+			std::size_t batchCount = std::min(count, BatchSize);
+			std::memcpy(buffer, values, batchCount * sizeof(T));
+			SwapBytes(buffer, sizeof(T), batchCount);
+
+			if (context.stream->Write(buffer, batchCount * sizeof(T)) != batchCount * sizeof(T))
+				return false;
+
+			count -= batchCount;
+			values += batchCount;
+		}
+
+		return true;
+	}
+
+	inline bool SerializeBits(SerializationContext& context, UInt64 value, unsigned int bitCount)
+	{
+		NazaraAssert(bitCount <= 64, "Bit count must be lower or equal to 64");
+
+		// Same layout as the bool serialization: bits are stored from the least significant one
+		while (bitCount > 0)
+		{
+			if (context.currentBitPos == 8)
+			{
+				context.currentBitPos = 0;
+				context.currentByte = 0;
+			}
+
+			unsigned int bits = std::min(bitCount, 8U - context.currentBitPos);
+			context.currentByte |= static_cast<UInt8>((value & ((1U << bits) - 1)) << context.currentBitPos);
+			context.currentBitPos += bits;
+
+			value >>= bits;
+			bitCount -= bits;
+
+			if (context.currentBitPos >= 8)
+			{
+				if (!Serialize<UInt8>(context, context.currentByte))
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	inline bool SerializeQuantized(SerializationContext& context, float value, float min, float max, unsigned int bitCount)
+	{
+		NazaraAssert(bitCount > 0 && bitCount <= 32, "Bit count must be between 1 and 32");
+		NazaraAssert(min < max, "Invalid range");
+
+		return SerializeBits(context, Detail::Quantize(value, min, max, bitCount), bitCount);
+	}
+
+	template<typename T>
+	std::enable_if_t<std::is_integral<T>::value, bool> SerializeVarInt(SerializationContext& context, T value)
+	{
+		UInt8 buffer[10]; //< A 64 bits integer takes up to ten bytes
+		std::size_t size = Detail::EncodeVarInt(Detail::ZigZagEncode(value), buffer);
+
+		return Serialize(context, buffer, size);
+	}
+
 	inline bool Unserialize(SerializationContext& context, bool* value)
 	{
 		if (context.currentBitPos == 8)
@@ -167,6 +317,87 @@ namespace Nz
 		else
 			return false;
 	}
+
+	template<typename T>
+	std::enable_if_t<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value, bool> Unserialize(SerializationContext& context, T* values, std::size_t count)
+	{
+		NazaraAssert(values || count == 0, "Invalid data pointer");
+
+		// Reset bit position
+		context.currentBitPos = 8;
+
+		if (context.stream->Read(values, count * sizeof(T)) != count * sizeof(T))
+			return false;
+
+		if (sizeof(T) != 1 && context.endianness != Endianness_Unknown && context.endianness != GetPlatformEndianness())
+			SwapBytes(values, sizeof(T), count);
+
+		return true;
+	}
+
+	inline bool UnserializeBits(SerializationContext& context, UInt64* value, unsigned int bitCount)
+	{
+		NazaraAssert(value, "Invalid data pointer");
+		NazaraAssert(bitCount <= 64, "Bit count must be lower or equal to 64");
+
+		UInt64 result = 0;
+		unsigned int shift = 0;
+		while (bitCount > 0)
+		{
+			if (context.currentBitPos == 8)
+			{
+				if (!Unserialize(context, &context.currentByte))
+					return false;
+
+				context.currentBitPos = 0;
+			}
+
+			unsigned int bits = std::min(bitCount, 8U - context.currentBitPos);
+			result |= static_cast<UInt64>((context.currentByte >> context.currentBitPos) & ((1U << bits) - 1)) << shift;
+			context.currentBitPos += bits;
+
+			bitCount -= bits;
+			shift += bits;
+		}
+
+		*value = result;
+		return true;
+	}
+
+	inline bool UnserializeQuantized(SerializationContext& context, float* value, float min, float max, unsigned int bitCount)
+	{
+		NazaraAssert(value, "Invalid data pointer");
+		NazaraAssert(bitCount > 0 && bitCount <= 32, "Bit count must be between 1 and 32");
+		NazaraAssert(min < max, "Invalid range");
+
+		UInt64 quantized;
+		if (!UnserializeBits(context, &quantized, bitCount))
+			return false;
+
+		*value = Detail::Dequantize(quantized, min, max, bitCount);
+		return true;
+	}
+
+	template<typename T>
+	std::enable_if_t<std::is_integral<T>::value, bool> UnserializeVarInt(SerializationContext& context, T* value)
+	{
+		NazaraAssert(value, "Invalid data pointer");
+
+		UInt64 encoded = 0;
+		for (unsigned int shift = 0; shift < 64; shift += 7)
+		{
+			UInt8 byte;
+			if (!Unserialize(context, &byte))
+				return false;
+
+			encoded |= static_cast<UInt64>(byte & 0x7F) << shift;
+			if ((byte & 0x80) == 0)
+				return Detail::ZigZagDecode(encoded, value);
+		}
+
+		NazaraError("Malformed variable-length integer");
+		return false;
+	}
 }
 
 #include <Nazara/Core/DebugOff.hpp>
@@ -40,6 +40,7 @@ namespace Nz
 
 			unsigned int FindFirst() const;
 			unsigned int FindNext(unsigned int bit) const;
+			template<typename F> void ForEachSetBit(F&& func) const;
 
 			Block GetBlock(unsigned int i) const;
 			unsigned int GetBlockCount() const;
@@ -47,6 +48,7 @@ namespace Nz
 			unsigned int GetSize() const;
 
 			void PerformsAND(const Bitset& a, const Bitset& b);
+			void PerformsANDNOT(const Bitset& a, const Bitset& b);
 			void PerformsNOT(const Bitset& a);
 			void PerformsOR(const Bitset& a, const Bitset& b);
 			void PerformsXOR(const Bitset& a, const Bitset& b);
@@ -4,6 +4,8 @@
 
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Math/Algorithm.hpp>
+#include <Nazara/Math/Simd.hpp>
+#include <algorithm>
 #include <limits>
 #include <utility>
 #include <Nazara/Core/Debug.hpp>
@@ -16,6 +18,101 @@
 
 namespace Nz
 {
+	namespace Detail
+	{
+		// Bitwise operations applied to the blocks of two bitsets, 128 bits at a time when SSE2 is available
+		struct BitsetAND
+		{
+			template<typename T> static T Apply(T a, T b) { return a & b; }
+
+			#ifdef NAZARA_MATH_SSE
+			static __m128i Apply(__m128i a, __m128i b) { return _mm_and_si128(a, b); }
+			#endif
+		};
+
+		struct BitsetANDNOT
+		{
+			template<typename T> static T Apply(T a, T b) { return a & ~b; }
+
+			#ifdef NAZARA_MATH_SSE
+			static __m128i Apply(__m128i a, __m128i b) { return _mm_andnot_si128(b, a); }
+			#endif
+		};
+
+		struct BitsetOR
+		{
+			template<typename T> static T Apply(T a, T b) { return a | b; }
+
+			#ifdef NAZARA_MATH_SSE
+			static __m128i Apply(__m128i a, __m128i b) { return _mm_or_si128(a, b); }
+			#endif
+		};
+
+		struct BitsetXOR
+		{
+			template<typename T> static T Apply(T a, T b) { return a ^ b; }
+
+			#ifdef NAZARA_MATH_SSE
+			static __m128i Apply(__m128i a, __m128i b) { return _mm_xor_si128(a, b); }
+			#endif
+		};
+
+		template<typename Operation, typename Block>
+		void ApplyBitsetOperation(Block* result, const Block* a, const Block* b, unsigned int blockCount)
+		{
+			// result may alias a or b, each block being read before being written
+			unsigned int i = 0;
+
+			#ifdef NAZARA_MATH_SSE
+			constexpr unsigned int blocksPerRegister = sizeof(__m128i) / sizeof(Block);
+			for (; i + blocksPerRegister <= blockCount; i += blocksPerRegister)
+			{
+				__m128i blocksA = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&a[i]));
+				__m128i blocksB = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&b[i]));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(&result[i]), Operation::Apply(blocksA, blocksB));
+			}
+			#endif
+
+			for (; i < blockCount; ++i)
+				result[i] = static_cast<Block>(Operation::Apply(a[i], b[i]));
+		}
+
+		template<typename Block>
+		bool TestBitsetIntersection(const Block* a, const Block* b, unsigned int blockCount)
+		{
+			unsigned int i = 0;
+
+			#ifdef NAZARA_MATH_SSE
+			constexpr unsigned int blocksPerRegister = sizeof(__m128i) / sizeof(Block);
+			const __m128i zero = _mm_setzero_si128();
+			for (; i + blocksPerRegister <= blockCount; i += blocksPerRegister)
+			{
+				__m128i blocksA = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&a[i]));
+				__m128i blocksB = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&b[i]));
+				if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(blocksA, blocksB), zero)) != 0xFFFF)
+					return true;
+			}
+			#endif
+
+			for (; i < blockCount; ++i)
+			{
+				if (a[i] & b[i])
+					return true;
+			}
+
+			return false;
+		}
+	}
+
+	template<typename Block, class Allocator>
+	constexpr Block Bitset<Block, Allocator>::fullBitMask;
+
+	template<typename Block, class Allocator>
+	constexpr unsigned int Bitset<Block, Allocator>::bitsPerBlock;
+
+	template<typename Block, class Allocator>
+	constexpr unsigned int Bitset<Block, Allocator>::npos;
+
 	template<typename Block, class Allocator>
 	Bitset<Block, Allocator>::Bitset() :
 	m_bitCount(0)
@@ -126,6 +223,25 @@ namespace Nz
 			return FindFirstFrom(blockIndex + 1);
 	}
 
+	template<typename Block, class Allocator>
+	template<typename F>
+	void Bitset<Block, Allocator>::ForEachSetBit(F&& func) const
+	{
+		// Équivalent à une boucle FindFirst/FindNext, sans rechercher le bloc à chaque bit
+		for (unsigned int i = 0; i < m_blocks.size(); ++i)
+		{
+			Block block = m_blocks[i];
+			while (block)
+			{
+				unsigned int bitIndex = IntegralLog2Pot(block & -block);
+				func(i*bitsPerBlock + bitIndex);
+
+				// Le bloc est relu car func a pu modifier le bitset (comme avec FindNext, les bits suivants activés seront visités)
+				block = m_blocks[i] & static_cast<Block>(static_cast<Block>(fullBitMask << bitIndex) << 1U);
+			}
+		}
+	}
+
 	template<typename Block, class Allocator>
 	Block Bitset<Block, Allocator>::GetBlock(unsigned int i) const
 	{
@@ -156,15 +272,36 @@ namespace Nz
 	void Bitset<Block, Allocator>::PerformsAND(const Bitset& a, const Bitset& b)
 	{
 		std::pair<unsigned int, unsigned int> minmax = std::minmax(a.GetBlockCount(), b.GetBlockCount());
+		unsigned int bitCount = std::max(a.GetSize(), b.GetSize());
 
-		// On réinitialise nos blocs à zéro
-		m_blocks.clear();
-		m_blocks.resize(minmax.second, 0U);
-		m_bitCount = std::max(a.GetSize(), b.GetSize());
+		// Nos blocs ne sont pas réinitialisés au préalable, a ou b pouvant être ce bitset (opérateur &=)
+		m_blocks.resize(minmax.second);
+		m_bitCount = bitCount;
 
 		// Dans le cas du AND, nous pouvons nous arrêter à la plus petite taille (car x & 0 = 0)
-		for (unsigned int i = 0; i < minmax.first; ++i)
-			m_blocks[i] = a.GetBlock(i) & b.GetBlock(i);
+		Detail::ApplyBitsetOperation<Detail::BitsetAND>(m_blocks.data(), a.m_blocks.data(), b.m_blocks.data(), minmax.first);
+		std::fill(m_blocks.begin() + minmax.first, m_blocks.end(), Block(0U));
+
+		ResetExtraBits();
+	}
+
+	template<typename Block, class Allocator>
+	void Bitset<Block, Allocator>::PerformsANDNOT(const Bitset& a, const Bitset& b)
+	{
+		// Calcule a & ~b, sans construire le complément de b
+		unsigned int aBlockCount = a.GetBlockCount();
+		unsigned int minBlockCount = std::min(aBlockCount, b.GetBlockCount());
+		unsigned int maxBlockCount = std::max(aBlockCount, b.GetBlockCount());
+		unsigned int bitCount = std::max(a.GetSize(), b.GetSize());
+
+		m_blocks.resize(maxBlockCount);
+		m_bitCount = bitCount;
+
+		Detail::ApplyBitsetOperation<Detail::BitsetANDNOT>(m_blocks.data(), a.m_blocks.data(), b.m_blocks.data(), minBlockCount);
+
+		// Au-delà de b, les blocs de a sont conservés (x & ~0 = x), au-delà de a ils sont nuls
+		for (unsigned int i = minBlockCount; i < maxBlockCount; ++i)
+			m_blocks[i] = (i < aBlockCount) ? a.m_blocks[i] : Block(0U);
 
 		ResetExtraBits();
 	}
@@ -192,8 +329,7 @@ namespace Nz
 		m_blocks.resize(maxBlockCount);
 		m_bitCount = greater.GetSize();
 
-		for (unsigned int i = 0; i < minBlockCount; ++i)
-			m_blocks[i] = a.GetBlock(i) | b.GetBlock(i);
+		Detail::ApplyBitsetOperation<Detail::BitsetOR>(m_blocks.data(), a.m_blocks.data(), b.m_blocks.data(), minBlockCount);
 
 		for (unsigned int i = minBlockCount; i < maxBlockCount; ++i)
 			m_blocks[i] = greater.GetBlock(i); // (x | 0 = x)
@@ -212,8 +348,7 @@ namespace Nz
 		m_blocks.resize(maxBlockCount);
 		m_bitCount = greater.GetSize();
 
-		for (unsigned int i = 0; i < minBlockCount; ++i)
-			m_blocks[i] = a.GetBlock(i) ^ b.GetBlock(i);
+		Detail::ApplyBitsetOperation<Detail::BitsetXOR>(m_blocks.data(), a.m_blocks.data(), b.m_blocks.data(), minBlockCount);
 
 		for (unsigned int i = minBlockCount; i < maxBlockCount; ++i)
 			m_blocks[i] = greater.GetBlock(i); // (x ^ 0 = x)
@@ -226,15 +361,8 @@ namespace Nz
 	{
 		// On ne testera que les blocs en commun
 		unsigned int sharedBlocks = std::min(GetBlockCount(), bitset.GetBlockCount());
-		for (unsigned int i = 0; i < sharedBlocks; ++i)
-		{
-			Block a = GetBlock(i);
-			Block b = bitset.GetBlock(i);
-			if (a & b)
-				return true;
-		}
 
-		return false;
+		return Detail::TestBitsetIntersection(m_blocks.data(), bitset.m_blocks.data(), sharedBlocks);
 	}
 
 	template<typename Block, class Allocator>
@@ -320,13 +448,15 @@ namespace Nz
 	template<typename Block, class Allocator>
 	bool Bitset<Block, Allocator>::TestAll() const
 	{
-		// Cas particulier du dernier bloc
+		// Cas particulier du dernier bloc (s'il est complet, son masque est nul)
 		Block lastBlockMask = GetLastBlockMask();
+		if (lastBlockMask == 0U)
+			lastBlockMask = fullBitMask;
 
 		for (unsigned int i = 0; i < m_blocks.size(); ++i)
 		{
 			Block mask = (i == m_blocks.size() - 1) ? lastBlockMask : fullBitMask;
-			if (m_blocks[i] == mask) // Les extra bits sont à zéro, on peut donc tester sans procéder à un masquage
+			if (m_blocks[i] != mask) // Les extra bits sont à zéro, on peut donc tester sans procéder à un masquage
 				return false;
 		}
 
@@ -32,6 +32,8 @@ namespace Nz
 
 			inline bool FlushBits();
 
+			inline bool HasFailed() const;
+
 			inline std::size_t Read(void* ptr, std::size_t size);
 
 			inline void SetDataEndianness(Endianness endiannes);
@@ -56,6 +58,7 @@ namespace Nz
 
 			std::unique_ptr<Stream> m_ownedStream;
 			SerializationContext m_context;
+			bool m_failed;
 	};
 }
 
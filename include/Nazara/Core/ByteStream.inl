@@ -7,14 +7,16 @@
 
 namespace Nz
 {
-	inline ByteStream::ByteStream(Stream* stream)
+	inline ByteStream::ByteStream(Stream* stream) :
+	m_failed(false)
 	{
 		m_context.stream = stream;
 	}
 
 	inline ByteStream::ByteStream(ByteStream&& stream) :
 	m_ownedStream(std::move(stream.m_ownedStream)),
-	m_context(stream.m_context)
+	m_context(stream.m_context),
+	m_failed(stream.m_failed)
 	{
 		stream.m_context.stream = nullptr;
 	}
@@ -59,6 +61,12 @@ namespace Nz
 		return true;
 	}
 
+	inline bool ByteStream::HasFailed() const
+	{
+		// Set by the first failed serialization or unserialization (a value read past the end of the stream is left untouched)
+		return m_failed;
+	}
+
 	inline std::size_t ByteStream::Read(void* ptr, std::size_t size)
 	{
 		if (!m_context.stream)
@@ -79,6 +87,7 @@ namespace Nz
 		FlushBits();
 
 		m_context.stream = stream;
+		m_failed = false;
 		m_ownedStream.reset();
 	}
 
@@ -98,7 +107,10 @@ namespace Nz
 			OnEmptyStream();
 
 		if (!Unserialize(m_context, &value))
+		{
 			NazaraError("Failed to serialize value");
+			m_failed = true;
+		}
 
 		return *this;
 	}
@@ -110,7 +122,10 @@ namespace Nz
 			OnEmptyStream();
 
 		if (!Serialize(m_context, value))
+		{
 			NazaraError("Failed to serialize value");
+			m_failed = true;
+		}
 
 		return *this;
 	}
@@ -118,6 +133,7 @@ namespace Nz
 	inline ByteStream& ByteStream::operator=(ByteStream&& stream)
 	{
 		m_context = stream.m_context;
+		m_failed = stream.m_failed;
 		m_ownedStream = std::move(stream.m_ownedStream);
 		
 		stream.m_context.stream = nullptr;
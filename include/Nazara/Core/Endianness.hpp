@@ -29,6 +29,7 @@ namespace Nz
 {
 	inline constexpr Endianness GetPlatformEndianness();
 	inline void SwapBytes(void* buffer, unsigned int size);
+	inline void SwapBytes(void* buffer, unsigned int size, std::size_t count);
 }
 
 #include <Nazara/Core/Endianness.inl>
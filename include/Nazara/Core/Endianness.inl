@@ -3,6 +3,7 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <algorithm>
+#include <cstring>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
@@ -16,14 +17,79 @@ namespace Nz
 		#endif
 	}
 
+	namespace Detail
+	{
+		// Written with shifts only so the compiler can vectorize loops using them
+		inline UInt16 SwapBytes16(UInt16 value)
+		{
+			return static_cast<UInt16>((value >> 8) | (value << 8));
+		}
+
+		inline UInt32 SwapBytes32(UInt32 value)
+		{
+			return ((value & 0x000000FFU) << 24) | ((value & 0x0000FF00U) << 8) |
+			       ((value & 0x00FF0000U) >> 8)  | ((value & 0xFF000000U) >> 24);
+		}
+
+		inline UInt64 SwapBytes64(UInt64 value)
+		{
+			return (static_cast<UInt64>(SwapBytes32(static_cast<UInt32>(value))) << 32) | SwapBytes32(static_cast<UInt32>(value >> 32));
+		}
+
+		template<typename T, T(*Swap)(T)>
+		void SwapBytesArray(UInt8* bytes, std::size_t count)
+		{
+			// memcpy keeps this valid for unaligned buffers and is optimized away by compilers
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				T value;
+				std::memcpy(&value, &bytes[i * sizeof(T)], sizeof(T));
+				value = Swap(value);
+				std::memcpy(&bytes[i * sizeof(T)], &value, sizeof(T));
+			}
+		}
+	}
+
 	inline void SwapBytes(void* buffer, unsigned int size)
+	{
+		SwapBytes(buffer, size, 1);
+	}
+
+	inline void SwapBytes(void* buffer, unsigned int size, std::size_t count)
 	{
 		UInt8* bytes = reinterpret_cast<UInt8*>(buffer);
-		unsigned int i = 0;
-		unsigned int j = size-1;
 
-		while (i < j)
-			std::swap(bytes[i++], bytes[j--]);
+		switch (size)
+		{
+			case 1:
+				break;
+
+			case 2:
+				Detail::SwapBytesArray<UInt16, Detail::SwapBytes16>(bytes, count);
+				break;
+
+			case 4:
+				Detail::SwapBytesArray<UInt32, Detail::SwapBytes32>(bytes, count);
+				break;
+
+			case 8:
+				Detail::SwapBytesArray<UInt64, Detail::SwapBytes64>(bytes, count);
+				break;
+
+			default:
+			{
+				for (std::size_t k = 0; k < count; ++k)
+				{
+					unsigned int i = 0;
+					unsigned int j = size-1;
+					while (i < j)
+						std::swap(bytes[i++], bytes[j--]);
+
+					bytes += size;
+				}
+				break;
+			}
+		}
 	}
 }
 
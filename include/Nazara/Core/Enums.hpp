@@ -61,6 +61,7 @@ namespace Nz
 	enum HashType
 	{
 		HashType_CRC32,
+		HashType_CRC32C,
 		HashType_Fletcher16,
 		HashType_MD5,
 		HashType_SHA1,
@@ -69,8 +70,9 @@ namespace Nz
 		HashType_SHA384,
 		HashType_SHA512,
 		HashType_Whirlpool,
+		HashType_XXHash64,
 
-		HashType_Max = HashType_Whirlpool
+		HashType_Max = HashType_XXHash64
 	};
 
 	enum OpenModeFlags
@@ -0,0 +1,96 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_FRAMEALLOCATOR_HPP
+#define NAZARA_FRAMEALLOCATOR_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/Mutex.hpp>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace Nz
+{
+	// Linear allocator for data living at most until the end of a frame, allocations only bump a cursor and are all
+	// released at once by Reset (memory is kept from one frame to another, so a steady frame does not touch the heap)
+	// Allocate may be called by several threads at once (each thread has its own regions), the other methods may not
+	class NAZARA_CORE_API FrameAllocator
+	{
+		public:
+			FrameAllocator(std::size_t regionSize = 64 * 1024);
+			FrameAllocator(const FrameAllocator&) = delete;
+			FrameAllocator(FrameAllocator&&) = delete;
+			~FrameAllocator();
+
+			void* Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+			template<typename T> T* AllocateArray(std::size_t count);
+
+			std::size_t GetAllocatedSize() const;
+			UInt64 GetAllocationCount() const;
+			std::size_t GetCapacity() const;
+			UInt64 GetHeapAllocationCount() const;
+			std::size_t GetRegionSize() const;
+
+			template<typename T, typename... Args> T* New(Args&&... args);
+
+			void Release();
+			void Reset();
+
+			FrameAllocator& operator=(const FrameAllocator&) = delete;
+			FrameAllocator& operator=(FrameAllocator&&) = delete;
+
+			static constexpr unsigned int MaxThreadRegions = 64;
+
+		private:
+			struct Region;
+			struct ThreadRegions;
+
+			void* AllocateSlow(ThreadRegions& regions, std::size_t size, std::size_t alignment);
+			ThreadRegions& GetThreadRegions(unsigned int index) const;
+
+			std::atomic<UInt64> m_heapAllocationCount;
+			std::size_t m_regionSize;
+			Mutex m_sharedMutex;
+			UInt8* m_threadRegions;
+			void* m_threadRegionsMemory;
+	};
+
+	// STL allocator taking its memory from a frame allocator, a default constructed adaptor uses operator new
+	template<typename T>
+	class FrameAllocatorAdaptor
+	{
+		template<typename U> friend class FrameAllocatorAdaptor;
+
+		public:
+			using value_type = T;
+			using propagate_on_container_copy_assignment = std::true_type;
+			using propagate_on_container_move_assignment = std::true_type;
+			using propagate_on_container_swap = std::true_type;
+
+			FrameAllocatorAdaptor();
+			FrameAllocatorAdaptor(FrameAllocator& allocator);
+			template<typename U> FrameAllocatorAdaptor(const FrameAllocatorAdaptor<U>& adaptor);
+
+			T* allocate(std::size_t n);
+			void deallocate(T* ptr, std::size_t n);
+
+			FrameAllocator* GetAllocator() const;
+
+			template<typename U> bool operator==(const FrameAllocatorAdaptor<U>& adaptor) const;
+			template<typename U> bool operator!=(const FrameAllocatorAdaptor<U>& adaptor) const;
+
+		private:
+			FrameAllocator* m_allocator;
+	};
+
+	template<typename T> using FrameVector = std::vector<T, FrameAllocatorAdaptor<T>>;
+}
+
+#include <Nazara/Core/FrameAllocator.inl>
+
+#endif // NAZARA_FRAMEALLOCATOR_HPP
@@ -0,0 +1,85 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/MemoryHelper.hpp>
+#include <utility>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	template<typename T>
+	T* FrameAllocator::AllocateArray(std::size_t count)
+	{
+		///DOC: Les éléments ne sont pas construits
+		return static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+	}
+
+	template<typename T, typename... Args>
+	T* FrameAllocator::New(Args&&... args)
+	{
+		static_assert(std::is_trivially_destructible<T>::value, "Objects of a frame allocator are never destroyed");
+
+		return PlacementNew<T>(Allocate(sizeof(T), alignof(T)), std::forward<Args>(args)...);
+	}
+
+	template<typename T>
+	FrameAllocatorAdaptor<T>::FrameAllocatorAdaptor() :
+	m_allocator(nullptr)
+	{
+	}
+
+	template<typename T>
+	FrameAllocatorAdaptor<T>::FrameAllocatorAdaptor(FrameAllocator& allocator) :
+	m_allocator(&allocator)
+	{
+	}
+
+	template<typename T>
+	template<typename U>
+	FrameAllocatorAdaptor<T>::FrameAllocatorAdaptor(const FrameAllocatorAdaptor<U>& adaptor) :
+	m_allocator(adaptor.m_allocator)
+	{
+	}
+
+	template<typename T>
+	T* FrameAllocatorAdaptor<T>::allocate(std::size_t n)
+	{
+		if (m_allocator)
+			return m_allocator->AllocateArray<T>(n);
+		else
+			return static_cast<T*>(OperatorNew(n * sizeof(T)));
+	}
+
+	template<typename T>
+	void FrameAllocatorAdaptor<T>::deallocate(T* ptr, std::size_t n)
+	{
+		NazaraUnused(n);
+
+		// Frame memory is only released by FrameAllocator::Reset
+		if (!m_allocator)
+			OperatorDelete(ptr);
+	}
+
+	template<typename T>
+	FrameAllocator* FrameAllocatorAdaptor<T>::GetAllocator() const
+	{
+		return m_allocator;
+	}
+
+	template<typename T>
+	template<typename U>
+	bool FrameAllocatorAdaptor<T>::operator==(const FrameAllocatorAdaptor<U>& adaptor) const
+	{
+		return m_allocator == adaptor.m_allocator;
+	}
+
+	template<typename T>
+	template<typename U>
+	bool FrameAllocatorAdaptor<T>::operator!=(const FrameAllocatorAdaptor<U>& adaptor) const
+	{
+		return !operator==(adaptor);
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
@@ -28,6 +28,11 @@ namespace Nz
 			std::size_t GetDigestLength() const override;
 			const char* GetHashName() const override;
 
+		protected:
+			using UpdateFunction = UInt32 (*)(UInt32 crc, const UInt8* data, std::size_t len);
+
+			HashCRC32(UInt32 polynomial, UpdateFunction updateFunction); //< updateFunction, if any, replaces the table-driven computation
+
 		private:
 			HashCRC32_state* m_state;
 	};
@@ -0,0 +1,25 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_HASH_CRC32C_HPP
+#define NAZARA_HASH_CRC32C_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/Hash/CRC32.hpp>
+
+namespace Nz
+{
+	class NAZARA_CORE_API HashCRC32C : public HashCRC32
+	{
+		public:
+			HashCRC32C();
+			~HashCRC32C() = default;
+
+			const char* GetHashName() const override;
+	};
+}
+
+#endif // NAZARA_HASH_CRC32C_HPP
@@ -1,5 +1,5 @@
 // Copyright (C) 2015 Jérôme Leclercq
-// This file is part of the "Nazara Engine - Graphics module"
+// This file is part of the "Nazara Engine - Core module"
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #pragma once
@@ -8,42 +8,65 @@
 #define NAZARA_MEMORYPOOL_HPP
 
 #include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/Mutex.hpp>
 #include <atomic>
-#include <memory>
+#include <vector>
 
 namespace Nz
 {
-	class MemoryPool
+	class NAZARA_CORE_API MemoryPool
 	{
 		public:
 			MemoryPool(unsigned int blockSize, unsigned int size = 1024, bool canGrow = true);
 			MemoryPool(const MemoryPool&) = delete;
-			MemoryPool(MemoryPool&& pool) noexcept;
-			~MemoryPool() = default;
+			MemoryPool(MemoryPool&&) = delete; ///TODO: Blocks point to their chunk, which points to the pool
+			~MemoryPool();
 
 			void* Allocate(unsigned int size);
 			template<typename T> void Delete(T* ptr);
 			void Free(void* ptr);
 
 			unsigned int GetBlockSize() const;
+			unsigned int GetChunkCount() const;
 			unsigned int GetFreeBlocks() const;
 			unsigned int GetSize() const;
 
 			template<typename T, typename... Args> T* New(Args&&... args);
 
+			void Trim();
+
 			MemoryPool& operator=(const MemoryPool&) = delete;
-			MemoryPool& operator=(MemoryPool&& pool) noexcept;
+			MemoryPool& operator=(MemoryPool&&) = delete;
+
+			static constexpr unsigned int BatchSize = 32;
+			static constexpr unsigned int MaxThreadCaches = 64;
 
 		private:
-			MemoryPool(MemoryPool* pool);
+			struct Block;
+			struct Chunk;
+			struct ThreadCache;
+
+			Block* AllocateChunk();
+			void* AllocateFallback(unsigned int size);
+			ThreadCache* GetThreadCache(unsigned int threadIndex) const;
+			Block* PopBatch();
+			void PushBatch(Block* batch);
+			void Release(Block* block);
+			void TrimIfNeeded();
+			void TrimInternal();
+
+			static Block* GetBlock(void* ptr);
 
-			std::unique_ptr<void*[]> m_freeList;
-			std::unique_ptr<UInt8[]> m_pool;
-			std::unique_ptr<MemoryPool> m_next;
-			std::atomic_uint m_freeCount;
-			MemoryPool* m_previous;
+			std::atomic<Block*> m_batches;
+			std::atomic_uint m_globalFreeCount;
+			std::atomic_uint m_trimThreshold;
+			std::vector<Chunk*> m_chunks;
+			mutable Mutex m_mutex;
+			UInt8* m_threadCaches;
+			void* m_threadCacheMemory;
 			bool m_canGrow;
 			unsigned int m_blockSize;
+			unsigned int m_blockStride;
 			unsigned int m_size;
 	};
 }
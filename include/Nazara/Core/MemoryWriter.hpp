@@ -0,0 +1,61 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_MEMORYWRITER_HPP
+#define NAZARA_MEMORYWRITER_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/Endianness.hpp>
+#include <type_traits>
+
+namespace Nz
+{
+	class MemoryWriter
+	{
+		public:
+			inline MemoryWriter(void* ptr, std::size_t size, Endianness dataEndianness = Endianness_BigEndian);
+			MemoryWriter(const MemoryWriter&) = delete;
+			MemoryWriter(MemoryWriter&&) = delete;
+			inline ~MemoryWriter();
+
+			inline bool FlushBits();
+
+			inline std::size_t GetCursorPos() const;
+			inline Endianness GetDataEndianness() const;
+			inline std::size_t GetSize() const;
+
+			inline bool HasOverflowed() const;
+
+			inline void SetDataEndianness(Endianness endianness);
+
+			inline bool Write(bool value);
+			template<typename T> std::enable_if_t<std::is_arithmetic<T>::value, bool> Write(T value);
+			template<typename T> std::enable_if_t<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value, bool> Write(const T* values, std::size_t count);
+			inline bool WriteBits(UInt64 value, unsigned int bitCount);
+			inline bool WriteQuantized(float value, float min, float max, unsigned int bitCount);
+			template<typename T> std::enable_if_t<std::is_integral<T>::value, bool> WriteVarInt(T value);
+
+			template<typename T> MemoryWriter& operator<<(const T& value);
+
+			MemoryWriter& operator=(const MemoryWriter&) = delete;
+			MemoryWriter& operator=(MemoryWriter&&) = delete;
+
+		private:
+			inline bool WriteBytes(const void* data, std::size_t size);
+
+			Endianness m_endianness;
+			UInt8* m_ptr;
+			std::size_t m_pos;
+			std::size_t m_size;
+			bool m_overflowed;
+			UInt8 m_currentBitPos;
+			UInt8 m_currentByte;
+	};
+}
+
+#include <Nazara/Core/MemoryWriter.inl>
+
+#endif // NAZARA_MEMORYWRITER_HPP
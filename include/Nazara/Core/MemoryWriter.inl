@@ -0,0 +1,177 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Algorithm.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <algorithm>
+#include <cstring>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	// Produces the same output as a SerializationContext (and thus ByteStream), without going through Stream virtual calls
+	// Writing past the end of the buffer fails and marks the writer as overflowed
+	inline MemoryWriter::MemoryWriter(void* ptr, std::size_t size, Endianness dataEndianness) :
+	m_endianness(dataEndianness),
+	m_ptr(static_cast<UInt8*>(ptr)),
+	m_pos(0),
+	m_size(size),
+	m_overflowed(false),
+	m_currentBitPos(8)
+	{
+	}
+
+	inline MemoryWriter::~MemoryWriter()
+	{
+		if (!FlushBits())
+			NazaraWarning("Failed to flush bits at writer destruction");
+	}
+
+	inline bool MemoryWriter::FlushBits()
+	{
+		if (m_currentBitPos != 8)
+		{
+			m_currentBitPos = 8;
+
+			return WriteBytes(&m_currentByte, 1);
+		}
+
+		return true;
+	}
+
+	inline std::size_t MemoryWriter::GetCursorPos() const
+	{
+		return m_pos;
+	}
+
+	inline Endianness MemoryWriter::GetDataEndianness() const
+	{
+		return m_endianness;
+	}
+
+	inline std::size_t MemoryWriter::GetSize() const
+	{
+		return m_size;
+	}
+
+	inline bool MemoryWriter::HasOverflowed() const
+	{
+		return m_overflowed;
+	}
+
+	inline void MemoryWriter::SetDataEndianness(Endianness endianness)
+	{
+		m_endianness = endianness;
+	}
+
+	inline bool MemoryWriter::Write(bool value)
+	{
+		return WriteBits((value) ? 1 : 0, 1);
+	}
+
+	template<typename T>
+	std::enable_if_t<std::is_arithmetic<T>::value, bool> MemoryWriter::Write(T value)
+	{
+		if (!FlushBits())
+			return false;
+
+		if (m_endianness != Endianness_Unknown && m_endianness != GetPlatformEndianness())
+			SwapBytes(&value, sizeof(T));
+
+		return WriteBytes(&value, sizeof(T));
+	}
+
+	template<typename T>
+	std::enable_if_t<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value, bool> MemoryWriter::Write(const T* values, std::size_t count)
+	{
+		NazaraAssert(values || count == 0, "Invalid data pointer");
+
+		if (!FlushBits())
+			return false;
+
+		UInt8* ptr = &m_ptr[m_pos];
+		if (!WriteBytes(values, count * sizeof(T)))
+			return false;
+
+		// Swap in place, in the destination buffer
+		if (m_endianness != Endianness_Unknown && m_endianness != GetPlatformEndianness())
+			SwapBytes(ptr, sizeof(T), count);
+
+		return true;
+	}
+
+	inline bool MemoryWriter::WriteBits(UInt64 value, unsigned int bitCount)
+	{
+		NazaraAssert(bitCount <= 64, "Bit count must be lower or equal to 64");
+
+		while (bitCount > 0)
+		{
+			if (m_currentBitPos == 8)
+			{
+				m_currentBitPos = 0;
+				m_currentByte = 0;
+			}
+
+			unsigned int bits = std::min(bitCount, 8U - m_currentBitPos);
+			m_currentByte |= static_cast<UInt8>((value & ((1U << bits) - 1)) << m_currentBitPos);
+			m_currentBitPos += bits;
+
+			value >>= bits;
+			bitCount -= bits;
+
+			if (m_currentBitPos >= 8)
+			{
+				if (!WriteBytes(&m_currentByte, 1))
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	inline bool MemoryWriter::WriteQuantized(float value, float min, float max, unsigned int bitCount)
+	{
+		NazaraAssert(bitCount > 0 && bitCount <= 32, "Bit count must be between 1 and 32");
+		NazaraAssert(min < max, "Invalid range");
+
+		return WriteBits(Detail::Quantize(value, min, max, bitCount), bitCount);
+	}
+
+	template<typename T>
+	std::enable_if_t<std::is_integral<T>::value, bool> MemoryWriter::WriteVarInt(T value)
+	{
+		if (!FlushBits())
+			return false;
+
+		UInt8 buffer[10]; //< A 64 bits integer takes up to ten bytes
+		std::size_t size = Detail::EncodeVarInt(Detail::ZigZagEncode(value), buffer);
+
+		return WriteBytes(buffer, size);
+	}
+
+	template<typename T>
+	MemoryWriter& MemoryWriter::operator<<(const T& value)
+	{
+		if (!Write(value))
+			NazaraError("Failed to serialize value");
+
+		return *this;
+	}
+
+	inline bool MemoryWriter::WriteBytes(const void* data, std::size_t size)
+	{
+		if (size > m_size - m_pos)
+		{
+			m_overflowed = true;
+			return false;
+		}
+
+		std::memcpy(&m_ptr[m_pos], data, size);
+		m_pos += size;
+
+		return true;
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
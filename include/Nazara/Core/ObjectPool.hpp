@@ -0,0 +1,44 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_OBJECTPOOL_HPP
+#define NAZARA_OBJECTPOOL_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/MemoryPool.hpp>
+
+namespace Nz
+{
+	template<typename T>
+	class ObjectPool
+	{
+		public:
+			ObjectPool(unsigned int size = 1024, bool canGrow = true);
+			ObjectPool(const ObjectPool&) = delete;
+			ObjectPool(ObjectPool&&) = delete;
+			~ObjectPool() = default;
+
+			void Delete(T* object);
+
+			unsigned int GetChunkCount() const;
+			unsigned int GetFreeObjects() const;
+			unsigned int GetSize() const;
+
+			template<typename... Args> T* New(Args&&... args);
+
+			void Trim();
+
+			ObjectPool& operator=(const ObjectPool&) = delete;
+			ObjectPool& operator=(ObjectPool&&) = delete;
+
+		private:
+			MemoryPool m_pool;
+	};
+}
+
+#include <Nazara/Core/ObjectPool.inl>
+
+#endif // NAZARA_OBJECTPOOL_HPP
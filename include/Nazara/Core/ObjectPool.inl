@@ -0,0 +1,57 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <utility>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	template<typename T>
+	ObjectPool<T>::ObjectPool(unsigned int size, bool canGrow) :
+	m_pool(sizeof(T), size, canGrow)
+	{
+		static_assert(alignof(T) <= 16, "Pool blocks are not aligned enough for this type");
+	}
+
+	template<typename T>
+	void ObjectPool<T>::Delete(T* object)
+	{
+		///DOC: Peut être appelé depuis n'importe quel thread
+		m_pool.Delete(object);
+	}
+
+	template<typename T>
+	unsigned int ObjectPool<T>::GetChunkCount() const
+	{
+		return m_pool.GetChunkCount();
+	}
+
+	template<typename T>
+	unsigned int ObjectPool<T>::GetFreeObjects() const
+	{
+		return m_pool.GetFreeBlocks();
+	}
+
+	template<typename T>
+	unsigned int ObjectPool<T>::GetSize() const
+	{
+		///DOC: Nombre d'objets par chunk
+		return m_pool.GetSize();
+	}
+
+	template<typename T>
+	template<typename... Args>
+	T* ObjectPool<T>::New(Args&&... args)
+	{
+		return m_pool.New<T>(std::forward<Args>(args)...);
+	}
+
+	template<typename T>
+	void ObjectPool<T>::Trim()
+	{
+		m_pool.Trim();
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
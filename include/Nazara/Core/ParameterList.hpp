@@ -9,6 +9,7 @@
 
 #include <Nazara/Prerequesites.hpp>
 #include <Nazara/Core/String.hpp>
+#include <Nazara/Core/StringId.hpp>
 #include <atomic>
 #include <unordered_map>
 
@@ -27,25 +28,42 @@ namespace Nz
 			void Clear();
 
 			bool GetBooleanParameter(const String& name, bool* value) const;
+			bool GetBooleanParameter(const StringId& name, bool* value) const;
 			bool GetFloatParameter(const String& name, float* value) const;
+			bool GetFloatParameter(const StringId& name, float* value) const;
 			bool GetIntegerParameter(const String& name, int* value) const;
+			bool GetIntegerParameter(const StringId& name, int* value) const;
 			bool GetParameterType(const String& name, ParameterType* type) const;
+			bool GetParameterType(const StringId& name, ParameterType* type) const;
 			bool GetPointerParameter(const String& name, void** value) const;
+			bool GetPointerParameter(const StringId& name, void** value) const;
 			bool GetStringParameter(const String& name, String* value) const;
+			bool GetStringParameter(const StringId& name, String* value) const;
 			bool GetUserdataParameter(const String& name, void** value) const;
+			bool GetUserdataParameter(const StringId& name, void** value) const;
 
 			bool HasParameter(const String& name) const;
+			bool HasParameter(const StringId& name) const;
 
 			void RemoveParameter(const String& name);
+			void RemoveParameter(const StringId& name);
 
 			void SetParameter(const String& name);
+			void SetParameter(const StringId& name);
 			void SetParameter(const String& name, const String& value);
+			void SetParameter(const StringId& name, const String& value);
 			void SetParameter(const String& name, const char* value);
+			void SetParameter(const StringId& name, const char* value);
 			void SetParameter(const String& name, void* value);
+			void SetParameter(const StringId& name, void* value);
 			void SetParameter(const String& name, void* value, Destructor destructor);
+			void SetParameter(const StringId& name, void* value, Destructor destructor);
 			void SetParameter(const String& name, bool value);
+			void SetParameter(const StringId& name, bool value);
 			void SetParameter(const String& name, float value);
+			void SetParameter(const StringId& name, float value);
 			void SetParameter(const String& name, int value);
+			void SetParameter(const StringId& name, int value);
 
 			ParameterList& operator=(const ParameterList& list);
 			ParameterList& operator=(ParameterList&&) = default;
@@ -86,7 +104,54 @@ namespace Nz
 				Value value;
 			};
 
-			using ParameterMap = std::unordered_map<String, Parameter>;
+			// Names may come from anywhere (files, scripts, ...) and are not always interned, so keys keep the
+			// hash of the name and compare interned names by identity, looking up a key never copies the name
+			struct ParameterKey
+			{
+				explicit ParameterKey(const String& keyName);
+				explicit ParameterKey(const StringId& keyId);
+				ParameterKey(const ParameterKey& key); //< Owns a copy of the name
+				~ParameterKey() = default;
+
+				bool operator==(const ParameterKey& key) const;
+				ParameterKey& operator=(const ParameterKey&) = delete;
+
+				StringId id; //< Empty if the name was not given interned
+				String storage;
+				const String* name;
+				std::size_t hash;
+			};
+
+			struct ParameterKeyHash
+			{
+				std::size_t operator()(const ParameterKey& key) const
+				{
+					return key.hash;
+				}
+			};
+
+			using ParameterMap = std::unordered_map<ParameterKey, Parameter, ParameterKeyHash>;
+
+			bool GetBooleanParameter(const ParameterKey& key, bool* value) const;
+			bool GetFloatParameter(const ParameterKey& key, float* value) const;
+			bool GetIntegerParameter(const ParameterKey& key, int* value) const;
+			bool GetParameterType(const ParameterKey& key, ParameterType* type) const;
+			bool GetPointerParameter(const ParameterKey& key, void** value) const;
+			bool GetStringParameter(const ParameterKey& key, String* value) const;
+			bool GetUserdataParameter(const ParameterKey& key, void** value) const;
+
+			bool HasParameter(const ParameterKey& key) const;
+
+			void RemoveParameter(const ParameterKey& key);
+
+			void SetParameter(const ParameterKey& key);
+			void SetParameter(const ParameterKey& key, const String& value);
+			void SetParameter(const ParameterKey& key, const char* value);
+			void SetParameter(const ParameterKey& key, void* value);
+			void SetParameter(const ParameterKey& key, void* value, Destructor destructor);
+			void SetParameter(const ParameterKey& key, bool value);
+			void SetParameter(const ParameterKey& key, float value);
+			void SetParameter(const ParameterKey& key, int value);
 
 			void DestroyValue(Parameter& parameter);
 
@@ -0,0 +1,39 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_POOLALLOCATOR_HPP
+#define NAZARA_POOLALLOCATOR_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/MemoryPool.hpp>
+#include <cstddef>
+
+namespace Nz
+{
+	// STL allocator taking single elements (the nodes of std::map, std::set, std::list...) from a pool shared by all containers of the same node size
+	// Containers using it must not outlive the static objects of the program
+	template<typename T>
+	class PoolAllocator
+	{
+		public:
+			using value_type = T;
+
+			PoolAllocator() = default;
+			template<typename U> PoolAllocator(const PoolAllocator<U>&);
+
+			T* allocate(std::size_t n);
+			void deallocate(T* ptr, std::size_t n);
+
+			template<typename U> bool operator==(const PoolAllocator<U>&) const;
+			template<typename U> bool operator!=(const PoolAllocator<U>&) const;
+
+			static MemoryPool& GetPool();
+	};
+}
+
+#include <Nazara/Core/PoolAllocator.inl>
+
+#endif // NAZARA_POOLALLOCATOR_HPP
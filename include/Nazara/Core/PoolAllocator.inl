@@ -0,0 +1,60 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/MemoryHelper.hpp>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	template<typename T>
+	template<typename U>
+	PoolAllocator<T>::PoolAllocator(const PoolAllocator<U>&)
+	{
+	}
+
+	template<typename T>
+	T* PoolAllocator<T>::allocate(std::size_t n)
+	{
+		static_assert(alignof(T) <= 16, "Pool blocks are not aligned enough for this type");
+
+		// Arrays (std::vector, std::deque buffers) are not worth pooling
+		if (n == 1)
+			return static_cast<T*>(GetPool().Allocate(sizeof(T)));
+		else
+			return static_cast<T*>(OperatorNew(n * sizeof(T)));
+	}
+
+	template<typename T>
+	void PoolAllocator<T>::deallocate(T* ptr, std::size_t n)
+	{
+		if (n == 1)
+			GetPool().Free(ptr); // Works even if the pointer comes from the pool of another module
+		else
+			OperatorDelete(ptr);
+	}
+
+	template<typename T>
+	template<typename U>
+	bool PoolAllocator<T>::operator==(const PoolAllocator<U>&) const
+	{
+		return true;
+	}
+
+	template<typename T>
+	template<typename U>
+	bool PoolAllocator<T>::operator!=(const PoolAllocator<U>&) const
+	{
+		return false;
+	}
+
+	template<typename T>
+	MemoryPool& PoolAllocator<T>::GetPool()
+	{
+		// Never destroyed on purpose: static containers using this allocator may be destroyed after the pool, with blocks still allocated
+		static MemoryPool* pool = new MemoryPool(sizeof(T), 256);
+		return *pool;
+	}
+}
+
+#include <Nazara/Core/DebugOff.hpp>
@@ -30,7 +30,7 @@ namespace Nz
 				TrimOnlyRight   = 0x08  // Trim(med), ne coupe que la partie droite de la chaîne
 			};
 
-			String();
+			inline String();
 			explicit String(char character);
 			String(std::size_t rep, char character);
 			String(std::size_t rep, const char* string);
@@ -39,9 +39,9 @@ namespace Nz
 			String(const char* string);
 			String(const char* string, std::size_t length);
 			String(const std::string& string);
-			String(const String& string) = default;
-			String(String&& string) noexcept = default;
-			~String() = default;
+			inline String(const String& string);
+			inline String(String&& string) noexcept;
+			inline ~String();
 
 			String& Append(char character);
 			String& Append(const char* string);
@@ -81,10 +81,10 @@ namespace Nz
 			std::size_t FindWord(const String& string, std::intmax_t start = 0, UInt32 flags = None) const;
 
 			char* GetBuffer();
-			std::size_t GetCapacity() const;
-			const char* GetConstBuffer() const;
+			inline std::size_t GetCapacity() const;
+			inline const char* GetConstBuffer() const;
 			std::size_t GetLength() const;
-			std::size_t GetSize() const;
+			inline std::size_t GetSize() const;
 			std::string GetUtf8String() const;
 			std::u16string GetUtf16String() const;
 			std::u32string GetUtf32String() const;
@@ -97,7 +97,7 @@ namespace Nz
 			String& Insert(std::intmax_t pos, const char* string, std::size_t length);
 			String& Insert(std::intmax_t pos, const String& string);
 
-			bool IsEmpty() const;
+			inline bool IsEmpty() const;
 			bool IsNull() const;
 			bool IsNumber(UInt8 radix = 10, UInt32 flags = CaseInsensitive) const;
 
@@ -297,27 +297,32 @@ namespace Nz
 			NAZARA_CORE_API friend bool operator>=(const std::string& string, const String& nstring);
 
 			static const std::size_t npos;
+			static constexpr std::size_t SmallStringCapacity = 15;
 
 		private:
 			struct SharedString;
 
-			String(std::shared_ptr<SharedString>&& sharedString);
-
+			void Allocate(std::size_t size);
+			void Allocate(std::size_t size, std::size_t capacity);
 			void EnsureOwnership(bool discardContent = false);
+			inline bool IsSmall() const;
 			inline void ReleaseString();
 
-			static const std::shared_ptr<SharedString>& GetEmptyString();
-
-			std::shared_ptr<SharedString> m_sharedString;
+			// Short strings are stored inline, larger ones live in a reference-counted buffer shared on copy (copy-on-write)
+			char* m_buffer; //< Points to m_smallString or to m_sharedString->string
+			std::size_t m_size;
+			union
+			{
+				SharedString* m_sharedString;
+				char m_smallString[SmallStringCapacity + 1];
+			};
 
 			struct SharedString
 			{
-				inline SharedString();
-				inline SharedString(std::size_t strSize);
-				inline SharedString(std::size_t strSize, std::size_t strCapacity);
+				inline SharedString(std::size_t strCapacity);
 
+				std::atomic<unsigned int> refCount;
 				std::size_t capacity;
-				std::size_t size;
 				std::unique_ptr<char[]> string;
 			};
 	};
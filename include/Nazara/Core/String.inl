@@ -3,40 +3,104 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Core/AbstractHash.hpp>
+#include <Nazara/Core/Hash/XXHash64.hpp>
+#include <cstring>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
 {
-	inline String::String(std::shared_ptr<SharedString>&& sharedString) :
-	m_sharedString(std::move(sharedString))
+	inline String::String() :
+	m_buffer(m_smallString),
+	m_size(0)
 	{
+		m_smallString[0] = '\0';
 	}
 
-	inline void String::ReleaseString()
+	inline String::String(const String& string) :
+	m_size(string.m_size)
 	{
-		m_sharedString = std::move(GetEmptyString());
+		if (string.IsSmall())
+		{
+			m_buffer = m_smallString;
+			std::memcpy(m_smallString, string.m_smallString, m_size + 1);
+		}
+		else
+		{
+			m_buffer = string.m_buffer;
+			m_sharedString = string.m_sharedString;
+			m_sharedString->refCount++;
+		}
 	}
 
-	inline String::SharedString::SharedString() : // Special case: empty string
-	capacity(0),
-	size(0)
+	inline String::String(String&& string) noexcept :
+	m_size(string.m_size)
 	{
+		if (string.IsSmall())
+		{
+			m_buffer = m_smallString;
+			std::memcpy(m_smallString, string.m_smallString, m_size + 1);
+		}
+		else
+		{
+			m_buffer = string.m_buffer;
+			m_sharedString = string.m_sharedString;
+
+			string.m_buffer = string.m_smallString;
+		}
+
+		string.m_size = 0;
+		string.m_smallString[0] = '\0';
 	}
 
-	inline String::SharedString::SharedString(std::size_t strSize) :
-	capacity(strSize), 
-	size(strSize),
-	string(new char[strSize + 1])
+	inline String::~String()
 	{
-		string[strSize] = '\0';
+		ReleaseString();
 	}
 
-	inline String::SharedString::SharedString(std::size_t strSize, std::size_t strCapacity) :
+	inline std::size_t String::GetCapacity() const
+	{
+		return (IsSmall()) ? SmallStringCapacity : m_sharedString->capacity;
+	}
+
+	inline const char* String::GetConstBuffer() const
+	{
+		return m_buffer;
+	}
+
+	inline std::size_t String::GetSize() const
+	{
+		return m_size;
+	}
+
+	inline bool String::IsEmpty() const
+	{
+		return m_size == 0;
+	}
+
+	inline bool String::IsSmall() const
+	{
+		return m_buffer == m_smallString;
+	}
+
+	inline void String::ReleaseString()
+	{
+		if (!IsSmall())
+		{
+			if (--m_sharedString->refCount == 0)
+				delete m_sharedString;
+
+			m_buffer = m_smallString;
+		}
+
+		m_size = 0;
+		m_smallString[0] = '\0';
+	}
+
+	inline String::SharedString::SharedString(std::size_t strCapacity) :
+	refCount(1),
 	capacity(strCapacity),
-	size(strSize),
 	string(new char[strCapacity + 1])
 	{
-		string[strSize] = '\0';
 	}
 
 	inline bool HashAppend(AbstractHash* hash, const String& string)
@@ -53,20 +117,8 @@ namespace std
 	{
 		size_t operator()(const Nz::String& str) const
 		{
-			// Algorithme DJB2
-			// http://www.cse.yorku.ca/~oz/hash.html
-
-			size_t h = 5381;
-			if (!str.IsEmpty())
-			{
-				const char* ptr = str.GetConstBuffer();
-
-				do
-					h = ((h << 5) + h) + *ptr;
-				while (*++ptr);
-			}
-
-			return h;
+			// xxHash64 travaille sur la taille de la chaîne (et non sur le caractère nul) et est bien plus rapide que DJB2
+			return static_cast<size_t>(Nz::HashXXHash64::Hash(str.GetConstBuffer(), str.GetSize()));
 		}
 	};
 }
@@ -0,0 +1,66 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_STRINGID_HPP
+#define NAZARA_STRINGID_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/String.hpp>
+#include <functional>
+
+namespace Nz
+{
+	// Interned name, compared by pointer and hashed once
+	// Interned names are never freed: build these from a known set of names (registration, constants), not from arbitrary input
+	class NAZARA_CORE_API StringId
+	{
+		public:
+			inline StringId();
+			explicit StringId(const char* string);
+			explicit StringId(const char* string, std::size_t length);
+			explicit StringId(const String& string);
+			StringId(const StringId&) = default;
+			~StringId() = default;
+
+			inline std::size_t GetHash() const;
+			inline const String& GetString() const;
+
+			inline bool IsEmpty() const;
+
+			StringId& operator=(const StringId&) = default;
+
+			inline bool operator==(const StringId& id) const;
+			inline bool operator!=(const StringId& id) const;
+			inline bool operator<(const StringId& id) const;
+
+			static bool Find(const char* string, std::size_t length, StringId* id);
+			static bool Find(const String& string, StringId* id);
+
+		private:
+			struct Entry
+			{
+				String string;
+				std::size_t hash;
+			};
+
+			struct Table;
+
+			static const String& GetEmptyString();
+			static Table& GetTable();
+
+			const Entry* m_entry; //< Interned entry, never freed (null for the empty string)
+	};
+}
+
+namespace std
+{
+	template<>
+	struct hash<Nz::StringId>;
+}
+
+#include <Nazara/Core/StringId.inl>
+
+#endif // NAZARA_STRINGID_HPP
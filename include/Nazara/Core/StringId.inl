@@ -0,0 +1,58 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	inline StringId::StringId() :
+	m_entry(nullptr)
+	{
+	}
+
+	inline std::size_t StringId::GetHash() const
+	{
+		return (m_entry) ? m_entry->hash : 0;
+	}
+
+	inline const String& StringId::GetString() const
+	{
+		return (m_entry) ? m_entry->string : GetEmptyString();
+	}
+
+	inline bool StringId::IsEmpty() const
+	{
+		return m_entry == nullptr;
+	}
+
+	inline bool StringId::operator==(const StringId& id) const
+	{
+		return m_entry == id.m_entry;
+	}
+
+	inline bool StringId::operator!=(const StringId& id) const
+	{
+		return m_entry != id.m_entry;
+	}
+
+	// Arbitrary (but stable during the program execution) order, not the lexicographic one
+	inline bool StringId::operator<(const StringId& id) const
+	{
+		return std::less<const Entry*>()(m_entry, id.m_entry);
+	}
+}
+
+namespace std
+{
+	template<>
+	struct hash<Nz::StringId>
+	{
+		size_t operator()(const Nz::StringId& id) const
+		{
+			return id.GetHash();
+		}
+	};
+}
+
+#include <Nazara/Core/DebugOff.hpp>
@@ -9,11 +9,14 @@
 
 #include <Nazara/Prerequesites.hpp>
 #include <Nazara/Core/Functor.hpp>
+#include <Nazara/Core/MemoryPool.hpp>
 
 namespace Nz
 {
 	class NAZARA_CORE_API TaskScheduler
 	{
+		friend class TaskSchedulerImpl;
+
 		public:
 			TaskScheduler() = delete;
 			~TaskScheduler() = delete;
@@ -23,6 +26,7 @@ namespace Nz
 			template<typename C> static void AddTask(void (C::*function)(), C* object);
 			static unsigned int GetWorkerCount();
 			static bool Initialize();
+			template<typename F> static void ParallelFor(std::size_t count, std::size_t maxTaskCount, const F& function);
 			static void Run();
 			static void SetWorkerCount(unsigned int workerCount);
 			static void Uninitialize();
@@ -30,6 +34,8 @@ namespace Nz
 
 		private:
 			static void AddTaskFunctor(Functor* taskFunctor);
+			static MemoryPool& GetTaskPool();
+			static void ReleaseTask(Functor* task);
 	};
 }
 
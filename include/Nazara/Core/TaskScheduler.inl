@@ -2,6 +2,7 @@
 // This file is part of the "Nazara Engine - Core module"
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
+#include <algorithm>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
@@ -9,19 +10,53 @@ namespace Nz
 	template<typename F>
 	void TaskScheduler::AddTask(F function)
 	{
-		AddTaskFunctor(new FunctorWithoutArgs<F>(function));
+		AddTaskFunctor(GetTaskPool().New<FunctorWithoutArgs<F>>(function));
 	}
 
 	template<typename F, typename... Args>
 	void TaskScheduler::AddTask(F function, Args&&... args)
 	{
-		AddTaskFunctor(new FunctorWithArgs<F, Args...>(function, std::forward<Args>(args)...));
+		AddTaskFunctor(GetTaskPool().New<FunctorWithArgs<F, Args...>>(function, std::forward<Args>(args)...));
 	}
 
 	template<typename C>
 	void TaskScheduler::AddTask(void (C::*function)(), C* object)
 	{
-		AddTaskFunctor(new MemberWithoutArgs<C>(function, object));
+		AddTaskFunctor(GetTaskPool().New<MemberWithoutArgs<C>>(function, object));
+	}
+
+	template<typename F>
+	void TaskScheduler::ParallelFor(std::size_t count, std::size_t maxTaskCount, const F& function)
+	{
+		///DOC: Découpe [0, count[ en intervalles contigus de tailles égales, function(first, last, taskIndex) est appelée une fois par intervalle
+		///DOC: Au plus maxTaskCount tâches (et une par worker) sont lancées, la fonction attend qu'elles soient toutes terminées
+		///DOC: Avec une seule tâche, la fonction est appelée directement depuis le thread courant
+		if (count == 0)
+			return;
+
+		std::size_t taskCount = std::min<std::size_t>(std::min<std::size_t>(GetWorkerCount(), maxTaskCount), count);
+		if (taskCount <= 1)
+		{
+			function(0, count, 0U);
+			return;
+		}
+
+		std::size_t first = 0;
+		for (std::size_t i = 0; i < taskCount; ++i)
+		{
+			std::size_t last = (count * (i + 1)) / taskCount;
+			unsigned int taskIndex = static_cast<unsigned int>(i);
+
+			AddTask([&function, first, last, taskIndex]()
+			{
+				function(first, last, taskIndex);
+			});
+
+			first = last;
+		}
+
+		Run();
+		WaitForTasks();
 	}
 }
 
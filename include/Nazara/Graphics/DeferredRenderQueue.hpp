@@ -9,6 +9,7 @@
 
 #include <Nazara/Prerequesites.hpp>
 #include <Nazara/Core/Color.hpp>
+#include <Nazara/Core/PoolAllocator.hpp>
 #include <Nazara/Graphics/AbstractRenderQueue.hpp>
 #include <Nazara/Graphics/Material.hpp>
 #include <Nazara/Math/Box.hpp>
@@ -57,7 +58,7 @@ namespace Nz
 				std::vector<Matrix4f> instances;
 			};
 
-			typedef std::map<MeshData, MeshInstanceEntry, MeshDataComparator> MeshInstanceContainer;
+			typedef std::map<MeshData, MeshInstanceEntry, MeshDataComparator, PoolAllocator<std::pair<const MeshData, MeshInstanceEntry>>> MeshInstanceContainer;
 
 			struct BatchedModelMaterialComparator
 			{
@@ -73,7 +74,7 @@ namespace Nz
 				bool instancingEnabled = false;
 			};
 
-			typedef std::map<const Material*, BatchedModelEntry, BatchedModelMaterialComparator> ModelBatches;
+			typedef std::map<const Material*, BatchedModelEntry, BatchedModelMaterialComparator, PoolAllocator<std::pair<const Material* const, BatchedModelEntry>>> ModelBatches;
 
 			struct Layer
 			{
@@ -9,6 +9,8 @@
 
 #include <Nazara/Prerequesites.hpp>
 #include <Nazara/Core/Color.hpp>
+#include <Nazara/Core/FrameAllocator.hpp>
+#include <Nazara/Core/PoolAllocator.hpp>
 #include <Nazara/Graphics/AbstractRenderQueue.hpp>
 #include <Nazara/Graphics/Material.hpp>
 #include <Nazara/Math/Box.hpp>
@@ -17,6 +19,7 @@
 #include <Nazara/Utility/MeshData.hpp>
 #include <Nazara/Utility/VertexBuffer.hpp>
 #include <map>
+#include <memory>
 #include <tuple>
 
 namespace Nz
@@ -66,10 +69,10 @@ namespace Nz
 			{
 				NazaraSlot(Material, OnMaterialRelease, materialReleaseSlot);
 
-				std::vector<BillboardData> billboards;
+				FrameVector<BillboardData> billboards;
 			};
 
-			typedef std::map<const Material*, BatchedBillboardEntry, BatchedBillboardComparator> BatchedBillboardContainer;
+			typedef std::map<const Material*, BatchedBillboardEntry, BatchedBillboardComparator, PoolAllocator<std::pair<const Material* const, BatchedBillboardEntry>>> BatchedBillboardContainer;
 
 			/// Sprites
 			struct SpriteChain_XYZ_Color_UV
@@ -82,7 +85,7 @@ namespace Nz
 			{
 				NazaraSlot(Texture, OnTextureRelease, textureReleaseSlot);
 
-				std::vector<SpriteChain_XYZ_Color_UV> spriteChains;
+				FrameVector<SpriteChain_XYZ_Color_UV> spriteChains;
 			};
 
 			struct BatchedSpriteMaterialComparator
@@ -90,7 +93,7 @@ namespace Nz
 				bool operator()(const Material* mat1, const Material* mat2);
 			};
 
-			typedef std::map<const Texture*, BatchedSpriteEntry> BasicSpriteOverlayContainer;
+			typedef std::map<const Texture*, BatchedSpriteEntry, std::less<const Texture*>, PoolAllocator<std::pair<const Texture* const, BatchedSpriteEntry>>> BasicSpriteOverlayContainer;
 
 			struct BatchedBasicSpriteEntry
 			{
@@ -100,7 +103,7 @@ namespace Nz
 				bool enabled = false;
 			};
 
-			typedef std::map<const Material*, BatchedBasicSpriteEntry> BasicSpriteBatches;
+			typedef std::map<const Material*, BatchedBasicSpriteEntry, std::less<const Material*>, PoolAllocator<std::pair<const Material* const, BatchedBasicSpriteEntry>>> BasicSpriteBatches;
 
 			/// Meshes
 			struct MeshDataComparator
@@ -117,7 +120,7 @@ namespace Nz
 				Spheref squaredBoundingSphere;
 			};
 
-			typedef std::map<MeshData, MeshInstanceEntry, MeshDataComparator> MeshInstanceContainer;
+			typedef std::map<MeshData, MeshInstanceEntry, MeshDataComparator, PoolAllocator<std::pair<const MeshData, MeshInstanceEntry>>> MeshInstanceContainer;
 
 			struct BatchedModelMaterialComparator
 			{
@@ -133,7 +136,7 @@ namespace Nz
 				bool instancingEnabled = false;
 			};
 
-			typedef std::map<const Material*, BatchedModelEntry, BatchedModelMaterialComparator> ModelBatches;
+			typedef std::map<const Material*, BatchedModelEntry, BatchedModelMaterialComparator, PoolAllocator<std::pair<const Material* const, BatchedModelEntry>>> ModelBatches;
 
 			struct TransparentModelData
 			{
@@ -143,7 +146,7 @@ namespace Nz
 				const Material* material;
 			};
 
-			typedef std::vector<unsigned int> TransparentModelContainer;
+			typedef FrameVector<unsigned int> TransparentModelContainer;
 
 			struct Layer
 			{
@@ -151,8 +154,8 @@ namespace Nz
 				BasicSpriteBatches basicSprites;
 				ModelBatches opaqueModels;
 				TransparentModelContainer transparentModels;
-				std::vector<TransparentModelData> transparentModelData;
-				std::vector<const Drawable*> otherDrawables;
+				FrameVector<TransparentModelData> transparentModelData;
+				FrameVector<const Drawable*> otherDrawables;
 				unsigned int clearCount = 0;
 			};
 
@@ -165,6 +168,9 @@ namespace Nz
 			void OnMaterialInvalidation(const Material* material);
 			void OnTextureInvalidation(const Texture* texture);
 			void OnVertexBufferInvalidation(const VertexBuffer* vertexBuffer);
+
+			// Memory of the per-frame containers (FrameVector), bound to it by Clear
+			std::unique_ptr<FrameAllocator> m_frameAllocator = std::make_unique<FrameAllocator>();
 	};
 }
 
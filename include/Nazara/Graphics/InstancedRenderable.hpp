@@ -16,6 +16,7 @@
 #include <Nazara/Math/BoundingVolume.hpp>
 #include <Nazara/Math/Frustum.hpp>
 #include <Nazara/Math/Matrix4.hpp>
+#include <limits>
 
 namespace Nz
 {
@@ -31,7 +32,7 @@ namespace Nz
 		public:
 			struct InstanceData;
 
-			InstancedRenderable() = default;
+			inline InstancedRenderable();
 			inline InstancedRenderable(const InstancedRenderable& renderable);
 			InstancedRenderable(InstancedRenderable&& renderable) = delete;
 			virtual ~InstancedRenderable();
@@ -42,8 +43,10 @@ namespace Nz
 			virtual bool Cull(const Frustumf& frustum, const InstanceData& instanceData) const;
 			virtual const BoundingVolumef& GetBoundingVolume() const;
 			virtual void InvalidateData(InstanceData* instanceData, UInt32 flags) const;
+			inline bool IsLodEnabled() const;
 			virtual void UpdateBoundingVolume(InstanceData* instanceData) const;
 			virtual void UpdateData(InstanceData* instanceData) const;
+			virtual void UpdateLod(float viewerDistance, bool visible);
 
 			inline InstancedRenderable& operator=(const InstancedRenderable& renderable);
 			InstancedRenderable& operator=(InstancedRenderable&& renderable) = delete;
@@ -56,6 +59,7 @@ namespace Nz
 			{
 				InstanceData(Matrix4f& referenceMatrix) :
 				transformMatrix(referenceMatrix),
+				screenScale(std::numeric_limits<float>::infinity()),
 				flags(0)
 				{
 				}
@@ -63,11 +67,13 @@ namespace Nz
 				std::vector<UInt8> data;
 				BoundingVolumef volume;
 				Matrix4f& transformMatrix;
+				float screenScale; // Fraction of the screen height covered by an unit at the instance (infinite for full detail)
 				UInt32 flags;
 				int renderOrder;
 			};
 
 		protected:
+			inline void EnableLod(bool lod);
 			virtual void MakeBoundingVolume() const = 0;
 			void InvalidateBoundingVolume();
 			inline void InvalidateInstanceData(UInt32 flags);
@@ -77,6 +83,7 @@ namespace Nz
 
 		private:
 			mutable bool m_boundingVolumeUpdated;
+			bool m_lodEnabled;
 
 			static InstancedRenderableLibrary::LibraryMap s_library;
 	};
@@ -4,10 +4,17 @@
 
 namespace Nz
 {
+	inline InstancedRenderable::InstancedRenderable() :
+	m_boundingVolumeUpdated(false),
+	m_lodEnabled(false)
+	{
+	}
+
 	inline InstancedRenderable::InstancedRenderable(const InstancedRenderable& renderable) :
 	RefCounted(),
 	m_boundingVolume(renderable.m_boundingVolume),
-	m_boundingVolumeUpdated(renderable.m_boundingVolumeUpdated)
+	m_boundingVolumeUpdated(renderable.m_boundingVolumeUpdated),
+	m_lodEnabled(renderable.m_lodEnabled)
 	{
 	}
 
@@ -17,9 +24,17 @@ namespace Nz
 			UpdateBoundingVolume();
 	}
 
+	inline void InstancedRenderable::EnableLod(bool lod)
+	{
+		m_lodEnabled = lod;
+	}
+
 	inline void InstancedRenderable::InvalidateBoundingVolume()
 	{
 		m_boundingVolumeUpdated = false;
+
+		// The instances' volumes are computed from this one
+		InvalidateInstanceData(0);
 	}
 
 	inline void InstancedRenderable::InvalidateInstanceData(UInt32 flags)
@@ -27,10 +42,16 @@ namespace Nz
 		OnInstancedRenderableInvalidateData(this, flags);
 	}
 
+	inline bool InstancedRenderable::IsLodEnabled() const
+	{
+		return m_lodEnabled;
+	}
+
 	inline InstancedRenderable& InstancedRenderable::operator=(const InstancedRenderable& renderable)
 	{
 		m_boundingVolume = renderable.m_boundingVolume;
 		m_boundingVolumeUpdated = renderable.m_boundingVolumeUpdated;
+		m_lodEnabled = renderable.m_lodEnabled;
 
 		return *this;
 	}
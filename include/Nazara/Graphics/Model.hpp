@@ -45,6 +45,7 @@ namespace Nz
 
 			void AddToRenderQueue(AbstractRenderQueue* renderQueue, const InstanceData& instanceData) const override;
 
+			float GetLodThreshold() const;
 			Material* GetMaterial(const String& subMeshName) const;
 			Material* GetMaterial(unsigned int matIndex) const;
 			Material* GetMaterial(unsigned int skinIndex, const String& subMeshName) const;
@@ -62,6 +63,7 @@ namespace Nz
 
 			void Reset();
 
+			void SetLodThreshold(float threshold);
 			bool SetMaterial(const String& subMeshName, Material* material);
 			void SetMaterial(unsigned int matIndex, Material* material);
 			bool SetMaterial(unsigned int skinIndex, const String& subMeshName, Material* material);
@@ -82,6 +84,7 @@ namespace Nz
 
 			std::vector<MaterialRef> m_materials;
 			MeshRef m_mesh;
+			float m_lodThreshold;
 			unsigned int m_matCount;
 			unsigned int m_skin;
 			unsigned int m_skinCount;
@@ -8,6 +8,7 @@
 #define NAZARA_PARTICLESYSTEM_HPP
 
 #include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/PoolAllocator.hpp>
 #include <Nazara/Graphics/ParticleController.hpp>
 #include <Nazara/Graphics/ParticleDeclaration.hpp>
 #include <Nazara/Graphics/ParticleEmitter.hpp>
@@ -72,7 +73,7 @@ namespace Nz
 			void MakeBoundingVolume() const override;
 			void ResizeBuffer();
 
-			std::set<unsigned int, std::greater<unsigned int>> m_dyingParticles;
+			std::set<unsigned int, std::greater<unsigned int>, PoolAllocator<unsigned int>> m_dyingParticles;
 			mutable std::vector<UInt8> m_buffer;
 			std::vector<ParticleControllerRef> m_controllers;
 			std::vector<ParticleEmitter*> m_emitters;
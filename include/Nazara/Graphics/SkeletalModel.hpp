@@ -26,6 +26,16 @@ namespace Nz
 		bool IsValid() const;
 	};
 
+	struct SkeletalModelLodLevel
+	{
+		// Les joints animés à ce niveau (tous si vide), les autres gardent leur dernière transformation
+		std::vector<unsigned int> jointIndices;
+		// La distance à la caméra à partir de laquelle ce niveau est utilisé
+		float distance = 0.f;
+		// Le temps minimal entre deux mises à jour du squelette (en secondes)
+		float updateInterval = 0.f;
+	};
+
 	class SkeletalModel;
 
 	using SkeletalModelLoader = ResourceLoader<SkeletalModel, SkeletalModelParameters>;
@@ -43,14 +53,19 @@ namespace Nz
 			void AddToRenderQueue(AbstractRenderQueue* renderQueue, const InstanceData& instanceData) const override;
 			void AdvanceAnimation(float elapsedTime);
 
+			void ClearLodLevels();
 			SkeletalModel* Clone() const;
 			SkeletalModel* Create() const;
 
 			void EnableAnimation(bool animation);
 
 			Animation* GetAnimation() const;
+			const SkeletalModelLodLevel* GetLodLevel() const;
+			unsigned int GetLodLevelCount() const;
 			Skeleton* GetSkeleton();
 			const Skeleton* GetSkeleton() const;
+			unsigned int GetSkippedJointCount() const;
+			unsigned int GetSkippedVertexCount() const;
 
 			bool HasAnimation() const;
 
@@ -64,10 +79,13 @@ namespace Nz
 			void Reset();
 
 			bool SetAnimation(Animation* animation);
+			void SetLodLevels(std::vector<SkeletalModelLodLevel> lodLevels);
 			void SetMesh(Mesh* mesh) override;
 			bool SetSequence(const String& sequenceName);
 			void SetSequence(unsigned int sequenceIndex);
 
+			void UpdateLod(float viewerDistance, bool visible) override;
+
 			SkeletalModel& operator=(const SkeletalModel& node) = default;
 			SkeletalModel& operator=(SkeletalModel&& node) = default;
 
@@ -76,14 +94,22 @@ namespace Nz
 			/*void Register() override;
 			void Unregister() override;*/
 			void Update() override;
+			void UpdateSkeleton();
 
 			AnimationRef m_animation;
 			Skeleton m_skeleton;
+			std::vector<SkeletalModelLodLevel> m_lodLevels;
 			const Sequence* m_currentSequence;
 			bool m_animationEnabled;
+			bool m_animationPending;
+			bool m_visible;
 			float m_interpolation;
+			float m_lodElapsedTime;
+			int m_lodLevel;
 			unsigned int m_currentFrame;
 			unsigned int m_nextFrame;
+			unsigned int m_skippedJointCount;
+			unsigned int m_skippedVertexCount;
 
 			static SkeletalModelLoader::LoaderList s_loaders;
 	};
@@ -9,6 +9,7 @@
 
 #include <Nazara/Prerequesites.hpp>
 #include <Nazara/Graphics/Config.hpp>
+#include <Nazara/Math/Matrix4.hpp>
 
 namespace Nz
 {
@@ -21,7 +22,7 @@ namespace Nz
 		friend class Graphics;
 
 		public:
-			using SkinFunction = void (*)(const SkeletalMesh* mesh, const Skeleton* skeleton, VertexBuffer* buffer);
+			using SkinFunction = void (*)(const SkeletalMesh* mesh, const Matrix4f* skinningMatrices, VertexBuffer* buffer);
 
 			SkinningManager() = delete;
 			~SkinningManager() = delete;
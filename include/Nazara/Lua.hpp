@@ -34,5 +34,6 @@
 #include <Nazara/Lua/Lua.hpp>
 #include <Nazara/Lua/LuaClass.hpp>
 #include <Nazara/Lua/LuaInstance.hpp>
+#include <Nazara/Lua/LuaScheduler.hpp>
 
 #endif // NAZARA_GLOBAL_LUA_HPP
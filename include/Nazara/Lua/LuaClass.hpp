@@ -30,6 +30,7 @@ namespace Nz
 			using ClassIndexFunc = std::function<bool(LuaInstance& lua, T& instance)>;
 			using ConstructorFunc = std::function<T*(LuaInstance& lua)>;
 			using FinalizerFunc = std::function<bool(LuaInstance& lua, T& instance)>;
+			using InlineConstructorFunc = std::function<bool(LuaInstance& lua, T* instance)>;
 			using StaticIndexFunc = std::function<bool(LuaInstance& lua)>;
 			using StaticFunc = std::function<int(LuaInstance& lua)>;
 
@@ -43,6 +44,7 @@ namespace Nz
 			void PushGlobalTable(LuaInstance& lua);
 
 			void SetConstructor(ConstructorFunc constructor);
+			void SetConstructor(InlineConstructorFunc constructor);
 			void SetFinalizer(FinalizerFunc finalizer);
 			void SetGetter(ClassIndexFunc getter);
 			void SetMethod(const String& name, ClassFunc method);
@@ -65,10 +67,11 @@ namespace Nz
 				std::vector<ClassFunc> methods;
 				std::vector<ParentFunc> parentGetters;
 				std::vector<StaticFunc> staticMethods;
-				std::unordered_map<String, InstanceGetter> instanceGetters;
+				std::unordered_map<const void*, InstanceGetter> instanceGetters; //< Indexed by the ClassInfo of derived classes
 				ClassIndexFunc getter;
 				ClassIndexFunc setter;
 				ConstructorFunc constructor;
+				InlineConstructorFunc inlineConstructor;
 				FinalizerFunc finalizer;
 				StaticIndexFunc staticGetter;
 				StaticIndexFunc staticSetter;
@@ -80,12 +83,17 @@ namespace Nz
 			static int FinalizerProxy(lua_State* state);
 			static int InfoDestructor(lua_State* state);
 			static void Get(const std::shared_ptr<ClassInfo>& info, LuaInstance& lua, T& instance);
+			static T* GetInstancePointer(void* userdata);
 			static int GetterProxy(lua_State* state);
 			static int MethodProxy(lua_State* state);
 			static int SetterProxy(lua_State* state);
 			static int StaticGetterProxy(lua_State* state);
 			static int StaticMethodProxy(lua_State* state);
 			static int StaticSetterProxy(lua_State* state);
+			static T* ToInstance(LuaInstance& lua, const ClassInfo& info);
+
+			static constexpr bool InlineStorage = LuaInlineStorage<T>::value;
+			static constexpr int TypeInfoIndex = 1; //< Metatable index of the class type information
 
 			std::map<String, ClassFunc> m_methods;
 			std::map<String, StaticFunc> m_staticMethods;
@@ -4,6 +4,7 @@
 
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/MemoryHelper.hpp>
+#include <cstring>
 #include <type_traits>
 #include <Nazara/Lua/Debug.hpp>
 
@@ -24,9 +25,10 @@ namespace Nz
 
 		std::shared_ptr<typename LuaClass<P>::ClassInfo>& parentInfo = parent.m_info;
 		
-		parentInfo->instanceGetters[m_info->name] = [info = m_info](LuaInstance& lua) -> P*
+		// The instance type (userdata and metatable) has already been checked by the caller
+		parentInfo->instanceGetters[m_info.get()] = [](LuaInstance& lua) -> P*
 		{
-			return *static_cast<T**>(lua.CheckUserdata(1, info->name));
+			return GetInstancePointer(lua.ToUserdata(1));
 		};
 
 		m_info->parentGetters.emplace_back([parentInfo] (LuaInstance& lua, T& instance)
@@ -64,10 +66,18 @@ namespace Nz
 			lua.PushString(m_info->name);
 			lua.SetField("__type");
 
-			// Define the Finalizer
-			lua.PushValue(1);
-			lua.PushCFunction(FinalizerProxy, 1);
-			lua.SetField("__gc");
+			// Store the ClassInfo address under an integer key, proxies use it to identify instances without any string lookup
+			lua.PushInteger(TypeInfoIndex);
+			lua.PushLightUserdata(m_info.get());
+			lua.SetTable(-3);
+
+			// Define the Finalizer (inline instances have nothing to release)
+			if (!InlineStorage || m_info->finalizer)
+			{
+				lua.PushValue(1);
+				lua.PushCFunction(FinalizerProxy, 1);
+				lua.SetField("__gc");
+			}
 
 			if (m_info->getter || !m_info->parentGetters.empty())
 			{
@@ -102,15 +112,10 @@ namespace Nz
 				lua.PushCFunction(MethodProxy, 2);
 				lua.SetField(pair.first); // Method name
 			}
-
-			m_info->instanceGetters[m_info->name] = [info = m_info](LuaInstance& lua)
-			{
-				return *static_cast<T**>(lua.CheckUserdata(1, info->name));
-			};
 		}
 		lua.Pop(); // On pop la metatable
 
-		if (m_info->constructor || m_info->staticGetter || m_info->staticSetter || !m_info->staticMethods.empty())
+		if (m_info->constructor || m_info->inlineConstructor || m_info->staticGetter || m_info->staticSetter || !m_info->staticMethods.empty())
 		{
 			// Création de l'instance globale
 			lua.PushTable(); // Class = {}
@@ -118,10 +123,11 @@ namespace Nz
 			// Création de la metatable associée à la table globale
 			lua.PushTable(); // ClassMeta = {}
 
-			if (m_info->constructor)
+			if (m_info->constructor || m_info->inlineConstructor)
 			{
 				lua.PushValue(1); // ClassInfo
-				lua.PushCFunction(ConstructorProxy, 1);
+				lua.PushMetatable(m_info->name); // Instance metatable
+				lua.PushCFunction(ConstructorProxy, 2);
 				lua.SetField("__call"); // ClassMeta.__call = ConstructorProxy
 			}
 
@@ -181,6 +187,14 @@ namespace Nz
 		m_info->constructor = constructor;
 	}
 
+	template<class T>
+	void LuaClass<T>::SetConstructor(InlineConstructorFunc constructor)
+	{
+		static_assert(InlineStorage, "Inline constructors require LuaInlineStorage to be specialized for this type");
+
+		m_info->inlineConstructor = constructor;
+	}
+
 	template<class T>
 	void LuaClass<T>::SetFinalizer(FinalizerFunc finalizer)
 	{
@@ -299,11 +313,27 @@ namespace Nz
 		LuaInstance& lua = *LuaInstance::GetInstance(state);
 
 		std::shared_ptr<ClassInfo>& info = *static_cast<std::shared_ptr<ClassInfo>*>(lua.ToUserdata(lua.GetIndexOfUpValue(1)));
-		const ConstructorFunc& constructor = info->constructor;
 
 		lua.Remove(1); // On enlève l'argument "table" du stack
 
-		T* instance = constructor(lua);
+		if (info->inlineConstructor)
+		{
+			// The arguments must stay on top of the stack while constructing, the (trivially copyable) instance is then copied into its userdata
+			typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+			if (!info->inlineConstructor(lua, reinterpret_cast<T*>(&storage)))
+			{
+				lua.Error("Constructor failed");
+				return 0; // Normalement jamais exécuté (l'erreur provoquant une exception)
+			}
+
+			std::memcpy(lua.PushUserdata(sizeof(T)), &storage, sizeof(T));
+
+			lua.PushValue(lua.GetIndexOfUpValue(2));
+			lua.SetMetatable(-2);
+			return 1;
+		}
+
+		T* instance = info->constructor(lua);
 		if (!instance)
 		{
 			lua.Error("Constructor failed");
@@ -322,10 +352,11 @@ namespace Nz
 		std::shared_ptr<ClassInfo>& info = *static_cast<std::shared_ptr<ClassInfo>*>(lua.ToUserdata(lua.GetIndexOfUpValue(1)));
 		const FinalizerFunc& finalizer = info->finalizer;
 
-		T* instance = *static_cast<T**>(lua.CheckUserdata(1, info->name));
+		T* instance = GetInstancePointer(lua.CheckUserdata(1, info->name));
 		lua.Remove(1); //< Remove the instance from the Lua stack
 
-		if (!finalizer || finalizer(lua, *instance))
+		bool release = !finalizer || finalizer(lua, *instance);
+		if (release && !InlineStorage)
 			delete instance;
 
 		return 0;
@@ -373,6 +404,17 @@ namespace Nz
 		}
 	}
 
+	template<class T>
+	T* LuaClass<T>::GetInstancePointer(void* userdata)
+	{
+		// Inline instances are stored in the userdata itself, others are referenced by a pointer
+		// Either way the userdata must be an instance of the class (as checked by ToInstance), nothing can be checked here
+		if (InlineStorage)
+			return static_cast<T*>(userdata);
+		else
+			return *static_cast<T**>(userdata);
+	}
+
 	template<class T>
 	int LuaClass<T>::GetterProxy(lua_State* state)
 	{
@@ -380,10 +422,13 @@ namespace Nz
 
 		std::shared_ptr<ClassInfo>& info = *static_cast<std::shared_ptr<ClassInfo>*>(lua.ToUserdata(lua.GetIndexOfUpValue(1)));
 
-		T& instance = *(*static_cast<T**>(lua.CheckUserdata(1, info->name)));
+		T* instance = ToInstance(lua, *info);
+		if (!instance)
+			return lua.ArgError(1, info->name + " expected");
+
 		lua.Remove(1); //< Remove the instance from the Lua stack
 
-		Get(info, lua, instance);
+		Get(info, lua, *instance);
 		return 1;
 	}
 
@@ -394,19 +439,9 @@ namespace Nz
 
 		std::shared_ptr<ClassInfo>& info = *static_cast<std::shared_ptr<ClassInfo>*>(lua.ToUserdata(lua.GetIndexOfUpValue(1)));
 
-		T* instance = nullptr;
-		if (lua.GetMetatable(1))
-		{
-			LuaType type = lua.GetField("__type");
-			if (type == LuaType_String)
-			{
-				String name = lua.ToString(-1);
-				auto it = info->instanceGetters.find(name);
-				if (it != info->instanceGetters.end())
-					instance = it->second(lua);
-			}
-			lua.Pop(2);
-		}
+		T* instance = ToInstance(lua, *info);
+		if (!instance)
+			return lua.ArgError(1, info->name + " expected");
 
 		lua.Remove(1); //< Remove the instance from the Lua stack
 
@@ -423,10 +458,13 @@ namespace Nz
 		std::shared_ptr<ClassInfo>& info = *static_cast<std::shared_ptr<ClassInfo>*>(lua.ToUserdata(lua.GetIndexOfUpValue(1)));
 		const ClassIndexFunc& setter = info->setter;
 
-		T& instance = *(*static_cast<T**>(lua.CheckUserdata(1, info->name)));
+		T* instance = ToInstance(lua, *info);
+		if (!instance)
+			return lua.ArgError(1, info->name + " expected");
+
 		lua.Remove(1); //< Remove the instance from the Lua stack
 
-		if (!setter(lua, instance))
+		if (!setter(lua, *instance))
 		{
 			std::size_t length;
 			const char* str = lua.ToString(2, &length);
@@ -437,6 +475,33 @@ namespace Nz
 		return 1;
 	}
 
+	template<class T>
+	T* LuaClass<T>::ToInstance(LuaInstance& lua, const ClassInfo& info)
+	{
+		// A table may have been given the metatable of the class, only userdata can hold an instance
+		T* instance = nullptr;
+		if (lua.GetType(1) == LuaType_Userdata && lua.GetMetatable(1))
+		{
+			lua.PushInteger(TypeInfoIndex);
+			if (lua.GetTable() == LuaType_LightUserdata)
+			{
+				const void* typeInfo = lua.ToUserdata(-1);
+				if (typeInfo == &info)
+					instance = GetInstancePointer(lua.ToUserdata(1));
+				else
+				{
+					// Instance of a derived class
+					auto it = info.instanceGetters.find(typeInfo);
+					if (it != info.instanceGetters.end())
+						instance = it->second(lua);
+				}
+			}
+			lua.Pop(2);
+		}
+
+		return instance;
+	}
+
 	template<class T>
 	int LuaClass<T>::StaticGetterProxy(lua_State* state)
 	{
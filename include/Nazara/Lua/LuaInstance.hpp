@@ -15,6 +15,8 @@
 #include <Nazara/Lua/Enums.hpp>
 #include <cstddef>
 #include <functional>
+#include <memory>
+#include <type_traits>
 
 struct lua_Debug;
 struct lua_State;
@@ -26,10 +28,15 @@ namespace Nz
 	using LuaCFunction = int (*)(lua_State* state);
 	using LuaFunction = std::function<int(LuaInstance& instance)>;
 
+	// Specialize as std::true_type to store instances of a trivially copyable type directly in their userdata
+	template<typename T> struct LuaInlineStorage : std::false_type {};
+
 	class NAZARA_LUA_API LuaInstance
 	{
+		friend class LuaScheduler;
+
 		public:
-			LuaInstance();
+			explicit LuaInstance(bool useMemoryPools = false);
 			LuaInstance(const LuaInstance&) = delete;
 			LuaInstance(LuaInstance&&) = delete; ///TODO
 			~LuaInstance();
@@ -88,6 +95,7 @@ namespace Nz
 			bool ExecuteFromStream(Stream& stream);
 
 			int GetAbsIndex(int index) const;
+			String GetBytecodeCacheDirectory() const;
 			LuaType GetField(const char* fieldName, int tableIndex = -1) const;
 			LuaType GetField(const String& fieldName, int tableIndex = -1) const;
 			LuaType GetGlobal(const char* name) const;
@@ -95,10 +103,12 @@ namespace Nz
 			lua_State* GetInternalState() const;
 			String GetLastError() const;
 			UInt32 GetMemoryLimit() const;
+			float GetMemoryFragmentation() const;
 			UInt32 GetMemoryUsage() const;
 			LuaType GetMetatable(const char* tname) const;
 			LuaType GetMetatable(const String& tname) const;
 			bool GetMetatable(int index) const;
+			UInt32 GetPeakMemoryUsage() const;
 			unsigned int GetStackTop() const;
 			LuaType GetTable(int index = -2) const;
 			UInt32 GetTimeLimit() const;
@@ -154,6 +164,7 @@ namespace Nz
 			template<typename T> void SetGlobal(const String& name, T&& arg);
 			void SetGlobal(const char* name);
 			void SetGlobal(const String& name);
+			void SetBytecodeCacheDirectory(const String& directory);
 			void SetMetatable(const char* tname) const;
 			void SetMetatable(const String& tname) const;
 			void SetMetatable(int index) const;
@@ -178,16 +189,26 @@ namespace Nz
 
 		private:
 			template<typename T> T CheckBounds(int index, long long value) const;
+			bool LoadWithBytecodeCache(const String& filePath, const String& source);
+			template<typename T> void PushInstance(const char* tname, T* instance, std::false_type) const;
+			template<typename T> void PushInstance(const char* tname, T* instance, std::true_type) const;
+			template<typename T, typename... Args> void PushNewInstance(std::false_type, const char* tname, Args&&... args) const;
+			template<typename T, typename... Args> void PushNewInstance(std::true_type, const char* tname, Args&&... args) const;
 			bool Run(int argCount, int resultCount);
 
+			struct MemoryPools;
+
 			static void* MemoryAllocator(void *ud, void *ptr, std::size_t osize, std::size_t nsize);
 			static int ProxyFunc(lua_State* state);
 			static void TimeLimiter(lua_State* state, lua_Debug* debug);
 
+			std::unique_ptr<MemoryPools> m_memoryPools;
 			UInt32 m_memoryLimit;
+			UInt32 m_memoryPeakUsage;
 			UInt32 m_memoryUsage;
 			UInt32 m_timeLimit;
 			Clock m_clock;
+			String m_bytecodeCacheDirectory;
 			String m_lastError;
 			lua_State* m_state;
 			unsigned int m_level;
@@ -3,6 +3,8 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Core/Algorithm.hpp>
+#include <Nazara/Core/MemoryHelper.hpp>
+#include <Nazara/Core/StringStream.hpp>
 #include <limits>
 #include <string>
 #include <type_traits>
@@ -512,15 +514,13 @@ namespace Nz
 	template<typename T>
 	void LuaInstance::PushInstance(const char* tname, T* instance) const
 	{
-		T** userdata = static_cast<T**>(PushUserdata(sizeof(T*)));
-		*userdata = instance;
-		SetMetatable(tname);
+		PushInstance(tname, instance, LuaInlineStorage<T>());
 	}
 
 	template<typename T, typename... Args>
 	void LuaInstance::PushInstance(const char* tname, Args&&... args) const
 	{
-		PushInstance(tname, new T(std::forward<Args>(args)...));
+		PushNewInstance<T>(LuaInlineStorage<T>(), tname, std::forward<Args>(args)...);
 	}
 
 	template<typename T>
@@ -549,6 +549,37 @@ namespace Nz
 		SetGlobal(name.GetConstBuffer(), std::forward<T>(arg));
 	}
 
+	template<typename T>
+	void LuaInstance::PushInstance(const char* tname, T* instance, std::false_type) const
+	{
+		T** userdata = static_cast<T**>(PushUserdata(sizeof(T*)));
+		*userdata = instance;
+		SetMetatable(tname);
+	}
+
+	template<typename T>
+	void LuaInstance::PushInstance(const char* tname, T* instance, std::true_type) const
+	{
+		// The userdata takes ownership of the instance, which is copied into it
+		PushNewInstance<T>(std::true_type(), tname, *instance);
+		delete instance;
+	}
+
+	template<typename T, typename... Args>
+	void LuaInstance::PushNewInstance(std::false_type, const char* tname, Args&&... args) const
+	{
+		PushInstance(tname, new T(std::forward<Args>(args)...), std::false_type());
+	}
+
+	template<typename T, typename... Args>
+	void LuaInstance::PushNewInstance(std::true_type, const char* tname, Args&&... args) const
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be stored inline");
+
+		PlacementNew<T>(PushUserdata(sizeof(T)), std::forward<Args>(args)...);
+		SetMetatable(tname);
+	}
+
 	template<typename T>
 	T LuaInstance::CheckBounds(int index, long long value) const
 	{
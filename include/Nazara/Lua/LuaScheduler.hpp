@@ -0,0 +1,79 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Lua scripting module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_LUASCHEDULER_HPP
+#define NAZARA_LUASCHEDULER_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Lua/Config.hpp>
+#include <memory>
+#include <vector>
+
+struct lua_Debug;
+struct lua_State;
+
+namespace Nz
+{
+	class LuaInstance;
+
+	// Runs many coroutines cooperatively: each one is given an instruction budget per resume and is yielded
+	// (instead of aborted) when it runs out of it, coroutines are then resumed in turn until the frame time budget is spent
+	class NAZARA_LUA_API LuaScheduler
+	{
+		public:
+			struct CoroutineStats
+			{
+				UInt64 executionTime = 0; //< In microseconds
+				UInt64 instructionCount = 0; //< Rounded to the hook granularity
+				unsigned int budgetExhaustionCount = 0;
+				unsigned int resumeCount = 0;
+			};
+
+			LuaScheduler(LuaInstance& instance, UInt32 defaultInstructionBudget = 10000);
+			LuaScheduler(const LuaScheduler&) = delete;
+			LuaScheduler(LuaScheduler&&) = delete;
+			~LuaScheduler();
+
+			void Clear();
+
+			std::size_t GetCoroutineCount() const;
+			bool GetCoroutineStats(unsigned int coroutineId, CoroutineStats* stats) const;
+			UInt32 GetDefaultInstructionBudget() const;
+
+			bool IsAlive(unsigned int coroutineId) const;
+
+			bool Kill(unsigned int coroutineId);
+
+			void SetDefaultInstructionBudget(UInt32 instructionBudget);
+			unsigned int Spawn(unsigned int argCount = 0);
+			unsigned int Spawn(unsigned int argCount, UInt32 instructionBudget);
+
+			unsigned int Update(UInt64 timeBudget);
+
+			LuaScheduler& operator=(const LuaScheduler&) = delete;
+			LuaScheduler& operator=(LuaScheduler&&) = delete;
+
+			static constexpr unsigned int InvalidId = 0;
+
+		private:
+			struct Coroutine;
+
+			std::size_t FindCoroutine(unsigned int coroutineId) const;
+			void Release(Coroutine& coroutine);
+			bool Resume(Coroutine& coroutine);
+
+			static void BudgetHook(lua_State* state, lua_Debug* debug);
+
+			std::vector<std::unique_ptr<Coroutine>> m_coroutines;
+			Coroutine* m_runningCoroutine;
+			std::size_t m_nextCoroutine;
+			LuaInstance& m_instance;
+			UInt32 m_defaultInstructionBudget;
+			unsigned int m_nextId;
+	};
+}
+
+#endif // NAZARA_LUASCHEDULER_HPP
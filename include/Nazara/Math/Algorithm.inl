@@ -9,6 +9,11 @@
 #include <cstdlib>
 #include <cstring>
 #include <type_traits>
+
+#ifdef NAZARA_COMPILER_MSVC
+	#include <intrin.h>
+#endif
+
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
@@ -31,70 +36,133 @@ namespace Nz
 			};
 		}
 
+		// The bit scan and population count instructions are used through the compiler intrinsics when available,
+		// the bit tricks are kept for the other compilers (popcnt itself is not required by the intrinsics)
 		template<typename T>
 		typename std::enable_if<sizeof(T) <= sizeof(UInt32), unsigned int>::type IntegralLog2(T number)
 		{
-			// https://graphics.stanford.edu/~seander/bithacks.html#IntegerLogDeBruijn
-			number |= number >> 1; // first round down to one less than a power of 2
-			number |= number >> 2;
-			number |= number >> 4;
-			number |= number >> 8;
-			number |= number >> 16;
+			UInt32 value = static_cast<typename std::make_unsigned<T>::type>(number);
+			if (value == 0)
+				return 0;
+
+			#if defined(NAZARA_COMPILER_CLANG) || defined(NAZARA_COMPILER_GCC)
+			return 31 - __builtin_clz(value);
+			#elif defined(NAZARA_COMPILER_MSVC)
+			unsigned long index;
+			_BitScanReverse(&index, value);
 
-			return MultiplyDeBruijnBitPosition[static_cast<UInt32>(number * 0x07C4ACDDU) >> 27];
+			return index;
+			#else
+			// https://graphics.stanford.edu/~seander/bithacks.html#IntegerLogDeBruijn
+			value |= value >> 1; // first round down to one less than a power of 2
+			value |= value >> 2;
+			value |= value >> 4;
+			value |= value >> 8;
+			value |= value >> 16;
+
+			return MultiplyDeBruijnBitPosition[static_cast<UInt32>(value * 0x07C4ACDDU) >> 27];
+			#endif
 		}
 
 		template<typename T>
 		// Les parenthèses autour de la condition sont nécesaires pour que GCC compile ça
 		typename std::enable_if<(sizeof(T) > sizeof(UInt32)), unsigned int>::type IntegralLog2(T number)
 		{
-			static_assert(sizeof(T) % sizeof(UInt32) == 0, "Assertion failed");
+			static_assert(sizeof(T) == sizeof(UInt64), "Assertion failed");
 
-			// L'algorithme pour le logarithme base 2 (au dessus) ne fonctionne qu'avec des nombres au plus 32bits
-			// ce code décompose les nombres plus grands en nombres 32 bits par masquage et bit shifting
-			for (int i = sizeof(T)-sizeof(UInt32); i >= 0; i -= sizeof(UInt32))
-			{
-				// Le masque 32 bits sur la partie du nombre qu'on traite actuellement
-				T mask = T(std::numeric_limits<UInt32>::max()) << i*8;
-				T val = (number & mask) >> i*8; // Masquage et shifting des bits vers la droite (pour le ramener sur 32bits)
-
-				// Appel de la fonction avec le nombre 32bits, si le résultat est non-nul nous avons la réponse
-				unsigned int log2 = IntegralLog2<UInt32>(val);
-				if (log2)
-					return log2 + i*8;
-			}
+			UInt64 value = static_cast<typename std::make_unsigned<T>::type>(number);
+			if (value == 0)
+				return 0;
 
-			return 0;
+			#if defined(NAZARA_COMPILER_CLANG) || defined(NAZARA_COMPILER_GCC)
+			return 63 - __builtin_clzll(value);
+			#elif defined(NAZARA_COMPILER_MSVC) && (defined(_M_X64) || defined(_M_ARM64))
+			unsigned long index;
+			_BitScanReverse64(&index, value);
+
+			return index;
+			#else
+			// L'algorithme pour le logarithme base 2 (au dessus) ne fonctionne qu'avec des nombres au plus 32bits
+			// ce code décompose les nombres en deux parties de 32 bits
+			UInt32 high = static_cast<UInt32>(value >> 32);
+			if (high)
+				return IntegralLog2<UInt32>(high) + 32;
+			else
+				return IntegralLog2<UInt32>(static_cast<UInt32>(value));
+			#endif
 		}
 
 		template<typename T>
 		typename std::enable_if<sizeof(T) <= sizeof(UInt32), unsigned int>::type IntegralLog2Pot(T number)
 		{
+			UInt32 value = static_cast<typename std::make_unsigned<T>::type>(number);
+
+			#if defined(NAZARA_COMPILER_CLANG) || defined(NAZARA_COMPILER_GCC)
+			return (value != 0) ? __builtin_ctz(value) : 0;
+			#elif defined(NAZARA_COMPILER_MSVC)
+			unsigned long index;
+			return (_BitScanForward(&index, value)) ? index : 0;
+			#else
 			// https://graphics.stanford.edu/~seander/bithacks.html#IntegerLogDeBruijn
-			return MultiplyDeBruijnBitPosition2[static_cast<UInt32>(number * 0x077CB531U) >> 27];
+			return MultiplyDeBruijnBitPosition2[static_cast<UInt32>(value * 0x077CB531U) >> 27];
+			#endif
 		}
 
 		template<typename T>
 		// Les parenthèses autour de la condition sont nécesaires pour que GCC compile ça
 		typename std::enable_if<(sizeof(T) > sizeof(UInt32)), unsigned int>::type IntegralLog2Pot(T number)
 		{
-			static_assert(sizeof(T) % sizeof(UInt32) == 0, "Assertion failed");
+			static_assert(sizeof(T) == sizeof(UInt64), "Assertion failed");
+
+			UInt64 value = static_cast<typename std::make_unsigned<T>::type>(number);
+
+			#if defined(NAZARA_COMPILER_CLANG) || defined(NAZARA_COMPILER_GCC)
+			return (value != 0) ? __builtin_ctzll(value) : 0;
+			#elif defined(NAZARA_COMPILER_MSVC) && (defined(_M_X64) || defined(_M_ARM64))
+			unsigned long index;
+			return (_BitScanForward64(&index, value)) ? index : 0;
+			#else
+			// Une puissance de deux n'a qu'un bit, dans l'une des deux parties de 32 bits
+			UInt32 low = static_cast<UInt32>(value);
+			if (low)
+				return IntegralLog2Pot<UInt32>(low);
+			else
+				return IntegralLog2Pot<UInt32>(static_cast<UInt32>(value >> 32)) + ((value != 0) ? 32 : 0);
+			#endif
+		}
 
-			// L'algorithme pour le logarithme base 2 (au dessus) ne fonctionne qu'avec des nombres au plus 32bits
-			// ce code décompose les nombres plus grands en nombres 32 bits par masquage et bit shifting
-			for (int i = sizeof(T)-sizeof(UInt32); i >= 0; i -= sizeof(UInt32))
-			{
-				// Le masque 32 bits sur la partie du nombre qu'on traite actuellement
-				T mask = T(std::numeric_limits<UInt32>::max()) << i*8;
-				UInt32 val = UInt32((number & mask) >> i*8); // Masquage et shifting des bits vers la droite (pour le ramener sur 32bits)
-
-				// Appel de la fonction avec le nombre 32bits, si le résultat est non-nul nous avons la réponse
-				unsigned int log2 = IntegralLog2Pot<UInt32>(val);
-				if (log2)
-					return log2 + i*8;
-			}
+		template<typename T>
+		typename std::enable_if<sizeof(T) <= sizeof(UInt32), unsigned int>::type PopCount(T number)
+		{
+			UInt32 value = static_cast<typename std::make_unsigned<T>::type>(number);
 
-			return 0;
+			#if defined(NAZARA_COMPILER_CLANG) || defined(NAZARA_COMPILER_GCC)
+			return __builtin_popcount(value);
+			#else
+			// https://graphics.stanford.edu/~seander/bithacks.html#CountBitsSetParallel
+			value = value - ((value >> 1) & 0x55555555U);
+			value = (value & 0x33333333U) + ((value >> 2) & 0x33333333U);
+
+			return (((value + (value >> 4)) & 0x0F0F0F0FU) * 0x01010101U) >> 24;
+			#endif
+		}
+
+		template<typename T>
+		// Les parenthèses autour de la condition sont nécesaires pour que GCC compile ça
+		typename std::enable_if<(sizeof(T) > sizeof(UInt32)), unsigned int>::type PopCount(T number)
+		{
+			static_assert(sizeof(T) == sizeof(UInt64), "Assertion failed");
+
+			UInt64 value = static_cast<typename std::make_unsigned<T>::type>(number);
+
+			#if defined(NAZARA_COMPILER_CLANG) || defined(NAZARA_COMPILER_GCC)
+			return __builtin_popcountll(value);
+			#else
+			value = value - ((value >> 1) & 0x5555555555555555ULL);
+			value = (value & 0x3333333333333333ULL) + ((value >> 2) & 0x3333333333333333ULL);
+
+			return static_cast<unsigned int>((((value + (value >> 4)) & 0x0F0F0F0F0F0F0F0FULL) * 0x0101010101010101ULL) >> 56);
+			#endif
 		}
 	}
 
@@ -145,15 +213,7 @@ namespace Nz
 	//TODO: Mark as constexpr when supported by all major compilers
 	/*constexpr*/ inline T CountBits(T value)
 	{
-		// https://graphics.stanford.edu/~seander/bithacks.html#CountBitsSetKernighan
-		unsigned int count = 0;
-		while (value)
-		{
-			value &= value - 1;
-			count++;
-		}
-
-		return count;
+		return static_cast<T>(Detail::PopCount<T>(value));
 	}
 
 	/*!
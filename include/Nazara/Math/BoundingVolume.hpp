@@ -11,6 +11,7 @@
 #include <Nazara/Math/Matrix4.hpp>
 #include <Nazara/Math/OrientedBox.hpp>
 #include <Nazara/Math/Vector3.hpp>
+#include <cstddef>
 
 namespace Nz
 {
@@ -58,6 +59,7 @@ namespace Nz
 			static BoundingVolume Infinite();
 			static BoundingVolume Lerp(const BoundingVolume& from, const BoundingVolume& to, T interpolation);
 			static BoundingVolume Null();
+			static void Update(BoundingVolume* volumes, const Matrix4<T>* transformMatrices, std::size_t count);
 
 			Extend extend;
 			Box<T> aabb;
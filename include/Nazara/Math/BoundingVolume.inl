@@ -6,6 +6,7 @@
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Math/Algorithm.hpp>
 #include <algorithm>
+#include <cmath>
 #include <cstring>
 #include <Nazara/Core/Debug.hpp>
 
@@ -544,6 +545,41 @@ namespace Nz
 
 		return volume;
 	}
+
+	/*!
+	* \brief Updates the obb and the aabb of an array of bounding volumes
+	*
+	* \param volumes Bounding volumes to update
+	* \param transformMatrices Matrix4 to apply to each bounding volume
+	* \param count Number of bounding volumes
+	*
+	* \remark Only finite volumes are updated
+	* \remark The aabb is computed from the center and the extents of the local box instead of the eight corners of the obb
+	*/
+
+	template<typename T>
+	void BoundingVolume<T>::Update(BoundingVolume* volumes, const Matrix4<T>* transformMatrices, std::size_t count)
+	{
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			BoundingVolume& volume = volumes[i];
+			if (volume.extend != Extend_Finite)
+				continue;
+
+			const Matrix4<T>& matrix = transformMatrices[i];
+			volume.obb.Update(matrix);
+
+			// The extents of the transformed box are the extents of the local box transformed by the absolute value of the matrix
+			Vector3<T> center = matrix.Transform(volume.obb.localBox.GetCenter());
+			Vector3<T> halfLengths = volume.obb.localBox.GetLengths() / F(2.0);
+
+			Vector3<T> extents(std::abs(matrix.m11) * halfLengths.x + std::abs(matrix.m21) * halfLengths.y + std::abs(matrix.m31) * halfLengths.z,
+			                   std::abs(matrix.m12) * halfLengths.x + std::abs(matrix.m22) * halfLengths.y + std::abs(matrix.m32) * halfLengths.z,
+			                   std::abs(matrix.m13) * halfLengths.x + std::abs(matrix.m23) * halfLengths.y + std::abs(matrix.m33) * halfLengths.z);
+
+			volume.aabb.Set(center - extents, center + extents);
+		}
+	}
 }
 
 /*!
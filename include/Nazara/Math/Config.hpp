@@ -39,4 +39,7 @@
 // Enable tests of security based on the code (Advised for the developpement)
 #define NAZARA_MATH_SAFE 1
 
+// Use SSE (and AVX) instructions for the float specializations of Matrix4 and Quaternion, when the compiler targets them
+#define NAZARA_MATH_SIMD 1
+
 #endif // NAZARA_CONFIG_MATH_HPP
@@ -7,6 +7,7 @@
 #ifndef NAZARA_FRUSTUM_HPP
 #define NAZARA_FRUSTUM_HPP
 
+#include <Nazara/Core/Bitset.hpp>
 #include <Nazara/Core/String.hpp>
 #include <Nazara/Math/BoundingVolume.hpp>
 #include <Nazara/Math/Enums.hpp>
@@ -15,6 +16,7 @@
 #include <Nazara/Math/Plane.hpp>
 #include <Nazara/Math/Sphere.hpp>
 #include <Nazara/Math/Vector3.hpp>
+#include <cstddef>
 
 namespace Nz
 {
@@ -36,6 +38,9 @@ namespace Nz
 			bool Contains(const Vector3<T>& point) const;
 			bool Contains(const Vector3<T>* points, unsigned int pointCount) const;
 
+			void CullBoxes(const T* minX, const T* minY, const T* minZ, const T* maxX, const T* maxY, const T* maxZ, std::size_t count, Bitset<>* visibility) const;
+			void CullSpheres(const T* centerX, const T* centerY, const T* centerZ, const T* radii, std::size_t count, Bitset<>* visibility) const;
+
 			Frustum& Extract(const Matrix4<T>& clipMatrix);
 			Frustum& Extract(const Matrix4<T>& view, const Matrix4<T>& projection);
 
@@ -8,6 +8,7 @@
 
 #include <Nazara/Core/StringStream.hpp>
 #include <Nazara/Math/Algorithm.hpp>
+#include <Nazara/Math/Simd.hpp>
 #include <cstring>
 #include <Nazara/Core/Debug.hpp>
 
@@ -239,6 +240,100 @@ namespace Nz
 		return true;
 	}
 
+	/*!
+	* \brief Tests an array of axis-aligned boxes against the frustum
+	*
+	* \param minX Array of the minimum X coordinate of the boxes
+	* \param minY Array of the minimum Y coordinate of the boxes
+	* \param minZ Array of the minimum Z coordinate of the boxes
+	* \param maxX Array of the maximum X coordinate of the boxes
+	* \param maxY Array of the maximum Y coordinate of the boxes
+	* \param maxZ Array of the maximum Z coordinate of the boxes
+	* \param count Number of boxes
+	* \param visibility Bitset receiving the result, resized to count bits: a bit is set if the box is (at least partially) inside the frustum
+	*
+	* \remark The result of a box is the one of Contains(const Box<T>&)
+	* \remark The plane which rejected the last box is tested first, as neighbour boxes are likely to be rejected by the same one
+	*
+	* \see CullSpheres
+	*/
+
+	template<typename T>
+	void Frustum<T>::CullBoxes(const T* minX, const T* minY, const T* minZ, const T* maxX, const T* maxY, const T* maxZ, std::size_t count, Bitset<>* visibility) const
+	{
+		NazaraAssert(visibility, "Invalid visibility bitset");
+
+		visibility->Resize(static_cast<unsigned int>(count));
+
+		unsigned int firstPlane = 0;
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			bool visible = true;
+			for (unsigned int j = 0; j <= FrustumPlane_Max; ++j)
+			{
+				unsigned int plane = (firstPlane + j) % (FrustumPlane_Max + 1);
+				const Vector3<T>& normal = m_planes[plane].normal;
+
+				Vector3<T> positiveVertex((normal.x >= F(0.0)) ? maxX[i] : minX[i],
+				                          (normal.y >= F(0.0)) ? maxY[i] : minY[i],
+				                          (normal.z >= F(0.0)) ? maxZ[i] : minZ[i]);
+
+				if (m_planes[plane].Distance(positiveVertex) < F(0.0))
+				{
+					firstPlane = plane;
+					visible = false;
+					break;
+				}
+			}
+
+			visibility->Set(static_cast<unsigned int>(i), visible);
+		}
+	}
+
+	/*!
+	* \brief Tests an array of spheres against the frustum
+	*
+	* \param centerX Array of the X coordinate of the center of the spheres
+	* \param centerY Array of the Y coordinate of the center of the spheres
+	* \param centerZ Array of the Z coordinate of the center of the spheres
+	* \param radii Array of the radius of the spheres
+	* \param count Number of spheres
+	* \param visibility Bitset receiving the result, resized to count bits: a bit is set if the sphere is (at least partially) inside the frustum
+	*
+	* \remark The result of a sphere is the one of Contains(const Sphere<T>&)
+	* \remark The plane which rejected the last sphere is tested first, as neighbour spheres are likely to be rejected by the same one
+	*
+	* \see CullBoxes
+	*/
+
+	template<typename T>
+	void Frustum<T>::CullSpheres(const T* centerX, const T* centerY, const T* centerZ, const T* radii, std::size_t count, Bitset<>* visibility) const
+	{
+		NazaraAssert(visibility, "Invalid visibility bitset");
+
+		visibility->Resize(static_cast<unsigned int>(count));
+
+		unsigned int firstPlane = 0;
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			Vector3<T> center(centerX[i], centerY[i], centerZ[i]);
+
+			bool visible = true;
+			for (unsigned int j = 0; j <= FrustumPlane_Max; ++j)
+			{
+				unsigned int plane = (firstPlane + j) % (FrustumPlane_Max + 1);
+				if (m_planes[plane].Distance(center) < -radii[i])
+				{
+					firstPlane = plane;
+					visible = false;
+					break;
+				}
+			}
+
+			visibility->Set(static_cast<unsigned int>(i), visible);
+		}
+	}
+
 	/*!
 	* \brief Constructs the frustum from a Matrix4
 	* \return A reference to this frustum which is the build up of projective matrix
@@ -648,10 +743,10 @@ namespace Nz
 	Frustum<T>& Frustum<T>::Set(const Frustum<U>& frustum)
 	{
 		for (unsigned int i = 0; i <= BoxCorner_Max; ++i)
-			m_corners[i].Set(frustum.m_corners[i]);
+			m_corners[i].Set(frustum.GetCorner(static_cast<BoxCorner>(i)));
 
 		for (unsigned int i = 0; i <= FrustumPlane_Max; ++i)
-			m_planes[i].Set(frustum.m_planes[i]);
+			m_planes[i].Set(frustum.GetPlane(static_cast<FrustumPlane>(i)));
 
 		return *this;
 	}
@@ -673,6 +768,174 @@ namespace Nz
 		       << "        Right: " << m_planes[FrustumPlane_Right].ToString() << "\n"
 		       << "        Top: " << m_planes[FrustumPlane_Top].ToString() << ")\n";
 	}
+
+	#ifdef NAZARA_MATH_SSE
+	// Float specializations, testing a group of Width volumes per plane (4 with SSE, 8 with AVX)
+
+	namespace Detail
+	{
+		template<typename Simd>
+		struct FrustumPlanes
+		{
+			FrustumPlanes(const Plane<float>* planes)
+			{
+				for (unsigned int i = 0; i <= FrustumPlane_Max; ++i)
+				{
+					distance[i] = Simd::Set(planes[i].distance);
+					normalX[i] = Simd::Set(planes[i].normal.x);
+					normalY[i] = Simd::Set(planes[i].normal.y);
+					normalZ[i] = Simd::Set(planes[i].normal.z);
+
+					// Index of the bounds (min: 0 to 2, max: 3 to 5) giving the positive vertex of a box
+					positiveX[i] = (planes[i].normal.x >= 0.f) ? 3 : 0;
+					positiveY[i] = (planes[i].normal.y >= 0.f) ? 4 : 1;
+					positiveZ[i] = (planes[i].normal.z >= 0.f) ? 5 : 2;
+				}
+			}
+
+			typename Simd::Register distance[FrustumPlane_Max + 1];
+			typename Simd::Register normalX[FrustumPlane_Max + 1];
+			typename Simd::Register normalY[FrustumPlane_Max + 1];
+			typename Simd::Register normalZ[FrustumPlane_Max + 1];
+			unsigned int positiveX[FrustumPlane_Max + 1];
+			unsigned int positiveY[FrustumPlane_Max + 1];
+			unsigned int positiveZ[FrustumPlane_Max + 1];
+		};
+
+		template<typename Simd>
+		typename Simd::Register PlaneDistance(const FrustumPlanes<Simd>& planes, unsigned int plane, typename Simd::Register x, typename Simd::Register y, typename Simd::Register z)
+		{
+			typename Simd::Register distance = Simd::Add(Simd::Mul(planes.normalX[plane], x), Simd::Mul(planes.normalY[plane], y));
+			return Simd::Sub(Simd::Add(distance, Simd::Mul(planes.normalZ[plane], z)), planes.distance[plane]);
+		}
+
+		// Returns the visibility mask of Simd::Width boxes, stops as soon as all of them are rejected
+		template<typename Simd>
+		int CullBoxGroup(const FrustumPlanes<Simd>& planes, const float* const* bounds, std::size_t index, unsigned int& firstPlane)
+		{
+			typename Simd::Register visible = Simd::True();
+			for (unsigned int i = 0; i <= FrustumPlane_Max; ++i)
+			{
+				unsigned int plane = firstPlane + i;
+				if (plane > FrustumPlane_Max)
+					plane -= FrustumPlane_Max + 1;
+
+				typename Simd::Register x = Simd::Load(&bounds[planes.positiveX[plane]][index]);
+				typename Simd::Register y = Simd::Load(&bounds[planes.positiveY[plane]][index]);
+				typename Simd::Register z = Simd::Load(&bounds[planes.positiveZ[plane]][index]);
+
+				visible = Simd::And(visible, Simd::CompareGreaterEqual(PlaneDistance(planes, plane, x, y, z), Simd::Set(0.f)));
+				if (Simd::MoveMask(visible) == 0)
+				{
+					firstPlane = plane;
+					return 0;
+				}
+			}
+
+			return Simd::MoveMask(visible);
+		}
+
+		// Returns the visibility mask of Simd::Width spheres, stops as soon as all of them are rejected
+		template<typename Simd>
+		int CullSphereGroup(const FrustumPlanes<Simd>& planes, const float* centerX, const float* centerY, const float* centerZ, const float* radii, unsigned int& firstPlane)
+		{
+			typename Simd::Register x = Simd::Load(centerX);
+			typename Simd::Register y = Simd::Load(centerY);
+			typename Simd::Register z = Simd::Load(centerZ);
+			typename Simd::Register negRadius = Simd::Sub(Simd::Set(0.f), Simd::Load(radii));
+
+			typename Simd::Register visible = Simd::True();
+			for (unsigned int i = 0; i <= FrustumPlane_Max; ++i)
+			{
+				unsigned int plane = firstPlane + i;
+				if (plane > FrustumPlane_Max)
+					plane -= FrustumPlane_Max + 1;
+
+				visible = Simd::And(visible, Simd::CompareGreaterEqual(PlaneDistance(planes, plane, x, y, z), negRadius));
+				if (Simd::MoveMask(visible) == 0)
+				{
+					firstPlane = plane;
+					return 0;
+				}
+			}
+
+			return Simd::MoveMask(visible);
+		}
+
+		#ifdef NAZARA_MATH_AVX
+		using FrustumSimd = SimdFloat8;
+		#else
+		using FrustumSimd = SimdFloat4;
+		#endif
+	}
+
+	template<>
+	inline void Frustum<float>::CullBoxes(const float* minX, const float* minY, const float* minZ, const float* maxX, const float* maxY, const float* maxZ, std::size_t count, Bitset<>* visibility) const
+	{
+		NazaraAssert(visibility, "Invalid visibility bitset");
+
+		using Simd = Detail::FrustumSimd;
+		constexpr unsigned int bitsPerBlock = Bitset<>::bitsPerBlock;
+
+		visibility->Resize(static_cast<unsigned int>(count));
+
+		const float* bounds[6] = {minX, minY, minZ, maxX, maxY, maxZ};
+		Detail::FrustumPlanes<Simd> planes(m_planes);
+
+		// The bitset is filled block by block, a block holding the result of several groups
+		unsigned int firstPlane = 0;
+		for (std::size_t blockStart = 0; blockStart < count; blockStart += bitsPerBlock)
+		{
+			std::size_t blockEnd = (count - blockStart > bitsPerBlock) ? blockStart + bitsPerBlock : count;
+
+			UInt32 block = 0;
+			std::size_t i = blockStart;
+			for (; i + Simd::Width <= blockEnd; i += Simd::Width)
+				block |= static_cast<UInt32>(Detail::CullBoxGroup(planes, bounds, i, firstPlane)) << (i - blockStart);
+
+			for (; i < blockEnd; ++i)
+			{
+				if (Contains(Boxf(Vector3f(minX[i], minY[i], minZ[i]), Vector3f(maxX[i], maxY[i], maxZ[i]))))
+					block |= UInt32(1U) << (i - blockStart);
+			}
+
+			visibility->SetBlock(static_cast<unsigned int>(blockStart / bitsPerBlock), block);
+		}
+	}
+
+	template<>
+	inline void Frustum<float>::CullSpheres(const float* centerX, const float* centerY, const float* centerZ, const float* radii, std::size_t count, Bitset<>* visibility) const
+	{
+		NazaraAssert(visibility, "Invalid visibility bitset");
+
+		using Simd = Detail::FrustumSimd;
+		constexpr unsigned int bitsPerBlock = Bitset<>::bitsPerBlock;
+
+		visibility->Resize(static_cast<unsigned int>(count));
+
+		Detail::FrustumPlanes<Simd> planes(m_planes);
+
+		// The bitset is filled block by block, a block holding the result of several groups
+		unsigned int firstPlane = 0;
+		for (std::size_t blockStart = 0; blockStart < count; blockStart += bitsPerBlock)
+		{
+			std::size_t blockEnd = (count - blockStart > bitsPerBlock) ? blockStart + bitsPerBlock : count;
+
+			UInt32 block = 0;
+			std::size_t i = blockStart;
+			for (; i + Simd::Width <= blockEnd; i += Simd::Width)
+				block |= static_cast<UInt32>(Detail::CullSphereGroup(planes, &centerX[i], &centerY[i], &centerZ[i], &radii[i], firstPlane)) << (i - blockStart);
+
+			for (; i < blockEnd; ++i)
+			{
+				if (Contains(Spheref(centerX[i], centerY[i], centerZ[i], radii[i])))
+					block |= UInt32(1U) << (i - blockStart);
+			}
+
+			visibility->SetBlock(static_cast<unsigned int>(blockStart / bitsPerBlock), block);
+		}
+	}
+	#endif
 }
 
 /*!
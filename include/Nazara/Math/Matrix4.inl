@@ -8,6 +8,7 @@
 #include <Nazara/Math/Config.hpp>
 #include <Nazara/Math/EulerAngles.hpp>
 #include <Nazara/Math/Quaternion.hpp>
+#include <Nazara/Math/Simd.hpp>
 #include <Nazara/Math/Vector2.hpp>
 #include <Nazara/Math/Vector3.hpp>
 #include <Nazara/Math/Vector4.hpp>
@@ -1286,6 +1287,39 @@ namespace Nz
 		                  m14 * vector.x + m24 * vector.y + m34 * vector.z + m44 * vector.w);
 	}
 
+	/*!
+	* \brief Transforms an array of Vector3 and one component by the matrix
+	*
+	* \param vectors Vectors to transform
+	* \param results Transformed vectors, may be the same array as vectors
+	* \param count Number of vectors
+	* \param w W Component of the imaginary Vector4
+	*
+	* \remark The float specialization transforms four vectors at once with SSE
+	*/
+
+	template<typename T>
+	void Matrix4<T>::Transform(const Vector3<T>* vectors, Vector3<T>* results, std::size_t count, T w) const
+	{
+		for (std::size_t i = 0; i < count; ++i)
+			results[i] = Transform(vectors[i], w);
+	}
+
+	/*!
+	* \brief Transforms an array of Vector4 by the matrix
+	*
+	* \param vectors Vectors to transform
+	* \param results Transformed vectors, may be the same array as vectors
+	* \param count Number of vectors
+	*/
+
+	template<typename T>
+	void Matrix4<T>::Transform(const Vector4<T>* vectors, Vector4<T>* results, std::size_t count) const
+	{
+		for (std::size_t i = 0; i < count; ++i)
+			results[i] = Transform(vectors[i]);
+	}
+
 	/*!
 	* \brief Transposes the matrix
 	* \return A reference to this matrix transposed
@@ -1530,6 +1564,24 @@ namespace Nz
 		return matrix;
 	}
 
+	/*!
+	* \brief Concatenates arrays of matrices, two by two
+	*
+	* \param left Left-hand side matrices
+	* \param right Right-hand side matrices
+	* \param results Products of the matrices, may be the same array as left or right
+	* \param count Number of matrices of each array
+	*
+	* \see Concatenate
+	*/
+
+	template<typename T>
+	void Matrix4<T>::Concatenate(const Matrix4* left, const Matrix4* right, Matrix4* results, std::size_t count)
+	{
+		for (std::size_t i = 0; i < count; ++i)
+			results[i] = Concatenate(left[i], right[i]);
+	}
+
 	/*!
 	* \brief Shorthand for the concatenation of two affine matrices
 	* \return A Matrix4 which is the product of two
@@ -1549,6 +1601,24 @@ namespace Nz
 		return matrix;
 	}
 
+	/*!
+	* \brief Concatenates arrays of affine matrices, two by two
+	*
+	* \param left Left-hand side matrices
+	* \param right Right-hand side matrices
+	* \param results Products of the matrices, may be the same array as left or right
+	* \param count Number of matrices of each array
+	*
+	* \see ConcatenateAffine
+	*/
+
+	template<typename T>
+	void Matrix4<T>::ConcatenateAffine(const Matrix4* left, const Matrix4* right, Matrix4* results, std::size_t count)
+	{
+		for (std::size_t i = 0; i < count; ++i)
+			results[i] = ConcatenateAffine(left[i], right[i]);
+	}
+
 	/*!
 	* \brief Shorthand for the identity matrix
 	* \return A Matrix4 which is the identity matrix
@@ -1760,6 +1830,280 @@ namespace Nz
 
 		return matrix;
 	}
+
+	#ifdef NAZARA_MATH_SSE
+	// Float specializations, the rows of a matrix (m11 to m14, ...) are loaded as SSE registers
+
+	namespace Detail
+	{
+		// Row of the product = sum of the rows of the right-hand side matrix, scaled by the components of the left-hand side row
+		inline __m128 ConcatenateRow(const float* row, __m128 right0, __m128 right1, __m128 right2, __m128 right3)
+		{
+			__m128 result = _mm_mul_ps(_mm_set1_ps(row[0]), right0);
+			result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(row[1]), right1));
+			result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(row[2]), right2));
+
+			return _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(row[3]), right3));
+		}
+
+		inline void ConcatenateSSE(const float* left, const float* right, float* result)
+		{
+			#ifdef NAZARA_MATH_AVX
+			// Two rows at once, the rows of the right-hand side matrix are duplicated in both lanes
+			__m256 right0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&right[0]));
+			__m256 right1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&right[4]));
+			__m256 right2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&right[8]));
+			__m256 right3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&right[12]));
+
+			__m256 rows[2];
+			for (unsigned int i = 0; i < 2; ++i)
+			{
+				__m256 leftRows = _mm256_loadu_ps(&left[i * 8]);
+
+				__m256 row = _mm256_mul_ps(_mm256_permute_ps(leftRows, _MM_SHUFFLE(0, 0, 0, 0)), right0);
+				row = _mm256_add_ps(row, _mm256_mul_ps(_mm256_permute_ps(leftRows, _MM_SHUFFLE(1, 1, 1, 1)), right1));
+				row = _mm256_add_ps(row, _mm256_mul_ps(_mm256_permute_ps(leftRows, _MM_SHUFFLE(2, 2, 2, 2)), right2));
+				rows[i] = _mm256_add_ps(row, _mm256_mul_ps(_mm256_permute_ps(leftRows, _MM_SHUFFLE(3, 3, 3, 3)), right3));
+			}
+
+			// Stored last, result may be left or right
+			_mm256_storeu_ps(&result[0], rows[0]);
+			_mm256_storeu_ps(&result[8], rows[1]);
+			#else
+			__m128 right0 = _mm_loadu_ps(&right[0]);
+			__m128 right1 = _mm_loadu_ps(&right[4]);
+			__m128 right2 = _mm_loadu_ps(&right[8]);
+			__m128 right3 = _mm_loadu_ps(&right[12]);
+
+			__m128 row0 = ConcatenateRow(&left[0], right0, right1, right2, right3);
+			__m128 row1 = ConcatenateRow(&left[4], right0, right1, right2, right3);
+			__m128 row2 = ConcatenateRow(&left[8], right0, right1, right2, right3);
+			__m128 row3 = ConcatenateRow(&left[12], right0, right1, right2, right3);
+
+			// Stored last, result may be left or right
+			_mm_storeu_ps(&result[0], row0);
+			_mm_storeu_ps(&result[4], row1);
+			_mm_storeu_ps(&result[8], row2);
+			_mm_storeu_ps(&result[12], row3);
+			#endif
+		}
+
+		inline void ConcatenateAffineSSE(const float* left, const float* right, float* result)
+		{
+			// The last column is forced to (0, 0, 0, 1), as the scalar version does
+			const __m128 mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+			const __m128 unitW = _mm_set_ps(1.f, 0.f, 0.f, 0.f);
+
+			__m128 right0 = _mm_and_ps(_mm_loadu_ps(&right[0]), mask);
+			__m128 right1 = _mm_and_ps(_mm_loadu_ps(&right[4]), mask);
+			__m128 right2 = _mm_and_ps(_mm_loadu_ps(&right[8]), mask);
+			__m128 right3 = _mm_and_ps(_mm_loadu_ps(&right[12]), mask);
+
+			__m128 row0 = ConcatenateRow(&left[0], right0, right1, right2, _mm_setzero_ps());
+			__m128 row1 = ConcatenateRow(&left[4], right0, right1, right2, _mm_setzero_ps());
+			__m128 row2 = ConcatenateRow(&left[8], right0, right1, right2, _mm_setzero_ps());
+			__m128 row3 = _mm_add_ps(ConcatenateRow(&left[12], right0, right1, right2, _mm_setzero_ps()), right3);
+
+			_mm_storeu_ps(&result[0], row0);
+			_mm_storeu_ps(&result[4], row1);
+			_mm_storeu_ps(&result[8], row2);
+			_mm_storeu_ps(&result[12], _mm_or_ps(row3, unitW));
+		}
+
+		inline __m128 CrossProductSSE(__m128 lhs, __m128 rhs)
+		{
+			__m128 lhsYZX = _mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(3, 0, 2, 1));
+			__m128 rhsYZX = _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(3, 0, 2, 1));
+			__m128 result = _mm_sub_ps(_mm_mul_ps(lhs, rhsYZX), _mm_mul_ps(lhsYZX, rhs));
+
+			return _mm_shuffle_ps(result, result, _MM_SHUFFLE(3, 0, 2, 1));
+		}
+	}
+
+	template<>
+	inline Matrix4<float>& Matrix4<float>::Concatenate(const Matrix4& matrix)
+	{
+		#if NAZARA_MATH_MATRIX4_CHECK_AFFINE
+		if (IsAffine() && matrix.IsAffine())
+			return ConcatenateAffine(matrix);
+		#endif
+
+		Detail::ConcatenateSSE(&m11, &matrix.m11, &m11);
+		return *this;
+	}
+
+	template<>
+	inline Matrix4<float>& Matrix4<float>::ConcatenateAffine(const Matrix4& matrix)
+	{
+		#ifdef NAZARA_DEBUG
+		if (!IsAffine())
+		{
+			NazaraWarning("First matrix not affine");
+			return Concatenate(matrix);
+		}
+
+		if (!matrix.IsAffine())
+		{
+			NazaraWarning("Second matrix not affine");
+			return Concatenate(matrix);
+		}
+		#endif
+
+		Detail::ConcatenateAffineSSE(&m11, &matrix.m11, &m11);
+		return *this;
+	}
+
+	template<>
+	inline bool Matrix4<float>::GetInverseAffine(Matrix4* dest) const
+	{
+		#ifdef NAZARA_DEBUG
+		if (!IsAffine())
+		{
+			NazaraWarning("Matrix is not affine");
+			return GetInverse(dest);
+		}
+
+		if (!dest)
+		{
+			NazaraError("Destination matrix must be valid");
+			return false;
+		}
+		#endif
+
+		const __m128 mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+
+		__m128 row0 = _mm_and_ps(_mm_loadu_ps(&m11), mask);
+		__m128 row1 = _mm_and_ps(_mm_loadu_ps(&m21), mask);
+		__m128 row2 = _mm_and_ps(_mm_loadu_ps(&m31), mask);
+
+		// The columns of the inverse of the 3x3 part are the cross products of its rows, divided by its determinant
+		__m128 column0 = Detail::CrossProductSSE(row1, row2);
+		__m128 column1 = Detail::CrossProductSSE(row2, row0);
+		__m128 column2 = Detail::CrossProductSSE(row0, row1);
+
+		float det = m11 * _mm_cvtss_f32(column0) + m12 * _mm_cvtss_f32(_mm_shuffle_ps(column0, column0, _MM_SHUFFLE(1, 1, 1, 1))) + m13 * _mm_cvtss_f32(_mm_shuffle_ps(column0, column0, _MM_SHUFFLE(2, 2, 2, 2)));
+		if (det == 0.f)
+			return false;
+
+		__m128 invDet = _mm_set1_ps(1.f / det);
+		column0 = _mm_mul_ps(column0, invDet);
+		column1 = _mm_mul_ps(column1, invDet);
+		column2 = _mm_mul_ps(column2, invDet);
+
+		__m128 column3 = _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS(column0, column1, column2, column3);
+
+		// Translation of the inverse: -translation * inverse of the 3x3 part
+		__m128 translation = _mm_mul_ps(_mm_set1_ps(m41), column0);
+		translation = _mm_add_ps(translation, _mm_mul_ps(_mm_set1_ps(m42), column1));
+		translation = _mm_add_ps(translation, _mm_mul_ps(_mm_set1_ps(m43), column2));
+		translation = _mm_sub_ps(_mm_set_ps(1.f, 0.f, 0.f, 0.f), translation);
+
+		_mm_storeu_ps(&dest->m11, column0);
+		_mm_storeu_ps(&dest->m21, column1);
+		_mm_storeu_ps(&dest->m31, column2);
+		_mm_storeu_ps(&dest->m41, translation);
+
+		return true;
+	}
+
+	template<>
+	inline Vector4<float> Matrix4<float>::Transform(const Vector4<float>& vector) const
+	{
+		__m128 result = Detail::ConcatenateRow(&vector.x, _mm_loadu_ps(&m11), _mm_loadu_ps(&m21), _mm_loadu_ps(&m31), _mm_loadu_ps(&m41));
+
+		Vector4<float> transformed;
+		_mm_storeu_ps(&transformed.x, result);
+
+		return transformed;
+	}
+
+	template<>
+	inline void Matrix4<float>::Transform(const Vector3<float>* vectors, Vector3<float>* results, std::size_t count, float w) const
+	{
+		static_assert(sizeof(Vector3<float>) == 3 * sizeof(float), "Vector3 must be tightly packed");
+
+		// Four vectors (three registers) at once, as structure of arrays
+		__m128 m11x4 = _mm_set1_ps(m11), m12x4 = _mm_set1_ps(m12), m13x4 = _mm_set1_ps(m13);
+		__m128 m21x4 = _mm_set1_ps(m21), m22x4 = _mm_set1_ps(m22), m23x4 = _mm_set1_ps(m23);
+		__m128 m31x4 = _mm_set1_ps(m31), m32x4 = _mm_set1_ps(m32), m33x4 = _mm_set1_ps(m33);
+		__m128 tx = _mm_set1_ps(m41 * w), ty = _mm_set1_ps(m42 * w), tz = _mm_set1_ps(m43 * w);
+
+		std::size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			const float* input = &vectors[i].x;
+			__m128 a = _mm_loadu_ps(&input[0]); // x0 y0 z0 x1
+			__m128 b = _mm_loadu_ps(&input[4]); // y1 z1 x2 y2
+			__m128 c = _mm_loadu_ps(&input[8]); // z2 x3 y3 z3
+
+			__m128 x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+			__m128 y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+			__m128 z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 3, 0)), _MM_SHUFFLE(1, 0, 2, 0));
+
+			__m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m11x4), _mm_mul_ps(y, m21x4)), _mm_add_ps(_mm_mul_ps(z, m31x4), tx));
+			__m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m12x4), _mm_mul_ps(y, m22x4)), _mm_add_ps(_mm_mul_ps(z, m32x4), ty));
+			__m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m13x4), _mm_mul_ps(y, m23x4)), _mm_add_ps(_mm_mul_ps(z, m33x4), tz));
+
+			__m128 xyLow = _mm_unpacklo_ps(rx, ry);  // rx0 ry0 rx1 ry1
+			__m128 xyHigh = _mm_unpackhi_ps(rx, ry); // rx2 ry2 rx3 ry3
+
+			float* output = &results[i].x;
+			_mm_storeu_ps(&output[0], _mm_shuffle_ps(xyLow, _mm_shuffle_ps(rz, xyLow, _MM_SHUFFLE(2, 2, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0)));
+			_mm_storeu_ps(&output[4], _mm_shuffle_ps(_mm_shuffle_ps(xyLow, rz, _MM_SHUFFLE(1, 1, 3, 3)), xyHigh, _MM_SHUFFLE(1, 0, 2, 0)));
+			_mm_storeu_ps(&output[8], _mm_shuffle_ps(_mm_shuffle_ps(rz, xyHigh, _MM_SHUFFLE(2, 2, 2, 2)), _mm_shuffle_ps(xyHigh, rz, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+		}
+
+		for (; i < count; ++i)
+			results[i] = Transform(vectors[i], w);
+	}
+
+	template<>
+	inline void Matrix4<float>::Transform(const Vector4<float>* vectors, Vector4<float>* results, std::size_t count) const
+	{
+		static_assert(sizeof(Vector4<float>) == 4 * sizeof(float), "Vector4 must be tightly packed");
+
+		#ifdef NAZARA_MATH_AVX
+		// Two vectors at once, the rows are duplicated in both lanes
+		__m256 row0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&m11));
+		__m256 row1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&m21));
+		__m256 row2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&m31));
+		__m256 row3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&m41));
+
+		std::size_t i = 0;
+		for (; i + 2 <= count; i += 2)
+		{
+			__m256 vector = _mm256_loadu_ps(&vectors[i].x);
+
+			__m256 result = _mm256_mul_ps(_mm256_permute_ps(vector, _MM_SHUFFLE(0, 0, 0, 0)), row0);
+			result = _mm256_add_ps(result, _mm256_mul_ps(_mm256_permute_ps(vector, _MM_SHUFFLE(1, 1, 1, 1)), row1));
+			result = _mm256_add_ps(result, _mm256_mul_ps(_mm256_permute_ps(vector, _MM_SHUFFLE(2, 2, 2, 2)), row2));
+			result = _mm256_add_ps(result, _mm256_mul_ps(_mm256_permute_ps(vector, _MM_SHUFFLE(3, 3, 3, 3)), row3));
+
+			_mm256_storeu_ps(&results[i].x, result);
+		}
+		#else
+		std::size_t i = 0;
+		#endif
+
+		for (; i < count; ++i)
+			results[i] = Transform(vectors[i]);
+	}
+
+	template<>
+	inline void Matrix4<float>::Concatenate(const Matrix4* left, const Matrix4* right, Matrix4* results, std::size_t count)
+	{
+		for (std::size_t i = 0; i < count; ++i)
+			Detail::ConcatenateSSE(&left[i].m11, &right[i].m11, &results[i].m11);
+	}
+
+	template<>
+	inline void Matrix4<float>::ConcatenateAffine(const Matrix4* left, const Matrix4* right, Matrix4* results, std::size_t count)
+	{
+		for (std::size_t i = 0; i < count; ++i)
+			Detail::ConcatenateAffineSSE(&left[i].m11, &right[i].m11, &results[i].m11);
+	}
+	#endif
 }
 
 /*!
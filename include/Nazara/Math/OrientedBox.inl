@@ -242,7 +242,9 @@ namespace Nz
 	void OrientedBox<T>::Update(const Matrix4<T>& transformMatrix)
 	{
 		for (unsigned int i = 0; i <= BoxCorner_Max; ++i)
-			m_corners[i] = transformMatrix.Transform(localBox.GetCorner(static_cast<BoxCorner>(i)));
+			m_corners[i] = localBox.GetCorner(static_cast<BoxCorner>(i));
+
+		transformMatrix.Transform(m_corners, m_corners, BoxCorner_Max + 1);
 	}
 
 	/*!
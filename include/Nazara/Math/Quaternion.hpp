@@ -8,6 +8,7 @@
 #define NAZARA_QUATERNION_HPP
 
 #include <Nazara/Core/String.hpp>
+#include <cstddef>
 
 namespace Nz
 {
@@ -78,7 +79,9 @@ namespace Nz
 
 			static Quaternion Identity();
 			static Quaternion Lerp(const Quaternion& from, const Quaternion& to, T interpolation);
+			static void Multiply(const Quaternion* left, const Quaternion* right, Quaternion* results, std::size_t count);
 			static Quaternion Normalize(const Quaternion& quat, T* length = nullptr);
+			static void Normalize(const Quaternion* quaternions, Quaternion* results, std::size_t count);
 			static Quaternion RotationBetween(const Vector3<T>& from, const Vector3<T>& to);
 			static Quaternion Slerp(const Quaternion& from, const Quaternion& to, T interpolation);
 			static Quaternion Zero();
@@ -6,6 +6,7 @@
 #include <Nazara/Math/Algorithm.hpp>
 #include <Nazara/Math/Config.hpp>
 #include <Nazara/Math/EulerAngles.hpp>
+#include <Nazara/Math/Simd.hpp>
 #include <Nazara/Math/Vector3.hpp>
 #include <cstring>
 #include <limits>
@@ -720,6 +721,22 @@ namespace Nz
 		return interpolated;
 	}
 
+	/*!
+	* \brief Multiplies arrays of quaternions, two by two
+	*
+	* \param left Left-hand side quaternions
+	* \param right Right-hand side quaternions
+	* \param results Products of the quaternions, may be the same array as left or right
+	* \param count Number of quaternions of each array
+	*/
+
+	template<typename T>
+	void Quaternion<T>::Multiply(const Quaternion* left, const Quaternion* right, Quaternion* results, std::size_t count)
+	{
+		for (std::size_t i = 0; i < count; ++i)
+			results[i] = left[i] * right[i];
+	}
+
 	/*!
 	* \brief Gives the normalized quaternion
 	* \return A normalized quaternion from the quat
@@ -736,6 +753,25 @@ namespace Nz
 		return quat.GetNormal(length);
 	}
 
+	/*!
+	* \brief Normalizes an array of quaternions
+	*
+	* \param quaternions Quaternions to normalize
+	* \param results Normalized quaternions, may be the same array as quaternions
+	* \param count Number of quaternions
+	*
+	* \remark Null quaternions are left untouched
+	*
+	* \see Normalize
+	*/
+
+	template<typename T>
+	void Quaternion<T>::Normalize(const Quaternion* quaternions, Quaternion* results, std::size_t count)
+	{
+		for (std::size_t i = 0; i < count; ++i)
+			results[i] = quaternions[i].GetNormal();
+	}
+
 	/*!
 	* \brief Gets the rotation required to rotate direction Vector3 from to direction Vector3 to
 	* \return A quaternion which is the rotation needed between those two Vector3
@@ -830,6 +866,82 @@ namespace Nz
 
 		return quaternion;
 	}
+
+	#ifdef NAZARA_MATH_SSE
+	// Float specializations, four quaternions at once as structure of arrays (a register per component)
+
+	template<>
+	inline void Quaternion<float>::Multiply(const Quaternion* left, const Quaternion* right, Quaternion* results, std::size_t count)
+	{
+		static_assert(sizeof(Quaternion<float>) == 4 * sizeof(float), "Quaternion must be tightly packed");
+
+		std::size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 lw = _mm_loadu_ps(&left[i].w);
+			__m128 lx = _mm_loadu_ps(&left[i + 1].w);
+			__m128 ly = _mm_loadu_ps(&left[i + 2].w);
+			__m128 lz = _mm_loadu_ps(&left[i + 3].w);
+			_MM_TRANSPOSE4_PS(lw, lx, ly, lz);
+
+			__m128 rw = _mm_loadu_ps(&right[i].w);
+			__m128 rx = _mm_loadu_ps(&right[i + 1].w);
+			__m128 ry = _mm_loadu_ps(&right[i + 2].w);
+			__m128 rz = _mm_loadu_ps(&right[i + 3].w);
+			_MM_TRANSPOSE4_PS(rw, rx, ry, rz);
+
+			__m128 w = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(lw, rw), _mm_mul_ps(lx, rx)), _mm_add_ps(_mm_mul_ps(ly, ry), _mm_mul_ps(lz, rz)));
+			__m128 x = _mm_add_ps(_mm_add_ps(_mm_mul_ps(lw, rx), _mm_mul_ps(lx, rw)), _mm_sub_ps(_mm_mul_ps(ly, rz), _mm_mul_ps(lz, ry)));
+			__m128 y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(lw, ry), _mm_mul_ps(ly, rw)), _mm_sub_ps(_mm_mul_ps(lz, rx), _mm_mul_ps(lx, rz)));
+			__m128 z = _mm_add_ps(_mm_add_ps(_mm_mul_ps(lw, rz), _mm_mul_ps(lz, rw)), _mm_sub_ps(_mm_mul_ps(lx, ry), _mm_mul_ps(ly, rx)));
+			_MM_TRANSPOSE4_PS(w, x, y, z);
+
+			_mm_storeu_ps(&results[i].w, w);
+			_mm_storeu_ps(&results[i + 1].w, x);
+			_mm_storeu_ps(&results[i + 2].w, y);
+			_mm_storeu_ps(&results[i + 3].w, z);
+		}
+
+		for (; i < count; ++i)
+			results[i] = left[i] * right[i];
+	}
+
+	template<>
+	inline void Quaternion<float>::Normalize(const Quaternion* quaternions, Quaternion* results, std::size_t count)
+	{
+		static_assert(sizeof(Quaternion<float>) == 4 * sizeof(float), "Quaternion must be tightly packed");
+
+		std::size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 w = _mm_loadu_ps(&quaternions[i].w);
+			__m128 x = _mm_loadu_ps(&quaternions[i + 1].w);
+			__m128 y = _mm_loadu_ps(&quaternions[i + 2].w);
+			__m128 z = _mm_loadu_ps(&quaternions[i + 3].w);
+			_MM_TRANSPOSE4_PS(w, x, y, z);
+
+			__m128 norm = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(w, w), _mm_mul_ps(x, x)), _mm_add_ps(_mm_mul_ps(y, y), _mm_mul_ps(z, z))));
+
+			// As the scalar version, null quaternions are kept as is (the division by zero is discarded by the mask)
+			__m128 valid = _mm_cmpgt_ps(norm, _mm_setzero_ps());
+			__m128 invNorm = _mm_or_ps(_mm_and_ps(valid, _mm_div_ps(_mm_set1_ps(1.f), norm)), _mm_andnot_ps(valid, _mm_set1_ps(1.f)));
+
+			w = _mm_mul_ps(w, invNorm);
+			x = _mm_mul_ps(x, invNorm);
+			y = _mm_mul_ps(y, invNorm);
+			z = _mm_mul_ps(z, invNorm);
+			_MM_TRANSPOSE4_PS(w, x, y, z);
+
+			_mm_storeu_ps(&results[i].w, w);
+			_mm_storeu_ps(&results[i + 1].w, x);
+			_mm_storeu_ps(&results[i + 2].w, y);
+			_mm_storeu_ps(&results[i + 3].w, z);
+		}
+
+		for (; i < count; ++i)
+			results[i] = quaternions[i].GetNormal();
+	}
+	#endif
 }
 
 /*!
@@ -0,0 +1,72 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Mathematics module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_MATH_SIMD_HPP
+#define NAZARA_MATH_SIMD_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Math/Config.hpp>
+
+// The mathematics module is made of templates only, the instruction sets are therefore chosen at compile-time
+// (HardwareInfo can not be used to select them at runtime)
+#if NAZARA_MATH_SIMD
+	#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define NAZARA_MATH_SSE
+		#include <emmintrin.h>
+	#endif
+
+	#if defined(NAZARA_MATH_SSE) && defined(__AVX__)
+		#define NAZARA_MATH_AVX
+		#include <immintrin.h>
+	#endif
+#endif
+
+namespace Nz
+{
+	namespace Detail
+	{
+		// Thin wrappers allowing to write an algorithm once for every register width
+		#ifdef NAZARA_MATH_SSE
+		struct SimdFloat4
+		{
+			using Register = __m128;
+
+			static constexpr unsigned int Width = 4;
+
+			static Register Add(Register a, Register b) { return _mm_add_ps(a, b); }
+			static Register And(Register a, Register b) { return _mm_and_ps(a, b); }
+			static Register CompareGreaterEqual(Register a, Register b) { return _mm_cmpge_ps(a, b); }
+			static Register Load(const float* ptr) { return _mm_loadu_ps(ptr); }
+			static int MoveMask(Register a) { return _mm_movemask_ps(a); }
+			static Register Mul(Register a, Register b) { return _mm_mul_ps(a, b); }
+			static Register Set(float value) { return _mm_set1_ps(value); }
+			static Register Sub(Register a, Register b) { return _mm_sub_ps(a, b); }
+			static Register True() { return _mm_castsi128_ps(_mm_set1_epi32(-1)); }
+		};
+		#endif
+
+		#ifdef NAZARA_MATH_AVX
+		struct SimdFloat8
+		{
+			using Register = __m256;
+
+			static constexpr unsigned int Width = 8;
+
+			static Register Add(Register a, Register b) { return _mm256_add_ps(a, b); }
+			static Register And(Register a, Register b) { return _mm256_and_ps(a, b); }
+			static Register CompareGreaterEqual(Register a, Register b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+			static Register Load(const float* ptr) { return _mm256_loadu_ps(ptr); }
+			static int MoveMask(Register a) { return _mm256_movemask_ps(a); }
+			static Register Mul(Register a, Register b) { return _mm256_mul_ps(a, b); }
+			static Register Set(float value) { return _mm256_set1_ps(value); }
+			static Register Sub(Register a, Register b) { return _mm256_sub_ps(a, b); }
+			static Register True() { return _mm256_castsi256_ps(_mm256_set1_epi32(-1)); }
+		};
+		#endif
+	}
+}
+
+#endif // NAZARA_MATH_SIMD_HPP
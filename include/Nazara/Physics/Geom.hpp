@@ -8,27 +8,28 @@
 #define NAZARA_GEOM_HPP
 
 #include <Nazara/Prerequesites.hpp>
+#include <Nazara/Core/ByteArray.hpp>
 #include <Nazara/Core/PrimitiveList.hpp>
 #include <Nazara/Core/ObjectLibrary.hpp>
 #include <Nazara/Core/ObjectRef.hpp>
 #include <Nazara/Core/RefCounted.hpp>
 #include <Nazara/Core/Signal.hpp>
+#include <Nazara/Core/Stream.hpp>
 #include <Nazara/Math/Box.hpp>
 #include <Nazara/Math/Quaternion.hpp>
 #include <Nazara/Math/Vector3.hpp>
 #include <Nazara/Physics/Config.hpp>
 #include <Nazara/Physics/Enums.hpp>
 #include <unordered_map>
+#include <vector>
 
 struct NewtonCollision;
 
 namespace Nz
 {
 	///TODO: CollisionModifier
-	///TODO: HeightfieldGeom
 	///TODO: PlaneGeom ?
 	///TODO: SceneGeom
-	///TODO: TreeGeom
 
 	class PhysGeom;
 	class PhysWorld;
@@ -221,6 +222,40 @@ namespace Nz
 			float m_radius;
 	};
 
+	class HeightfieldGeom;
+
+	using HeightfieldGeomConstRef = ObjectRef<const HeightfieldGeom>;
+	using HeightfieldGeomRef = ObjectRef<HeightfieldGeom>;
+
+	class NAZARA_PHYSICS_API HeightfieldGeom : public PhysGeom
+	{
+		public:
+			HeightfieldGeom(unsigned int width, unsigned int height, const float* heights, float horizontalScale, const Matrix4f& transformMatrix = Matrix4f::Identity());
+			HeightfieldGeom(unsigned int width, unsigned int height, const float* heights, float horizontalScale, const Vector3f& translation, const Quaternionf& rotation = Quaternionf::Identity());
+
+			void ComputeInertialMatrix(Vector3f* inertia, Vector3f* center) const override;
+			float ComputeVolume() const override;
+
+			GeomType GetType() const override;
+
+			bool SaveToStream(Stream& stream) const;
+
+			static HeightfieldGeomRef LoadFromStream(Stream& stream);
+			template<typename... Args> static HeightfieldGeomRef New(Args&&... args);
+
+		private:
+			HeightfieldGeom(ByteArray bakedShape, const Matrix4f& transformMatrix);
+
+			NewtonCollision* CreateHandle(PhysWorld* world) const override;
+
+			mutable ByteArray m_bakedShape; //< Newton serialization of the shape, filled by the first build
+			mutable std::vector<float> m_heights;
+			Matrix4f m_matrix;
+			float m_horizontalScale;
+			unsigned int m_height;
+			unsigned int m_width;
+	};
+
 	class NullGeom;
 
 	using NullGeomConstRef = ObjectRef<const NullGeom>;
@@ -266,6 +301,39 @@ namespace Nz
 			Vector3f m_position;
 			float m_radius;
 	};
+
+	class TriangleMeshGeom;
+
+	using TriangleMeshGeomConstRef = ObjectRef<const TriangleMeshGeom>;
+	using TriangleMeshGeomRef = ObjectRef<TriangleMeshGeom>;
+
+	// Static geometry only (levels, props), built as a Newton tree collision
+	class NAZARA_PHYSICS_API TriangleMeshGeom : public PhysGeom
+	{
+		public:
+			TriangleMeshGeom(const void* vertices, unsigned int vertexCount, unsigned int stride, const UInt32* indices, unsigned int indexCount, bool optimize = true, const Matrix4f& transformMatrix = Matrix4f::Identity());
+			TriangleMeshGeom(const void* vertices, unsigned int vertexCount, unsigned int stride, const UInt32* indices, unsigned int indexCount, bool optimize, const Vector3f& translation, const Quaternionf& rotation = Quaternionf::Identity());
+
+			void ComputeInertialMatrix(Vector3f* inertia, Vector3f* center) const override;
+			float ComputeVolume() const override;
+
+			GeomType GetType() const override;
+
+			bool SaveToStream(Stream& stream) const;
+
+			static TriangleMeshGeomRef LoadFromStream(Stream& stream);
+			template<typename... Args> static TriangleMeshGeomRef New(Args&&... args);
+
+		private:
+			TriangleMeshGeom(ByteArray bakedShape);
+
+			NewtonCollision* CreateHandle(PhysWorld* world) const override;
+
+			mutable ByteArray m_bakedShape; //< Newton serialization of the tree, filled by the first build
+			mutable std::vector<UInt32> m_indices;
+			mutable std::vector<Vector3f> m_vertices; //< Already transformed
+			bool m_optimize;
+	};
 }
 
 #include <Nazara/Physics/Geom.inl>
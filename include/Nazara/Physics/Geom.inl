@@ -61,6 +61,15 @@ namespace Nz
 		return object.release();
 	}
 
+	template<typename... Args>
+	HeightfieldGeomRef HeightfieldGeom::New(Args&&... args)
+	{
+		std::unique_ptr<HeightfieldGeom> object(new HeightfieldGeom(std::forward<Args>(args)...));
+		object->SetPersistent(false);
+
+		return object.release();
+	}
+
 	template<typename... Args>
 	NullGeomRef NullGeom::New(Args&&... args)
 	{
@@ -78,6 +87,15 @@ namespace Nz
 
 		return object.release();
 	}
+
+	template<typename... Args>
+	TriangleMeshGeomRef TriangleMeshGeom::New(Args&&... args)
+	{
+		std::unique_ptr<TriangleMeshGeom> object(new TriangleMeshGeom(std::forward<Args>(args)...));
+		object->SetPersistent(false);
+
+		return object.release();
+	}
 }
 
 #include <Nazara/Physics/DebugOff.hpp>
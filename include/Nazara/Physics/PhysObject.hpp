@@ -41,14 +41,18 @@ namespace Nz
 			const PhysGeomRef& GetGeom() const;
 			float GetGravityFactor() const;
 			NewtonBody* GetHandle() const;
+			Vector3f GetInterpolatedPosition(float interpolation) const;
+			Quaternionf GetInterpolatedRotation(float interpolation) const;
 			float GetMass() const;
 			Vector3f GetMassCenter(CoordSys coordSys = CoordSys_Local) const;
 			const Matrix4f& GetMatrix() const;
 			Vector3f GetPosition() const;
 			Quaternionf GetRotation() const;
+			void* GetUserdata() const;
 			Vector3f GetVelocity() const;
 
 			bool IsAutoSleepEnabled() const;
+			bool IsInterpolated() const;
 			bool IsMoveable() const;
 			bool IsSleeping() const;
 
@@ -59,22 +63,32 @@ namespace Nz
 			void SetMassCenter(const Vector3f& center);
 			void SetPosition(const Vector3f& position);
 			void SetRotation(const Quaternionf& rotation);
+			void SetUserdata(void* userdata);
 			void SetVelocity(const Vector3f& velocity);
 
 			PhysObject& operator=(const PhysObject& object);
 			PhysObject& operator=(PhysObject&& object);
 
 		private:
+			friend PhysWorld;
+
+			void NotifyMoved(int threadIndex);
 			void UpdateBody();
 			static void ForceAndTorqueCallback(const NewtonBody* body, float timeStep, int threadIndex);
 			static void TransformCallback(const NewtonBody* body, const float* matrix, int threadIndex);
 
 			Matrix4f m_matrix;
+			Matrix4f m_previousMatrix; //< Before the last step which moved the object
 			PhysGeomRef m_geom;
 			Vector3f m_forceAccumulator;
 			Vector3f m_torqueAccumulator;
 			NewtonBody* m_body;
 			PhysWorld* m_world;
+			UInt64 m_transformStep; //< World step which moved the object last
+			void* m_userdata;
+			std::size_t m_movedIndex; //< Position in the moved object list of the world, if m_moved
+			int m_movedThreadIndex; //< List of the thread which moved the object, or -1 for the moved objects of the world
+			bool m_moved; //< Part of the moved objects of the world
 			float m_gravityFactor;
 			float m_mass;
 	};
@@ -9,37 +9,91 @@
 
 #include <Nazara/Prerequesites.hpp>
 #include <Nazara/Math/Box.hpp>
+#include <Nazara/Math/Quaternion.hpp>
+#include <Nazara/Math/Sphere.hpp>
 #include <Nazara/Math/Vector3.hpp>
 #include <Nazara/Physics/Config.hpp>
+#include <Nazara/Physics/Geom.hpp>
+#include <vector>
 
 struct NewtonWorld;
 
 namespace Nz
 {
+	class PhysObject;
+
 	class NAZARA_PHYSICS_API PhysWorld
 	{
+		friend PhysObject;
+
 		public:
+			struct QueryHit
+			{
+				PhysObject* object = nullptr; //< Null if nothing was hit
+				Vector3f normal;
+				Vector3f position;
+				float fraction; //< Position of the hit between the start (0) and the end (1) of the query
+			};
+
+			struct RaycastQuery
+			{
+				Vector3f from;
+				Vector3f to;
+			};
+
+			struct SweepQuery
+			{
+				PhysGeomRef geom;
+				Quaternionf rotation;
+				Vector3f from;
+				Vector3f to;
+			};
+
 			PhysWorld();
 			PhysWorld(const PhysWorld&) = delete;
 			PhysWorld(PhysWorld&&) = delete; ///TODO
 			~PhysWorld();
 
+			void ClearMovedObjects();
+
 			Vector3f GetGravity() const;
 			NewtonWorld* GetHandle() const;
+			float GetInterpolationFactor() const;
+			unsigned int GetMaxThreadCount() const;
+			const std::vector<PhysObject*>& GetMovedObjects() const; //< Objects whose transform changed since the last ClearMovedObjects, in no particular order (sleeping ones never appear)
 			float GetStepSize() const;
+			unsigned int GetThreadCount() const;
+
+			void Overlap(const Boxf& box, std::vector<PhysObject*>* objects);
+			void Overlap(const Boxf* boxes, std::size_t boxCount, std::vector<PhysObject*>* objects);
+			void Overlap(const Spheref& sphere, std::vector<PhysObject*>* objects);
+			void Overlap(const Spheref* spheres, std::size_t sphereCount, std::vector<PhysObject*>* objects);
+
+			bool Raycast(const Vector3f& from, const Vector3f& to, QueryHit* hit = nullptr);
+			void Raycast(const RaycastQuery* queries, std::size_t queryCount, QueryHit* hits);
 
 			void SetGravity(const Vector3f& gravity);
 			void SetSolverModel(unsigned int model);
 			void SetStepSize(float stepSize);
+			void SetThreadCount(unsigned int threadCount);
 
 			void Step(float timestep);
 
+			bool Sweep(const PhysGeomRef& geom, const Quaternionf& rotation, const Vector3f& from, const Vector3f& to, QueryHit* hit = nullptr);
+			void Sweep(const SweepQuery* queries, std::size_t queryCount, QueryHit* hits);
+
 			PhysWorld& operator=(const PhysWorld&) = delete;
 			PhysWorld& operator=(PhysWorld&&) = delete; ///TODO
 
 		private:
+			void NotifyMoved(PhysObject* object, int threadIndex);
+			void ReplaceMovedObject(PhysObject* object, PhysObject* newObject);
+
+			std::vector<std::vector<PhysObject*>> m_threadMovedObjects; //< Filled by the transform callbacks, one list per solver thread
+			std::vector<PhysObject*> m_movedObjects;
 			Vector3f m_gravity;
 			NewtonWorld* m_world;
+			UInt64 m_stepCount;
 			float m_stepSize;
 			float m_timestepAccumulator;
 	};
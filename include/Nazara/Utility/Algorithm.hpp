@@ -21,7 +21,7 @@ namespace Nz
 {
 	struct SkinningData
 	{
-		const Joint* joints;
+		const Matrix4f* skinningMatrices; // One per joint, see Skeleton::ComputeSkinningMatrices
 		const SkeletalMeshVertex* inputVertex;
 		MeshVertex* outputVertex;
 	};
@@ -51,6 +51,10 @@ namespace Nz
 	NAZARA_UTILITY_API void GenerateUvSphere(float size, unsigned int sliceCount, unsigned int stackCount, const Matrix4f& matrix, const Rectf& textureCoords, VertexPointers vertexPointers, IndexIterator indices, Boxf* aabb = nullptr, unsigned int indexOffset = 0);
 
 	NAZARA_UTILITY_API void OptimizeIndices(IndexIterator indices, unsigned int indexCount);
+	NAZARA_UTILITY_API void OptimizeOverdraw(IndexIterator indices, unsigned int indexCount, SparsePtr<const Vector3f> positionPtr, float threshold = 1.05f);
+	NAZARA_UTILITY_API unsigned int OptimizeVertexFetch(IndexIterator indices, unsigned int indexCount, void* vertices, unsigned int vertexCount, unsigned int vertexStride);
+
+	NAZARA_UTILITY_API unsigned int SimplifyIndices(IndexIterator indices, unsigned int indexCount, unsigned int vertexCount, SparsePtr<const Vector3f> positionPtr, SparsePtr<const Vector3f> normalPtr, SparsePtr<const Vector2f> uvPtr, unsigned int targetIndexCount, float maxError, float* resultError = nullptr);
 
 	NAZARA_UTILITY_API void SkinPosition(const SkinningData& data, unsigned int startVertex, unsigned int vertexCount);
 	NAZARA_UTILITY_API void SkinPositionNormal(const SkinningData& data, unsigned int startVertex, unsigned int vertexCount);
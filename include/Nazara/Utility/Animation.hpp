@@ -16,6 +16,7 @@
 #include <Nazara/Core/ResourceManager.hpp>
 #include <Nazara/Core/Signal.hpp>
 #include <Nazara/Core/String.hpp>
+#include <Nazara/Math/Matrix4.hpp>
 #include <Nazara/Utility/Config.hpp>
 #include <Nazara/Utility/Enums.hpp>
 #include <Nazara/Utility/Sequence.hpp>
@@ -35,6 +36,33 @@ namespace Nz
 
 	class Animation;
 	class Skeleton;
+	class SkeletonPose;
+
+	struct AnimationLayer
+	{
+		const Animation* animation = nullptr;
+		// Optionnel, un poids par joint multipliant celui de la couche (permet de n'animer qu'une partie du squelette)
+		const float* jointWeights = nullptr;
+		AnimationBlendMode blendMode = AnimationBlendMode_Override;
+		float interpolation = 0.f;
+		float weight = 1.f;
+		unsigned int frameA = 0;
+		unsigned int frameB = 0;
+		// La frame de l'animation par rapport à laquelle une couche additive est exprimée
+		unsigned int referenceFrame = 0;
+	};
+
+	struct SkeletonAnimationJob
+	{
+		// Les couches sont appliquées dans l'ordre, à partir de la pose de repos du squelette
+		const AnimationLayer* layers = nullptr;
+		const Skeleton* skeleton = nullptr;
+		// Reçoit une matrice de skinning par joint du squelette
+		Matrix4f* skinningMatrices = nullptr;
+		// Optionnel, reçoit la pose finale
+		SkeletonPose* pose = nullptr;
+		unsigned int layerCount = 0;
+	};
 
 	using AnimationConstRef = ObjectRef<const Animation>;
 	using AnimationLibrary = ObjectLibrary<Animation>;
@@ -57,6 +85,7 @@ namespace Nz
 
 			bool AddSequence(const Sequence& sequence);
 			void AnimateSkeleton(Skeleton* targetSkeleton, unsigned int frameA, unsigned int frameB, float interpolation) const;
+			void AnimateSkeleton(Skeleton* targetSkeleton, unsigned int frameA, unsigned int frameB, float interpolation, const unsigned int* indices, unsigned int indiceCount) const;
 
 			bool CreateSkeletal(unsigned int frameCount, unsigned int jointCount);
 			void Destroy();
@@ -88,6 +117,9 @@ namespace Nz
 			void RemoveSequence(const String& sequenceName);
 			void RemoveSequence(unsigned int index);
 
+			void Sample(SkeletonPose* pose, unsigned int frameA, unsigned int frameB, float interpolation) const;
+
+			static void AnimateSkeletons(const SkeletonAnimationJob* jobs, std::size_t jobCount, bool parallel = true);
 			template<typename... Args> static AnimationRef New(Args&&... args);
 
 			// Signals:
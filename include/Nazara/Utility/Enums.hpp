@@ -9,6 +9,14 @@
 
 namespace Nz
 {
+	enum AnimationBlendMode
+	{
+		AnimationBlendMode_Additive, // The layer is added to the pose, relatively to a reference frame
+		AnimationBlendMode_Override, // The layer is interpolated with the pose
+
+		AnimationBlendMode_Max = AnimationBlendMode_Override
+	};
+
 	enum AnimationType
 	{
 		AnimationType_Skeletal,
@@ -99,6 +107,18 @@ namespace Nz
 		ImageType_Max = ImageType_Cubemap
 	};
 
+	enum MeshOptimizationFlags
+	{
+		MeshOptimization_None = 0x0,
+
+		MeshOptimization_Overdraw    = 0x1, // Sorts clusters of triangles so that the outer ones are drawn first
+		MeshOptimization_VertexCache = 0x2, // Reorders the triangles for the post-transform vertex cache
+		MeshOptimization_VertexFetch = 0x4, // Reorders the vertices in their order of use
+
+		MeshOptimization_All = MeshOptimization_Overdraw | MeshOptimization_VertexCache | MeshOptimization_VertexFetch,
+		MeshOptimization_Max = MeshOptimization_VertexFetch*2-1
+	};
+
 	enum NodeType
 	{
 		NodeType_Default,  // Node
@@ -46,6 +46,10 @@ namespace Nz
 		// Faut-il optimiser les index buffers ? (Rendu plus rapide, mais le chargement dure plus longtemps)
 		bool optimizeIndexBuffers = true;
 
+		// Faut-il réordonner les sommets selon leur utilisation ? (Meilleure localité mémoire lors du rendu)
+		bool optimizeVertexBuffers = true;
+
+		UInt32 GetOptimizationFlags() const;
 		bool IsValid() const;
 	};
 
@@ -84,6 +88,7 @@ namespace Nz
 			bool CreateStatic();
 			void Destroy();
 
+			void GenerateLods(unsigned int lodCount, float reductionFactor = 0.5f, float maxError = 0.05f);
 			void GenerateNormals();
 			void GenerateNormalsAndTangents();
 			void GenerateTangents();
@@ -117,6 +122,8 @@ namespace Nz
 			bool LoadFromMemory(const void* data, std::size_t size, const MeshParams& params = MeshParams());
 			bool LoadFromStream(Stream& stream, const MeshParams& params = MeshParams());
 
+			void Optimize(UInt32 optimizationFlags = MeshOptimization_All, bool parallel = true);
+
 			void Recenter();
 
 			void RemoveSubMesh(const String& identifier);
@@ -19,8 +19,12 @@
 
 namespace Nz
 {
+	class TransformHierarchy;
+
 	class NAZARA_UTILITY_API Node
 	{
+		friend TransformHierarchy;
+
 		public:
 			Node();
 			Node(const Node& node);
@@ -33,6 +37,7 @@ namespace Nz
 			const std::vector<Node*>& GetChilds() const;
 			virtual Vector3f GetDown() const;
 			virtual Vector3f GetForward() const;
+			TransformHierarchy* GetHierarchy() const;
 			bool GetInheritPosition() const;
 			bool GetInheritRotation() const;
 			bool GetInheritScale() const;
@@ -118,6 +123,8 @@ namespace Nz
 			Vector3f m_position;
 			Vector3f m_scale;
 			const Node* m_parent;
+			TransformHierarchy* m_hierarchy;
+			UInt32 m_hierarchyHandle;
 			mutable bool m_derivedUpdated;
 			bool m_inheritPosition;
 			bool m_inheritRotation;
@@ -19,6 +19,7 @@
 namespace Nz
 {
 	class Skeleton;
+	class SkeletonPose;
 
 	using SkeletonConstRef = ObjectRef<const Skeleton>;
 	using SkeletonLibrary = ObjectLibrary<Skeleton>;
@@ -37,9 +38,15 @@ namespace Nz
 			Skeleton(const Skeleton& skeleton);
 			~Skeleton();
 
+			void ApplyPose(const SkeletonPose& pose);
+
+			void ComputeSkinningMatrices(const SkeletonPose& pose, Matrix4f* skinningMatrices) const;
 			bool Create(unsigned int jointCount);
+
 			void Destroy();
 
+			void EnsureSkinningDataUpdate() const;
+
 			const Boxf& GetAABB() const;
 			Joint* GetJoint(const String& jointName);
 			Joint* GetJoint(unsigned int index);
@@ -49,6 +56,7 @@ namespace Nz
 			const Joint* GetJoints() const;
 			unsigned int GetJointCount() const;
 			int GetJointIndex(const String& jointName) const;
+			void GetPose(SkeletonPose* pose) const;
 
 			void Interpolate(const Skeleton& skeletonA, const Skeleton& skeletonB, float interpolation);
 			void Interpolate(const Skeleton& skeletonA, const Skeleton& skeletonB, float interpolation, unsigned int* indices, unsigned int indiceCount);
@@ -67,7 +75,9 @@ namespace Nz
 		private:
 			void InvalidateJoints();
 			void InvalidateJointMap();
+			void InvalidateSkinningData();
 			void UpdateJointMap() const;
+			void UpdateSkinningData() const;
 
 			static bool Initialize();
 			static void Uninitialize();
@@ -0,0 +1,58 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_SKELETONPOSE_HPP
+#define NAZARA_SKELETONPOSE_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Math/Quaternion.hpp>
+#include <Nazara/Math/Vector3.hpp>
+#include <Nazara/Utility/Config.hpp>
+#include <vector>
+
+namespace Nz
+{
+	// Local transforms of the joints of a skeleton, stored by attribute so that sampling and blending run over flat arrays
+	// A pose is not bound to a skeleton: many poses (one per animated instance) may share a skeleton
+	class NAZARA_UTILITY_API SkeletonPose
+	{
+		public:
+			SkeletonPose() = default;
+			explicit SkeletonPose(unsigned int jointCount);
+			SkeletonPose(const SkeletonPose&) = default;
+			SkeletonPose(SkeletonPose&&) noexcept = default;
+			~SkeletonPose() = default;
+
+			void ApplyAdditive(const SkeletonPose& additivePose, float weight, const float* jointWeights = nullptr);
+
+			void Blend(const SkeletonPose& pose, float weight, const float* jointWeights = nullptr);
+
+			unsigned int GetJointCount() const;
+			Vector3f* GetPositions();
+			const Vector3f* GetPositions() const;
+			Quaternionf* GetRotations();
+			const Quaternionf* GetRotations() const;
+			Vector3f* GetScales();
+			const Vector3f* GetScales() const;
+
+			void MakeAdditive(const SkeletonPose& referencePose);
+			void MakeIdentity();
+
+			void Resize(unsigned int jointCount);
+
+			SkeletonPose& operator=(const SkeletonPose&) = default;
+			SkeletonPose& operator=(SkeletonPose&&) noexcept = default;
+
+		private:
+			std::vector<Quaternionf> m_rotations;
+			std::vector<Vector3f> m_positions;
+			std::vector<Vector3f> m_scales;
+	};
+}
+
+#include <Nazara/Utility/SkeletonPose.inl>
+
+#endif // NAZARA_SKELETONPOSE_HPP
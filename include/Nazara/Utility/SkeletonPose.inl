@@ -0,0 +1,50 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Utility/Debug.hpp>
+
+namespace Nz
+{
+	inline SkeletonPose::SkeletonPose(unsigned int jointCount)
+	{
+		Resize(jointCount);
+	}
+
+	inline unsigned int SkeletonPose::GetJointCount() const
+	{
+		return static_cast<unsigned int>(m_positions.size());
+	}
+
+	inline Vector3f* SkeletonPose::GetPositions()
+	{
+		return m_positions.data();
+	}
+
+	inline const Vector3f* SkeletonPose::GetPositions() const
+	{
+		return m_positions.data();
+	}
+
+	inline Quaternionf* SkeletonPose::GetRotations()
+	{
+		return m_rotations.data();
+	}
+
+	inline const Quaternionf* SkeletonPose::GetRotations() const
+	{
+		return m_rotations.data();
+	}
+
+	inline Vector3f* SkeletonPose::GetScales()
+	{
+		return m_scales.data();
+	}
+
+	inline const Vector3f* SkeletonPose::GetScales() const
+	{
+		return m_scales.data();
+	}
+}
+
+#include <Nazara/Utility/DebugOff.hpp>
@@ -15,6 +15,7 @@
 #include <Nazara/Utility/IndexBuffer.hpp>
 #include <Nazara/Utility/VertexBuffer.hpp>
 #include <Nazara/Utility/VertexDeclaration.hpp>
+#include <vector>
 
 namespace Nz
 {
@@ -32,6 +33,9 @@ namespace Nz
 			SubMesh(const Mesh* parent);
 			virtual ~SubMesh();
 
+			void ClearLods();
+
+			bool GenerateLods(unsigned int lodCount, float reductionFactor = 0.5f, float maxError = 0.05f);
 			void GenerateNormals();
 			void GenerateNormalsAndTangents();
 			void GenerateTangents();
@@ -39,6 +43,9 @@ namespace Nz
 			virtual const Boxf& GetAABB() const = 0;
 			virtual AnimationType GetAnimationType() const = 0;
 			virtual const IndexBuffer* GetIndexBuffer() const = 0;
+			unsigned int GetLodCount() const;
+			float GetLodError(unsigned int lod) const;
+			const IndexBuffer* GetLodIndexBuffer(unsigned int lod) const;
 			unsigned int GetMaterialIndex() const;
 			const Mesh* GetParent() const;
 			PrimitiveMode GetPrimitiveMode() const;
@@ -54,6 +61,14 @@ namespace Nz
 			NazaraSignal(OnSubMeshRelease, const SubMesh* /*subMesh*/);
 
 		protected:
+			// Simplified indices of a level of detail, sharing the vertices of the sub-mesh
+			struct Lod
+			{
+				IndexBufferConstRef indexBuffer;
+				float error; // Maximal distance to the original surface, in mesh units
+			};
+
+			std::vector<Lod> m_lods;
 			PrimitiveMode m_primitiveMode;
 			const Mesh* m_parent;
 			unsigned int m_matIndex;
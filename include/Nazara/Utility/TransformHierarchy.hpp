@@ -0,0 +1,119 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_TRANSFORMHIERARCHY_HPP
+#define NAZARA_TRANSFORMHIERARCHY_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <Nazara/Math/Matrix4.hpp>
+#include <Nazara/Math/Quaternion.hpp>
+#include <Nazara/Math/Vector3.hpp>
+#include <Nazara/Utility/Config.hpp>
+#include <limits>
+#include <vector>
+
+namespace Nz
+{
+	class Node;
+
+	// Transforms stored by attribute and sorted depth-first (a parent always comes before its children), so that Update
+	// computes every dirty world transform in a single linear pass, without recursion nor pointer chasing
+	// A Node may be bound to a hierarchy, its local transform is then read from it and its derived transform written back by Update
+	class NAZARA_UTILITY_API TransformHierarchy
+	{
+		public:
+			using Handle = UInt32;
+
+			TransformHierarchy();
+			TransformHierarchy(const TransformHierarchy&) = delete;
+			TransformHierarchy(TransformHierarchy&&) = delete;
+			~TransformHierarchy();
+
+			Handle AddNode(Node* node);
+
+			void Clear();
+
+			Handle Create(Handle parent = InvalidHandle);
+
+			void Destroy(Handle handle);
+
+			std::size_t GetCount() const;
+			Handle GetHandle(const Node* node) const;
+			bool GetInheritPosition(Handle handle) const;
+			bool GetInheritRotation(Handle handle) const;
+			bool GetInheritScale(Handle handle) const;
+			const Vector3f& GetLocalPosition(Handle handle) const;
+			const Quaternionf& GetLocalRotation(Handle handle) const;
+			const Vector3f& GetLocalScale(Handle handle) const;
+			Node* GetNode(Handle handle) const;
+			Handle GetParent(Handle handle) const;
+			std::size_t GetRootCount() const;
+			const Matrix4f& GetWorldMatrix(Handle handle) const;
+			const Vector3f& GetWorldPosition(Handle handle) const;
+			const Quaternionf& GetWorldRotation(Handle handle) const;
+			const Vector3f& GetWorldScale(Handle handle) const;
+
+			void Invalidate(Handle handle);
+			bool IsValid(Handle handle) const;
+
+			void RemoveNode(Node* node);
+
+			void SetInheritPosition(Handle handle, bool inheritPosition);
+			void SetInheritRotation(Handle handle, bool inheritRotation);
+			void SetInheritScale(Handle handle, bool inheritScale);
+			void SetLocalPosition(Handle handle, const Vector3f& position);
+			void SetLocalRotation(Handle handle, const Quaternionf& rotation);
+			void SetLocalScale(Handle handle, const Vector3f& scale);
+			void SetParent(Handle handle, Handle parent);
+
+			void Update(bool parallel = false);
+
+			TransformHierarchy& operator=(const TransformHierarchy&) = delete;
+			TransformHierarchy& operator=(TransformHierarchy&&) = delete;
+
+			static constexpr Handle InvalidHandle = std::numeric_limits<Handle>::max();
+			static constexpr std::size_t ParallelThreshold = 1024; //< Minimum number of transforms per task
+
+		private:
+			enum Flag : UInt8
+			{
+				Flag_Alive           = 0x01,
+				Flag_Dirty           = 0x02,
+				Flag_InheritPosition = 0x04,
+				Flag_InheritRotation = 0x08,
+				Flag_InheritScale    = 0x10
+			};
+
+			Handle AllocateHandle(UInt32 index);
+			UInt32 GetIndex(Handle handle) const;
+			void Reorder();
+			void SetFlag(Handle handle, UInt8 flag, bool enabled);
+			void UpdateRange(std::size_t firstIndex, std::size_t lastIndex);
+
+			static constexpr UInt32 InvalidIndex = std::numeric_limits<UInt32>::max();
+
+			std::vector<Handle> m_freeHandles;
+			std::vector<Handle> m_handles; //< Per index
+			std::vector<Matrix4f> m_worldMatrices;
+			std::vector<Node*> m_nodes;
+			std::vector<Quaternionf> m_localRotations;
+			std::vector<Quaternionf> m_worldRotations;
+			std::vector<UInt8> m_flags;
+			std::vector<UInt32> m_indices; //< Per handle
+			std::vector<UInt32> m_parentIndices;
+			std::vector<UInt32> m_rootIndices; //< Each root is followed by its subtree
+			std::vector<Vector3f> m_localPositions;
+			std::vector<Vector3f> m_localScales;
+			std::vector<Vector3f> m_worldPositions;
+			std::vector<Vector3f> m_worldScales;
+			std::size_t m_aliveCount;
+			bool m_orderInvalidated;
+	};
+}
+
+#include <Nazara/Utility/TransformHierarchy.inl>
+
+#endif // NAZARA_TRANSFORMHIERARCHY_HPP
@@ -0,0 +1,108 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Utility/Debug.hpp>
+
+namespace Nz
+{
+	inline std::size_t TransformHierarchy::GetCount() const
+	{
+		return m_aliveCount;
+	}
+
+	inline bool TransformHierarchy::GetInheritPosition(Handle handle) const
+	{
+		return (m_flags[GetIndex(handle)] & Flag_InheritPosition) != 0;
+	}
+
+	inline bool TransformHierarchy::GetInheritRotation(Handle handle) const
+	{
+		return (m_flags[GetIndex(handle)] & Flag_InheritRotation) != 0;
+	}
+
+	inline bool TransformHierarchy::GetInheritScale(Handle handle) const
+	{
+		return (m_flags[GetIndex(handle)] & Flag_InheritScale) != 0;
+	}
+
+	inline const Vector3f& TransformHierarchy::GetLocalPosition(Handle handle) const
+	{
+		return m_localPositions[GetIndex(handle)];
+	}
+
+	inline const Quaternionf& TransformHierarchy::GetLocalRotation(Handle handle) const
+	{
+		return m_localRotations[GetIndex(handle)];
+	}
+
+	inline const Vector3f& TransformHierarchy::GetLocalScale(Handle handle) const
+	{
+		return m_localScales[GetIndex(handle)];
+	}
+
+	inline Node* TransformHierarchy::GetNode(Handle handle) const
+	{
+		return m_nodes[GetIndex(handle)];
+	}
+
+	inline TransformHierarchy::Handle TransformHierarchy::GetParent(Handle handle) const
+	{
+		UInt32 parentIndex = m_parentIndices[GetIndex(handle)];
+		if (parentIndex == InvalidIndex || (m_flags[parentIndex] & Flag_Alive) == 0)
+			return InvalidHandle;
+
+		return m_handles[parentIndex];
+	}
+
+	inline std::size_t TransformHierarchy::GetRootCount() const
+	{
+		///DOC: Valide après un appel à Update
+		return m_rootIndices.size();
+	}
+
+	inline const Matrix4f& TransformHierarchy::GetWorldMatrix(Handle handle) const
+	{
+		///DOC: Valide après un appel à Update
+		return m_worldMatrices[GetIndex(handle)];
+	}
+
+	inline const Vector3f& TransformHierarchy::GetWorldPosition(Handle handle) const
+	{
+		///DOC: Valide après un appel à Update
+		return m_worldPositions[GetIndex(handle)];
+	}
+
+	inline const Quaternionf& TransformHierarchy::GetWorldRotation(Handle handle) const
+	{
+		///DOC: Valide après un appel à Update
+		return m_worldRotations[GetIndex(handle)];
+	}
+
+	inline const Vector3f& TransformHierarchy::GetWorldScale(Handle handle) const
+	{
+		///DOC: Valide après un appel à Update
+		return m_worldScales[GetIndex(handle)];
+	}
+
+	inline void TransformHierarchy::Invalidate(Handle handle)
+	{
+		///DOC: Les enfants sont mis à jour avec leur parent, seul le transform modifié est marqué
+		m_flags[GetIndex(handle)] |= Flag_Dirty;
+	}
+
+	inline bool TransformHierarchy::IsValid(Handle handle) const
+	{
+		return handle < m_indices.size() && m_indices[handle] != InvalidIndex;
+	}
+
+	inline UInt32 TransformHierarchy::GetIndex(Handle handle) const
+	{
+		NazaraAssert(IsValid(handle), "Invalid handle");
+
+		return m_indices[handle];
+	}
+}
+
+#include <Nazara/Utility/DebugOff.hpp>
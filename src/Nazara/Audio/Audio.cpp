@@ -34,6 +34,11 @@ namespace Nz
 		}
 	}
 
+	AudioBackend Audio::GetBackend()
+	{
+		return s_backend;
+	}
+
 	float Audio::GetDopplerFactor()
 	{
 		return alGetFloat(AL_DOPPLER_FACTOR);
@@ -81,12 +86,17 @@ namespace Nz
 		return velocity;
 	}
 
+	SoftwareMixer* Audio::GetSoftwareMixer()
+	{
+		return OpenAL::GetSoftwareMixer();
+	}
+
 	float Audio::GetSpeedOfSound()
 	{
 		return alGetFloat(AL_SPEED_OF_SOUND);
 	}
 
-	bool Audio::Initialize()
+	bool Audio::Initialize(AudioBackend backend)
 	{
 		if (s_moduleReferenceCounter > 0)
 		{
@@ -106,13 +116,28 @@ namespace Nz
 		// Initialisation du module
 		CallOnExit onExit(Audio::Uninitialize);
 
-		// Initialisation d'OpenAL
-		if (!OpenAL::Initialize())
+		// Initialisation d'OpenAL (ou de son implémentation logicielle)
+		switch (backend)
 		{
-			NazaraError("Failed to initialize OpenAL");
-			return false;
+			case AudioBackend_OpenAL:
+				if (!OpenAL::Initialize())
+				{
+					NazaraError("Failed to initialize OpenAL");
+					return false;
+				}
+				break;
+
+			case AudioBackend_Software:
+				if (!OpenAL::InitializeSoftware())
+				{
+					NazaraError("Failed to initialize software mixer");
+					return false;
+				}
+				break;
 		}
 
+		s_backend = backend;
+
 		if (!SoundBuffer::Initialize())
 		{
 			NazaraError("Failed to initialize sound buffers");
@@ -245,5 +270,6 @@ namespace Nz
 		Core::Uninitialize();
 	}
 
+	AudioBackend Audio::s_backend = AudioBackend_OpenAL;
 	unsigned int Audio::s_moduleReferenceCounter = 0;
 }
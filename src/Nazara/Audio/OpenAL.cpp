@@ -3,10 +3,12 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Audio/OpenAL.hpp>
+#include <Nazara/Audio/SoftwareMixer.hpp>
 #include <Nazara/Core/DynLib.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/Log.hpp>
 #include <cstring>
+#include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <Nazara/Audio/Debug.hpp>
@@ -16,6 +18,7 @@ namespace Nz
 	namespace
 	{
 		DynLib s_library;
+		std::unique_ptr<SoftwareMixer> s_softwareMixer;
 		String s_deviceName;
 		String s_rendererName;
 		String s_vendorName;
@@ -56,6 +59,11 @@ namespace Nz
 		return s_vendorName;
 	}
 
+	SoftwareMixer* OpenAL::GetSoftwareMixer()
+	{
+		return s_softwareMixer.get();
+	}
+
 	unsigned int OpenAL::GetVersion()
 	{
 		return s_version;
@@ -63,7 +71,7 @@ namespace Nz
 
 	bool OpenAL::Initialize(bool openDevice)
 	{
-		if (s_library.IsLoaded())
+		if (IsInitialized())
 			return true;
 
 		#if defined(NAZARA_PLATFORM_WINDOWS)
@@ -217,9 +225,31 @@ namespace Nz
 		return true;
 	}
 
+	bool OpenAL::InitializeSoftware(unsigned int sampleRate)
+	{
+		if (IsInitialized())
+			return true;
+
+		if (sampleRate == 0)
+		{
+			NazaraError("Sample rate must be different from zero");
+			return false;
+		}
+
+		// No library nor device, the entry points are implemented by the software mixer
+		s_softwareMixer.reset(new SoftwareMixer(sampleRate));
+		LoadSoftwareEntries(s_softwareMixer.get());
+
+		s_rendererName = alGetString(AL_RENDERER);
+		s_vendorName = alGetString(AL_VENDOR);
+		s_version = 110;
+
+		return true;
+	}
+
 	bool OpenAL::IsInitialized()
 	{
-		return s_library.IsLoaded();
+		return s_library.IsLoaded() || s_softwareMixer;
 	}
 
 	std::size_t OpenAL::QueryInputDevices(std::vector<String>& devices)
@@ -243,7 +273,7 @@ namespace Nz
 	bool OpenAL::SetDevice(const String& deviceName)
 	{
 		s_deviceName = deviceName;
-		if (IsInitialized())
+		if (s_library.IsLoaded())
 		{
 			CloseDevice();
 
@@ -260,6 +290,7 @@ namespace Nz
 		s_rendererName.Clear(false);
 		s_vendorName.Clear(false);
 		s_library.Unload();
+		s_softwareMixer.reset();
 	}
 
 	///ATTENTION: La valeur entière est le nombre de canaux possédés par ce format
@@ -0,0 +1,777 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Audio module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Audio/OpenAL.hpp>
+#include <Nazara/Audio/SoftwareMixer.hpp>
+#include <cstring>
+#include <Nazara/Audio/Debug.hpp>
+
+// Implementation of the OpenAL entry points used by the engine on top of the software mixer,
+// this way sounds, musics and emitters work the same way whatever the backend is
+
+namespace Nz
+{
+	namespace
+	{
+		// AL_EXT_MCFORMATS values
+		constexpr ALenum s_formatQuad16 = 0x1205;
+		constexpr ALenum s_format51Chn16 = 0x120B;
+		constexpr ALenum s_format61Chn16 = 0x120E;
+		constexpr ALenum s_format71Chn16 = 0x1211;
+
+		SoftwareMixer* s_mixer = nullptr;
+		ALenum s_error = AL_NO_ERROR;
+
+		void SetError(ALenum error)
+		{
+			// Like OpenAL, only the first error is kept until it is read
+			if (s_error == AL_NO_ERROR)
+				s_error = error;
+		}
+
+		bool CheckSource(ALuint source)
+		{
+			if (!s_mixer->IsSource(source))
+			{
+				SetError(AL_INVALID_NAME);
+				return false;
+			}
+
+			return true;
+		}
+
+		Vector3f* GetVectorParameter(SoftwareMixer::SourceParameters& parameters, ALenum param)
+		{
+			switch (param)
+			{
+				case AL_POSITION:
+					return &parameters.position;
+
+				case AL_VELOCITY:
+					return &parameters.velocity;
+
+				default:
+					return nullptr;
+			}
+		}
+
+		Vector3f* GetVectorParameter(SoftwareMixer::ListenerParameters& listener, ALenum param)
+		{
+			switch (param)
+			{
+				case AL_POSITION:
+					return &listener.position;
+
+				case AL_VELOCITY:
+					return &listener.velocity;
+
+				default:
+					return nullptr;
+			}
+		}
+
+		/******************************** Buffers ********************************/
+
+		void AL_APIENTRY SoftBufferData(ALuint buffer, ALenum format, const ALvoid* data, ALsizei size, ALsizei freq)
+		{
+			unsigned int channelCount;
+			switch (format)
+			{
+				case AL_FORMAT_MONO16:
+					channelCount = 1;
+					break;
+
+				case AL_FORMAT_STEREO16:
+					channelCount = 2;
+					break;
+
+				case s_formatQuad16:
+					channelCount = 4;
+					break;
+
+				case s_format51Chn16:
+					channelCount = 6;
+					break;
+
+				case s_format61Chn16:
+					channelCount = 7;
+					break;
+
+				case s_format71Chn16:
+					channelCount = 8;
+					break;
+
+				default:
+					SetError(AL_INVALID_ENUM);
+					return;
+			}
+
+			if (!s_mixer->IsBuffer(buffer))
+			{
+				SetError(AL_INVALID_NAME);
+				return;
+			}
+
+			if (size < 0 || freq <= 0 || !s_mixer->UpdateBuffer(buffer, channelCount, static_cast<const Int16*>(data), size / sizeof(Int16), freq))
+				SetError(AL_INVALID_VALUE);
+		}
+
+		void AL_APIENTRY SoftDeleteBuffers(ALsizei n, const ALuint* buffers)
+		{
+			for (ALsizei i = 0; i < n; ++i)
+			{
+				if (!s_mixer->IsBuffer(buffers[i]))
+					SetError(AL_INVALID_NAME);
+				else if (!s_mixer->DestroyBuffer(buffers[i]))
+					SetError(AL_INVALID_OPERATION);
+			}
+		}
+
+		void AL_APIENTRY SoftGenBuffers(ALsizei n, ALuint* buffers)
+		{
+			for (ALsizei i = 0; i < n; ++i)
+				buffers[i] = s_mixer->CreateBuffer();
+		}
+
+		ALboolean AL_APIENTRY SoftIsBuffer(ALuint buffer)
+		{
+			return (s_mixer->IsBuffer(buffer)) ? AL_TRUE : AL_FALSE;
+		}
+
+		/******************************** Context ********************************/
+
+		void AL_APIENTRY SoftDistanceModel(ALenum distanceModel)
+		{
+			// Only the default model is implemented
+			if (distanceModel != AL_INVERSE_DISTANCE_CLAMPED)
+				SetError(AL_INVALID_VALUE);
+		}
+
+		void AL_APIENTRY SoftDopplerFactor(ALfloat value)
+		{
+			if (value < 0.f)
+			{
+				SetError(AL_INVALID_VALUE);
+				return;
+			}
+
+			s_mixer->SetDopplerFactor(value);
+		}
+
+		ALenum AL_APIENTRY SoftGetEnumValue(const ALchar* ename)
+		{
+			if (std::strcmp(ename, "AL_FORMAT_QUAD16") == 0)
+				return s_formatQuad16;
+			else if (std::strcmp(ename, "AL_FORMAT_51CHN16") == 0)
+				return s_format51Chn16;
+			else if (std::strcmp(ename, "AL_FORMAT_61CHN16") == 0)
+				return s_format61Chn16;
+			else if (std::strcmp(ename, "AL_FORMAT_71CHN16") == 0)
+				return s_format71Chn16;
+			else
+				return 0;
+		}
+
+		ALenum AL_APIENTRY SoftGetError()
+		{
+			ALenum error = s_error;
+			s_error = AL_NO_ERROR;
+
+			return error;
+		}
+
+		ALfloat AL_APIENTRY SoftGetFloat(ALenum param)
+		{
+			switch (param)
+			{
+				case AL_DOPPLER_FACTOR:
+					return s_mixer->GetDopplerFactor();
+
+				case AL_SPEED_OF_SOUND:
+					return s_mixer->GetSpeedOfSound();
+
+				default:
+					SetError(AL_INVALID_ENUM);
+					return 0.f;
+			}
+		}
+
+		const ALchar* AL_APIENTRY SoftGetString(ALenum param)
+		{
+			switch (param)
+			{
+				case AL_EXTENSIONS:
+					return "AL_EXT_MCFORMATS";
+
+				case AL_RENDERER:
+					return "Software mixer";
+
+				case AL_VENDOR:
+					return "Nazara Engine";
+
+				case AL_VERSION:
+					return "1.1";
+
+				default:
+					SetError(AL_INVALID_ENUM);
+					return nullptr;
+			}
+		}
+
+		ALboolean AL_APIENTRY SoftIsExtensionPresent(const ALchar* extname)
+		{
+			return (std::strcmp(extname, "AL_EXT_MCFORMATS") == 0) ? AL_TRUE : AL_FALSE;
+		}
+
+		void AL_APIENTRY SoftSpeedOfSound(ALfloat value)
+		{
+			if (value <= 0.f)
+			{
+				SetError(AL_INVALID_VALUE);
+				return;
+			}
+
+			s_mixer->SetSpeedOfSound(value);
+		}
+
+		/******************************** Listener ********************************/
+
+		void AL_APIENTRY SoftGetListener3f(ALenum param, ALfloat* value1, ALfloat* value2, ALfloat* value3)
+		{
+			SoftwareMixer::ListenerParameters listener = s_mixer->GetListener();
+
+			Vector3f* vector = GetVectorParameter(listener, param);
+			if (!vector)
+			{
+				SetError(AL_INVALID_ENUM);
+				return;
+			}
+
+			*value1 = vector->x;
+			*value2 = vector->y;
+			*value3 = vector->z;
+		}
+
+		void AL_APIENTRY SoftGetListenerf(ALenum param, ALfloat* value)
+		{
+			if (param != AL_GAIN)
+			{
+				SetError(AL_INVALID_ENUM);
+				return;
+			}
+
+			*value = s_mixer->GetListener().gain;
+		}
+
+		void AL_APIENTRY SoftGetListenerfv(ALenum param, ALfloat* values)
+		{
+			SoftwareMixer::ListenerParameters listener = s_mixer->GetListener();
+
+			switch (param)
+			{
+				case AL_GAIN:
+					values[0] = listener.gain;
+					break;
+
+				case AL_ORIENTATION:
+					std::memcpy(&values[0], &listener.forward, 3*sizeof(float));
+					std::memcpy(&values[3], &listener.up, 3*sizeof(float));
+					break;
+
+				default:
+				{
+					Vector3f* vector = GetVectorParameter(listener, param);
+					if (!vector)
+					{
+						SetError(AL_INVALID_ENUM);
+						return;
+					}
+
+					std::memcpy(values, vector, 3*sizeof(float));
+					break;
+				}
+			}
+		}
+
+		void AL_APIENTRY SoftListener3f(ALenum param, ALfloat value1, ALfloat value2, ALfloat value3)
+		{
+			SoftwareMixer::ListenerParameters listener = s_mixer->GetListener();
+
+			Vector3f* vector = GetVectorParameter(listener, param);
+			if (!vector)
+			{
+				SetError(AL_INVALID_ENUM);
+				return;
+			}
+
+			vector->Set(value1, value2, value3);
+			s_mixer->SetListener(listener);
+		}
+
+		void AL_APIENTRY SoftListenerf(ALenum param, ALfloat value)
+		{
+			if (param != AL_GAIN)
+			{
+				SetError(AL_INVALID_ENUM);
+				return;
+			}
+
+			SoftwareMixer::ListenerParameters listener = s_mixer->GetListener();
+			listener.gain = value;
+
+			s_mixer->SetListener(listener);
+		}
+
+		void AL_APIENTRY SoftListenerfv(ALenum param, const ALfloat* values)
+		{
+			SoftwareMixer::ListenerParameters listener = s_mixer->GetListener();
+
+			switch (param)
+			{
+				case AL_GAIN:
+					listener.gain = values[0];
+					break;
+
+				case AL_ORIENTATION:
+					listener.forward.Set(values[0], values[1], values[2]);
+					listener.up.Set(values[3], values[4], values[5]);
+					break;
+
+				default:
+				{
+					Vector3f* vector = GetVectorParameter(listener, param);
+					if (!vector)
+					{
+						SetError(AL_INVALID_ENUM);
+						return;
+					}
+
+					vector->Set(values[0], values[1], values[2]);
+					break;
+				}
+			}
+
+			s_mixer->SetListener(listener);
+		}
+
+		/******************************** Sources ********************************/
+
+		void AL_APIENTRY SoftDeleteSources(ALsizei n, const ALuint* sources)
+		{
+			for (ALsizei i = 0; i < n; ++i)
+			{
+				if (CheckSource(sources[i]))
+					s_mixer->DestroySource(sources[i]);
+			}
+		}
+
+		void AL_APIENTRY SoftGenSources(ALsizei n, ALuint* sources)
+		{
+			for (ALsizei i = 0; i < n; ++i)
+				sources[i] = s_mixer->CreateSource();
+		}
+
+		void AL_APIENTRY SoftGetSource3f(ALuint source, ALenum param, ALfloat* value1, ALfloat* value2, ALfloat* value3)
+		{
+			if (!CheckSource(source))
+				return;
+
+			SoftwareMixer::SourceParameters parameters = s_mixer->GetSourceParameters(source);
+
+			Vector3f* vector = GetVectorParameter(parameters, param);
+			if (!vector)
+			{
+				SetError(AL_INVALID_ENUM);
+				return;
+			}
+
+			*value1 = vector->x;
+			*value2 = vector->y;
+			*value3 = vector->z;
+		}
+
+		void AL_APIENTRY SoftGetSourcef(ALuint source, ALenum param, ALfloat* value)
+		{
+			if (!CheckSource(source))
+				return;
+
+			SoftwareMixer::SourceParameters parameters = s_mixer->GetSourceParameters(source);
+			switch (param)
+			{
+				case AL_GAIN:
+					*value = parameters.gain;
+					break;
+
+				case AL_MAX_DISTANCE:
+					*value = parameters.maxDistance;
+					break;
+
+				case AL_PITCH:
+					*value = parameters.pitch;
+					break;
+
+				case AL_REFERENCE_DISTANCE:
+					*value = parameters.minDistance;
+					break;
+
+				case AL_ROLLOFF_FACTOR:
+					*value = parameters.attenuation;
+					break;
+
+				case AL_SEC_OFFSET:
+					*value = s_mixer->GetSourceOffset(source);
+					break;
+
+				default:
+					SetError(AL_INVALID_ENUM);
+					break;
+			}
+		}
+
+		void AL_APIENTRY SoftGetSourcefv(ALuint source, ALenum param, ALfloat* values)
+		{
+			if (!CheckSource(source))
+				return;
+
+			SoftwareMixer::SourceParameters parameters = s_mixer->GetSourceParameters(source);
+
+			Vector3f* vector = GetVectorParameter(parameters, param);
+			if (vector)
+				std::memcpy(values, vector, 3*sizeof(float));
+			else
+				SoftGetSourcef(source, param, values);
+		}
+
+		void AL_APIENTRY SoftGetSourcei(ALuint source, ALenum param, ALint* value)
+		{
+			if (!CheckSource(source))
+				return;
+
+			switch (param)
+			{
+				case AL_BUFFERS_PROCESSED:
+					*value = s_mixer->GetSourceProcessedBufferCount(source);
+					break;
+
+				case AL_BUFFERS_QUEUED:
+					*value = s_mixer->GetSourceQueuedBufferCount(source);
+					break;
+
+				case AL_LOOPING:
+					*value = (s_mixer->GetSourceParameters(source).looping) ? AL_TRUE : AL_FALSE;
+					break;
+
+				case AL_SOURCE_RELATIVE:
+					*value = (s_mixer->GetSourceParameters(source).spatialized) ? AL_FALSE : AL_TRUE;
+					break;
+
+				case AL_SOURCE_STATE:
+				{
+					switch (s_mixer->GetSourceStatus(source))
+					{
+						case SoundStatus_Paused:
+							*value = AL_PAUSED;
+							break;
+
+						case SoundStatus_Playing:
+							*value = AL_PLAYING;
+							break;
+
+						case SoundStatus_Stopped:
+							*value = AL_STOPPED;
+							break;
+					}
+					break;
+				}
+
+				default:
+					SetError(AL_INVALID_ENUM);
+					break;
+			}
+		}
+
+		ALboolean AL_APIENTRY SoftIsSource(ALuint source)
+		{
+			return (s_mixer->IsSource(source)) ? AL_TRUE : AL_FALSE;
+		}
+
+		void AL_APIENTRY SoftSource3f(ALuint source, ALenum param, ALfloat value1, ALfloat value2, ALfloat value3)
+		{
+			if (!CheckSource(source))
+				return;
+
+			SoftwareMixer::SourceParameters parameters = s_mixer->GetSourceParameters(source);
+
+			Vector3f* vector = GetVectorParameter(parameters, param);
+			if (!vector)
+			{
+				SetError(AL_INVALID_ENUM);
+				return;
+			}
+
+			vector->Set(value1, value2, value3);
+			s_mixer->SetSourceParameters(source, parameters);
+		}
+
+		void AL_APIENTRY SoftSourcef(ALuint source, ALenum param, ALfloat value)
+		{
+			if (!CheckSource(source))
+				return;
+
+			if (param == AL_SEC_OFFSET)
+			{
+				s_mixer->SetSourceOffset(source, value);
+				return;
+			}
+
+			SoftwareMixer::SourceParameters parameters = s_mixer->GetSourceParameters(source);
+			switch (param)
+			{
+				case AL_GAIN:
+					parameters.gain = value;
+					break;
+
+				case AL_MAX_DISTANCE:
+					parameters.maxDistance = value;
+					break;
+
+				case AL_PITCH:
+					parameters.pitch = value;
+					break;
+
+				case AL_REFERENCE_DISTANCE:
+					parameters.minDistance = value;
+					break;
+
+				case AL_ROLLOFF_FACTOR:
+					parameters.attenuation = value;
+					break;
+
+				default:
+					SetError(AL_INVALID_ENUM);
+					return;
+			}
+
+			s_mixer->SetSourceParameters(source, parameters);
+		}
+
+		void AL_APIENTRY SoftSourcefv(ALuint source, ALenum param, const ALfloat* values)
+		{
+			if (!CheckSource(source))
+				return;
+
+			SoftwareMixer::SourceParameters parameters = s_mixer->GetSourceParameters(source);
+
+			Vector3f* vector = GetVectorParameter(parameters, param);
+			if (vector)
+			{
+				vector->Set(values[0], values[1], values[2]);
+				s_mixer->SetSourceParameters(source, parameters);
+			}
+			else
+				SoftSourcef(source, param, values[0]);
+		}
+
+		void AL_APIENTRY SoftSourcei(ALuint source, ALenum param, ALint value)
+		{
+			if (!CheckSource(source))
+				return;
+
+			if (param == AL_BUFFER)
+			{
+				if (!s_mixer->SetSourceBuffer(source, value))
+					SetError(AL_INVALID_OPERATION);
+
+				return;
+			}
+
+			SoftwareMixer::SourceParameters parameters = s_mixer->GetSourceParameters(source);
+			switch (param)
+			{
+				case AL_LOOPING:
+					parameters.looping = (value != AL_FALSE);
+					break;
+
+				case AL_SOURCE_RELATIVE:
+					parameters.spatialized = (value == AL_FALSE);
+					break;
+
+				default:
+					SetError(AL_INVALID_ENUM);
+					return;
+			}
+
+			s_mixer->SetSourceParameters(source, parameters);
+		}
+
+		void AL_APIENTRY SoftSourcePause(ALuint source)
+		{
+			if (CheckSource(source))
+				s_mixer->PauseSource(source);
+		}
+
+		void AL_APIENTRY SoftSourcePlay(ALuint source)
+		{
+			if (CheckSource(source))
+				s_mixer->PlaySource(source);
+		}
+
+		void AL_APIENTRY SoftSourceQueueBuffers(ALuint source, ALsizei nb, const ALuint* buffers)
+		{
+			if (CheckSource(source) && !s_mixer->QueueSourceBuffers(source, nb, buffers))
+				SetError(AL_INVALID_NAME);
+		}
+
+		void AL_APIENTRY SoftSourceRewind(ALuint source)
+		{
+			if (!CheckSource(source))
+				return;
+
+			s_mixer->StopSource(source);
+			s_mixer->SetSourceOffset(source, 0.f);
+		}
+
+		void AL_APIENTRY SoftSourceStop(ALuint source)
+		{
+			if (CheckSource(source))
+				s_mixer->StopSource(source);
+		}
+
+		void AL_APIENTRY SoftSourceUnqueueBuffers(ALuint source, ALsizei nb, ALuint* buffers)
+		{
+			if (CheckSource(source) && !s_mixer->UnqueueSourceBuffers(source, nb, buffers))
+				SetError(AL_INVALID_VALUE);
+		}
+
+		/********************************** ALC **********************************/
+
+		const ALCchar* ALC_APIENTRY SoftcGetString(ALCdevice* device, ALCenum param)
+		{
+			NazaraUnused(device);
+			NazaraUnused(param);
+
+			// There is no device to list
+			return nullptr;
+		}
+
+		ALCboolean ALC_APIENTRY SoftcIsExtensionPresent(ALCdevice* device, const ALCchar* extname)
+		{
+			NazaraUnused(device);
+			NazaraUnused(extname);
+
+			return ALC_FALSE;
+		}
+	}
+
+	void OpenAL::LoadSoftwareEntries(SoftwareMixer* mixer)
+	{
+		s_mixer = mixer;
+		s_error = AL_NO_ERROR;
+
+		// Entry points which are not used by the engine are left null
+		// al
+		alBuffer3f = nullptr;
+		alBuffer3i = nullptr;
+		alBufferData = SoftBufferData;
+		alBufferf = nullptr;
+		alBufferfv = nullptr;
+		alBufferi = nullptr;
+		alBufferiv = nullptr;
+		alDeleteBuffers = SoftDeleteBuffers;
+		alDeleteSources = SoftDeleteSources;
+		alDisable = nullptr;
+		alDistanceModel = SoftDistanceModel;
+		alDopplerFactor = SoftDopplerFactor;
+		alDopplerVelocity = nullptr;
+		alEnable = nullptr;
+		alGenBuffers = SoftGenBuffers;
+		alGenSources = SoftGenSources;
+		alGetBoolean = nullptr;
+		alGetBooleanv = nullptr;
+		alGetBuffer3f = nullptr;
+		alGetBuffer3i = nullptr;
+		alGetBufferf = nullptr;
+		alGetBufferfv = nullptr;
+		alGetBufferi = nullptr;
+		alGetBufferiv = nullptr;
+		alGetDouble = nullptr;
+		alGetDoublev = nullptr;
+		alGetEnumValue = SoftGetEnumValue;
+		alGetError = SoftGetError;
+		alGetFloat = SoftGetFloat;
+		alGetFloatv = nullptr;
+		alGetInteger = nullptr;
+		alGetIntegerv = nullptr;
+		alGetListener3f = SoftGetListener3f;
+		alGetListener3i = nullptr;
+		alGetListenerf = SoftGetListenerf;
+		alGetListenerfv = SoftGetListenerfv;
+		alGetListeneri = nullptr;
+		alGetListeneriv = nullptr;
+		alGetProcAddress = nullptr;
+		alGetSource3f = SoftGetSource3f;
+		alGetSource3i = nullptr;
+		alGetSourcef = SoftGetSourcef;
+		alGetSourcefv = SoftGetSourcefv;
+		alGetSourcei = SoftGetSourcei;
+		alGetSourceiv = nullptr;
+		alGetString = SoftGetString;
+		alIsBuffer = SoftIsBuffer;
+		alIsEnabled = nullptr;
+		alIsExtensionPresent = SoftIsExtensionPresent;
+		alIsSource = SoftIsSource;
+		alListener3f = SoftListener3f;
+		alListener3i = nullptr;
+		alListenerf = SoftListenerf;
+		alListenerfv = SoftListenerfv;
+		alListeneri = nullptr;
+		alListeneriv = nullptr;
+		alSource3f = SoftSource3f;
+		alSource3i = nullptr;
+		alSourcef = SoftSourcef;
+		alSourcefv = SoftSourcefv;
+		alSourcei = SoftSourcei;
+		alSourceiv = nullptr;
+		alSourcePause = SoftSourcePause;
+		alSourcePausev = nullptr;
+		alSourcePlay = SoftSourcePlay;
+		alSourcePlayv = nullptr;
+		alSourceQueueBuffers = SoftSourceQueueBuffers;
+		alSourceRewind = SoftSourceRewind;
+		alSourceRewindv = nullptr;
+		alSourceStop = SoftSourceStop;
+		alSourceStopv = nullptr;
+		alSourceUnqueueBuffers = SoftSourceUnqueueBuffers;
+		alSpeedOfSound = SoftSpeedOfSound;
+
+		// alc
+		alcCaptureCloseDevice = nullptr;
+		alcCaptureOpenDevice = nullptr;
+		alcCaptureSamples = nullptr;
+		alcCaptureStart = nullptr;
+		alcCaptureStop = nullptr;
+		alcCloseDevice = nullptr;
+		alcCreateContext = nullptr;
+		alcDestroyContext = nullptr;
+		alcGetContextsDevice = nullptr;
+		alcGetCurrentContext = nullptr;
+		alcGetEnumValue = nullptr;
+		alcGetError = nullptr;
+		alcGetIntegerv = nullptr;
+		alcGetProcAddress = nullptr;
+		alcGetString = SoftcGetString;
+		alcIsExtensionPresent = SoftcIsExtensionPresent;
+		alcMakeContextCurrent = nullptr;
+		alcOpenDevice = nullptr;
+		alcProcessContext = nullptr;
+		alcSuspendContext = nullptr;
+
+		AudioFormat[AudioFormat_Mono] = AL_FORMAT_MONO16;
+		AudioFormat[AudioFormat_Stereo] = AL_FORMAT_STEREO16;
+		AudioFormat[AudioFormat_Quad] = s_formatQuad16;
+		AudioFormat[AudioFormat_5_1] = s_format51Chn16;
+		AudioFormat[AudioFormat_6_1] = s_format61Chn16;
+		AudioFormat[AudioFormat_7_1] = s_format71Chn16;
+	}
+}
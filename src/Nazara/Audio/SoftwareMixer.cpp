@@ -0,0 +1,918 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Audio module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Audio/SoftwareMixer.hpp>
+#include <Nazara/Core/Endianness.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/File.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <Nazara/Math/Algorithm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define NAZARA_AUDIO_MIXER_SSE2
+#endif
+
+#include <Nazara/Audio/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		constexpr float s_sampleScale = 1.f / 32768.f;
+		constexpr UInt32 s_renderChunkSize = 4096; //< In frames
+
+		// Mixes frames of a buffer read at its own pace (no resampling) into the stereo output
+		void MixFrames(float* output, const Int16* samples, UInt32 frameCount, unsigned int channelCount, float leftGain, float rightGain)
+		{
+			UInt32 frame = 0;
+
+			switch (channelCount)
+			{
+				case 1:
+				{
+					#ifdef NAZARA_AUDIO_MIXER_SSE2
+					__m128 left = _mm_set1_ps(leftGain * s_sampleScale);
+					__m128 right = _mm_set1_ps(rightGain * s_sampleScale);
+					for (; frame + 4 <= frameCount; frame += 4)
+					{
+						__m128i packed = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&samples[frame]));
+						__m128 values = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(packed, packed), 16));
+
+						__m128 leftValues = _mm_mul_ps(values, left);
+						__m128 rightValues = _mm_mul_ps(values, right);
+
+						float* out = &output[frame * 2];
+						_mm_storeu_ps(out,     _mm_add_ps(_mm_loadu_ps(out),     _mm_unpacklo_ps(leftValues, rightValues)));
+						_mm_storeu_ps(out + 4, _mm_add_ps(_mm_loadu_ps(out + 4), _mm_unpackhi_ps(leftValues, rightValues)));
+					}
+					#endif
+
+					for (; frame < frameCount; ++frame)
+					{
+						float value = samples[frame] * s_sampleScale;
+						output[frame * 2 + 0] += value * leftGain;
+						output[frame * 2 + 1] += value * rightGain;
+					}
+					break;
+				}
+
+				case 2:
+				{
+					#ifdef NAZARA_AUDIO_MIXER_SSE2
+					__m128 gains = _mm_setr_ps(leftGain * s_sampleScale, rightGain * s_sampleScale, leftGain * s_sampleScale, rightGain * s_sampleScale);
+					for (; frame + 4 <= frameCount; frame += 4)
+					{
+						__m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&samples[frame * 2]));
+						__m128 low = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(packed, packed), 16));
+						__m128 high = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(packed, packed), 16));
+
+						float* out = &output[frame * 2];
+						_mm_storeu_ps(out,     _mm_add_ps(_mm_loadu_ps(out),     _mm_mul_ps(low, gains)));
+						_mm_storeu_ps(out + 4, _mm_add_ps(_mm_loadu_ps(out + 4), _mm_mul_ps(high, gains)));
+					}
+					#endif
+
+					for (; frame < frameCount; ++frame)
+					{
+						output[frame * 2 + 0] += samples[frame * 2 + 0] * s_sampleScale * leftGain;
+						output[frame * 2 + 1] += samples[frame * 2 + 1] * s_sampleScale * rightGain;
+					}
+					break;
+				}
+
+				default:
+				{
+					// Multichannel formats are downmixed
+					float scale = s_sampleScale / channelCount;
+					for (; frame < frameCount; ++frame)
+					{
+						int sum = 0;
+						for (unsigned int i = 0; i < channelCount; ++i)
+							sum += samples[frame * channelCount + i];
+
+						output[frame * 2 + 0] += sum * scale * leftGain;
+						output[frame * 2 + 1] += sum * scale * rightGain;
+					}
+					break;
+				}
+			}
+		}
+
+		void ReadFrame(const Int16* samples, UInt32 frame, unsigned int channelCount, float* left, float* right)
+		{
+			const Int16* frameSamples = &samples[frame * channelCount];
+			switch (channelCount)
+			{
+				case 1:
+					*left = *right = frameSamples[0] * s_sampleScale;
+					break;
+
+				case 2:
+					*left = frameSamples[0] * s_sampleScale;
+					*right = frameSamples[1] * s_sampleScale;
+					break;
+
+				default:
+				{
+					int sum = 0;
+					for (unsigned int i = 0; i < channelCount; ++i)
+						sum += frameSamples[i];
+
+					*left = *right = sum * s_sampleScale / channelCount;
+					break;
+				}
+			}
+		}
+
+		// Mixes frames of a buffer read at another pace (pitch or sample rate) by linear interpolation, returns the number of output frames
+		UInt32 MixResampledFrames(float* output, UInt32 outputFrameCount, const Int16* samples, UInt32 frameCount, unsigned int channelCount, double* cursor, double step, float leftGain, float rightGain)
+		{
+			UInt32 frame = 0;
+			UInt32 lastFrame = frameCount - 1;
+			double position = *cursor;
+
+			if (channelCount == 1)
+			{
+				leftGain *= s_sampleScale;
+				rightGain *= s_sampleScale;
+
+				for (; frame < outputFrameCount && position < frameCount; ++frame)
+				{
+					UInt32 index = static_cast<UInt32>(position);
+					float factor = static_cast<float>(position - index);
+					float value = Lerp(static_cast<float>(samples[index]), static_cast<float>(samples[std::min(index + 1, lastFrame)]), factor);
+
+					output[frame * 2 + 0] += value * leftGain;
+					output[frame * 2 + 1] += value * rightGain;
+
+					position += step;
+				}
+			}
+			else
+			{
+				for (; frame < outputFrameCount && position < frameCount; ++frame)
+				{
+					UInt32 index = static_cast<UInt32>(position);
+					float factor = static_cast<float>(position - index);
+
+					float left, right, nextLeft, nextRight;
+					ReadFrame(samples, index, channelCount, &left, &right);
+					ReadFrame(samples, std::min(index + 1, lastFrame), channelCount, &nextLeft, &nextRight);
+
+					output[frame * 2 + 0] += Lerp(left, nextLeft, factor) * leftGain;
+					output[frame * 2 + 1] += Lerp(right, nextRight, factor) * rightGain;
+
+					position += step;
+				}
+			}
+
+			*cursor = position;
+			return frame;
+		}
+
+		void WriteLE16(UInt8* ptr, UInt16 value)
+		{
+			ptr[0] = static_cast<UInt8>(value);
+			ptr[1] = static_cast<UInt8>(value >> 8);
+		}
+
+		void WriteLE32(UInt8* ptr, UInt32 value)
+		{
+			WriteLE16(ptr, static_cast<UInt16>(value));
+			WriteLE16(ptr + 2, static_cast<UInt16>(value >> 16));
+		}
+	}
+
+	SoftwareMixer::SoftwareMixer(unsigned int sampleRate) :
+	m_renderedFrameCount(0),
+	m_dopplerFactor(1.f),
+	m_speedOfSound(343.3f),
+	m_sampleRate(sampleRate)
+	{
+		NazaraAssert(sampleRate > 0, "Sample rate must be different from zero");
+	}
+
+	unsigned int SoftwareMixer::CreateBuffer()
+	{
+		LockGuard lock(m_mutex);
+
+		unsigned int index;
+		if (!m_freeBuffers.empty())
+		{
+			index = m_freeBuffers.back();
+			m_freeBuffers.pop_back();
+		}
+		else
+		{
+			index = static_cast<unsigned int>(m_buffers.size());
+			m_buffers.emplace_back();
+		}
+
+		m_buffers[index].used = true;
+
+		return index + 1;
+	}
+
+	unsigned int SoftwareMixer::CreateSource()
+	{
+		LockGuard lock(m_mutex);
+
+		unsigned int index;
+		if (!m_freeSources.empty())
+		{
+			index = m_freeSources.back();
+			m_freeSources.pop_back();
+		}
+		else
+		{
+			index = static_cast<unsigned int>(m_sources.size());
+			m_sources.emplace_back();
+		}
+
+		Source& source = m_sources[index];
+		source.currentBuffer = 0;
+		source.cursor = 0.0;
+		source.parameters = SourceParameters();
+		source.status = SoundStatus_Stopped;
+		source.used = true;
+
+		return index + 1;
+	}
+
+	bool SoftwareMixer::DestroyBuffer(unsigned int bufferId)
+	{
+		LockGuard lock(m_mutex);
+
+		Buffer* buffer = GetBufferInternal(bufferId);
+		if (!buffer)
+		{
+			NazaraError("Invalid buffer");
+			return false;
+		}
+
+		if (buffer->queueCount > 0)
+		{
+			NazaraError("Buffer is still used by a source");
+			return false;
+		}
+
+		*buffer = Buffer();
+		m_freeBuffers.push_back(bufferId - 1);
+
+		return true;
+	}
+
+	void SoftwareMixer::DestroySource(unsigned int sourceId)
+	{
+		LockGuard lock(m_mutex);
+
+		Source* source = GetSourceInternal(sourceId);
+		if (!source)
+		{
+			NazaraError("Invalid source");
+			return;
+		}
+
+		ReleaseQueue(*source);
+		source->used = false;
+
+		m_freeSources.push_back(sourceId - 1);
+	}
+
+	float SoftwareMixer::GetDopplerFactor() const
+	{
+		LockGuard lock(m_mutex);
+
+		return m_dopplerFactor;
+	}
+
+	SoftwareMixer::ListenerParameters SoftwareMixer::GetListener() const
+	{
+		LockGuard lock(m_mutex);
+
+		return m_listener;
+	}
+
+	UInt64 SoftwareMixer::GetRenderedFrameCount() const
+	{
+		LockGuard lock(m_mutex);
+
+		return m_renderedFrameCount;
+	}
+
+	unsigned int SoftwareMixer::GetSampleRate() const
+	{
+		return m_sampleRate;
+	}
+
+	float SoftwareMixer::GetSourceOffset(unsigned int sourceId) const
+	{
+		LockGuard lock(m_mutex);
+
+		const Source* source = GetSourceInternal(sourceId);
+		if (!source)
+		{
+			NazaraError("Invalid source");
+			return 0.f;
+		}
+
+		if (source->currentBuffer >= source->queue.size())
+			return 0.f;
+
+		double offset = 0.0;
+		for (std::size_t i = 0; i <= source->currentBuffer; ++i)
+		{
+			const Buffer& buffer = m_buffers[source->queue[i] - 1];
+			if (buffer.sampleRate == 0)
+				continue;
+
+			double frames = (i == source->currentBuffer) ? source->cursor : buffer.frameCount;
+			offset += frames / buffer.sampleRate;
+		}
+
+		return static_cast<float>(offset);
+	}
+
+	SoftwareMixer::SourceParameters SoftwareMixer::GetSourceParameters(unsigned int sourceId) const
+	{
+		LockGuard lock(m_mutex);
+
+		const Source* source = GetSourceInternal(sourceId);
+		if (!source)
+		{
+			NazaraError("Invalid source");
+			return SourceParameters();
+		}
+
+		return source->parameters;
+	}
+
+	unsigned int SoftwareMixer::GetSourceProcessedBufferCount(unsigned int sourceId) const
+	{
+		LockGuard lock(m_mutex);
+
+		const Source* source = GetSourceInternal(sourceId);
+		if (!source)
+		{
+			NazaraError("Invalid source");
+			return 0;
+		}
+
+		return static_cast<unsigned int>(std::min(source->currentBuffer, source->queue.size()));
+	}
+
+	unsigned int SoftwareMixer::GetSourceQueuedBufferCount(unsigned int sourceId) const
+	{
+		LockGuard lock(m_mutex);
+
+		const Source* source = GetSourceInternal(sourceId);
+		if (!source)
+		{
+			NazaraError("Invalid source");
+			return 0;
+		}
+
+		return static_cast<unsigned int>(source->queue.size());
+	}
+
+	SoundStatus SoftwareMixer::GetSourceStatus(unsigned int sourceId) const
+	{
+		LockGuard lock(m_mutex);
+
+		const Source* source = GetSourceInternal(sourceId);
+		if (!source)
+		{
+			NazaraError("Invalid source");
+			return SoundStatus_Stopped;
+		}
+
+		return source->status;
+	}
+
+	float SoftwareMixer::GetSpeedOfSound() const
+	{
+		LockGuard lock(m_mutex);
+
+		return m_speedOfSound;
+	}
+
+	bool SoftwareMixer::IsBuffer(unsigned int buffer) const
+	{
+		LockGuard lock(m_mutex);
+
+		return buffer != InvalidId && buffer <= m_buffers.size() && m_buffers[buffer - 1].used;
+	}
+
+	bool SoftwareMixer::IsSource(unsigned int source) const
+	{
+		LockGuard lock(m_mutex);
+
+		return GetSourceInternal(source) != nullptr;
+	}
+
+	void SoftwareMixer::PauseSource(unsigned int sourceId)
+	{
+		LockGuard lock(m_mutex);
+
+		Source* source = GetSourceInternal(sourceId);
+		if (!source)
+		{
+			NazaraError("Invalid source");
+			return;
+		}
+
+		if (source->status == SoundStatus_Playing)
+			source->status = SoundStatus_Paused;
+	}
+
+	void SoftwareMixer::PlaySource(unsigned int sourceId)
+	{
+		LockGuard lock(m_mutex);
+
+		Source* source = GetSourceInternal(sourceId);
+		if (!source)
+		{
+			NazaraError("Invalid source");
+			return;
+		}
+
+		// Like OpenAL, playing a paused source resumes it while playing a playing or stopped source restarts it
+		if (source->status != SoundStatus_Paused)
+		{
+			source->currentBuffer = 0;
+			source->cursor = 0.0;
+		}
+
+		source->status = (source->queue.empty()) ? SoundStatus_Stopped : SoundStatus_Playing;
+	}
+
+	bool SoftwareMixer::QueueSourceBuffers(unsigned int sourceId, unsigned int count, const unsigned int* buffers)
+	{
+		NazaraAssert(count == 0 || buffers, "Invalid buffer array");
+
+		LockGuard lock(m_mutex);
+
+		Source* source = GetSourceInternal(sourceId);
+		if (!source)
+		{
+			NazaraError("Invalid source");
+			return false;
+		}
+
+		for (unsigned int i = 0; i < count; ++i)
+		{
+			if (!GetBufferInternal(buffers[i]))
+			{
+				NazaraError("Invalid buffer #" + String::Number(i));
+				return false;
+			}
+		}
+
+		for (unsigned int i = 0; i < count; ++i)
+		{
+			m_buffers[buffers[i] - 1].queueCount++;
+			source->queue.push_back(buffers[i]);
+		}
+
+		return true;
+	}
+
+	void SoftwareMixer::Render(float* output, UInt32 frameCount)
+	{
+		NazaraAssert(frameCount == 0 || output, "Invalid output");
+
+		LockGuard lock(m_mutex);
+
+		RenderInternal(output, frameCount);
+	}
+
+	void SoftwareMixer::Render(Int16* output, UInt32 frameCount)
+	{
+		NazaraAssert(frameCount == 0 || output, "Invalid output");
+
+		LockGuard lock(m_mutex);
+
+		m_mixBuffer.resize(frameCount * ChannelCount);
+		RenderInternal(m_mixBuffer.data(), frameCount);
+
+		for (std::size_t i = 0; i < m_mixBuffer.size(); ++i)
+			output[i] = static_cast<Int16>(Clamp(m_mixBuffer[i], -1.f, 1.f) * 32767.f);
+	}
+
+	bool SoftwareMixer::RenderToFile(const String& filePath, UInt32 frameCount)
+	{
+		File file(filePath);
+		if (!file.Open(OpenMode_WriteOnly | OpenMode_Truncate))
+		{
+			NazaraError("Failed to open \"" + filePath + "\" for writing");
+			return false;
+		}
+
+		return RenderToStream(file, frameCount);
+	}
+
+	bool SoftwareMixer::RenderToStream(Stream& stream, UInt32 frameCount)
+	{
+		const UInt32 blockAlign = ChannelCount * sizeof(Int16);
+		const UInt32 dataSize = frameCount * blockAlign;
+
+		// 16 bits PCM WAV header
+		UInt8 header[44];
+		std::memcpy(&header[0], "RIFF", 4);
+		WriteLE32(&header[4], 36 + dataSize);
+		std::memcpy(&header[8], "WAVEfmt ", 8);
+		WriteLE32(&header[16], 16);
+		WriteLE16(&header[20], 1); // PCM
+		WriteLE16(&header[22], ChannelCount);
+		WriteLE32(&header[24], m_sampleRate);
+		WriteLE32(&header[28], m_sampleRate * blockAlign);
+		WriteLE16(&header[32], blockAlign);
+		WriteLE16(&header[34], 16);
+		std::memcpy(&header[36], "data", 4);
+		WriteLE32(&header[40], dataSize);
+
+		if (stream.Write(header, sizeof(header)) != sizeof(header))
+		{
+			NazaraError("Failed to write WAV header");
+			return false;
+		}
+
+		std::vector<Int16> samples(std::min(frameCount, s_renderChunkSize) * ChannelCount);
+		while (frameCount > 0)
+		{
+			UInt32 chunkSize = std::min(frameCount, s_renderChunkSize);
+			Render(samples.data(), chunkSize);
+
+			#ifdef NAZARA_BIG_ENDIAN
+			SwapBytes(samples.data(), sizeof(Int16), chunkSize * ChannelCount);
+			#endif
+
+			std::size_t byteCount = chunkSize * blockAlign;
+			if (stream.Write(samples.data(), byteCount) != byteCount)
+			{
+				NazaraError("Failed to write samples");
+				return false;
+			}
+
+			frameCount -= chunkSize;
+		}
+
+		return true;
+	}
+
+	void SoftwareMixer::SetDopplerFactor(float dopplerFactor)
+	{
+		LockGuard lock(m_mutex);
+
+		m_dopplerFactor = dopplerFactor;
+	}
+
+	void SoftwareMixer::SetListener(const ListenerParameters& listener)
+	{
+		LockGuard lock(m_mutex);
+
+		m_listener = listener;
+	}
+
+	bool SoftwareMixer::SetSourceBuffer(unsigned int sourceId, unsigned int bufferId)
+	{
+		LockGuard lock(m_mutex);
+
+		Source* source = GetSourceInternal(sourceId);
+		if (!source)
+		{
+			NazaraError("Invalid source");
+			return false;
+		}
+
+		if (source->status != SoundStatus_Stopped)
+		{
+			NazaraError("Source must be stopped");
+			return false;
+		}
+
+		if (bufferId != InvalidId && !GetBufferInternal(bufferId))
+		{
+			NazaraError("Invalid buffer");
+			return false;
+		}
+
+		ReleaseQueue(*source);
+
+		if (bufferId != InvalidId)
+		{
+			m_buffers[bufferId - 1].queueCount++;
+			source->queue.push_back(bufferId);
+		}
+
+		return true;
+	}
+
+	void SoftwareMixer::SetSourceOffset(unsigned int sourceId, float offset)
+	{
+		LockGuard lock(m_mutex);
+
+		Source* source = GetSourceInternal(sourceId);
+		if (!source)
+		{
+			NazaraError("Invalid source");
+			return;
+		}
+
+		double remaining = std::max(offset, 0.f);
+		for (std::size_t i = 0; i < source->queue.size(); ++i)
+		{
+			const Buffer& buffer = m_buffers[source->queue[i] - 1];
+			if (buffer.sampleRate == 0)
+				continue;
+
+			double duration = static_cast<double>(buffer.frameCount) / buffer.sampleRate;
+			if (remaining < duration)
+			{
+				source->currentBuffer = i;
+				source->cursor = remaining * buffer.sampleRate;
+				return;
+			}
+
+			remaining -= duration;
+		}
+
+		NazaraError("Offset is out of range");
+	}
+
+	void SoftwareMixer::SetSourceParameters(unsigned int sourceId, const SourceParameters& parameters)
+	{
+		LockGuard lock(m_mutex);
+
+		Source* source = GetSourceInternal(sourceId);
+		if (!source)
+		{
+			NazaraError("Invalid source");
+			return;
+		}
+
+		source->parameters = parameters;
+	}
+
+	void SoftwareMixer::SetSpeedOfSound(float speed)
+	{
+		LockGuard lock(m_mutex);
+
+		m_speedOfSound = speed;
+	}
+
+	void SoftwareMixer::StopSource(unsigned int sourceId)
+	{
+		LockGuard lock(m_mutex);
+
+		Source* source = GetSourceInternal(sourceId);
+		if (!source)
+		{
+			NazaraError("Invalid source");
+			return;
+		}
+
+		// Every queued buffer is considered processed once the source is stopped
+		source->currentBuffer = source->queue.size();
+		source->cursor = 0.0;
+		source->status = SoundStatus_Stopped;
+	}
+
+	bool SoftwareMixer::UnqueueSourceBuffers(unsigned int sourceId, unsigned int count, unsigned int* buffers)
+	{
+		NazaraAssert(count == 0 || buffers, "Invalid buffer array");
+
+		LockGuard lock(m_mutex);
+
+		Source* source = GetSourceInternal(sourceId);
+		if (!source)
+		{
+			NazaraError("Invalid source");
+			return false;
+		}
+
+		// Only processed buffers can be unqueued
+		if (count > std::min(source->currentBuffer, source->queue.size()))
+		{
+			NazaraError("Not enough processed buffers");
+			return false;
+		}
+
+		for (unsigned int i = 0; i < count; ++i)
+		{
+			buffers[i] = source->queue[i];
+			m_buffers[buffers[i] - 1].queueCount--;
+		}
+
+		source->queue.erase(source->queue.begin(), source->queue.begin() + count);
+		source->currentBuffer -= count;
+
+		return true;
+	}
+
+	bool SoftwareMixer::UpdateBuffer(unsigned int bufferId, unsigned int channelCount, const Int16* samples, UInt32 sampleCount, UInt32 sampleRate)
+	{
+		NazaraAssert(sampleCount == 0 || samples, "Invalid samples");
+
+		LockGuard lock(m_mutex);
+
+		Buffer* buffer = GetBufferInternal(bufferId);
+		if (!buffer)
+		{
+			NazaraError("Invalid buffer");
+			return false;
+		}
+
+		if (channelCount == 0 || sampleCount % channelCount != 0)
+		{
+			NazaraError("Sample count must be a multiple of the channel count");
+			return false;
+		}
+
+		if (sampleRate == 0)
+		{
+			NazaraError("Sample rate must be different from zero");
+			return false;
+		}
+
+		if (buffer->queueCount > 0)
+		{
+			NazaraError("Buffer is used by a source");
+			return false;
+		}
+
+		buffer->channelCount = channelCount;
+		buffer->frameCount = sampleCount / channelCount;
+		buffer->sampleRate = sampleRate;
+		buffer->samples.assign(samples, samples + sampleCount);
+
+		return true;
+	}
+
+	void SoftwareMixer::ComputeGains(const Source& source, const Buffer& buffer, float* leftGain, float* rightGain, double* step) const
+	{
+		const SourceParameters& parameters = source.parameters;
+
+		float gain = m_listener.gain * parameters.gain;
+		float pitch = parameters.pitch;
+
+		// Like OpenAL, only mono buffers are spatialized
+		if (buffer.channelCount == 1)
+		{
+			Vector3f toSource = parameters.position;
+			if (parameters.spatialized)
+				toSource -= m_listener.position;
+
+			float distance = toSource.GetLength();
+
+			// Inverse distance clamped model (the default one of OpenAL)
+			float clampedDistance = Clamp(distance, parameters.minDistance, std::max(parameters.minDistance, parameters.maxDistance));
+			float denominator = parameters.minDistance + parameters.attenuation * (clampedDistance - parameters.minDistance);
+			if (denominator > 0.f)
+				gain *= parameters.minDistance / denominator;
+
+			float pan = 0.f;
+			if (distance > 0.0001f)
+			{
+				if (parameters.spatialized && m_dopplerFactor > 0.f && m_speedOfSound > 0.f)
+				{
+					Vector3f toListener = -toSource / distance;
+
+					float limit = m_speedOfSound / m_dopplerFactor;
+					float listenerSpeed = std::min(toListener.DotProduct(m_listener.velocity), limit);
+					float sourceSpeed = std::min(toListener.DotProduct(parameters.velocity), limit);
+
+					float shiftDenominator = m_speedOfSound - m_dopplerFactor * sourceSpeed;
+					if (shiftDenominator > 0.0001f)
+						pitch *= (m_speedOfSound - m_dopplerFactor * listenerSpeed) / shiftDenominator;
+				}
+
+				Vector3f right = m_listener.forward.CrossProduct(m_listener.up);
+				right.Normalize();
+
+				pan = Clamp(toSource.DotProduct(right) / distance, -1.f, 1.f);
+			}
+
+			// Constant power panning
+			float angle = (pan + 1.f) * float(M_PI) / 4.f;
+			*leftGain = gain * std::cos(angle);
+			*rightGain = gain * std::sin(angle);
+		}
+		else
+		{
+			*leftGain = gain;
+			*rightGain = gain;
+		}
+
+		*step = std::max(pitch, 0.f) * static_cast<double>(buffer.sampleRate) / m_sampleRate;
+	}
+
+	SoftwareMixer::Buffer* SoftwareMixer::GetBufferInternal(unsigned int buffer)
+	{
+		if (buffer == InvalidId || buffer > m_buffers.size() || !m_buffers[buffer - 1].used)
+			return nullptr;
+
+		return &m_buffers[buffer - 1];
+	}
+
+	SoftwareMixer::Source* SoftwareMixer::GetSourceInternal(unsigned int source)
+	{
+		if (source == InvalidId || source > m_sources.size() || !m_sources[source - 1].used)
+			return nullptr;
+
+		return &m_sources[source - 1];
+	}
+
+	const SoftwareMixer::Source* SoftwareMixer::GetSourceInternal(unsigned int source) const
+	{
+		if (source == InvalidId || source > m_sources.size() || !m_sources[source - 1].used)
+			return nullptr;
+
+		return &m_sources[source - 1];
+	}
+
+	void SoftwareMixer::MixSource(Source& source, float* output, UInt32 frameCount)
+	{
+		UInt32 frame = 0;
+		UInt32 lastLoopFrame = 0;
+		bool looped = false;
+
+		while (frame < frameCount && source.status == SoundStatus_Playing)
+		{
+			const Buffer& buffer = m_buffers[source.queue[source.currentBuffer] - 1];
+
+			if (buffer.frameCount > 0)
+			{
+				float leftGain, rightGain;
+				double step;
+				ComputeGains(source, buffer, &leftGain, &rightGain, &step);
+
+				if (step == 1.0 && source.cursor == std::floor(source.cursor))
+				{
+					// Same pace than the output, the samples can be mixed as a block
+					UInt32 position = static_cast<UInt32>(source.cursor);
+					UInt32 count = std::min(frameCount - frame, buffer.frameCount - position);
+
+					MixFrames(&output[frame * ChannelCount], &buffer.samples[position * buffer.channelCount], count, buffer.channelCount, leftGain, rightGain);
+
+					source.cursor += count;
+					frame += count;
+				}
+				else
+				{
+					frame += MixResampledFrames(&output[frame * ChannelCount], frameCount - frame, buffer.samples.data(), buffer.frameCount, buffer.channelCount, &source.cursor, step, leftGain, rightGain);
+				}
+			}
+
+			if (source.cursor >= buffer.frameCount)
+			{
+				source.cursor -= buffer.frameCount;
+				source.currentBuffer++;
+
+				if (source.currentBuffer >= source.queue.size())
+				{
+					// A looping queue which does not produce any frame would never end
+					if (source.parameters.looping && (!looped || frame != lastLoopFrame))
+					{
+						source.currentBuffer = 0;
+						lastLoopFrame = frame;
+						looped = true;
+					}
+					else
+					{
+						source.cursor = 0.0;
+						source.status = SoundStatus_Stopped;
+					}
+				}
+			}
+		}
+	}
+
+	void SoftwareMixer::ReleaseQueue(Source& source)
+	{
+		for (unsigned int buffer : source.queue)
+			m_buffers[buffer - 1].queueCount--;
+
+		source.queue.clear();
+		source.currentBuffer = 0;
+		source.cursor = 0.0;
+	}
+
+	void SoftwareMixer::RenderInternal(float* output, UInt32 frameCount)
+	{
+		std::fill(output, output + frameCount * ChannelCount, 0.f);
+
+		for (Source& source : m_sources)
+		{
+			if (source.used && source.status == SoundStatus_Playing)
+				MixSource(source, output, frameCount);
+		}
+
+		m_renderedFrameCount += frameCount;
+	}
+}
@@ -5,6 +5,7 @@
 #include <Nazara/Core/AbstractHash.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/Hash/CRC32.hpp>
+#include <Nazara/Core/Hash/CRC32C.hpp>
 #include <Nazara/Core/Hash/Fletcher16.hpp>
 #include <Nazara/Core/Hash/MD5.hpp>
 #include <Nazara/Core/Hash/SHA1.hpp>
@@ -13,6 +14,7 @@
 #include <Nazara/Core/Hash/SHA384.hpp>
 #include <Nazara/Core/Hash/SHA512.hpp>
 #include <Nazara/Core/Hash/Whirlpool.hpp>
+#include <Nazara/Core/Hash/XXHash64.hpp>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
@@ -31,6 +33,9 @@ namespace Nz
 			case HashType_CRC32:
 				return std::unique_ptr<AbstractHash>(new HashCRC32);
 
+			case HashType_CRC32C:
+				return std::unique_ptr<AbstractHash>(new HashCRC32C);
+
 			case HashType_MD5:
 				return std::unique_ptr<AbstractHash>(new HashMD5);
 
@@ -51,6 +56,9 @@ namespace Nz
 
 			case HashType_Whirlpool:
 				return std::unique_ptr<AbstractHash>(new HashWhirlpool);
+
+			case HashType_XXHash64:
+				return std::unique_ptr<AbstractHash>(new HashXXHash64);
 		}
 
 		NazaraInternalError("Hash type not handled (0x" + String::Number(type, 16) + ')');
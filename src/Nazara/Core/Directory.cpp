@@ -294,7 +294,8 @@ namespace Nz
 				if (p.EndsWith(NAZARA_DIRECTORY_SEPARATOR))
 					p = p.SubString(0, -2);
 
-				if (!DirectoryImpl::Exists(p) && !DirectoryImpl::Create(p))
+				// The root of an absolute path ("/") gives an empty path
+				if (!p.IsEmpty() && !DirectoryImpl::Exists(p) && !DirectoryImpl::Create(p))
 					return false;
 
 				if (foundPos == String::npos)
@@ -0,0 +1,276 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/FrameAllocator.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <Nazara/Core/MemoryHelper.hpp>
+#include <Nazara/Core/ThreadIndex.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	struct FrameAllocator::Region
+	{
+		Region* next;
+		std::size_t size;
+
+		UInt8* GetData()
+		{
+			return reinterpret_cast<UInt8*>(this) + HeaderSize;
+		}
+
+		static constexpr std::size_t HeaderSize = (sizeof(Region*) + sizeof(std::size_t) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+	};
+
+	struct FrameAllocator::ThreadRegions
+	{
+		Region* current;
+		Region* first;
+		UInt8* cursor;
+		UInt8* end;
+		UInt64 allocationCount;
+		std::size_t allocatedSize; //< Requested by the user
+		std::size_t nextRegionSize; //< Size of the first region to allocate, after a frame which needed several regions
+		std::size_t usedSize; //< Including the padding and the unused end of the regions
+	};
+
+	namespace
+	{
+		constexpr std::size_t s_cacheLineSize = 64;
+		constexpr std::size_t s_threadRegionsStride = s_cacheLineSize; //< Prevents false sharing between the threads
+
+		inline void* BumpAllocate(UInt8*& cursor, UInt8* end, std::size_t size, std::size_t alignment)
+		{
+			std::uintptr_t address = (reinterpret_cast<std::uintptr_t>(cursor) + alignment - 1) & ~std::uintptr_t(alignment - 1);
+			if (!cursor || address + size > reinterpret_cast<std::uintptr_t>(end))
+				return nullptr;
+
+			cursor = reinterpret_cast<UInt8*>(address + size);
+			return reinterpret_cast<void*>(address);
+		}
+	}
+
+	FrameAllocator::FrameAllocator(std::size_t regionSize) :
+	m_heapAllocationCount(0),
+	m_regionSize(regionSize)
+	{
+		static_assert(sizeof(ThreadRegions) <= s_threadRegionsStride, "Thread regions do not fit their stride");
+
+		// One more slot, shared by the threads which have no slot of their own
+		m_threadRegionsMemory = OperatorNew((MaxThreadRegions + 1) * s_threadRegionsStride + s_cacheLineSize - 1);
+
+		std::uintptr_t address = reinterpret_cast<std::uintptr_t>(m_threadRegionsMemory);
+		m_threadRegions = reinterpret_cast<UInt8*>((address + s_cacheLineSize - 1) & ~std::uintptr_t(s_cacheLineSize - 1));
+
+		for (unsigned int i = 0; i <= MaxThreadRegions; ++i)
+		{
+			ThreadRegions& regions = GetThreadRegions(i);
+			regions.current = nullptr;
+			regions.first = nullptr;
+			regions.cursor = nullptr;
+			regions.end = nullptr;
+			regions.allocationCount = 0;
+			regions.allocatedSize = 0;
+			regions.nextRegionSize = 0;
+			regions.usedSize = 0;
+		}
+	}
+
+	FrameAllocator::~FrameAllocator()
+	{
+		Release();
+
+		OperatorDelete(m_threadRegionsMemory);
+	}
+
+	void* FrameAllocator::Allocate(std::size_t size, std::size_t alignment)
+	{
+		NazaraAssert(alignment > 0 && (alignment & (alignment - 1)) == 0, "Alignment must be a power of two");
+
+		auto AllocateFrom = [this, size, alignment](ThreadRegions& regions)
+		{
+			UInt8* previousCursor = regions.cursor;
+
+			void* ptr = BumpAllocate(regions.cursor, regions.end, size, alignment);
+			if (!ptr)
+				return AllocateSlow(regions, size, alignment);
+
+			regions.allocationCount++;
+			regions.allocatedSize += size;
+			regions.usedSize += regions.cursor - previousCursor;
+
+			return ptr;
+		};
+
+		unsigned int threadIndex = ThreadIndex::Get();
+		if (threadIndex < MaxThreadRegions)
+			return AllocateFrom(GetThreadRegions(threadIndex));
+		else
+		{
+			LockGuard lock(m_sharedMutex);
+			return AllocateFrom(GetThreadRegions(MaxThreadRegions));
+		}
+	}
+
+	std::size_t FrameAllocator::GetAllocatedSize() const
+	{
+		///DOC: Taille demandée depuis le dernier Reset
+		std::size_t allocatedSize = 0;
+		for (unsigned int i = 0; i <= MaxThreadRegions; ++i)
+			allocatedSize += GetThreadRegions(i).allocatedSize;
+
+		return allocatedSize;
+	}
+
+	UInt64 FrameAllocator::GetAllocationCount() const
+	{
+		///DOC: Nombre d'allocations depuis le dernier Reset
+		UInt64 allocationCount = 0;
+		for (unsigned int i = 0; i <= MaxThreadRegions; ++i)
+			allocationCount += GetThreadRegions(i).allocationCount;
+
+		return allocationCount;
+	}
+
+	std::size_t FrameAllocator::GetCapacity() const
+	{
+		std::size_t capacity = 0;
+		for (unsigned int i = 0; i <= MaxThreadRegions; ++i)
+		{
+			for (Region* region = GetThreadRegions(i).first; region; region = region->next)
+				capacity += region->size;
+		}
+
+		return capacity;
+	}
+
+	UInt64 FrameAllocator::GetHeapAllocationCount() const
+	{
+		///DOC: Nombre de régions allouées depuis la création, ne devrait plus augmenter une fois les premières frames passées
+		return m_heapAllocationCount.load(std::memory_order_relaxed);
+	}
+
+	std::size_t FrameAllocator::GetRegionSize() const
+	{
+		return m_regionSize;
+	}
+
+	void FrameAllocator::Release()
+	{
+		///DOC: Libère toute la mémoire, les allocations précédentes deviennent invalides
+		for (unsigned int i = 0; i <= MaxThreadRegions; ++i)
+		{
+			ThreadRegions& regions = GetThreadRegions(i);
+
+			Region* region = regions.first;
+			while (region)
+			{
+				Region* next = region->next;
+				OperatorDelete(region);
+
+				region = next;
+			}
+
+			regions.current = nullptr;
+			regions.first = nullptr;
+			regions.cursor = nullptr;
+			regions.end = nullptr;
+			regions.allocationCount = 0;
+			regions.allocatedSize = 0;
+			regions.nextRegionSize = 0;
+			regions.usedSize = 0;
+		}
+	}
+
+	void FrameAllocator::Reset()
+	{
+		///DOC: Toutes les allocations précédentes deviennent invalides, la mémoire est gardée pour la frame suivante
+		for (unsigned int i = 0; i <= MaxThreadRegions; ++i)
+		{
+			ThreadRegions& regions = GetThreadRegions(i);
+			if (!regions.first)
+				continue;
+
+			if (regions.usedSize > regions.first->size)
+			{
+				// The frame did not fit in the first region, the regions are merged into one big enough for it
+				Region* region = regions.first;
+				while (region)
+				{
+					Region* next = region->next;
+					OperatorDelete(region);
+
+					region = next;
+				}
+
+				regions.current = nullptr;
+				regions.first = nullptr;
+				regions.cursor = nullptr;
+				regions.end = nullptr;
+				regions.nextRegionSize = regions.usedSize;
+			}
+			else
+			{
+				regions.current = regions.first;
+				regions.cursor = regions.first->GetData();
+				regions.end = regions.cursor + regions.first->size;
+			}
+
+			regions.allocationCount = 0;
+			regions.allocatedSize = 0;
+			regions.usedSize = 0;
+		}
+	}
+
+	void* FrameAllocator::AllocateSlow(ThreadRegions& regions, std::size_t size, std::size_t alignment)
+	{
+		// The end of the current region is lost for this frame
+		regions.usedSize += regions.end - regions.cursor;
+
+		std::size_t requiredSize = size + alignment - 1;
+
+		// Regions kept from previous frames are reused when possible
+		Region* nextRegion = (regions.current) ? regions.current->next : regions.first;
+		if (!nextRegion || nextRegion->size < requiredSize)
+		{
+			std::size_t regionSize = std::max({m_regionSize, requiredSize, regions.nextRegionSize});
+			regions.nextRegionSize = 0;
+
+			Region* region = static_cast<Region*>(OperatorNew(Region::HeaderSize + regionSize));
+			region->next = nextRegion;
+			region->size = regionSize;
+
+			if (regions.current)
+				regions.current->next = region;
+			else
+				regions.first = region;
+
+			m_heapAllocationCount.fetch_add(1, std::memory_order_relaxed);
+
+			nextRegion = region;
+		}
+
+		regions.current = nextRegion;
+		regions.cursor = nextRegion->GetData();
+		regions.end = regions.cursor + nextRegion->size;
+
+		UInt8* previousCursor = regions.cursor;
+		void* ptr = BumpAllocate(regions.cursor, regions.end, size, alignment);
+		NazaraAssert(ptr, "Region is too small");
+
+		regions.allocationCount++;
+		regions.allocatedSize += size;
+		regions.usedSize += regions.cursor - previousCursor;
+
+		return ptr;
+	}
+
+	FrameAllocator::ThreadRegions& FrameAllocator::GetThreadRegions(unsigned int index) const
+	{
+		return *reinterpret_cast<ThreadRegions*>(m_threadRegions + index * s_threadRegionsStride);
+	}
+}
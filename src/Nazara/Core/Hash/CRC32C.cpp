@@ -0,0 +1,85 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/Hash/CRC32C.hpp>
+#include <Nazara/Core/HardwareInfo.hpp>
+#include <cstring>
+
+#if defined(NAZARA_COMPILER_MSVC) && (defined(_M_X64) || defined(_M_IX86))
+	#include <nmmintrin.h>
+	#define NAZARA_CRC32C_SSE42
+	#define NAZARA_CRC32C_TARGET
+#elif (defined(NAZARA_COMPILER_GCC) || defined(NAZARA_COMPILER_CLANG)) && (defined(__x86_64__) || defined(__i386__))
+	#include <nmmintrin.h>
+	#define NAZARA_CRC32C_SSE42
+	#define NAZARA_CRC32C_TARGET __attribute__((target("sse4.2")))
+#endif
+
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		using CRC32CFunction = UInt32 (*)(UInt32 crc, const UInt8* data, std::size_t len);
+
+		#ifdef NAZARA_CRC32C_SSE42
+		// The crc32 instruction implements the Castagnoli polynomial, only enabled once SSE4.2 support has been checked
+		NAZARA_CRC32C_TARGET UInt32 crc32c_sse42(UInt32 crc, const UInt8* data, std::size_t len)
+		{
+			#if defined(_M_X64) || defined(__x86_64__)
+			UInt64 crc64 = crc;
+			while (len >= 8)
+			{
+				UInt64 value;
+				std::memcpy(&value, data, sizeof(UInt64));
+
+				crc64 = _mm_crc32_u64(crc64, value);
+
+				data += 8;
+				len -= 8;
+			}
+			crc = static_cast<UInt32>(crc64);
+			#endif
+
+			while (len >= 4)
+			{
+				UInt32 value;
+				std::memcpy(&value, data, sizeof(UInt32));
+
+				crc = _mm_crc32_u32(crc, value);
+
+				data += 4;
+				len -= 4;
+			}
+
+			while (len--)
+				crc = _mm_crc32_u8(crc, *data++);
+
+			return crc;
+		}
+		#endif
+
+		// The table-driven computation of HashCRC32 is used if the processor can't do better
+		CRC32CFunction GetUpdateFunction()
+		{
+			#ifdef NAZARA_CRC32C_SSE42
+			if (HardwareInfo::Initialize() && HardwareInfo::HasCapability(ProcessorCap_SSE42))
+				return crc32c_sse42;
+			#endif
+
+			return nullptr;
+		}
+	}
+
+	HashCRC32C::HashCRC32C() :
+	HashCRC32(0x1edc6f41, GetUpdateFunction())
+	{
+	}
+
+	const char* HashCRC32C::GetHashName() const
+	{
+		return "CRC32C";
+	}
+}
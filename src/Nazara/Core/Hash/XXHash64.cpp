@@ -0,0 +1,237 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+// xxHash64, by Yann Collet
+// https://github.com/Cyan4973/xxHash
+
+#include <Nazara/Core/Hash/XXHash64.hpp>
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/Endianness.hpp>
+#include <algorithm>
+#include <cstring>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	struct HashXXHash64_state
+	{
+		UInt64 accumulators[4];
+		UInt64 seed;
+		UInt64 totalLength;
+		UInt8 buffer[32];
+		std::size_t bufferSize;
+	};
+
+	namespace
+	{
+		const UInt64 prime1 = 11400714785074694791ULL;
+		const UInt64 prime2 = 14029467366897019727ULL;
+		const UInt64 prime3 =  1609587929392839161ULL;
+		const UInt64 prime4 =  9650029242287828579ULL;
+		const UInt64 prime5 =  2870177450012600261ULL;
+
+		inline UInt64 xxh64_rotl(UInt64 value, unsigned int bits)
+		{
+			return (value << bits) | (value >> (64 - bits));
+		}
+
+		inline UInt64 xxh64_read64(const UInt8* data)
+		{
+			UInt64 value;
+			std::memcpy(&value, data, sizeof(UInt64));
+
+			#ifdef NAZARA_BIG_ENDIAN
+			SwapBytes(&value, sizeof(UInt64));
+			#endif
+
+			return value;
+		}
+
+		inline UInt32 xxh64_read32(const UInt8* data)
+		{
+			UInt32 value;
+			std::memcpy(&value, data, sizeof(UInt32));
+
+			#ifdef NAZARA_BIG_ENDIAN
+			SwapBytes(&value, sizeof(UInt32));
+			#endif
+
+			return value;
+		}
+
+		inline UInt64 xxh64_round(UInt64 accumulator, UInt64 input)
+		{
+			accumulator += input * prime2;
+			accumulator = xxh64_rotl(accumulator, 31);
+			return accumulator * prime1;
+		}
+
+		inline UInt64 xxh64_merge_round(UInt64 hash, UInt64 accumulator)
+		{
+			hash ^= xxh64_round(0, accumulator);
+			return hash * prime1 + prime4;
+		}
+
+		void xxh64_init(UInt64* accumulators, UInt64 seed)
+		{
+			accumulators[0] = seed + prime1 + prime2;
+			accumulators[1] = seed + prime2;
+			accumulators[2] = seed;
+			accumulators[3] = seed - prime1;
+		}
+
+		// Processes as many 32 bytes stripes as possible, returns the number of consumed bytes
+		std::size_t xxh64_consume(UInt64* accumulators, const UInt8* data, std::size_t len)
+		{
+			UInt64 v1 = accumulators[0];
+			UInt64 v2 = accumulators[1];
+			UInt64 v3 = accumulators[2];
+			UInt64 v4 = accumulators[3];
+
+			std::size_t consumed = 0;
+			while (len - consumed >= 32)
+			{
+				const UInt8* stripe = data + consumed;
+				v1 = xxh64_round(v1, xxh64_read64(stripe));
+				v2 = xxh64_round(v2, xxh64_read64(stripe + 8));
+				v3 = xxh64_round(v3, xxh64_read64(stripe + 16));
+				v4 = xxh64_round(v4, xxh64_read64(stripe + 24));
+
+				consumed += 32;
+			}
+
+			accumulators[0] = v1;
+			accumulators[1] = v2;
+			accumulators[2] = v3;
+			accumulators[3] = v4;
+
+			return consumed;
+		}
+
+		UInt64 xxh64_finalize(const UInt64* accumulators, UInt64 seed, UInt64 totalLength, const UInt8* remaining, std::size_t len)
+		{
+			UInt64 hash;
+			if (totalLength >= 32)
+			{
+				hash = xxh64_rotl(accumulators[0], 1) + xxh64_rotl(accumulators[1], 7) + xxh64_rotl(accumulators[2], 12) + xxh64_rotl(accumulators[3], 18);
+				for (unsigned int i = 0; i < 4; ++i)
+					hash = xxh64_merge_round(hash, accumulators[i]);
+			}
+			else
+				hash = seed + prime5;
+
+			hash += totalLength;
+
+			while (len >= 8)
+			{
+				hash ^= xxh64_round(0, xxh64_read64(remaining));
+				hash = xxh64_rotl(hash, 27) * prime1 + prime4;
+
+				remaining += 8;
+				len -= 8;
+			}
+
+			if (len >= 4)
+			{
+				hash ^= UInt64(xxh64_read32(remaining)) * prime1;
+				hash = xxh64_rotl(hash, 23) * prime2 + prime3;
+
+				remaining += 4;
+				len -= 4;
+			}
+
+			while (len--)
+			{
+				hash ^= (*remaining++) * prime5;
+				hash = xxh64_rotl(hash, 11) * prime1;
+			}
+
+			hash ^= hash >> 33;
+			hash *= prime2;
+			hash ^= hash >> 29;
+			hash *= prime3;
+			hash ^= hash >> 32;
+
+			return hash;
+		}
+	}
+
+	HashXXHash64::HashXXHash64(UInt64 seed)
+	{
+		m_state = new HashXXHash64_state;
+		m_state->seed = seed;
+	}
+
+	HashXXHash64::~HashXXHash64()
+	{
+		delete m_state;
+	}
+
+	void HashXXHash64::Append(const UInt8* data, std::size_t len)
+	{
+		m_state->totalLength += len;
+
+		// Complete the pending stripe first
+		if (m_state->bufferSize > 0)
+		{
+			std::size_t copySize = std::min(len, 32 - m_state->bufferSize);
+			std::memcpy(&m_state->buffer[m_state->bufferSize], data, copySize);
+			m_state->bufferSize += copySize;
+
+			data += copySize;
+			len -= copySize;
+
+			if (m_state->bufferSize < 32)
+				return;
+
+			xxh64_consume(m_state->accumulators, m_state->buffer, 32);
+			m_state->bufferSize = 0;
+		}
+
+		std::size_t consumed = xxh64_consume(m_state->accumulators, data, len);
+
+		m_state->bufferSize = len - consumed;
+		std::memcpy(m_state->buffer, data + consumed, m_state->bufferSize);
+	}
+
+	void HashXXHash64::Begin()
+	{
+		xxh64_init(m_state->accumulators, m_state->seed);
+		m_state->bufferSize = 0;
+		m_state->totalLength = 0;
+	}
+
+	ByteArray HashXXHash64::End()
+	{
+		UInt64 hash = xxh64_finalize(m_state->accumulators, m_state->seed, m_state->totalLength, m_state->buffer, m_state->bufferSize);
+
+		#ifdef NAZARA_LITTLE_ENDIAN
+		SwapBytes(&hash, sizeof(UInt64));
+		#endif
+
+		return ByteArray(reinterpret_cast<UInt8*>(&hash), 8);
+	}
+
+	std::size_t HashXXHash64::GetDigestLength() const
+	{
+		return 8;
+	}
+
+	const char* HashXXHash64::GetHashName() const
+	{
+		return "XXHash64";
+	}
+
+	UInt64 HashXXHash64::Hash(const void* data, std::size_t size, UInt64 seed)
+	{
+		const UInt8* ptr = static_cast<const UInt8*>(data);
+
+		UInt64 accumulators[4];
+		xxh64_init(accumulators, seed);
+
+		std::size_t consumed = xxh64_consume(accumulators, ptr, size);
+
+		return xxh64_finalize(accumulators, seed, size, ptr + consumed, size - consumed);
+	}
+}
@@ -0,0 +1,462 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/MemoryPool.hpp>
+#include <Nazara/Core/Config.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <Nazara/Core/MemoryHelper.hpp>
+#include <Nazara/Core/ThreadIndex.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		// Every block is preceded by a header giving its chunk, this keeps Free in O(1) whatever the number of chunks
+		// Its size keeps the blocks aligned as the memory returned by operator new
+		constexpr unsigned int s_blockHeaderSize = 16;
+		constexpr unsigned int s_cacheLineSize = 64;
+		constexpr unsigned int s_releasedChunk = std::numeric_limits<unsigned int>::max();
+
+		unsigned int RoundUp(unsigned int value, unsigned int multiple)
+		{
+			return (value + multiple - 1) / multiple * multiple;
+		}
+	}
+
+	struct MemoryPool::Block
+	{
+		Chunk* chunk; //< nullptr if the block was allocated by operator new
+		UInt8 padding[s_blockHeaderSize - sizeof(Chunk*)];
+
+		// Only valid while the block is free (this is where the user data lies)
+		Block* next;
+		Block* nextBatch; //< Only valid for the first block of a batch
+		unsigned int batchSize; //< Same
+	};
+
+	struct MemoryPool::Chunk
+	{
+		MemoryPool* owner;
+		UInt8* blocks;
+		unsigned int trimCount; //< Free blocks counted by the last trim
+	};
+
+	struct MemoryPool::ThreadCache
+	{
+		std::atomic<Block*> head; //< Only the owning thread touches it, relaxed accesses are enough
+		std::atomic_uint count;
+	};
+
+	constexpr unsigned int MemoryPool::BatchSize;
+	constexpr unsigned int MemoryPool::MaxThreadCaches;
+
+	MemoryPool::MemoryPool(unsigned int blockSize, unsigned int size, bool canGrow) :
+	m_batches(nullptr),
+	m_globalFreeCount(0),
+	m_trimThreshold(2 * size),
+	m_canGrow(canGrow),
+	m_blockSize(blockSize),
+	m_size(size)
+	{
+		static_assert(offsetof(Block, next) == s_blockHeaderSize, "Block header has an unexpected size");
+		static_assert(sizeof(ThreadCache) <= s_cacheLineSize, "Thread cache does not fit a cache line");
+
+		NazaraAssert(size > 0, "Pool size must be over zero");
+
+		// A free block must be able to store the links of the free lists
+		unsigned int payloadSize = std::max<unsigned int>(blockSize, sizeof(Block) - s_blockHeaderSize);
+		m_blockStride = s_blockHeaderSize + RoundUp(payloadSize, s_blockHeaderSize);
+
+		// One cache line per thread to prevent false sharing
+		m_threadCacheMemory = OperatorNew(MaxThreadCaches * s_cacheLineSize + s_cacheLineSize - 1);
+
+		std::uintptr_t cacheAddress = reinterpret_cast<std::uintptr_t>(m_threadCacheMemory);
+		m_threadCaches = reinterpret_cast<UInt8*>((cacheAddress + s_cacheLineSize - 1) & ~std::uintptr_t(s_cacheLineSize - 1));
+		for (unsigned int i = 0; i < MaxThreadCaches; ++i)
+		{
+			ThreadCache* cache = PlacementNew<ThreadCache>(GetThreadCache(i));
+			cache->head.store(nullptr, std::memory_order_relaxed);
+			cache->count.store(0, std::memory_order_relaxed);
+		}
+
+		// Like before, the first chunk is allocated right away
+		LockGuard lock(m_mutex);
+
+		Block* batch = AllocateChunk();
+		PushBatch(batch);
+	}
+
+	MemoryPool::~MemoryPool()
+	{
+		///DOC: Les blocs encore alloués deviennent invalides
+		for (Chunk* chunk : m_chunks)
+			OperatorDelete(chunk);
+
+		OperatorDelete(m_threadCacheMemory);
+	}
+
+	void* MemoryPool::Allocate(unsigned int size)
+	{
+		///DOC: Si la taille est supérieure à celle d'un bloc du pool, l'opérateur new est utilisé
+		if (size > m_blockSize)
+			return AllocateFallback(size);
+
+		Block* block;
+
+		unsigned int threadIndex = ThreadIndex::Get();
+		if (threadIndex < MaxThreadCaches)
+		{
+			ThreadCache* threadCache = GetThreadCache(threadIndex);
+
+			block = threadCache->head.load(std::memory_order_relaxed);
+			unsigned int count;
+			if (!block)
+			{
+				block = PopBatch();
+				if (!block)
+					return AllocateFallback(size); // The pool cannot grow anymore
+
+				count = block->batchSize;
+			}
+			else
+				count = threadCache->count.load(std::memory_order_relaxed);
+
+			threadCache->head.store(block->next, std::memory_order_relaxed);
+			threadCache->count.store(count - 1, std::memory_order_relaxed);
+		}
+		else
+		{
+			// Too many threads, this one takes a block of a batch and gives back the rest
+			block = PopBatch();
+			if (!block)
+				return AllocateFallback(size);
+
+			Block* remaining = block->next;
+			if (remaining)
+			{
+				remaining->batchSize = block->batchSize - 1;
+				PushBatch(remaining);
+			}
+		}
+
+		return reinterpret_cast<UInt8*>(block) + s_blockHeaderSize;
+	}
+
+	void MemoryPool::Free(void* ptr)
+	{
+		///DOC: Le bloc peut être libéré depuis n'importe quel thread, et même depuis un autre pool
+		///DOC: Le pointeur doit provenir d'Allocate ou de New (d'un pool quelconque), la provenance étant lue dans l'en-tête du bloc
+		///DOC: Un pointeur alloué en dehors d'un pool ne doit donc pas lui être passé
+		if (!ptr)
+			return;
+
+		Block* block = GetBlock(ptr);
+
+		Chunk* chunk = block->chunk;
+		if (!chunk)
+		{
+			OperatorDelete(block);
+			return;
+		}
+
+		MemoryPool* owner = chunk->owner;
+
+		#if NAZARA_CORE_SAFE
+		UInt8* blockPtr = reinterpret_cast<UInt8*>(block);
+		if (blockPtr < chunk->blocks || blockPtr >= chunk->blocks + owner->m_blockStride * owner->m_size)
+			throw std::runtime_error("Invalid pointer (does not point to an element of the pool)");
+		#endif
+
+		owner->Release(block);
+	}
+
+	unsigned int MemoryPool::GetBlockSize() const
+	{
+		return m_blockSize;
+	}
+
+	unsigned int MemoryPool::GetChunkCount() const
+	{
+		LockGuard lock(m_mutex);
+
+		return static_cast<unsigned int>(m_chunks.size());
+	}
+
+	unsigned int MemoryPool::GetFreeBlocks() const
+	{
+		///DOC: Inclut les blocs mis en cache par les threads, le résultat est approximatif si d'autres threads utilisent le pool
+		unsigned int freeBlocks = m_globalFreeCount.load(std::memory_order_relaxed);
+		for (unsigned int i = 0; i < MaxThreadCaches; ++i)
+			freeBlocks += GetThreadCache(i)->count.load(std::memory_order_relaxed);
+
+		return freeBlocks;
+	}
+
+	unsigned int MemoryPool::GetSize() const
+	{
+		///DOC: Nombre de blocs par chunk
+		return m_size;
+	}
+
+	void MemoryPool::Trim()
+	{
+		///DOC: Libère les chunks entièrement libres (en gardant un chunk d'avance)
+		///DOC: Seul le cache du thread appelant est vidé, les blocs en cache dans les autres threads gardent leur chunk en vie
+		unsigned int threadIndex = ThreadIndex::Get();
+		if (threadIndex < MaxThreadCaches)
+		{
+			ThreadCache* threadCache = GetThreadCache(threadIndex);
+
+			Block* batch = threadCache->head.load(std::memory_order_relaxed);
+			if (batch)
+			{
+				batch->batchSize = threadCache->count.load(std::memory_order_relaxed);
+				PushBatch(batch);
+
+				threadCache->head.store(nullptr, std::memory_order_relaxed);
+				threadCache->count.store(0, std::memory_order_relaxed);
+			}
+		}
+
+		LockGuard lock(m_mutex);
+
+		TrimInternal();
+	}
+
+	MemoryPool::Block* MemoryPool::AllocateChunk()
+	{
+		// m_mutex must be locked
+		if (!m_canGrow && !m_chunks.empty())
+			return nullptr;
+
+		unsigned int headerSize = RoundUp(sizeof(Chunk), s_blockHeaderSize);
+
+		Chunk* chunk = static_cast<Chunk*>(OperatorNew(headerSize + m_blockStride * m_size));
+		chunk->owner = this;
+		chunk->blocks = reinterpret_cast<UInt8*>(chunk) + headerSize;
+		chunk->trimCount = 0;
+
+		m_chunks.push_back(chunk);
+
+		// The chunk is split into batches, the first one is returned and the others go to the global list
+		Block* firstBatch = nullptr;
+		for (unsigned int first = 0; first < m_size; first += BatchSize)
+		{
+			unsigned int batchSize = std::min(BatchSize, m_size - first);
+
+			Block* batch = nullptr;
+			for (unsigned int i = first + batchSize; i-- > first;)
+			{
+				Block* block = reinterpret_cast<Block*>(chunk->blocks + i * m_blockStride);
+				block->chunk = chunk;
+				block->next = batch;
+				batch = block;
+			}
+			batch->batchSize = batchSize;
+
+			if (firstBatch)
+				PushBatch(batch);
+			else
+				firstBatch = batch;
+		}
+
+		// The free blocks are back to zero, the next trim will only happen after two chunks have been freed
+		m_trimThreshold.store(m_globalFreeCount.load(std::memory_order_relaxed) + 2 * m_size, std::memory_order_relaxed);
+
+		return firstBatch;
+	}
+
+	void* MemoryPool::AllocateFallback(unsigned int size)
+	{
+		// The header tells Free that this block comes from operator new
+		Block* block = static_cast<Block*>(OperatorNew(s_blockHeaderSize + size));
+		block->chunk = nullptr;
+
+		return reinterpret_cast<UInt8*>(block) + s_blockHeaderSize;
+	}
+
+	MemoryPool::Block* MemoryPool::PopBatch()
+	{
+		// Pushes are lock-free but pops are serialized, which prevents the ABA problem (a batch cannot be popped and pushed back while we are popping it)
+		LockGuard lock(m_mutex);
+
+		Block* batch = m_batches.load(std::memory_order_acquire);
+		while (batch && !m_batches.compare_exchange_weak(batch, batch->nextBatch, std::memory_order_acquire, std::memory_order_acquire));
+
+		if (batch)
+		{
+			m_globalFreeCount.fetch_sub(batch->batchSize, std::memory_order_relaxed);
+			return batch;
+		}
+		else
+			return AllocateChunk();
+	}
+
+	void MemoryPool::PushBatch(Block* batch)
+	{
+		// The counter is increased first so that it never goes under zero
+		m_globalFreeCount.fetch_add(batch->batchSize, std::memory_order_relaxed);
+
+		Block* head = m_batches.load(std::memory_order_relaxed);
+		do
+		{
+			batch->nextBatch = head;
+		}
+		while (!m_batches.compare_exchange_weak(head, batch, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	inline void MemoryPool::Release(Block* block)
+	{
+		unsigned int threadIndex = ThreadIndex::Get();
+		if (threadIndex < MaxThreadCaches)
+		{
+			ThreadCache* threadCache = GetThreadCache(threadIndex);
+
+			Block* head = threadCache->head.load(std::memory_order_relaxed);
+			unsigned int count = threadCache->count.load(std::memory_order_relaxed) + 1;
+
+			block->next = head;
+			head = block;
+
+			// A thread freeing more than it allocates (a consumer) gives its blocks back by batches
+			if (count >= 2 * BatchSize)
+			{
+				Block* last = head;
+				for (unsigned int i = 1; i < BatchSize; ++i)
+					last = last->next;
+
+				Block* batch = head;
+				head = last->next;
+				last->next = nullptr;
+				count -= BatchSize;
+
+				batch->batchSize = BatchSize;
+				PushBatch(batch);
+				TrimIfNeeded();
+			}
+
+			threadCache->head.store(head, std::memory_order_relaxed);
+			threadCache->count.store(count, std::memory_order_relaxed);
+		}
+		else
+		{
+			block->next = nullptr;
+			block->batchSize = 1;
+			PushBatch(block);
+			TrimIfNeeded();
+		}
+	}
+
+	void MemoryPool::TrimIfNeeded()
+	{
+		// Hysteresis: chunks are only released once enough free blocks accumulated since the last growth or trim
+		if (m_globalFreeCount.load(std::memory_order_relaxed) > m_trimThreshold.load(std::memory_order_relaxed) && m_mutex.TryLock())
+		{
+			TrimInternal();
+			m_mutex.Unlock();
+		}
+	}
+
+	void MemoryPool::TrimInternal()
+	{
+		// m_mutex must be locked, which prevents any pop while the list is rebuilt (other threads can still push)
+		Block* batches = m_batches.exchange(nullptr, std::memory_order_acquire);
+
+		for (Chunk* chunk : m_chunks)
+			chunk->trimCount = 0;
+
+		unsigned int blockCount = 0;
+		for (Block* batch = batches; batch; batch = batch->nextBatch)
+		{
+			for (Block* block = batch; block; block = block->next)
+			{
+				block->chunk->trimCount++;
+				blockCount++;
+			}
+		}
+
+		m_globalFreeCount.fetch_sub(blockCount, std::memory_order_relaxed);
+
+		// Fully free chunks are released, except one to absorb the next allocations
+		bool spareKept = false;
+		for (Chunk* chunk : m_chunks)
+		{
+			if (chunk->trimCount == m_size)
+			{
+				if (spareKept)
+					chunk->trimCount = s_releasedChunk;
+				else
+					spareKept = true;
+			}
+		}
+
+		// The remaining blocks are put back in batches
+		Block* batch = nullptr;
+		unsigned int batchSize = 0;
+		Block* batchList = batches;
+		while (batchList)
+		{
+			Block* nextBatch = batchList->nextBatch;
+			Block* block = batchList;
+			while (block)
+			{
+				Block* next = block->next;
+				if (block->chunk->trimCount != s_releasedChunk)
+				{
+					block->next = batch;
+					batch = block;
+
+					if (++batchSize == BatchSize)
+					{
+						batch->batchSize = batchSize;
+						PushBatch(batch);
+
+						batch = nullptr;
+						batchSize = 0;
+					}
+				}
+
+				block = next;
+			}
+
+			batchList = nextBatch;
+		}
+
+		if (batch)
+		{
+			batch->batchSize = batchSize;
+			PushBatch(batch);
+		}
+
+		auto it = std::remove_if(m_chunks.begin(), m_chunks.end(), [] (Chunk* chunk)
+		{
+			if (chunk->trimCount != s_releasedChunk)
+				return false;
+
+			OperatorDelete(chunk);
+			return true;
+		});
+		m_chunks.erase(it, m_chunks.end());
+
+		m_trimThreshold.store(m_globalFreeCount.load(std::memory_order_relaxed) + 2 * m_size, std::memory_order_relaxed);
+	}
+
+	inline MemoryPool::ThreadCache* MemoryPool::GetThreadCache(unsigned int threadIndex) const
+	{
+		return reinterpret_cast<ThreadCache*>(m_threadCaches + threadIndex * s_cacheLineSize);
+	}
+
+	MemoryPool::Block* MemoryPool::GetBlock(void* ptr)
+	{
+		return reinterpret_cast<Block*>(static_cast<UInt8*>(ptr) - s_blockHeaderSize);
+	}
+
+}
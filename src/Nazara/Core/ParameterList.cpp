@@ -32,10 +32,218 @@ namespace Nz
 
 	bool ParameterList::GetBooleanParameter(const String& name, bool* value) const
 	{
-		auto it = m_parameters.find(name);
+		return GetBooleanParameter(ParameterKey(name), value);
+	}
+
+	bool ParameterList::GetBooleanParameter(const StringId& name, bool* value) const
+	{
+		return GetBooleanParameter(ParameterKey(name), value);
+	}
+
+	bool ParameterList::GetFloatParameter(const String& name, float* value) const
+	{
+		return GetFloatParameter(ParameterKey(name), value);
+	}
+
+	bool ParameterList::GetFloatParameter(const StringId& name, float* value) const
+	{
+		return GetFloatParameter(ParameterKey(name), value);
+	}
+
+	bool ParameterList::GetIntegerParameter(const String& name, int* value) const
+	{
+		return GetIntegerParameter(ParameterKey(name), value);
+	}
+
+	bool ParameterList::GetIntegerParameter(const StringId& name, int* value) const
+	{
+		return GetIntegerParameter(ParameterKey(name), value);
+	}
+
+	bool ParameterList::GetParameterType(const String& name, ParameterType* type) const
+	{
+		return GetParameterType(ParameterKey(name), type);
+	}
+
+	bool ParameterList::GetParameterType(const StringId& name, ParameterType* type) const
+	{
+		return GetParameterType(ParameterKey(name), type);
+	}
+
+	bool ParameterList::GetPointerParameter(const String& name, void** value) const
+	{
+		return GetPointerParameter(ParameterKey(name), value);
+	}
+
+	bool ParameterList::GetPointerParameter(const StringId& name, void** value) const
+	{
+		return GetPointerParameter(ParameterKey(name), value);
+	}
+
+	bool ParameterList::GetStringParameter(const String& name, String* value) const
+	{
+		return GetStringParameter(ParameterKey(name), value);
+	}
+
+	bool ParameterList::GetStringParameter(const StringId& name, String* value) const
+	{
+		return GetStringParameter(ParameterKey(name), value);
+	}
+
+	bool ParameterList::GetUserdataParameter(const String& name, void** value) const
+	{
+		return GetUserdataParameter(ParameterKey(name), value);
+	}
+
+	bool ParameterList::GetUserdataParameter(const StringId& name, void** value) const
+	{
+		return GetUserdataParameter(ParameterKey(name), value);
+	}
+
+	bool ParameterList::HasParameter(const String& name) const
+	{
+		return HasParameter(ParameterKey(name));
+	}
+
+	bool ParameterList::HasParameter(const StringId& name) const
+	{
+		return HasParameter(ParameterKey(name));
+	}
+
+	void ParameterList::RemoveParameter(const String& name)
+	{
+		RemoveParameter(ParameterKey(name));
+	}
+
+	void ParameterList::RemoveParameter(const StringId& name)
+	{
+		RemoveParameter(ParameterKey(name));
+	}
+
+	void ParameterList::SetParameter(const String& name)
+	{
+		SetParameter(ParameterKey(name));
+	}
+
+	void ParameterList::SetParameter(const StringId& name)
+	{
+		SetParameter(ParameterKey(name));
+	}
+
+	void ParameterList::SetParameter(const String& name, const String& value)
+	{
+		SetParameter(ParameterKey(name), value);
+	}
+
+	void ParameterList::SetParameter(const StringId& name, const String& value)
+	{
+		SetParameter(ParameterKey(name), value);
+	}
+
+	void ParameterList::SetParameter(const String& name, const char* value)
+	{
+		SetParameter(ParameterKey(name), value);
+	}
+
+	void ParameterList::SetParameter(const StringId& name, const char* value)
+	{
+		SetParameter(ParameterKey(name), value);
+	}
+
+	void ParameterList::SetParameter(const String& name, void* value)
+	{
+		SetParameter(ParameterKey(name), value);
+	}
+
+	void ParameterList::SetParameter(const StringId& name, void* value)
+	{
+		SetParameter(ParameterKey(name), value);
+	}
+
+	void ParameterList::SetParameter(const String& name, void* value, Destructor destructor)
+	{
+		SetParameter(ParameterKey(name), value, destructor);
+	}
+
+	void ParameterList::SetParameter(const StringId& name, void* value, Destructor destructor)
+	{
+		SetParameter(ParameterKey(name), value, destructor);
+	}
+
+	void ParameterList::SetParameter(const String& name, bool value)
+	{
+		SetParameter(ParameterKey(name), value);
+	}
+
+	void ParameterList::SetParameter(const StringId& name, bool value)
+	{
+		SetParameter(ParameterKey(name), value);
+	}
+
+	void ParameterList::SetParameter(const String& name, float value)
+	{
+		SetParameter(ParameterKey(name), value);
+	}
+
+	void ParameterList::SetParameter(const StringId& name, float value)
+	{
+		SetParameter(ParameterKey(name), value);
+	}
+
+	void ParameterList::SetParameter(const String& name, int value)
+	{
+		SetParameter(ParameterKey(name), value);
+	}
+
+	void ParameterList::SetParameter(const StringId& name, int value)
+	{
+		SetParameter(ParameterKey(name), value);
+	}
+
+	ParameterList& ParameterList::operator=(const ParameterList& list)
+	{
+		Clear();
+
+		for (auto it = list.m_parameters.begin(); it != list.m_parameters.end(); ++it)
+		{
+			Parameter& parameter = m_parameters[it->first];
+
+			switch (it->second.type)
+			{
+				case ParameterType_Boolean:
+				case ParameterType_Float:
+				case ParameterType_Integer:
+				case ParameterType_Pointer:
+					std::memcpy(&parameter, &it->second, sizeof(Parameter));
+					break;
+
+				case ParameterType_String:
+					parameter.type = ParameterType_String;
+
+					PlacementNew<String>(&parameter.value.stringVal, it->second.value.stringVal);
+					break;
+
+				case ParameterType_Userdata:
+					parameter.type = ParameterType_Userdata;
+					parameter.value.userdataVal = it->second.value.userdataVal;
+					++(parameter.value.userdataVal->counter);
+					break;
+
+				case ParameterType_None:
+					parameter.type = ParameterType_None;
+					break;
+			}
+		}
+
+		return *this;
+	}
+
+	bool ParameterList::GetBooleanParameter(const ParameterKey& key, bool* value) const
+	{
+		auto it = m_parameters.find(key);
 		if (it == m_parameters.end())
 		{
-			NazaraError("Parameter \"" + name + "\" is not present");
+			NazaraError("Parameter \"" + *key.name + "\" is not present");
 			return false;
 		}
 
@@ -72,12 +280,12 @@ namespace Nz
 		return false;
 	}
 
-	bool ParameterList::GetFloatParameter(const String& name, float* value) const
+	bool ParameterList::GetFloatParameter(const ParameterKey& key, float* value) const
 	{
-		auto it = m_parameters.find(name);
+		auto it = m_parameters.find(key);
 		if (it == m_parameters.end())
 		{
-			NazaraError("Parameter \"" + name + "\" is not present");
+			NazaraError("Parameter \"" + *key.name + "\" is not present");
 			return false;
 		}
 
@@ -114,12 +322,12 @@ namespace Nz
 		return false;
 	}
 
-	bool ParameterList::GetIntegerParameter(const String& name, int* value) const
+	bool ParameterList::GetIntegerParameter(const ParameterKey& key, int* value) const
 	{
-		auto it = m_parameters.find(name);
+		auto it = m_parameters.find(key);
 		if (it == m_parameters.end())
 		{
-			NazaraError("Parameter \"" + name + "\" is not present");
+			NazaraError("Parameter \"" + *key.name + "\" is not present");
 			return false;
 		}
 
@@ -135,7 +343,7 @@ namespace Nz
 
 			case ParameterType_Integer:
 				*value = it->second.value.intVal;
-				return false;
+				return true;
 
 			case ParameterType_String:
 			{
@@ -161,9 +369,9 @@ namespace Nz
 		return false;
 	}
 
-	bool ParameterList::GetParameterType(const String& name, ParameterType* type) const
+	bool ParameterList::GetParameterType(const ParameterKey& key, ParameterType* type) const
 	{
-		auto it = m_parameters.find(name);
+		auto it = m_parameters.find(key);
 		if (it == m_parameters.end())
 			return false;
 
@@ -172,12 +380,12 @@ namespace Nz
 		return true;
 	}
 
-	bool ParameterList::GetPointerParameter(const String& name, void** value) const
+	bool ParameterList::GetPointerParameter(const ParameterKey& key, void** value) const
 	{
-		auto it = m_parameters.find(name);
+		auto it = m_parameters.find(key);
 		if (it == m_parameters.end())
 		{
-			NazaraError("Parameter \"" + name + "\" is not present");
+			NazaraError("Parameter \"" + *key.name + "\" is not present");
 			return false;
 		}
 
@@ -203,12 +411,12 @@ namespace Nz
 		return false;
 	}
 
-	bool ParameterList::GetStringParameter(const String& name, String* value) const
+	bool ParameterList::GetStringParameter(const ParameterKey& key, String* value) const
 	{
-		auto it = m_parameters.find(name);
+		auto it = m_parameters.find(key);
 		if (it == m_parameters.end())
 		{
-			NazaraError("Parameter \"" + name + "\" is not present");
+			NazaraError("Parameter \"" + *key.name + "\" is not present");
 			return false;
 		}
 
@@ -247,12 +455,12 @@ namespace Nz
 		return false;
 	}
 
-	bool ParameterList::GetUserdataParameter(const String& name, void** value) const
+	bool ParameterList::GetUserdataParameter(const ParameterKey& key, void** value) const
 	{
-		auto it = m_parameters.find(name);
+		auto it = m_parameters.find(key);
 		if (it == m_parameters.end())
 		{
-			NazaraError("Parameter \"" + name + "\" is not present");
+			NazaraError("Parameter \"" + *key.name + "\" is not present");
 			return false;
 		}
 
@@ -268,14 +476,14 @@ namespace Nz
 		}
 	}
 
-	bool ParameterList::HasParameter(const String& name) const
+	bool ParameterList::HasParameter(const ParameterKey& key) const
 	{
-		return m_parameters.find(name) != m_parameters.end();
+		return m_parameters.find(key) != m_parameters.end();
 	}
 
-	void ParameterList::RemoveParameter(const String& name)
+	void ParameterList::RemoveParameter(const ParameterKey& key)
 	{
-		auto it = m_parameters.find(name);
+		auto it = m_parameters.find(key);
 		if (it != m_parameters.end())
 		{
 			DestroyValue(it->second);
@@ -283,9 +491,9 @@ namespace Nz
 		}
 	}
 
-	void ParameterList::SetParameter(const String& name)
+	void ParameterList::SetParameter(const ParameterKey& key)
 	{
-		std::pair<ParameterMap::iterator, bool> pair = m_parameters.insert(std::make_pair(name, Parameter()));
+		std::pair<ParameterMap::iterator, bool> pair = m_parameters.insert(std::make_pair(key, Parameter()));
 		Parameter& parameter = pair.first->second;
 
 		if (!pair.second)
@@ -294,9 +502,9 @@ namespace Nz
 		parameter.type = ParameterType_None;
 	}
 
-	void ParameterList::SetParameter(const String& name, const String& value)
+	void ParameterList::SetParameter(const ParameterKey& key, const String& value)
 	{
-		std::pair<ParameterMap::iterator, bool> pair = m_parameters.insert(std::make_pair(name, Parameter()));
+		std::pair<ParameterMap::iterator, bool> pair = m_parameters.insert(std::make_pair(key, Parameter()));
 		Parameter& parameter = pair.first->second;
 
 		if (!pair.second)
@@ -307,9 +515,9 @@ namespace Nz
 		PlacementNew<String>(&parameter.value.stringVal, value);
 	}
 
-	void ParameterList::SetParameter(const String& name, const char* value)
+	void ParameterList::SetParameter(const ParameterKey& key, const char* value)
 	{
-		std::pair<ParameterMap::iterator, bool> pair = m_parameters.insert(std::make_pair(name, Parameter()));
+		std::pair<ParameterMap::iterator, bool> pair = m_parameters.insert(std::make_pair(key, Parameter()));
 		Parameter& parameter = pair.first->second;
 
 		if (!pair.second)
@@ -320,9 +528,9 @@ namespace Nz
 		PlacementNew<String>(&parameter.value.stringVal, value);
 	}
 
-	void ParameterList::SetParameter(const String& name, void* value)
+	void ParameterList::SetParameter(const ParameterKey& key, void* value)
 	{
-		std::pair<ParameterMap::iterator, bool> pair = m_parameters.insert(std::make_pair(name, Parameter()));
+		std::pair<ParameterMap::iterator, bool> pair = m_parameters.insert(std::make_pair(key, Parameter()));
 		Parameter& parameter = pair.first->second;
 
 		if (!pair.second)
@@ -332,9 +540,9 @@ namespace Nz
 		parameter.value.ptrVal = value;
 	}
 
-	void ParameterList::SetParameter(const String& name, void* value, Destructor destructor)
+	void ParameterList::SetParameter(const ParameterKey& key, void* value, Destructor destructor)
 	{
-		std::pair<ParameterMap::iterator, bool> pair = m_parameters.insert(std::make_pair(name, Parameter()));
+		std::pair<ParameterMap::iterator, bool> pair = m_parameters.insert(std::make_pair(key, Parameter()));
 		Parameter& parameter = pair.first->second;
 
 		if (!pair.second)
@@ -344,9 +552,9 @@ namespace Nz
 		parameter.value.userdataVal = new Parameter::UserdataValue(destructor, value);
 	}
 
-	void ParameterList::SetParameter(const String& name, bool value)
+	void ParameterList::SetParameter(const ParameterKey& key, bool value)
 	{
-		std::pair<ParameterMap::iterator, bool> pair = m_parameters.insert(std::make_pair(name, Parameter()));
+		std::pair<ParameterMap::iterator, bool> pair = m_parameters.insert(std::make_pair(key, Parameter()));
 		Parameter& parameter = pair.first->second;
 
 		if (!pair.second)
@@ -356,9 +564,9 @@ namespace Nz
 		parameter.value.boolVal = value;
 	}
 
-	void ParameterList::SetParameter(const String& name, float value)
+	void ParameterList::SetParameter(const ParameterKey& key, float value)
 	{
-		std::pair<ParameterMap::iterator, bool> pair = m_parameters.insert(std::make_pair(name, Parameter()));
+		std::pair<ParameterMap::iterator, bool> pair = m_parameters.insert(std::make_pair(key, Parameter()));
 		Parameter& parameter = pair.first->second;
 
 		if (!pair.second)
@@ -368,9 +576,9 @@ namespace Nz
 		parameter.value.floatVal = value;
 	}
 
-	void ParameterList::SetParameter(const String& name, int value)
+	void ParameterList::SetParameter(const ParameterKey& key, int value)
 	{
-		std::pair<ParameterMap::iterator, bool> pair = m_parameters.insert(std::make_pair(name, Parameter()));
+		std::pair<ParameterMap::iterator, bool> pair = m_parameters.insert(std::make_pair(key, Parameter()));
 		Parameter& parameter = pair.first->second;
 
 		if (!pair.second)
@@ -380,44 +588,6 @@ namespace Nz
 		parameter.value.intVal = value;
 	}
 
-	ParameterList& ParameterList::operator=(const ParameterList& list)
-	{
-		Clear();
-
-		for (auto it = list.m_parameters.begin(); it != list.m_parameters.end(); ++it)
-		{
-			Parameter& parameter = m_parameters[it->first];
-
-			switch (it->second.type)
-			{
-				case ParameterType_Boolean:
-				case ParameterType_Float:
-				case ParameterType_Integer:
-				case ParameterType_Pointer:
-					std::memcpy(&parameter, &it->second, sizeof(Parameter));
-					break;
-
-				case ParameterType_String:
-					parameter.type = ParameterType_String;
-
-					PlacementNew<String>(&parameter.value.stringVal, it->second.value.stringVal);
-					break;
-
-				case ParameterType_Userdata:
-					parameter.type = ParameterType_Userdata;
-					parameter.value.userdataVal = it->second.value.userdataVal;
-					++(parameter.value.userdataVal->counter);
-					break;
-
-				case ParameterType_None:
-					parameter.type = ParameterType_None;
-					break;
-			}
-		}
-
-		return *this;
-	}
-
 	void ParameterList::DestroyValue(Parameter& parameter)
 	{
 		switch (parameter.type)
@@ -445,4 +615,34 @@ namespace Nz
 				break;
 		}
 	}
+
+	ParameterList::ParameterKey::ParameterKey(const String& keyName) :
+	name(&keyName),
+	hash(std::hash<String>()(keyName))
+	{
+	}
+
+	ParameterList::ParameterKey::ParameterKey(const StringId& keyId) :
+	id(keyId),
+	name(&keyId.GetString()),
+	hash(keyId.GetHash())
+	{
+	}
+
+	ParameterList::ParameterKey::ParameterKey(const ParameterKey& key) :
+	id(key.id),
+	storage(*key.name),
+	name(&storage),
+	hash(key.hash)
+	{
+	}
+
+	bool ParameterList::ParameterKey::operator==(const ParameterKey& key) const
+	{
+		// Two interned names are the same string only if they are the same entry
+		if (!id.IsEmpty() && !key.id.IsEmpty())
+			return id == key.id;
+
+		return hash == key.hash && *name == *key.name;
+	}
 }
@@ -5,6 +5,7 @@
 #include <Nazara/Core/Posix/TaskSchedulerImpl.hpp>
 #include <Nazara/Core/Config.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
 #include <Nazara/Core/Debug.hpp>
 
 namespace Nz
@@ -156,7 +157,7 @@ namespace Nz
 			{
 				// On exécute la tâche avant de la supprimer
 				task->Run();
-				delete task;
+				TaskScheduler::ReleaseTask(task);
 			}
 			else
 			{
@@ -0,0 +1,90 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/StringId.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <Nazara/Core/Mutex.hpp>
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	struct StringId::Table
+	{
+		Mutex mutex;
+		std::unordered_map<String, std::unique_ptr<Entry>> entries;
+	};
+
+	StringId::StringId(const char* string) :
+	StringId(string, (string) ? std::strlen(string) : 0)
+	{
+	}
+
+	StringId::StringId(const char* string, std::size_t length) :
+	StringId(String(string, length))
+	{
+	}
+
+	StringId::StringId(const String& string) :
+	m_entry(nullptr)
+	{
+		if (string.IsEmpty())
+			return;
+
+		Table& table = GetTable();
+		LockGuard lock(table.mutex);
+
+		std::unique_ptr<Entry>& entry = table.entries[string];
+		if (!entry)
+		{
+			entry.reset(new Entry);
+			entry->hash = std::hash<String>()(string);
+			entry->string = string;
+		}
+
+		m_entry = entry.get();
+	}
+
+	bool StringId::Find(const char* string, std::size_t length, StringId* id)
+	{
+		return Find(String(string, length), id);
+	}
+
+	bool StringId::Find(const String& string, StringId* id)
+	{
+		NazaraAssert(id, "Invalid id pointer");
+
+		if (string.IsEmpty())
+		{
+			id->m_entry = nullptr;
+			return true;
+		}
+
+		Table& table = GetTable();
+		LockGuard lock(table.mutex);
+
+		auto it = table.entries.find(string);
+		if (it == table.entries.end())
+			return false;
+
+		id->m_entry = it->second.get();
+		return true;
+	}
+
+	const String& StringId::GetEmptyString()
+	{
+		static String emptyString;
+		return emptyString;
+	}
+
+	StringId::Table& StringId::GetTable()
+	{
+		// Never destroyed, identifiers may still be used by static objects during the program exit
+		static Table* table = new Table;
+		return *table;
+	}
+}
@@ -84,9 +84,25 @@ namespace Nz
 		if (!Initialize())
 		{
 			NazaraError("Failed to initialize Task Scheduler");
+			ReleaseTask(taskFunctor);
 			return;
 		}
 
 		s_pendingWorks.push_back(taskFunctor);
 	}
+
+	MemoryPool& TaskScheduler::GetTaskPool()
+	{
+		// Tasks are allocated by the main thread and released by the workers, which is what the thread caches of the pool are made for
+		// Most functors (a lambda with a few captures) fit in a block, bigger ones are allocated by the pool through operator new
+		// The pool is never destroyed, tasks may still be released by the workers during the static destruction
+		static MemoryPool* pool = new MemoryPool(64, 256);
+		return *pool;
+	}
+
+	void TaskScheduler::ReleaseTask(Functor* task)
+	{
+		// Functor is the first (and only) base of every task, its address is the one given by the pool
+		GetTaskPool().Delete(task);
+	}
 }
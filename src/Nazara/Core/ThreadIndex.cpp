@@ -0,0 +1,73 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Core/ThreadIndex.hpp>
+#include <Nazara/Core/LockGuard.hpp>
+#include <Nazara/Core/Mutex.hpp>
+#include <vector>
+#include <Nazara/Core/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		std::vector<unsigned int>& GetFreeIndexes()
+		{
+			static std::vector<unsigned int> freeIndexes;
+			return freeIndexes;
+		}
+
+		Mutex& GetMutex()
+		{
+			static Mutex mutex;
+			return mutex;
+		}
+	}
+
+	constexpr unsigned int ThreadIndex::InvalidIndex;
+
+	struct ThreadIndex::IndexOwner
+	{
+		IndexOwner(unsigned int threadIndex) :
+		index(threadIndex)
+		{
+		}
+
+		~IndexOwner()
+		{
+			// Destructors of thread_locals constructed before this one run afterwards and must not use the slot anymore
+			ThreadIndex::GetStorage() = ThreadIndex::InvalidIndex;
+
+			LockGuard lock(GetMutex());
+			GetFreeIndexes().push_back(index);
+		}
+
+		unsigned int index;
+	};
+
+	unsigned int ThreadIndex::Acquire()
+	{
+		unsigned int index;
+		{
+			LockGuard lock(GetMutex());
+
+			static unsigned int nextIndex = 0;
+
+			std::vector<unsigned int>& freeIndexes = GetFreeIndexes();
+			if (!freeIndexes.empty())
+			{
+				index = freeIndexes.back();
+				freeIndexes.pop_back();
+			}
+			else
+				index = nextIndex++;
+		}
+
+		// Gives the index back when the thread ends
+		thread_local IndexOwner owner(index);
+		GetStorage() = index + 1;
+
+		return index;
+	}
+}
@@ -0,0 +1,55 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Core module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#pragma once
+
+#ifndef NAZARA_THREADINDEX_HPP
+#define NAZARA_THREADINDEX_HPP
+
+#include <Nazara/Prerequesites.hpp>
+#include <limits>
+
+namespace Nz
+{
+	// Small index identifying the current thread, used to give each thread its own slot in per-thread caches
+	// Indexes are given back when a thread ends, so that the next thread inherits the slots (and what they cache)
+	// Once given back, Get returns InvalidIndex for the rest of the thread (e.g. from a later thread_local destructor)
+	class ThreadIndex
+	{
+		public:
+			ThreadIndex() = delete;
+			~ThreadIndex() = delete;
+
+			static inline unsigned int Get();
+
+			static constexpr unsigned int InvalidIndex = std::numeric_limits<unsigned int>::max();
+
+		private:
+			struct IndexOwner;
+
+			static unsigned int Acquire();
+			static inline unsigned int& GetStorage();
+	};
+
+	unsigned int ThreadIndex::Get()
+	{
+		unsigned int index = GetStorage();
+		if (index == 0)
+			return Acquire();
+		else if (index == InvalidIndex)
+			return InvalidIndex; // Already given back, the slot may belong to another thread now
+		else
+			return index - 1;
+	}
+
+	unsigned int& ThreadIndex::GetStorage()
+	{
+		// Index + 1 of the current thread (0 before acquisition, InvalidIndex once given back)
+		// A trivially initialized thread_local is much faster to access than an object
+		thread_local unsigned int index = 0;
+		return index;
+	}
+}
+
+#endif // NAZARA_THREADINDEX_HPP
@@ -5,6 +5,7 @@
 #include <Nazara/Core/Win32/TaskSchedulerImpl.hpp>
 #include <Nazara/Core/Config.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
 #include <cstdlib> // std::ldiv
 #include <process.h>
 #include <Nazara/Core/Debug.hpp>
@@ -225,7 +226,7 @@ namespace Nz
 			{
 				// On exécute la tâche avant de la supprimer
 				task->Run();
-				delete task;
+				TaskScheduler::ReleaseTask(task);
 			}
 			else
 			{
@@ -271,9 +271,6 @@ namespace Nz
 					continue;
 				}
 
-				if (parameters.mesh.optimizeIndexBuffers)
-					indexBuffer->Optimize();
-
 				subMesh->GenerateAABB();
 				subMesh->SetIndexBuffer(indexBuffer);
 				subMesh->SetMaterialIndex(meshes[i].material);
@@ -291,6 +288,9 @@ namespace Nz
 			}
 			mesh->SetMaterialCount(parser.GetMaterialCount());
 
+			// Les sous-meshs sont optimisés ensemble (en parallèle)
+			mesh->Optimize(parameters.mesh.GetOptimizationFlags());
+
 			if (parameters.mesh.center)
 				mesh->Recenter();
 
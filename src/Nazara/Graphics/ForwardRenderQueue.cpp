@@ -11,6 +11,19 @@
 
 namespace Nz
 {
+	namespace
+	{
+		template<typename T>
+		void RebindFrameVector(FrameVector<T>& vector, FrameAllocator& allocator)
+		{
+			// The vector is empty and its storage was reclaimed by the frame allocator, the new one is reserved at the size it reached last frame
+			FrameVector<T> newVector{FrameAllocatorAdaptor<T>(allocator)};
+			newVector.reserve(vector.capacity());
+
+			vector.swap(newVector);
+		}
+	}
+
 	void ForwardRenderQueue::AddBillboard(int renderOrder, const Material* material, const Vector3f& position, const Vector2f& size, const Vector2f& sinCos, const Color& color)
 	{
 		NazaraAssert(material, "Invalid material");
@@ -512,10 +525,41 @@ namespace Nz
 					layer.otherDrawables.clear();
 					layer.transparentModels.clear();
 					layer.transparentModelData.clear();
+
+					for (auto& pair : layer.billboards)
+						pair.second.billboards.clear();
+
+					for (auto& pair : layer.basicSprites)
+					{
+						for (auto& overlayPair : pair.second.overlayMap)
+							overlayPair.second.spriteChains.clear();
+					}
+
 					++it;
 				}
 			}
 		}
+
+		// Per-frame containers are empty, their memory can be given back at once
+		m_frameAllocator->Reset();
+
+		for (auto& pair : layers)
+		{
+			Layer& layer = pair.second;
+
+			RebindFrameVector(layer.otherDrawables, *m_frameAllocator);
+			RebindFrameVector(layer.transparentModels, *m_frameAllocator);
+			RebindFrameVector(layer.transparentModelData, *m_frameAllocator);
+
+			for (auto& billboardPair : layer.billboards)
+				RebindFrameVector(billboardPair.second.billboards, *m_frameAllocator);
+
+			for (auto& spritePair : layer.basicSprites)
+			{
+				for (auto& overlayPair : spritePair.second.overlayMap)
+					RebindFrameVector(overlayPair.second.spriteChains, *m_frameAllocator);
+			}
+		}
 	}
 
 	void ForwardRenderQueue::Sort(const AbstractViewer* viewer)
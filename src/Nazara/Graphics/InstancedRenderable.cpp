@@ -42,5 +42,14 @@ namespace Nz
 		NazaraAssert(instanceData, "Invalid instance data");
 	}
 
+	void InstancedRenderable::UpdateLod(float viewerDistance, bool visible)
+	{
+		///DOC: Appelé chaque frame avec la distance à la caméra la plus proche et la visibilité de l'objet
+		///DOC: (d'après son volume englobant), permet d'adapter le coût de l'objet (animation, détails, ...)
+		///DOC: Seulement si le niveau de détail est activé (EnableLod), les autres objets ne coûtent rien
+		NazaraUnused(viewerDistance);
+		NazaraUnused(visible);
+	}
+
 	InstancedRenderableLibrary::LibraryMap InstancedRenderable::s_library;
 }
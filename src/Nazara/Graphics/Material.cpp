@@ -662,26 +662,44 @@ namespace Nz
 
 	void Material::GenerateShader(UInt32 flags) const
 	{
+		// Interned once, the uber-shader then compares them by pointer
+		static const StringId alphaMappingName("ALPHA_MAPPING");
+		static const StringId alphaTestName("ALPHA_TEST");
+		static const StringId computeTbnMatrixName("COMPUTE_TBNMATRIX");
+		static const StringId diffuseMappingName("DIFFUSE_MAPPING");
+		static const StringId emissiveMappingName("EMISSIVE_MAPPING");
+		static const StringId lightingName("LIGHTING");
+		static const StringId normalMappingName("NORMAL_MAPPING");
+		static const StringId parallaxMappingName("PARALLAX_MAPPING");
+		static const StringId specularMappingName("SPECULAR_MAPPING");
+		static const StringId textureMappingName("TEXTURE_MAPPING");
+		static const StringId transformName("TRANSFORM");
+		static const StringId flagBillboardName("FLAG_BILLBOARD");
+		static const StringId flagDeferredName("FLAG_DEFERRED");
+		static const StringId flagInstancingName("FLAG_INSTANCING");
+		static const StringId flagTextureOverlayName("FLAG_TEXTUREOVERLAY");
+		static const StringId flagVertexColorName("FLAG_VERTEXCOLOR");
+
 		ParameterList list;
-		list.SetParameter("ALPHA_MAPPING", m_alphaMap.IsValid());
-		list.SetParameter("ALPHA_TEST", m_alphaTestEnabled);
-		list.SetParameter("COMPUTE_TBNMATRIX", m_normalMap.IsValid() || m_heightMap.IsValid());
-		list.SetParameter("DIFFUSE_MAPPING", m_diffuseMap.IsValid());
-		list.SetParameter("EMISSIVE_MAPPING", m_emissiveMap.IsValid());
-		list.SetParameter("LIGHTING", m_lightingEnabled);
-		list.SetParameter("NORMAL_MAPPING", m_normalMap.IsValid());
-		list.SetParameter("PARALLAX_MAPPING", m_heightMap.IsValid());
-		list.SetParameter("SPECULAR_MAPPING", m_specularMap.IsValid());
-		list.SetParameter("TEXTURE_MAPPING", m_alphaMap.IsValid() || m_diffuseMap.IsValid() || m_emissiveMap.IsValid() ||
+		list.SetParameter(alphaMappingName, m_alphaMap.IsValid());
+		list.SetParameter(alphaTestName, m_alphaTestEnabled);
+		list.SetParameter(computeTbnMatrixName, m_normalMap.IsValid() || m_heightMap.IsValid());
+		list.SetParameter(diffuseMappingName, m_diffuseMap.IsValid());
+		list.SetParameter(emissiveMappingName, m_emissiveMap.IsValid());
+		list.SetParameter(lightingName, m_lightingEnabled);
+		list.SetParameter(normalMappingName, m_normalMap.IsValid());
+		list.SetParameter(parallaxMappingName, m_heightMap.IsValid());
+		list.SetParameter(specularMappingName, m_specularMap.IsValid());
+		list.SetParameter(textureMappingName, m_alphaMap.IsValid() || m_diffuseMap.IsValid() || m_emissiveMap.IsValid() ||
 											 m_normalMap.IsValid() || m_heightMap.IsValid() || m_specularMap.IsValid() ||
 											 flags & ShaderFlags_TextureOverlay);
-		list.SetParameter("TRANSFORM", m_transformEnabled);
+		list.SetParameter(transformName, m_transformEnabled);
 
-		list.SetParameter("FLAG_BILLBOARD", static_cast<bool>((flags & ShaderFlags_Billboard) != 0));
-		list.SetParameter("FLAG_DEFERRED", static_cast<bool>((flags & ShaderFlags_Deferred) != 0));
-		list.SetParameter("FLAG_INSTANCING", static_cast<bool>((flags & ShaderFlags_Instancing) != 0));
-		list.SetParameter("FLAG_TEXTUREOVERLAY", static_cast<bool>((flags & ShaderFlags_TextureOverlay) != 0));
-		list.SetParameter("FLAG_VERTEXCOLOR", static_cast<bool>((flags & ShaderFlags_VertexColor) != 0));
+		list.SetParameter(flagBillboardName, static_cast<bool>((flags & ShaderFlags_Billboard) != 0));
+		list.SetParameter(flagDeferredName, static_cast<bool>((flags & ShaderFlags_Deferred) != 0));
+		list.SetParameter(flagInstancingName, static_cast<bool>((flags & ShaderFlags_Instancing) != 0));
+		list.SetParameter(flagTextureOverlayName, static_cast<bool>((flags & ShaderFlags_TextureOverlay) != 0));
+		list.SetParameter(flagVertexColorName, static_cast<bool>((flags & ShaderFlags_VertexColor) != 0));
 
 		ShaderInstance& instance = m_shaders[flags];
 		instance.uberInstance = m_uberShader->Get(list);
@@ -7,6 +7,7 @@
 #include <Nazara/Graphics/Config.hpp>
 #include <Nazara/Utility/MeshData.hpp>
 #include <Nazara/Utility/StaticMesh.hpp>
+#include <algorithm>
 #include <memory>
 #include <Nazara/Graphics/Debug.hpp>
 
@@ -26,6 +27,7 @@ namespace Nz
 	}
 
 	Model::Model() :
+	m_lodThreshold(0.001f),
 	m_matCount(0),
 	m_skin(0),
 	m_skinCount(1)
@@ -39,14 +41,26 @@ namespace Nz
 
 	void Model::AddToRenderQueue(AbstractRenderQueue* renderQueue, const InstanceData& instanceData) const
 	{
+		///DOC: Le niveau de détail de chaque sous-mesh est le plus grossier dont l'erreur, projetée à l'écran, reste sous le seuil
+		Vector3f scale = instanceData.transformMatrix.GetScale();
+		float screenScale = instanceData.screenScale * std::max({scale.x, scale.y, scale.z});
+
 		unsigned int submeshCount = m_mesh->GetSubMeshCount();
 		for (unsigned int i = 0; i < submeshCount; ++i)
 		{
 			const StaticMesh* mesh = static_cast<const StaticMesh*>(m_mesh->GetSubMesh(i));
 			Material* material = m_materials[mesh->GetMaterialIndex()];
 
+			unsigned int lod = mesh->GetLodCount() - 1;
+			for (; lod > 0; --lod)
+			{
+				float error = mesh->GetLodError(lod);
+				if (error == 0.f || error * screenScale <= m_lodThreshold)
+					break;
+			}
+
 			MeshData meshData;
-			meshData.indexBuffer = mesh->GetIndexBuffer();
+			meshData.indexBuffer = mesh->GetLodIndexBuffer(lod);
 			meshData.primitiveMode = mesh->GetPrimitiveMode();
 			meshData.vertexBuffer = mesh->GetVertexBuffer();
 
@@ -54,6 +68,11 @@ namespace Nz
 		}
 	}
 
+	float Model::GetLodThreshold() const
+	{
+		return m_lodThreshold;
+	}
+
 	Material* Model::GetMaterial(const String& subMeshName) const
 	{
 		#if NAZARA_GRAPHICS_SAFE
@@ -192,6 +211,12 @@ namespace Nz
 		}
 	}
 
+	void Model::SetLodThreshold(float threshold)
+	{
+		///DOC: Le seuil est l'erreur tolérée à l'écran, en fraction de la hauteur de celui-ci (0 pour toujours afficher le niveau original)
+		m_lodThreshold = threshold;
+	}
+
 	bool Model::SetMaterial(const String& subMeshName, Material* material)
 	{
 		SubMesh* subMesh = m_mesh->GetSubMesh(subMeshName);
@@ -304,6 +329,7 @@ namespace Nz
 		}
 		#endif
 
+		///DOC: Les niveaux de détail du mesh doivent être générés avant qu'il ne soit donné au modèle
 		m_mesh = mesh;
 
 		if (m_mesh)
@@ -312,12 +338,21 @@ namespace Nz
 			m_materials.clear();
 			m_materials.resize(m_matCount, Material::GetDefault());
 			m_skinCount = 1;
+
+			// La taille à l'écran n'est utile que pour choisir le niveau de détail des sous-meshs
+			bool hasLods = false;
+			for (unsigned int i = 0; i < mesh->GetSubMeshCount() && !hasLods; ++i)
+				hasLods = (mesh->GetSubMesh(i)->GetLodCount() > 1);
+
+			EnableLod(hasLods);
 		}
 		else
 		{
 			m_matCount = 0;
 			m_materials.clear();
 			m_skinCount = 0;
+
+			EnableLod(false);
 		}
 
 		InvalidateBoundingVolume();
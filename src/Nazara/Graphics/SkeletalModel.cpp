@@ -9,6 +9,7 @@
 #include <Nazara/Utility/BufferMapper.hpp>
 #include <Nazara/Utility/MeshData.hpp>
 #include <Nazara/Utility/SkeletalMesh.hpp>
+#include <algorithm>
 #include <memory>
 #include <Nazara/Graphics/Debug.hpp>
 
@@ -27,8 +28,16 @@ namespace Nz
 
 	SkeletalModel::SkeletalModel() :
 	m_currentSequence(nullptr),
-	m_animationEnabled(true)
+	m_animationEnabled(true),
+	m_animationPending(false),
+	m_visible(true),
+	m_lodElapsedTime(0.f),
+	m_lodLevel(-1),
+	m_skippedJointCount(0),
+	m_skippedVertexCount(0)
 	{
+		// Même sans niveau de détail, le squelette n'est pas mis à jour tant que le modèle n'est pas visible
+		EnableLod(true);
 	}
 
 	void SkeletalModel::AddToRenderQueue(AbstractRenderQueue* renderQueue, const InstanceData& instanceData) const
@@ -87,9 +96,25 @@ namespace Nz
 			}
 		}
 
-		m_animation->AnimateSkeleton(&m_skeleton, m_currentFrame, m_nextFrame, m_interpolation);
+		m_lodElapsedTime += elapsedTime;
 
-		InvalidateBoundingVolume();
+		// Hors de vue, ou entre deux mises à jour de son niveau de détail, le squelette garde sa pose (ce qui évite aussi son skinning)
+		const SkeletalModelLodLevel* lodLevel = GetLodLevel();
+		if (!m_visible || (lodLevel && m_lodElapsedTime < lodLevel->updateInterval))
+		{
+			m_animationPending = true;
+			m_skippedJointCount = m_skeleton.GetJointCount();
+			m_skippedVertexCount = (m_mesh) ? m_mesh->GetVertexCount() : 0;
+			return;
+		}
+
+		UpdateSkeleton();
+	}
+
+	void SkeletalModel::ClearLodLevels()
+	{
+		m_lodLevels.clear();
+		m_lodLevel = -1;
 	}
 
 	SkeletalModel* SkeletalModel::Clone() const
@@ -112,6 +137,17 @@ namespace Nz
 		return m_animation;
 	}
 
+	const SkeletalModelLodLevel* SkeletalModel::GetLodLevel() const
+	{
+		///DOC: Renvoie le niveau de détail actuel, ou nullptr si le modèle est animé entièrement
+		return (m_lodLevel >= 0) ? &m_lodLevels[m_lodLevel] : nullptr;
+	}
+
+	unsigned int SkeletalModel::GetLodLevelCount() const
+	{
+		return m_lodLevels.size();
+	}
+
 	Skeleton* SkeletalModel::GetSkeleton()
 	{
 		InvalidateBoundingVolume();
@@ -124,6 +160,18 @@ namespace Nz
 		return &m_skeleton;
 	}
 
+	unsigned int SkeletalModel::GetSkippedJointCount() const
+	{
+		///DOC: Renvoie le nombre de joints non-animés lors de la dernière mise à jour de l'animation
+		return m_skippedJointCount;
+	}
+
+	unsigned int SkeletalModel::GetSkippedVertexCount() const
+	{
+		///DOC: Renvoie le nombre de vertices dont le skinning a été évité lors de la dernière mise à jour de l'animation
+		return m_skippedVertexCount;
+	}
+
 	bool SkeletalModel::HasAnimation() const
 	{
 		return m_animation != nullptr;
@@ -204,6 +252,32 @@ namespace Nz
 		return true;
 	}
 
+	void SkeletalModel::SetLodLevels(std::vector<SkeletalModelLodLevel> lodLevels)
+	{
+		///DOC: Les niveaux sont triés par distance, le modèle est animé entièrement en-deçà de la distance du premier
+		#if NAZARA_GRAPHICS_SAFE
+		for (const SkeletalModelLodLevel& lodLevel : lodLevels)
+		{
+			for (unsigned int index : lodLevel.jointIndices)
+			{
+				if (index >= m_skeleton.GetJointCount())
+				{
+					NazaraError("Joint index out of range (" + String::Number(index) + " >= " + String::Number(m_skeleton.GetJointCount()) + ')');
+					return;
+				}
+			}
+		}
+		#endif
+
+		m_lodLevels = std::move(lodLevels);
+		m_lodLevel = -1;
+
+		std::sort(m_lodLevels.begin(), m_lodLevels.end(), [](const SkeletalModelLodLevel& lhs, const SkeletalModelLodLevel& rhs)
+		{
+			return lhs.distance < rhs.distance;
+		});
+	}
+
 	void SkeletalModel::SetMesh(Mesh* mesh)
 	{
 		#if NAZARA_GRAPHICS_SAFE
@@ -215,6 +289,7 @@ namespace Nz
 		#endif
 
 		Model::SetMesh(mesh);
+		EnableLod(true);
 
 		if (m_mesh)
 		{
@@ -275,6 +350,20 @@ namespace Nz
 		m_nextFrame = m_currentSequence->firstFrame;
 	}
 
+	void SkeletalModel::UpdateLod(float viewerDistance, bool visible)
+	{
+		m_lodLevel = -1;
+		for (unsigned int i = 0; i < m_lodLevels.size() && m_lodLevels[i].distance <= viewerDistance; ++i)
+			m_lodLevel = i;
+
+		bool wasVisible = m_visible;
+		m_visible = visible;
+
+		// Un modèle qui redevient visible est mis à jour avant d'être affiché
+		if (visible && !wasVisible && m_animationPending && m_animation)
+			UpdateSkeleton();
+	}
+
 	void SkeletalModel::MakeBoundingVolume() const
 	{
 		m_boundingVolume.Set(m_skeleton.GetAABB());
@@ -286,5 +375,26 @@ namespace Nz
 			AdvanceAnimation(m_scene->GetUpdateTime());*/
 	}
 
+	void SkeletalModel::UpdateSkeleton()
+	{
+		const SkeletalModelLodLevel* lodLevel = GetLodLevel();
+		if (lodLevel && !lodLevel->jointIndices.empty())
+		{
+			m_animation->AnimateSkeleton(&m_skeleton, m_currentFrame, m_nextFrame, m_interpolation, lodLevel->jointIndices.data(), lodLevel->jointIndices.size());
+			m_skippedJointCount = m_skeleton.GetJointCount() - lodLevel->jointIndices.size();
+		}
+		else
+		{
+			m_animation->AnimateSkeleton(&m_skeleton, m_currentFrame, m_nextFrame, m_interpolation);
+			m_skippedJointCount = 0;
+		}
+
+		m_animationPending = false;
+		m_lodElapsedTime = 0.f;
+		m_skippedVertexCount = 0;
+
+		InvalidateBoundingVolume();
+	}
+
 	SkeletalModelLoader::LoaderList SkeletalModel::s_loaders;
 }
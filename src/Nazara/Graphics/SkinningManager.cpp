@@ -7,6 +7,8 @@
 #include <Nazara/Core/TaskScheduler.hpp>
 #include <Nazara/Utility/Algorithm.hpp>
 #include <Nazara/Utility/SkeletalMesh.hpp>
+#include <Nazara/Utility/Skeleton.hpp>
+#include <Nazara/Utility/SkeletonPose.hpp>
 #include <Nazara/Utility/VertexBuffer.hpp>
 #include <Nazara/Utility/VertexMapper.hpp>
 #include <memory>
@@ -33,6 +35,8 @@ namespace Nz
 			NazaraSlot(Skeleton, OnSkeletonJointsInvalidated, skeletonJointsInvalidatedSlot);
 
 			MeshMap meshMap;
+			std::vector<Matrix4f> skinningMatrices;
+			bool skinningMatricesUpdated = false;
 		};
 
 		struct QueueData
@@ -44,10 +48,11 @@ namespace Nz
 
 		using SkeletonMap = std::unordered_map<const Skeleton*, MeshData>;
 		SkeletonMap s_cache;
+		SkeletonPose s_pose;
 		std::vector<QueueData> s_skinningQueue;
 
 
-		void Skin_MonoCPU(const SkeletalMesh* mesh, const Skeleton* skeleton, VertexBuffer* buffer)
+		void Skin_MonoCPU(const SkeletalMesh* mesh, const Matrix4f* skinningMatrices, VertexBuffer* buffer)
 		{
 			BufferMapper<VertexBuffer> inputMapper(mesh->GetVertexBuffer(), BufferAccess_ReadOnly);
 			BufferMapper<VertexBuffer> outputMapper(buffer, BufferAccess_DiscardAndWrite);
@@ -55,12 +60,12 @@ namespace Nz
 			SkinningData skinningData;
 			skinningData.inputVertex = static_cast<SkeletalMeshVertex*>(inputMapper.GetPointer());
 			skinningData.outputVertex = static_cast<MeshVertex*>(outputMapper.GetPointer());
-			skinningData.joints = skeleton->GetJoints();
+			skinningData.skinningMatrices = skinningMatrices;
 
 			SkinPositionNormalTangent(skinningData, 0, mesh->GetVertexCount());
 		}
 
-		void Skin_MultiCPU(const SkeletalMesh* mesh, const Skeleton* skeleton, VertexBuffer* buffer)
+		void Skin_MultiCPU(const SkeletalMesh* mesh, const Matrix4f* skinningMatrices, VertexBuffer* buffer)
 		{
 			BufferMapper<VertexBuffer> inputMapper(mesh->GetVertexBuffer(), BufferAccess_ReadOnly);
 			BufferMapper<VertexBuffer> outputMapper(buffer, BufferAccess_DiscardAndWrite);
@@ -68,13 +73,7 @@ namespace Nz
 			SkinningData skinningData;
 			skinningData.inputVertex = static_cast<SkeletalMeshVertex*>(inputMapper.GetPointer());
 			skinningData.outputVertex = static_cast<MeshVertex*>(outputMapper.GetPointer());
-			skinningData.joints = skeleton->GetJoints();
-
-			// Afin d'empêcher les différents threads de vouloir mettre à jour la même matrice en même temps,
-			// on se charge de la mettre à jour avant de les lancer
-			unsigned int jointCount = skeleton->GetJointCount();
-			for (unsigned int i = 0; i < jointCount; ++i)
-				skinningData.joints[i].EnsureSkinningMatrixUpdate();
+			skinningData.skinningMatrices = skinningMatrices;
 
 			unsigned int workerCount = TaskScheduler::GetWorkerCount();
 
@@ -152,7 +151,21 @@ namespace Nz
 	void SkinningManager::Skin()
 	{
 		for (QueueData& data : s_skinningQueue)
-			s_skinFunc(data.mesh, data.skeleton, data.buffer);
+		{
+			MeshData& meshData = s_cache.at(data.skeleton);
+
+			// Les matrices sont calculées en une passe, une seule fois par squelette quel que soit son nombre de meshs
+			if (!meshData.skinningMatricesUpdated)
+			{
+				data.skeleton->GetPose(&s_pose);
+
+				meshData.skinningMatrices.resize(data.skeleton->GetJointCount());
+				data.skeleton->ComputeSkinningMatrices(s_pose, meshData.skinningMatrices.data());
+				meshData.skinningMatricesUpdated = true;
+			}
+
+			s_skinFunc(data.mesh, meshData.skinningMatrices.data(), data.buffer);
+		}
 
 		s_skinningQueue.clear();
 	}
@@ -179,7 +192,10 @@ namespace Nz
 
 	void SkinningManager::OnSkeletonInvalidated(const Skeleton* skeleton)
 	{
-		for (auto& pair : s_cache.at(skeleton).meshMap)
+		MeshData& meshData = s_cache.at(skeleton);
+		meshData.skinningMatricesUpdated = false;
+
+		for (auto& pair : meshData.meshMap)
 			pair.second.updated = false;
 	}
 
@@ -191,6 +207,7 @@ namespace Nz
 	void SkinningManager::Uninitialize()
 	{
 		s_cache.clear();
+		s_pose = SkeletonPose();
 		s_skinningQueue.clear();
 	}
 
@@ -6,15 +6,23 @@
 #include <Lua/lauxlib.h>
 #include <Lua/lua.h>
 #include <Lua/lualib.h>
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/ByteStream.hpp>
 #include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/Directory.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/File.hpp>
+#include <Nazara/Core/Hash/XXHash64.hpp>
 #include <Nazara/Core/MemoryHelper.hpp>
 #include <Nazara/Core/MemoryView.hpp>
 #include <Nazara/Core/StringStream.hpp>
+#include <algorithm>
+#include <array>
 #include <cstdlib>
+#include <cstring>
 #include <stdexcept>
 #include <unordered_map>
+#include <vector>
 #include <Nazara/Lua/Debug.hpp>
 
 namespace Nz
@@ -73,6 +81,21 @@ namespace Nz
 			throw std::runtime_error("Lua panic: " + lastError);
 		}
 
+		// Header of the bytecode cache files: magic, version, source last write time, source hash and bytecode hash
+		constexpr UInt32 s_bytecodeMagic = 0x434C5A4E; // "NZLC"
+		constexpr UInt32 s_bytecodeVersion = 1;
+		constexpr std::size_t s_bytecodeHeaderSize = 2 * sizeof(UInt32) + 3 * sizeof(UInt64);
+
+		int BytecodeWriter(lua_State* state, const void* data, std::size_t size, void* userdata)
+		{
+			NazaraUnused(state);
+
+			ByteArray* bytecode = static_cast<ByteArray*>(userdata);
+			bytecode->Append(data, size);
+
+			return 0;
+		}
+
 		const char* StreamReader(lua_State* state, void* data, std::size_t* size)
 		{
 			NazaraUnused(state);
@@ -129,14 +152,151 @@ namespace Nz
 		};
 
 		static_assert(sizeof(s_types)/sizeof(int) == LuaType_Max+1, "Lua type array is incomplete");
+
+		// Size classes of the memory pools, Lua blocks bigger than the last one are allocated with realloc
+		constexpr std::array<unsigned int, 12> s_poolBlockSizes = {16, 32, 48, 64, 80, 96, 112, 128, 160, 192, 224, 256};
+		constexpr std::size_t s_maxPooledSize = 256;
+		constexpr std::size_t s_poolChunkSize = 8 * 1024;
+
+		std::size_t GetSizeClass(std::size_t size)
+		{
+			if (size <= 128)
+				return (size - 1) / 16;
+			else
+				return 8 + (size - 129) / 32;
+		}
+	}
+
+	// Size-classed free lists, chunks are kept until the instance is destroyed as Lua tends to reuse them quickly
+	struct LuaInstance::MemoryPools
+	{
+		struct FreeBlock
+		{
+			FreeBlock* next;
+		};
+
+		void* Allocate(std::size_t size);
+		void Free(void* ptr, std::size_t size);
+		void* Reallocate(void* ptr, std::size_t oldSize, std::size_t newSize);
+
+		std::array<FreeBlock*, s_poolBlockSizes.size()> freeLists = {};
+		std::vector<void*> chunks;
+		std::size_t reservedMemory = 0; //< Memory allocated for the chunks
+		std::size_t requestedMemory = 0; //< Sum of the sizes requested by Lua for the live pooled blocks
+
+		~MemoryPools()
+		{
+			for (void* chunk : chunks)
+				std::free(chunk);
+		}
+	};
+
+	void* LuaInstance::MemoryPools::Allocate(std::size_t size)
+	{
+		std::size_t sizeClass = GetSizeClass(size);
+
+		FreeBlock*& freeList = freeLists[sizeClass];
+		if (!freeList)
+		{
+			// Every block of a new chunk goes in the free list
+			std::size_t blockSize = s_poolBlockSizes[sizeClass];
+			std::size_t blockCount = s_poolChunkSize / blockSize;
+
+			UInt8* chunk = static_cast<UInt8*>(std::malloc(blockSize * blockCount));
+			if (!chunk)
+				return nullptr;
+
+			chunks.push_back(chunk);
+			reservedMemory += blockSize * blockCount;
+
+			for (std::size_t i = blockCount; i-- > 0;)
+			{
+				FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + i * blockSize);
+				block->next = freeList;
+				freeList = block;
+			}
+		}
+
+		FreeBlock* block = freeList;
+		freeList = block->next;
+
+		requestedMemory += size;
+
+		return block;
+	}
+
+	void LuaInstance::MemoryPools::Free(void* ptr, std::size_t size)
+	{
+		if (size > s_maxPooledSize)
+		{
+			std::free(ptr);
+			return;
+		}
+
+		FreeBlock*& freeList = freeLists[GetSizeClass(size)];
+
+		FreeBlock* block = static_cast<FreeBlock*>(ptr);
+		block->next = freeList;
+		freeList = block;
+
+		requestedMemory -= size;
 	}
 
-	LuaInstance::LuaInstance() :
+	void* LuaInstance::MemoryPools::Reallocate(void* ptr, std::size_t oldSize, std::size_t newSize)
+	{
+		// Lua gives us back the size of every block, which tells us where it comes from
+		bool wasPooled = (ptr && oldSize <= s_maxPooledSize);
+		bool isPooled = (newSize <= s_maxPooledSize);
+
+		if (!wasPooled && !isPooled)
+			return std::realloc(ptr, newSize);
+
+		if (wasPooled && isPooled && GetSizeClass(oldSize) == GetSizeClass(newSize))
+		{
+			requestedMemory += newSize;
+			requestedMemory -= oldSize;
+			return ptr;
+		}
+
+		void* newPtr = (isPooled) ? Allocate(newSize) : std::malloc(newSize);
+		if (!newPtr)
+		{
+			if (newSize > oldSize)
+				return nullptr;
+
+			// Lua doesn't allow a block to fail shrinking, the original block is kept as it is bigger than any block of the new size class
+			if (wasPooled)
+				requestedMemory -= oldSize;
+			else
+			{
+				// Adopted by the pool, which frees it with its chunks
+				chunks.push_back(ptr);
+				reservedMemory += oldSize;
+			}
+
+			requestedMemory += newSize;
+			return ptr;
+		}
+
+		if (ptr)
+		{
+			std::memcpy(newPtr, ptr, std::min(oldSize, newSize));
+			Free(ptr, oldSize);
+		}
+
+		return newPtr;
+	}
+
+	LuaInstance::LuaInstance(bool useMemoryPools) :
 	m_memoryLimit(0),
+	m_memoryPeakUsage(0),
 	m_memoryUsage(0),
 	m_timeLimit(1000),
 	m_level(0)
 	{
+		if (useMemoryPools)
+			m_memoryPools.reset(new MemoryPools);
+
 		m_state = lua_newstate(MemoryAllocator, this);
 		lua_atpanic(m_state, AtPanic);
 		lua_sethook(m_state, TimeLimiter, LUA_MASKCOUNT, 1000);
@@ -413,7 +573,13 @@ namespace Nz
 
 		file.Close();
 
-		return Execute(source);
+		if (m_bytecodeCacheDirectory.IsEmpty())
+			return Execute(source);
+
+		if (!LoadWithBytecodeCache(file.GetPath(), source))
+			return false;
+
+		return Run(0, 0);
 	}
 
 	bool LuaInstance::ExecuteFromMemory(const void* data, unsigned int size)
@@ -443,6 +609,11 @@ namespace Nz
 		return lua_absindex(m_state, index);
 	}
 
+	String LuaInstance::GetBytecodeCacheDirectory() const
+	{
+		return m_bytecodeCacheDirectory;
+	}
+
 	LuaType LuaInstance::GetField(const char* fieldName, int tableIndex) const
 	{
 		return FromLuaType(lua_getfield(m_state, tableIndex, fieldName));
@@ -478,6 +649,15 @@ namespace Nz
 		return m_memoryLimit;
 	}
 
+	float LuaInstance::GetMemoryFragmentation() const
+	{
+		///DOC: Part of the memory reserved by the pools which does not hold any Lua data (free blocks and rounding to the size classes)
+		if (!m_memoryPools || m_memoryPools->reservedMemory == 0)
+			return 0.f;
+
+		return 1.f - static_cast<float>(m_memoryPools->requestedMemory) / m_memoryPools->reservedMemory;
+	}
+
 	UInt32 LuaInstance::GetMemoryUsage() const
 	{
 		return m_memoryUsage;
@@ -498,6 +678,11 @@ namespace Nz
 		return lua_getmetatable(m_state, index) != 0;
 	}
 
+	UInt32 LuaInstance::GetPeakMemoryUsage() const
+	{
+		return m_memoryPeakUsage;
+	}
+
 	unsigned int LuaInstance::GetStackTop() const
 	{
 		return lua_gettop(m_state);
@@ -749,6 +934,13 @@ namespace Nz
 		lua_setmetatable(m_state, index);
 	}
 
+	void LuaInstance::SetBytecodeCacheDirectory(const String& directory)
+	{
+		///DOC: ExecuteFromFile will store and reuse compiled scripts in this directory (disabled if empty)
+		///DOC: Bytecode is not verified by Lua, the directory must not be writable by untrusted users
+		m_bytecodeCacheDirectory = directory;
+	}
+
 	void LuaInstance::SetMemoryLimit(UInt32 memoryLimit)
 	{
 		m_memoryLimit = memoryLimit;
@@ -857,34 +1049,121 @@ namespace Nz
 		return true;
 	}
 
+	bool LuaInstance::LoadWithBytecodeCache(const String& filePath, const String& source)
+	{
+		String chunkName = '@' + filePath;
+		UInt64 lastWriteTime = static_cast<UInt64>(File::GetLastWriteTime(filePath));
+		UInt64 sourceHash = HashXXHash64::Hash(source.GetConstBuffer(), source.GetSize());
+
+		// One cache file per script path
+		String cacheDirectory = File::AbsolutePath(m_bytecodeCacheDirectory);
+		String cachePath = cacheDirectory + NAZARA_DIRECTORY_SEPARATOR + String::Number(HashXXHash64::Hash(filePath.GetConstBuffer(), filePath.GetSize()), 16) + ".luac";
+
+		File cacheFile(cachePath);
+		if (File::Exists(cachePath) && cacheFile.Open(OpenMode_ReadOnly))
+		{
+			ByteArray cacheData(static_cast<std::size_t>(cacheFile.GetSize()), 0);
+			bool read = (cacheFile.Read(cacheData.GetBuffer(), cacheData.GetSize()) == cacheData.GetSize());
+			cacheFile.Close();
+
+			if (read && cacheData.GetSize() > s_bytecodeHeaderSize)
+			{
+				UInt32 magic, version;
+				UInt64 cachedWriteTime, cachedSourceHash, bytecodeHash;
+
+				ByteStream stream(cacheData.GetConstBuffer(), s_bytecodeHeaderSize);
+				stream >> magic >> version >> cachedWriteTime >> cachedSourceHash >> bytecodeHash;
+
+				if (magic == s_bytecodeMagic && version == s_bytecodeVersion && cachedWriteTime == lastWriteTime && cachedSourceHash == sourceHash)
+				{
+					// Lua does not check binary chunks, a corrupted one could crash the instance
+					const char* bytecode = reinterpret_cast<const char*>(cacheData.GetConstBuffer() + s_bytecodeHeaderSize);
+					std::size_t bytecodeSize = cacheData.GetSize() - s_bytecodeHeaderSize;
+
+					if (HashXXHash64::Hash(bytecode, bytecodeSize) == bytecodeHash)
+					{
+						if (luaL_loadbufferx(m_state, bytecode, bytecodeSize, chunkName.GetConstBuffer(), "b") == 0)
+							return true;
+
+						// Produced by another Lua version, let's compile the source again
+						lua_pop(m_state, 1);
+					}
+				}
+			}
+		}
+
+		if (luaL_loadbufferx(m_state, source.GetConstBuffer(), source.GetSize(), chunkName.GetConstBuffer(), "t") != 0)
+		{
+			m_lastError = lua_tostring(m_state, -1);
+			lua_pop(m_state, 1);
+
+			return false;
+		}
+
+		ByteArray bytecode;
+		lua_dump(m_state, BytecodeWriter, &bytecode, 0);
+
+		if (!Directory::Exists(cacheDirectory) && !Directory::Create(cacheDirectory, true))
+		{
+			NazaraWarning("Failed to create bytecode cache directory \"" + cacheDirectory + '"');
+			return true;
+		}
+
+		if (!cacheFile.Open(OpenMode_WriteOnly | OpenMode_Truncate))
+		{
+			NazaraWarning("Failed to open bytecode cache file \"" + cachePath + '"');
+			return true;
+		}
+
+		ByteStream stream(&cacheFile);
+		stream << s_bytecodeMagic << s_bytecodeVersion << lastWriteTime << sourceHash << HashXXHash64::Hash(bytecode.GetConstBuffer(), bytecode.GetSize());
+		stream.Write(bytecode.GetConstBuffer(), bytecode.GetSize());
+
+		return true;
+	}
+
 	void* LuaInstance::MemoryAllocator(void* ud, void* ptr, std::size_t osize, std::size_t nsize)
 	{
 		LuaInstance* instance = static_cast<LuaInstance*>(ud);
+		MemoryPools* memoryPools = instance->m_memoryPools.get();
 		UInt32& memoryLimit = instance->m_memoryLimit;
 		UInt32& memoryUsage = instance->m_memoryUsage;
 
+		// When ptr is null, osize holds the type of the object instead of a size
+		if (!ptr)
+			osize = 0;
+
 		if (nsize == 0)
 		{
-			memoryUsage -= osize;
-			std::free(ptr);
+			if (ptr)
+			{
+				memoryUsage -= osize;
+
+				if (memoryPools)
+					memoryPools->Free(ptr, osize);
+				else
+					std::free(ptr);
+			}
 
 			return nullptr;
 		}
 		else
 		{
-			UInt32 usage = memoryUsage + nsize;
-			if (ptr)
-				usage -= osize;
-
+			UInt32 usage = memoryUsage + nsize - osize;
 			if (memoryLimit != 0 && usage > memoryLimit)
 			{
 				NazaraError("Lua memory usage is over memory limit (" + String::Number(usage) + " > " + String::Number(memoryLimit) + ')');
 				return nullptr;
 			}
 
-			memoryUsage = usage;
+			void* newPtr = (memoryPools) ? memoryPools->Reallocate(ptr, osize, nsize) : std::realloc(ptr, nsize);
+			if (newPtr)
+			{
+				memoryUsage = usage;
+				instance->m_memoryPeakUsage = std::max(instance->m_memoryPeakUsage, usage);
+			}
 
-			return std::realloc(ptr, nsize);
+			return newPtr;
 		}
 	}
 
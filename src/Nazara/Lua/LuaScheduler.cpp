@@ -0,0 +1,275 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Lua scripting module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Lua/LuaScheduler.hpp>
+#include <Lua/lauxlib.h>
+#include <Lua/lua.h>
+#include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Lua/LuaInstance.hpp>
+#include <algorithm>
+#include <Nazara/Lua/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		// Number of instructions between two checks of the budget, lower values are more precise but slower
+		constexpr UInt32 s_hookGranularity = 100;
+	}
+
+	struct LuaScheduler::Coroutine
+	{
+		CoroutineStats stats;
+		lua_State* thread;
+		UInt32 executedInstructions; //< During the current resume
+		UInt32 hookCount;
+		UInt32 instructionBudget;
+		int threadRef;
+		unsigned int id;
+		unsigned int pendingArgCount; //< Arguments of the first resume
+		bool killed; //< Killed while running, it is released once lua_resume returns
+	};
+
+	LuaScheduler::LuaScheduler(LuaInstance& instance, UInt32 defaultInstructionBudget) :
+	m_runningCoroutine(nullptr),
+	m_nextCoroutine(0),
+	m_instance(instance),
+	m_defaultInstructionBudget(defaultInstructionBudget),
+	m_nextId(InvalidId + 1)
+	{
+		// Threads created by lua_newthread copy the extra space of the main thread, coroutines created from scripts must not find a dangling pointer there
+		*static_cast<Coroutine**>(lua_getextraspace(instance.GetInternalState())) = nullptr;
+	}
+
+	LuaScheduler::~LuaScheduler()
+	{
+		Clear();
+	}
+
+	void LuaScheduler::Clear()
+	{
+		///DOC: Si appelé depuis une coroutine, celle-ci n'est libérée qu'une fois interrompue
+		std::unique_ptr<Coroutine> running;
+		for (auto& coroutine : m_coroutines)
+		{
+			if (coroutine.get() == m_runningCoroutine)
+			{
+				coroutine->killed = true;
+				running = std::move(coroutine);
+			}
+			else
+				Release(*coroutine);
+		}
+
+		m_coroutines.clear();
+		m_nextCoroutine = 0;
+
+		if (running)
+			m_coroutines.emplace_back(std::move(running));
+	}
+
+	std::size_t LuaScheduler::GetCoroutineCount() const
+	{
+		return m_coroutines.size();
+	}
+
+	bool LuaScheduler::GetCoroutineStats(unsigned int coroutineId, CoroutineStats* stats) const
+	{
+		NazaraAssert(stats, "Invalid stats pointer");
+
+		std::size_t index = FindCoroutine(coroutineId);
+		if (index == m_coroutines.size())
+			return false;
+
+		*stats = m_coroutines[index]->stats;
+		return true;
+	}
+
+	UInt32 LuaScheduler::GetDefaultInstructionBudget() const
+	{
+		return m_defaultInstructionBudget;
+	}
+
+	bool LuaScheduler::IsAlive(unsigned int coroutineId) const
+	{
+		std::size_t index = FindCoroutine(coroutineId);
+		return index != m_coroutines.size() && !m_coroutines[index]->killed;
+	}
+
+	bool LuaScheduler::Kill(unsigned int coroutineId)
+	{
+		///DOC: Une coroutine peut se tuer elle-même (depuis une fonction appelée par son script), elle est alors interrompue au plus tôt
+		std::size_t index = FindCoroutine(coroutineId);
+		if (index == m_coroutines.size() || m_coroutines[index]->killed)
+			return false;
+
+		// The running coroutine is still used by lua_resume, Update releases it afterwards
+		if (m_coroutines[index].get() == m_runningCoroutine)
+		{
+			m_runningCoroutine->killed = true;
+			return true;
+		}
+
+		Release(*m_coroutines[index]);
+		m_coroutines.erase(m_coroutines.begin() + index);
+
+		if (m_nextCoroutine > index)
+			m_nextCoroutine--;
+
+		return true;
+	}
+
+	void LuaScheduler::SetDefaultInstructionBudget(UInt32 instructionBudget)
+	{
+		m_defaultInstructionBudget = instructionBudget;
+	}
+
+	unsigned int LuaScheduler::Spawn(unsigned int argCount)
+	{
+		return Spawn(argCount, m_defaultInstructionBudget);
+	}
+
+	unsigned int LuaScheduler::Spawn(unsigned int argCount, UInt32 instructionBudget)
+	{
+		lua_State* state = m_instance.GetInternalState();
+
+		NazaraAssert(lua_gettop(state) > static_cast<int>(argCount), "Not enough values on the stack");
+		NazaraAssert(lua_type(state, -static_cast<int>(argCount) - 1) == LUA_TFUNCTION, "Coroutine body must be a function");
+
+		std::unique_ptr<Coroutine> coroutine(new Coroutine);
+		coroutine->executedInstructions = 0;
+		coroutine->id = m_nextId++;
+		coroutine->instructionBudget = instructionBudget;
+		coroutine->killed = false;
+		coroutine->pendingArgCount = argCount;
+		coroutine->thread = lua_newthread(state);
+		coroutine->threadRef = luaL_ref(state, LUA_REGISTRYINDEX); // Pops the thread and keeps it from being collected
+
+		if (instructionBudget > 0)
+			coroutine->hookCount = std::min(instructionBudget, s_hookGranularity);
+		else
+			coroutine->hookCount = s_hookGranularity; // Only for the stats
+
+		// The hook finds back its coroutine through the extra space of the thread
+		*static_cast<Coroutine**>(lua_getextraspace(coroutine->thread)) = coroutine.get();
+
+		lua_xmove(state, coroutine->thread, argCount + 1);
+
+		m_coroutines.emplace_back(std::move(coroutine));
+
+		return m_coroutines.back()->id;
+	}
+
+	unsigned int LuaScheduler::Update(UInt64 timeBudget)
+	{
+		Clock clock;
+
+		// Every coroutine is resumed at most once per update, the cursor keeps the round-robin fair from one update to another
+		unsigned int resumedCount = 0;
+		std::size_t coroutineCount = m_coroutines.size();
+		while (resumedCount < coroutineCount && !m_coroutines.empty())
+		{
+			if (resumedCount > 0 && clock.GetMicroseconds() >= timeBudget)
+				break;
+
+			if (m_nextCoroutine >= m_coroutines.size())
+				m_nextCoroutine = 0;
+
+			Coroutine& coroutine = *m_coroutines[m_nextCoroutine];
+			resumedCount++;
+
+			if (Resume(coroutine) && !coroutine.killed)
+				m_nextCoroutine++;
+			else
+			{
+				Release(coroutine);
+				m_coroutines.erase(m_coroutines.begin() + m_nextCoroutine);
+			}
+		}
+
+		return resumedCount;
+	}
+
+	std::size_t LuaScheduler::FindCoroutine(unsigned int coroutineId) const
+	{
+		// Ids are increasing and coroutines are only appended, the array stays sorted
+		auto it = std::lower_bound(m_coroutines.begin(), m_coroutines.end(), coroutineId, [](const std::unique_ptr<Coroutine>& coroutine, unsigned int id) { return coroutine->id < id; });
+		if (it != m_coroutines.end() && (*it)->id == coroutineId)
+			return std::distance(m_coroutines.begin(), it);
+		else
+			return m_coroutines.size();
+	}
+
+	void LuaScheduler::Release(Coroutine& coroutine)
+	{
+		luaL_unref(m_instance.GetInternalState(), LUA_REGISTRYINDEX, coroutine.threadRef);
+	}
+
+	bool LuaScheduler::Resume(Coroutine& coroutine)
+	{
+		coroutine.executedInstructions = 0;
+		lua_sethook(coroutine.thread, BudgetHook, LUA_MASKCOUNT, coroutine.hookCount);
+
+		// Functions called by the coroutine have to work on its own stack
+		lua_State* mainState = m_instance.m_state;
+		m_instance.m_state = coroutine.thread;
+		m_runningCoroutine = &coroutine;
+
+		UInt64 startTime = GetElapsedMicroseconds();
+		int status = lua_resume(coroutine.thread, mainState, coroutine.pendingArgCount);
+		UInt64 executionTime = GetElapsedMicroseconds() - startTime;
+
+		m_instance.m_state = mainState;
+		m_runningCoroutine = nullptr;
+
+		coroutine.pendingArgCount = 0;
+		coroutine.stats.executionTime += executionTime;
+		coroutine.stats.instructionCount += coroutine.executedInstructions;
+		coroutine.stats.resumeCount++;
+
+		switch (status)
+		{
+			case LUA_YIELD:
+				lua_settop(coroutine.thread, 0); // Yielded values are of no use
+				return true;
+
+			case LUA_OK:
+				return false;
+
+			default:
+			{
+				// Scripts can raise any value (error({}) for example)
+				String message = (lua_isstring(coroutine.thread, -1)) ? String(lua_tostring(coroutine.thread, -1)) : "(error object is a " + String(luaL_typename(coroutine.thread, -1)) + " value)";
+				NazaraError("Coroutine #" + String::Number(coroutine.id) + " failed: " + message);
+				return false;
+			}
+		}
+	}
+
+	void LuaScheduler::BudgetHook(lua_State* state, lua_Debug* debug)
+	{
+		NazaraUnused(debug);
+
+		// Coroutines created by a scheduled coroutine inherit its hook, but are not scheduled themselves
+		Coroutine* coroutine = *static_cast<Coroutine**>(lua_getextraspace(state));
+		if (!coroutine)
+			return;
+
+		coroutine->executedInstructions += coroutine->hookCount;
+
+		// A coroutine which killed itself is interrupted as soon as possible
+		if (coroutine->killed && lua_isyieldable(state))
+		{
+			lua_yield(state, 0);
+			return;
+		}
+
+		if (coroutine->instructionBudget > 0 && coroutine->executedInstructions >= coroutine->instructionBudget && lua_isyieldable(state))
+		{
+			coroutine->stats.budgetExhaustionCount++;
+			lua_yield(state, 0);
+		}
+	}
+}
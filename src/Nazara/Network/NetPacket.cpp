@@ -5,6 +5,7 @@
 #include <Nazara/Network/NetPacket.hpp>
 #include <Nazara/Core/LockGuard.hpp>
 #include <Nazara/Core/MemoryView.hpp>
+#include <Nazara/Core/MemoryWriter.hpp>
 #include <Nazara/Network/Debug.hpp>
 
 namespace Nz
@@ -42,12 +43,9 @@ namespace Nz
 
 	bool NetPacket::EncodeHeader(void* data, UInt16 packetSize, UInt16 netCode)
 	{
-		MemoryView stream(data, HeaderSize);
-
-		SerializationContext context;
-		context.stream = &stream;
+		MemoryWriter writer(data, HeaderSize);
 
-		return Serialize(context, packetSize) && Serialize(context, netCode);
+		return writer.Write(packetSize) && writer.Write(netCode);
 	}
 
 	void NetPacket::OnEmptyStream()
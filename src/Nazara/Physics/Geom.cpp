@@ -3,8 +3,11 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Physics/Geom.hpp>
+#include <Nazara/Core/ByteStream.hpp>
+#include <Nazara/Core/Error.hpp>
 #include <Nazara/Physics/PhysWorld.hpp>
 #include <Newton/Newton.h>
+#include <cstring>
 #include <memory>
 #include <Nazara/Physics/Debug.hpp>
 
@@ -33,6 +36,144 @@ namespace Nz
 			NazaraError("Primitive type not handled (0x" + String::Number(primitive.type, 16) + ')');
 			return PhysGeomRef();
 		}
+
+		constexpr UInt32 s_bakedShapeMagic = 0x47505A4E; // "NZPG"
+		constexpr UInt32 s_bakedShapeVersion = 1;
+
+		struct BakedShapeReader
+		{
+			const UInt8* ptr;
+			std::size_t remaining;
+			bool truncated;
+		};
+
+		ByteArray BakeShape(PhysWorld* world, const NewtonCollision* collision)
+		{
+			ByteArray bakedShape;
+			NewtonCollisionSerialize(world->GetHandle(), collision, [](void* const serializeHandle, const void* const buffer, int size)
+			{
+				static_cast<ByteArray*>(serializeHandle)->Append(buffer, size);
+			}, &bakedShape);
+
+			return bakedShape;
+		}
+
+		NewtonCollision* CreateFromBakedShape(PhysWorld* world, const ByteArray& bakedShape)
+		{
+			BakedShapeReader reader;
+			reader.ptr = bakedShape.GetConstBuffer();
+			reader.remaining = bakedShape.GetSize();
+			reader.truncated = false;
+
+			NewtonCollision* collision = NewtonCreateCollisionFromSerialization(world->GetHandle(), [](void* const serializeHandle, void* const buffer, int size)
+			{
+				BakedShapeReader* shapeReader = static_cast<BakedShapeReader*>(serializeHandle);
+
+				// Newton cannot be told to stop reading, it gets zeros until the end and its result is discarded
+				if (size < 0 || static_cast<std::size_t>(size) > shapeReader->remaining)
+				{
+					if (size > 0)
+						std::memset(buffer, 0, size);
+
+					shapeReader->remaining = 0;
+					shapeReader->truncated = true;
+					return;
+				}
+
+				std::memcpy(buffer, shapeReader->ptr, size);
+				shapeReader->ptr += size;
+				shapeReader->remaining -= size;
+			}, &reader);
+
+			if (reader.truncated)
+			{
+				NazaraError("Baked shape is truncated");
+
+				if (collision)
+					NewtonDestroyCollision(collision);
+
+				return nullptr;
+			}
+
+			return collision;
+		}
+
+		bool ReadBakedShape(Stream& stream, GeomType type, ByteArray* bakedShape, Matrix4f* matrix)
+		{
+			ByteStream byteStream(&stream);
+
+			UInt32 magic;
+			UInt32 version;
+			UInt32 newtonVersion;
+			UInt32 shapeType;
+			UInt32 shapeSize;
+			byteStream >> magic >> version >> newtonVersion >> shapeType;
+
+			if (byteStream.HasFailed() || magic != s_bakedShapeMagic || version != s_bakedShapeVersion)
+			{
+				NazaraError("Stream does not contain a baked shape");
+				return false;
+			}
+
+			// Newton serialization format may change between versions
+			if (newtonVersion != static_cast<UInt32>(NewtonWorldGetVersion()))
+			{
+				NazaraError("Shape was baked with another version of Newton (" + String::Number(newtonVersion) + ')');
+				return false;
+			}
+
+			if (shapeType != static_cast<UInt32>(type))
+			{
+				NazaraError("Baked shape type mismatch (expected " + String::Number(type) + ", got " + String::Number(shapeType) + ')');
+				return false;
+			}
+
+			for (unsigned int i = 0; i < 16; ++i)
+				byteStream >> (*matrix)[i];
+
+			byteStream >> shapeSize;
+
+			// The size is checked before allocating anything for it
+			if (byteStream.HasFailed() || shapeSize > stream.GetSize() - stream.GetCursorPos())
+			{
+				NazaraError("Failed to read baked shape: stream is truncated");
+				return false;
+			}
+
+			bakedShape->Resize(shapeSize);
+			if (byteStream.Read(bakedShape->GetBuffer(), shapeSize) != shapeSize)
+			{
+				NazaraError("Failed to read baked shape: stream is truncated");
+				return false;
+			}
+
+			// The Newton serialization is loaded once in a temporary world, so that a corrupt one is rejected here rather than when the geom is used
+			PhysWorld world;
+
+			NewtonCollision* collision = CreateFromBakedShape(&world, *bakedShape);
+			if (!collision)
+			{
+				NazaraError("Failed to load baked shape");
+				return false;
+			}
+			NewtonDestroyCollision(collision);
+
+			return true;
+		}
+
+		bool WriteBakedShape(Stream& stream, GeomType type, const ByteArray& bakedShape, const Matrix4f& matrix)
+		{
+			ByteStream byteStream(&stream);
+			byteStream << s_bakedShapeMagic << s_bakedShapeVersion << static_cast<UInt32>(NewtonWorldGetVersion()) << static_cast<UInt32>(type);
+
+			for (unsigned int i = 0; i < 16; ++i)
+				byteStream << matrix[i];
+
+			byteStream << static_cast<UInt32>(bakedShape.GetSize());
+			byteStream.Write(bakedShape.GetConstBuffer(), bakedShape.GetSize());
+
+			return byteStream.FlushBits();
+		}
 	}
 
 	PhysGeom::~PhysGeom()
@@ -386,6 +527,94 @@ namespace Nz
 		return NewtonCreateCylinder(world->GetHandle(), m_radius, m_length, 0, m_matrix);
 	}
 
+	/****************************** HeightfieldGeom ******************************/
+
+	HeightfieldGeom::HeightfieldGeom(unsigned int width, unsigned int height, const float* heights, float horizontalScale, const Matrix4f& transformMatrix) :
+	m_heights(heights, heights + width*height),
+	m_matrix(transformMatrix),
+	m_horizontalScale(horizontalScale),
+	m_height(height),
+	m_width(width)
+	{
+		NazaraAssert(width >= 2 && height >= 2, "Heightfield must be at least 2x2");
+		NazaraAssert(heights, "Invalid heights");
+	}
+
+	HeightfieldGeom::HeightfieldGeom(unsigned int width, unsigned int height, const float* heights, float horizontalScale, const Vector3f& translation, const Quaternionf& rotation) :
+	HeightfieldGeom(width, height, heights, horizontalScale, Matrix4f::Transform(translation, rotation))
+	{
+	}
+
+	HeightfieldGeom::HeightfieldGeom(ByteArray bakedShape, const Matrix4f& transformMatrix) :
+	m_bakedShape(std::move(bakedShape)),
+	m_matrix(transformMatrix),
+	m_horizontalScale(0.f),
+	m_height(0),
+	m_width(0)
+	{
+	}
+
+	void HeightfieldGeom::ComputeInertialMatrix(Vector3f* inertia, Vector3f* center) const
+	{
+		// Static geometry, no meaningful inertia
+		if (inertia)
+			inertia->MakeUnit();
+
+		if (center)
+			center->MakeZero();
+	}
+
+	float HeightfieldGeom::ComputeVolume() const
+	{
+		return 0.f;
+	}
+
+	GeomType HeightfieldGeom::GetType() const
+	{
+		return GeomType_Heightfield;
+	}
+
+	bool HeightfieldGeom::SaveToStream(Stream& stream) const
+	{
+		if (m_bakedShape.IsEmpty())
+		{
+			PhysWorld world;
+			NewtonDestroyCollision(CreateHandle(&world)); // Bakes the shape
+		}
+
+		return WriteBakedShape(stream, GeomType_Heightfield, m_bakedShape, m_matrix);
+	}
+
+	HeightfieldGeomRef HeightfieldGeom::LoadFromStream(Stream& stream)
+	{
+		ByteArray bakedShape;
+		Matrix4f matrix;
+		if (!ReadBakedShape(stream, GeomType_Heightfield, &bakedShape, &matrix))
+			return HeightfieldGeomRef();
+
+		return New(std::move(bakedShape), matrix);
+	}
+
+	NewtonCollision* HeightfieldGeom::CreateHandle(PhysWorld* world) const
+	{
+		NewtonCollision* collision;
+		if (m_bakedShape.IsEmpty())
+		{
+			std::vector<char> attributes(m_width*m_height, 0);
+			collision = NewtonCreateHeightFieldCollision(world->GetHandle(), m_width, m_height, 0, m_heights.data(), attributes.data(), m_horizontalScale, 0);
+
+			// Other worlds will load the baked shape instead of building it again
+			m_bakedShape = BakeShape(world, collision);
+			m_heights.clear();
+			m_heights.shrink_to_fit();
+		}
+		else
+			collision = CreateFromBakedShape(world, m_bakedShape);
+
+		NewtonCollisionSetMatrix(collision, m_matrix);
+		return collision;
+	}
+
 	/********************************* NullGeom **********************************/
 
 	NullGeom::NullGeom()
@@ -452,4 +681,97 @@ namespace Nz
 	{
 		return NewtonCreateSphere(world->GetHandle(), m_radius, 0, Matrix4f::Translate(m_position));
 	}
+
+	/***************************** TriangleMeshGeom ******************************/
+
+	TriangleMeshGeom::TriangleMeshGeom(const void* vertices, unsigned int vertexCount, unsigned int stride, const UInt32* indices, unsigned int indexCount, bool optimize, const Matrix4f& transformMatrix) :
+	m_indices(indices, indices + indexCount),
+	m_optimize(optimize)
+	{
+		NazaraAssert(indexCount % 3 == 0, "Index count must be a multiple of 3");
+
+		// Tree collisions don't have an offset matrix, vertices are transformed once and for all
+		const UInt8* ptr = static_cast<const UInt8*>(vertices);
+
+		m_vertices.resize(vertexCount);
+		for (unsigned int i = 0; i < vertexCount; ++i)
+			m_vertices[i] = transformMatrix.Transform(*reinterpret_cast<const Vector3f*>(ptr + stride*i));
+	}
+
+	TriangleMeshGeom::TriangleMeshGeom(const void* vertices, unsigned int vertexCount, unsigned int stride, const UInt32* indices, unsigned int indexCount, bool optimize, const Vector3f& translation, const Quaternionf& rotation) :
+	TriangleMeshGeom(vertices, vertexCount, stride, indices, indexCount, optimize, Matrix4f::Transform(translation, rotation))
+	{
+	}
+
+	TriangleMeshGeom::TriangleMeshGeom(ByteArray bakedShape) :
+	m_bakedShape(std::move(bakedShape)),
+	m_optimize(false)
+	{
+	}
+
+	void TriangleMeshGeom::ComputeInertialMatrix(Vector3f* inertia, Vector3f* center) const
+	{
+		// Static geometry, no meaningful inertia
+		if (inertia)
+			inertia->MakeUnit();
+
+		if (center)
+			center->MakeZero();
+	}
+
+	float TriangleMeshGeom::ComputeVolume() const
+	{
+		return 0.f;
+	}
+
+	GeomType TriangleMeshGeom::GetType() const
+	{
+		return GeomType_Tree;
+	}
+
+	bool TriangleMeshGeom::SaveToStream(Stream& stream) const
+	{
+		if (m_bakedShape.IsEmpty())
+		{
+			PhysWorld world;
+			NewtonDestroyCollision(CreateHandle(&world)); // Bakes the shape
+		}
+
+		return WriteBakedShape(stream, GeomType_Tree, m_bakedShape, Matrix4f::Identity());
+	}
+
+	TriangleMeshGeomRef TriangleMeshGeom::LoadFromStream(Stream& stream)
+	{
+		ByteArray bakedShape;
+		Matrix4f matrix;
+		if (!ReadBakedShape(stream, GeomType_Tree, &bakedShape, &matrix))
+			return TriangleMeshGeomRef();
+
+		return New(std::move(bakedShape));
+	}
+
+	NewtonCollision* TriangleMeshGeom::CreateHandle(PhysWorld* world) const
+	{
+		if (!m_bakedShape.IsEmpty())
+			return CreateFromBakedShape(world, m_bakedShape);
+
+		NewtonCollision* collision = NewtonCreateTreeCollision(world->GetHandle(), 0);
+
+		NewtonTreeCollisionBeginBuild(collision);
+		for (std::size_t i = 0; i < m_indices.size(); i += 3)
+		{
+			Vector3f face[3] = {m_vertices[m_indices[i]], m_vertices[m_indices[i + 1]], m_vertices[m_indices[i + 2]]};
+			NewtonTreeCollisionAddFace(collision, 3, &face[0].x, sizeof(Vector3f), 0);
+		}
+		NewtonTreeCollisionEndBuild(collision, (m_optimize) ? 1 : 0);
+
+		// Building the tree is slow, other worlds will load the baked shape instead
+		m_bakedShape = BakeShape(world, collision);
+		m_indices.clear();
+		m_indices.shrink_to_fit();
+		m_vertices.clear();
+		m_vertices.shrink_to_fit();
+
+		return collision;
+	}
 }
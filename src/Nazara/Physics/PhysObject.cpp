@@ -19,10 +19,16 @@ namespace Nz
 
 	PhysObject::PhysObject(PhysWorld* world, PhysGeomRef geom, const Matrix4f& mat) :
 	m_matrix(mat),
+	m_previousMatrix(mat),
 	m_geom(std::move(geom)),
 	m_forceAccumulator(Vector3f::Zero()),
 	m_torqueAccumulator(Vector3f::Zero()),
 	m_world(world),
+	m_transformStep(0),
+	m_userdata(nullptr),
+	m_movedIndex(0),
+	m_movedThreadIndex(-1),
+	m_moved(false),
 	m_gravityFactor(1.f),
 	m_mass(0.f)
 	{
@@ -37,10 +43,16 @@ namespace Nz
 
 	PhysObject::PhysObject(const PhysObject& object) :
 	m_matrix(object.m_matrix),
+	m_previousMatrix(object.m_matrix),
 	m_geom(object.m_geom),
 	m_forceAccumulator(Vector3f::Zero()),
 	m_torqueAccumulator(Vector3f::Zero()),
 	m_world(object.m_world),
+	m_transformStep(0),
+	m_userdata(nullptr),
+	m_movedIndex(0),
+	m_movedThreadIndex(-1),
+	m_moved(false),
 	m_gravityFactor(object.m_gravityFactor),
 	m_mass(0.f)
 	{
@@ -54,19 +66,35 @@ namespace Nz
 
 	PhysObject::PhysObject(PhysObject&& object) :
 	m_matrix(std::move(object.m_matrix)),
+	m_previousMatrix(std::move(object.m_previousMatrix)),
 	m_geom(std::move(object.m_geom)),
 	m_forceAccumulator(std::move(object.m_forceAccumulator)),
 	m_torqueAccumulator(std::move(object.m_torqueAccumulator)),
 	m_body(object.m_body),
 	m_world(object.m_world),
+	m_transformStep(object.m_transformStep),
+	m_userdata(object.m_userdata),
+	m_movedIndex(object.m_movedIndex),
+	m_movedThreadIndex(object.m_movedThreadIndex),
+	m_moved(object.m_moved),
 	m_gravityFactor(object.m_gravityFactor),
 	m_mass(object.m_mass)
 	{
+		if (m_body)
+			NewtonBodySetUserData(m_body, this);
+
+		if (m_moved)
+			m_world->ReplaceMovedObject(&object, this);
+
 		object.m_body = nullptr;
+		object.m_moved = false;
 	}
 
 	PhysObject::~PhysObject()
 	{
+		if (m_moved)
+			m_world->ReplaceMovedObject(this, nullptr);
+
 		if (m_body)
 			NewtonDestroyBody(m_world->GetHandle(), m_body);
 	}
@@ -158,6 +186,22 @@ namespace Nz
 		return m_body;
 	}
 
+	Vector3f PhysObject::GetInterpolatedPosition(float interpolation) const
+	{
+		if (!IsInterpolated())
+			return m_matrix.GetTranslation();
+
+		return Vector3f::Lerp(m_previousMatrix.GetTranslation(), m_matrix.GetTranslation(), interpolation);
+	}
+
+	Quaternionf PhysObject::GetInterpolatedRotation(float interpolation) const
+	{
+		if (!IsInterpolated())
+			return m_matrix.GetRotation();
+
+		return Quaternionf::Slerp(m_previousMatrix.GetRotation(), m_matrix.GetRotation(), interpolation);
+	}
+
 	float PhysObject::GetMass() const
 	{
 		return m_mass;
@@ -196,6 +240,11 @@ namespace Nz
 		return m_matrix.GetRotation();
 	}
 
+	void* PhysObject::GetUserdata() const
+	{
+		return m_userdata;
+	}
+
 	Vector3f PhysObject::GetVelocity() const
 	{
 		Vector3f velocity;
@@ -209,6 +258,12 @@ namespace Nz
 		return NewtonBodyGetAutoSleep(m_body) != 0;
 	}
 
+	bool PhysObject::IsInterpolated() const
+	{
+		// Objects which did not move during the last step are at rest, their previous state is outdated
+		return m_transformStep == m_world->m_stepCount;
+	}
+
 	bool PhysObject::IsMoveable() const
 	{
 		return m_mass > 0.f;
@@ -283,6 +338,11 @@ namespace Nz
 		UpdateBody();
 	}
 
+	void PhysObject::SetUserdata(void* userdata)
+	{
+		m_userdata = userdata;
+	}
+
 	void PhysObject::SetVelocity(const Vector3f& velocity)
 	{
 		NewtonBodySetVelocity(m_body, velocity);
@@ -294,9 +354,23 @@ namespace Nz
 		return operator=(std::move(physObj));
 	}
 
+	void PhysObject::NotifyMoved(int threadIndex)
+	{
+		// Newton calls the transform callback of a body once per substep at most, and substeps are sequential
+		if (!m_moved)
+		{
+			m_moved = true;
+			m_world->NotifyMoved(this, threadIndex);
+		}
+	}
+
 	void PhysObject::UpdateBody()
 	{
 		NewtonBodySetMatrix(m_body, m_matrix);
+		NotifyMoved(0);
+
+		// Teleportations are not interpolated
+		m_previousMatrix = m_matrix;
 
 		if (NumberEquals(m_mass, 0.f))
 		{
@@ -316,6 +390,9 @@ namespace Nz
 
 	PhysObject& PhysObject::operator=(PhysObject&& object)
 	{
+		if (m_moved)
+			m_world->ReplaceMovedObject(this, nullptr);
+
 		if (m_body)
 			NewtonDestroyBody(m_world->GetHandle(), m_body);
 
@@ -325,10 +402,23 @@ namespace Nz
 		m_gravityFactor      = object.m_gravityFactor;
 		m_mass               = object.m_mass;
 		m_matrix             = std::move(object.m_matrix);
+		m_moved              = object.m_moved;
+		m_movedIndex         = object.m_movedIndex;
+		m_movedThreadIndex   = object.m_movedThreadIndex;
+		m_previousMatrix     = std::move(object.m_previousMatrix);
 		m_torqueAccumulator  = std::move(object.m_torqueAccumulator);
+		m_transformStep      = object.m_transformStep;
+		m_userdata           = object.m_userdata;
 		m_world              = object.m_world;
 
+		if (m_body)
+			NewtonBodySetUserData(m_body, this);
+
+		if (m_moved)
+			m_world->ReplaceMovedObject(&object, this);
+
 		object.m_body = nullptr;
+		object.m_moved = false;
 
 		return *this;
 	}
@@ -357,10 +447,11 @@ namespace Nz
 
 	void PhysObject::TransformCallback(const NewtonBody* body, const float* matrix, int threadIndex)
 	{
-		NazaraUnused(threadIndex);
-
 		PhysObject* me = static_cast<PhysObject*>(NewtonBodyGetUserData(body));
+		me->m_previousMatrix = me->m_matrix;
 		me->m_matrix.Set(matrix);
+		me->m_transformStep = me->m_world->m_stepCount;
+		me->NotifyMoved(threadIndex);
 
 		/*for (std::set<PhysObjectListener*>::iterator it = me->m_listeners.begin(); it != me->m_listeners.end(); ++it)
 			(*it)->PhysObjectOnUpdate(me);*/
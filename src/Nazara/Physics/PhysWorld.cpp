@@ -3,18 +3,73 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Physics/PhysWorld.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Nazara/Physics/PhysObject.hpp>
 #include <Newton/Newton.h>
+#include <algorithm>
+#include <limits>
 #include <Nazara/Physics/Debug.hpp>
 
 namespace Nz
 {
+	namespace
+	{
+		// Under this number of queries per task, dispatching them costs more than it saves
+		constexpr std::size_t s_minQueriesPerTask = 32;
+
+		// Splits the queries between at most maxTaskCount tasks, func(first, count, threadIndex) is called once per task
+		template<typename F>
+		void DispatchQueries(std::size_t queryCount, unsigned int maxTaskCount, const F& func)
+		{
+			std::size_t taskCount = std::min<std::size_t>(maxTaskCount, queryCount / s_minQueriesPerTask);
+			TaskScheduler::ParallelFor(queryCount, taskCount, [&func](std::size_t first, std::size_t last, unsigned int taskIndex)
+			{
+				func(first, last - first, static_cast<int>(taskIndex));
+			});
+		}
+
+		void CollectBody(const NewtonBody* const body, void* const userData)
+		{
+			static_cast<std::vector<PhysObject*>*>(userData)->push_back(static_cast<PhysObject*>(NewtonBodyGetUserData(body)));
+		}
+
+		dFloat RaycastFilter(const NewtonBody* const body, const NewtonCollision* const shapeHit, const dFloat* const hitNormal, int* const collisionID, void* const userData, dFloat intersectParam)
+		{
+			NazaraUnused(shapeHit);
+			NazaraUnused(collisionID);
+
+			PhysWorld::QueryHit* hit = static_cast<PhysWorld::QueryHit*>(userData);
+			if (intersectParam < hit->fraction)
+			{
+				hit->fraction = intersectParam;
+				hit->normal.Set(hitNormal);
+				hit->object = static_cast<PhysObject*>(NewtonBodyGetUserData(body));
+			}
+
+			// Newton will then only report hits closer than this one
+			return intersectParam;
+		}
+
+		void ResetHit(const Vector3f& to, PhysWorld::QueryHit* hit)
+		{
+			hit->fraction = 1.f;
+			hit->normal = Vector3f::Zero();
+			hit->object = nullptr;
+			hit->position = to;
+		}
+	}
+
 	PhysWorld::PhysWorld() :
 	m_gravity(Vector3f::Zero()),
+	m_stepCount(0),
 	m_stepSize(0.005f),
 	m_timestepAccumulator(0.f)
 	{
 		m_world = NewtonCreate();
 		NewtonWorldSetUserData(m_world, this);
+
+		m_threadMovedObjects.resize(std::max(NewtonGetThreadsCount(m_world), 1));
 	}
 
 	PhysWorld::~PhysWorld()
@@ -22,6 +77,14 @@ namespace Nz
 		NewtonDestroy(m_world);
 	}
 
+	void PhysWorld::ClearMovedObjects()
+	{
+		for (PhysObject* object : m_movedObjects)
+			object->m_moved = false;
+
+		m_movedObjects.clear();
+	}
+
 	Vector3f PhysWorld::GetGravity() const
 	{
 		return m_gravity;
@@ -32,11 +95,140 @@ namespace Nz
 		return m_world;
 	}
 
+	float PhysWorld::GetInterpolationFactor() const
+	{
+		// Part of a step which was not simulated yet, to interpolate between the previous and the current state
+		return m_timestepAccumulator / m_stepSize;
+	}
+
+	unsigned int PhysWorld::GetMaxThreadCount() const
+	{
+		return NewtonGetMaxThreadsCount(m_world);
+	}
+
+	const std::vector<PhysObject*>& PhysWorld::GetMovedObjects() const
+	{
+		return m_movedObjects;
+	}
+
 	float PhysWorld::GetStepSize() const
 	{
 		return m_stepSize;
 	}
 
+	unsigned int PhysWorld::GetThreadCount() const
+	{
+		return NewtonGetThreadsCount(m_world);
+	}
+
+	void PhysWorld::Overlap(const Boxf& box, std::vector<PhysObject*>* objects)
+	{
+		Overlap(&box, 1, objects);
+	}
+
+	void PhysWorld::Overlap(const Boxf* boxes, std::size_t boxCount, std::vector<PhysObject*>* objects)
+	{
+		NazaraAssert(boxes || boxCount == 0, "Invalid boxes");
+		NazaraAssert(objects || boxCount == 0, "Invalid object lists");
+
+		// Only the broadphase is involved, Newton doesn't need a thread index
+		DispatchQueries(boxCount, std::numeric_limits<unsigned int>::max(), [this, boxes, objects](std::size_t first, std::size_t count, int threadIndex)
+		{
+			NazaraUnused(threadIndex);
+
+			for (std::size_t i = first; i < first + count; ++i)
+			{
+				objects[i].clear();
+				NewtonWorldForEachBodyInAABBDo(m_world, boxes[i].GetMinimum(), boxes[i].GetMaximum(), CollectBody, &objects[i]);
+			}
+		});
+	}
+
+	void PhysWorld::Overlap(const Spheref& sphere, std::vector<PhysObject*>* objects)
+	{
+		Overlap(&sphere, 1, objects);
+	}
+
+	void PhysWorld::Overlap(const Spheref* spheres, std::size_t sphereCount, std::vector<PhysObject*>* objects)
+	{
+		NazaraAssert(spheres || sphereCount == 0, "Invalid spheres");
+		NazaraAssert(objects || sphereCount == 0, "Invalid object lists");
+
+		// Newton keeps per-thread data for distance queries, we can't use more tasks than it has threads
+		DispatchQueries(sphereCount, GetThreadCount(), [this, spheres, objects](std::size_t first, std::size_t count, int threadIndex)
+		{
+			for (std::size_t i = first; i < first + count; ++i)
+			{
+				const Spheref& sphere = spheres[i];
+				Vector3f center = sphere.GetPosition();
+				Vector3f extent(sphere.radius);
+
+				std::vector<PhysObject*>& sphereObjects = objects[i];
+				sphereObjects.clear();
+				NewtonWorldForEachBodyInAABBDo(m_world, center - extent, center + extent, CollectBody, &sphereObjects);
+
+				// The broadphase only tested the bounding box of the sphere against the bounding box of the bodies
+				auto it = std::remove_if(sphereObjects.begin(), sphereObjects.end(), [&](PhysObject* object)
+				{
+					const NewtonBody* body = object->GetHandle();
+
+					Matrix4f matrix;
+					NewtonBodyGetMatrix(body, matrix);
+
+					float contact[4];
+					float normal[4];
+					if (NewtonCollisionPointDistance(m_world, center, NewtonBodyGetCollision(body), matrix, contact, normal, threadIndex) == 0)
+						return false; // The center is inside the body
+
+					return center.SquaredDistance(Vector3f(contact)) > sphere.radius * sphere.radius;
+				});
+				sphereObjects.erase(it, sphereObjects.end());
+			}
+		});
+	}
+
+	bool PhysWorld::Raycast(const Vector3f& from, const Vector3f& to, QueryHit* hit)
+	{
+		RaycastQuery query;
+		query.from = from;
+		query.to = to;
+
+		QueryHit queryHit;
+		Raycast(&query, 1, &queryHit);
+
+		if (hit)
+			*hit = queryHit;
+
+		return queryHit.object != nullptr;
+	}
+
+	void PhysWorld::Raycast(const RaycastQuery* queries, std::size_t queryCount, QueryHit* hits)
+	{
+		NazaraAssert(queries || queryCount == 0, "Invalid queries");
+		NazaraAssert(hits || queryCount == 0, "Invalid hits");
+
+		DispatchQueries(queryCount, std::numeric_limits<unsigned int>::max(), [this, queries, hits](std::size_t first, std::size_t count, int threadIndex)
+		{
+			NazaraUnused(threadIndex);
+
+			for (std::size_t i = first; i < first + count; ++i)
+			{
+				const RaycastQuery& query = queries[i];
+				QueryHit& hit = hits[i];
+
+				ResetHit(query.to, &hit);
+				hit.fraction = std::numeric_limits<float>::infinity();
+
+				NewtonWorldRayCast(m_world, query.from, query.to, RaycastFilter, &hit, nullptr);
+
+				if (hit.object)
+					hit.position = Vector3f::Lerp(query.from, query.to, hit.fraction);
+				else
+					hit.fraction = 1.f;
+			}
+		});
+	}
+
 	void PhysWorld::SetGravity(const Vector3f& gravity)
 	{
 		m_gravity = gravity;
@@ -52,14 +244,125 @@ namespace Nz
 		m_stepSize = stepSize;
 	}
 
+	void PhysWorld::SetThreadCount(unsigned int threadCount)
+	{
+		NazaraAssert(threadCount > 0, "Thread count must be over zero");
+
+		NewtonSetThreadsCount(m_world, threadCount);
+
+		// Newton may clamp the thread count, the callbacks will only receive indices of threads it actually uses
+		unsigned int actualThreadCount = std::max(NewtonGetThreadsCount(m_world), 1);
+		if (actualThreadCount > m_threadMovedObjects.size())
+			m_threadMovedObjects.resize(actualThreadCount);
+	}
+
 	void PhysWorld::Step(float timestep)
 	{
 		m_timestepAccumulator += timestep;
 
 		while (m_timestepAccumulator >= m_stepSize)
 		{
+			m_stepCount++;
 			NewtonUpdate(m_world, m_stepSize);
 			m_timestepAccumulator -= m_stepSize;
 		}
+
+		for (auto& movedObjects : m_threadMovedObjects)
+		{
+			for (PhysObject* object : movedObjects)
+			{
+				object->m_movedIndex = m_movedObjects.size();
+				object->m_movedThreadIndex = -1;
+				m_movedObjects.push_back(object);
+			}
+
+			movedObjects.clear();
+		}
+	}
+
+	bool PhysWorld::Sweep(const PhysGeomRef& geom, const Quaternionf& rotation, const Vector3f& from, const Vector3f& to, QueryHit* hit)
+	{
+		SweepQuery query;
+		query.from = from;
+		query.geom = geom;
+		query.rotation = rotation;
+		query.to = to;
+
+		QueryHit queryHit;
+		Sweep(&query, 1, &queryHit);
+
+		if (hit)
+			*hit = queryHit;
+
+		return queryHit.object != nullptr;
+	}
+
+	void PhysWorld::Sweep(const SweepQuery* queries, std::size_t queryCount, QueryHit* hits)
+	{
+		NazaraAssert(queries || queryCount == 0, "Invalid queries");
+		NazaraAssert(hits || queryCount == 0, "Invalid hits");
+
+		// Collision handles are created on demand, which is not thread-safe
+		for (std::size_t i = 0; i < queryCount; ++i)
+		{
+			NazaraAssert(queries[i].geom.IsValid(), "Invalid geom");
+			queries[i].geom->GetHandle(this);
+		}
+
+		// Newton keeps per-thread data for convex casts, we can't use more tasks than it has threads
+		DispatchQueries(queryCount, GetThreadCount(), [this, queries, hits](std::size_t first, std::size_t count, int threadIndex)
+		{
+			for (std::size_t i = first; i < first + count; ++i)
+			{
+				const SweepQuery& query = queries[i];
+				QueryHit& hit = hits[i];
+
+				Matrix4f matrix = Matrix4f::Transform(query.from, query.rotation);
+
+				NewtonWorldConvexCastReturnInfo info;
+				float hitParam;
+				if (NewtonWorldConvexCast(m_world, matrix, query.to, query.geom->GetHandle(this), &hitParam, nullptr, nullptr, &info, 1, threadIndex) > 0)
+				{
+					hit.fraction = hitParam;
+					hit.normal.Set(info.m_normal);
+					hit.object = static_cast<PhysObject*>(NewtonBodyGetUserData(info.m_hitBody));
+					hit.position.Set(info.m_point);
+				}
+				else
+					ResetHit(query.to, &hit);
+			}
+		});
+	}
+
+	void PhysWorld::NotifyMoved(PhysObject* object, int threadIndex)
+	{
+		NazaraAssert(threadIndex >= 0 && static_cast<std::size_t>(threadIndex) < m_threadMovedObjects.size(), "Thread index out of range");
+
+		std::vector<PhysObject*>& movedObjects = m_threadMovedObjects[threadIndex];
+		object->m_movedIndex = movedObjects.size();
+		object->m_movedThreadIndex = threadIndex;
+		movedObjects.push_back(object);
+	}
+
+	void PhysWorld::ReplaceMovedObject(PhysObject* object, PhysObject* newObject)
+	{
+		// The objects know their place in the lists, this is called for every destroyed or moved object
+		std::vector<PhysObject*>& movedObjects = (object->m_movedThreadIndex >= 0) ? m_threadMovedObjects[object->m_movedThreadIndex] : m_movedObjects;
+		std::size_t index = object->m_movedIndex;
+		NazaraAssert(index < movedObjects.size() && movedObjects[index] == object, "Object is not part of the moved objects");
+
+		if (newObject)
+		{
+			newObject->m_movedIndex = index;
+			newObject->m_movedThreadIndex = object->m_movedThreadIndex;
+			movedObjects[index] = newObject;
+		}
+		else
+		{
+			// The order of the moved objects doesn't matter, the last one takes the place of the removed one
+			movedObjects[index] = movedObjects.back();
+			movedObjects[index]->m_movedIndex = index;
+			movedObjects.pop_back();
+		}
 	}
 }
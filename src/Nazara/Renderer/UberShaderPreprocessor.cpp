@@ -20,10 +20,12 @@ namespace Nz
 	UberShaderInstance* UberShaderPreprocessor::Get(const ParameterList& parameters) const
 	{
 		// Première étape, transformer les paramètres en un flag
+		// Un paramètre absent (ou non-booléen) désactive simplement son flag, sans erreur
 		UInt32 flags = 0;
-		for (auto it = m_flags.begin(); it != m_flags.end(); ++it)
 		{
-			if (parameters.HasParameter(it->first))
+			ErrorFlags flagsErrFlags(ErrorFlag_Silent, true);
+
+			for (auto it = m_flags.begin(); it != m_flags.end(); ++it)
 			{
 				bool value;
 				if (parameters.GetBooleanParameter(it->first, &value) && value)
@@ -53,9 +55,10 @@ namespace Nz
 					if (shaderStage.present && (flags & shaderStage.requiredFlags) == shaderStage.requiredFlags)
 					{
 						UInt32 stageFlags = 0;
-						for (auto it = shaderStage.flags.begin(); it != shaderStage.flags.end(); ++it)
 						{
-							if (parameters.HasParameter(it->first))
+							ErrorFlags flagsErrFlags(ErrorFlag_Silent, true);
+
+							for (auto it = shaderStage.flags.begin(); it != shaderStage.flags.end(); ++it)
 							{
 								bool value;
 								if (parameters.GetBooleanParameter(it->first, &value) && value)
@@ -79,7 +82,7 @@ namespace Nz
 							code << "#define EARLY_FRAGMENT_TEST " << (glslVersion >= 420 || OpenGL::IsSupported(OpenGLExtension_Shader_ImageLoadStore)) << "\n\n";
 
 							for (auto it = shaderStage.flags.begin(); it != shaderStage.flags.end(); ++it)
-								code << "#define " << it->first << ' ' << ((stageFlags & it->second) ? '1' : '0') << '\n';
+								code << "#define " << it->first.GetString() << ' ' << ((stageFlags & it->second) ? '1' : '0') << '\n';
 
 							code << "\n#line 1\n"; // Pour que les éventuelles erreurs du shader se réfèrent à la bonne ligne
 							code << shaderStage.source;
@@ -121,8 +124,10 @@ namespace Nz
 		std::vector<String> flags;
 		shaderFlags.Split(flags, ' ');
 
-		for (String& flag : flags)
+		for (const String& flagName : flags)
 		{
+			StringId flag(flagName);
+
 			auto it = m_flags.find(flag);
 			if (it == m_flags.end())
 				m_flags[flag] = 1U << m_flags.size();
@@ -138,8 +143,9 @@ namespace Nz
 		flags.clear();
 		requiredFlags.Split(flags, ' ');
 
-		for (String& flag : flags)
+		for (const String& flagName : flags)
 		{
+			StringId flag(flagName);
 			UInt32 flagVal;
 
 			auto it = m_flags.find(flag);
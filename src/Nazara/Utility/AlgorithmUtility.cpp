@@ -29,6 +29,12 @@
 #include <Nazara/Math/Algorithm.hpp>
 #include <Nazara/Utility/IndexIterator.hpp>
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <tuple>
 #include <unordered_map>
 #include <Nazara/Utility/Debug.hpp>
 
@@ -163,47 +169,7 @@ namespace Nz
 				unsigned int m_vertexIndex;
 		};
 
-		// Source: https://code.google.com/p/vcacne/
-		// Auteur: Michael Georgoulpoulos
-		// Selon ce papier: http://home.comcast.net/~tom_forsyth/papers/fast_vert_cache_opt.html
-		// Modifié pour les besoins du moteur
-		///TODO: Déplacer dans un fichier à part ?
-		struct VertexCacheData
-		{
-			int position_in_cache = -1;
-			float current_score = 0.f;
-			int total_valence = 0; // toatl number of triangles using this vertex
-			int remaining_valence = 0; // number of triangles using it but not yet rendered
-			std::vector<int> tri_indices; // indices to the indices that use this vertex
-			bool calculated; // was the score calculated during this iteration?
-
-
-			int FindTriangle(int tri)
-			{
-				for (unsigned int i = 0; i < tri_indices.size(); ++i)
-					if (tri_indices[i] == tri) return i;
-
-				return -1;
-			}
-
-			void MoveTriangleToEnd(int tri)
-			{
-				auto it = std::find(tri_indices.begin(), tri_indices.end(), tri);
-				NazaraAssert(it != tri_indices.end(), "Triangle not found");
-
-				tri_indices.erase(it);
-				tri_indices.push_back(tri);
-			}
-		};
-
-		struct TriangleCacheData
-		{
-			bool rendered = false; // has the triangle been added to the draw list yet?
-			float current_score = 0.f; // sum of the score of its vertices
-			int verts[3] = {-1, -1, -1}; // indices to the triangle's vertices
-			bool calculated = false; // was the score calculated during this iteration?
-		};
-
+		// LRU cache model from vcacheopt, used to measure the cache misses
 		class VertexCache
 		{
 			public:
@@ -281,350 +247,601 @@ namespace Nz
 				int m_misses; // cache miss count
 		};
 
+		// Constants of the vertex cache optimizer
+		constexpr float CacheDecayPower = 1.5f;
+		constexpr float LastTriangleScore = 0.75f;
+		constexpr float ValenceBoostPower = 0.5f;
+		constexpr float ValenceBoostScale = 2.f;
+		constexpr UInt32 InvalidTriangle = std::numeric_limits<UInt32>::max();
+		constexpr unsigned int CacheSize = 32; // Same size as the one of the cache of ComputeCacheMissCount
+		constexpr unsigned int MaxValence = 32; // Above it, the valence boost is the same
+
+		// Linear-time version of the algorithm described by Tom Forsyth (https://tomforsyth1000.github.io/papers/fast_vert_cache_opt.html)
+		// The scores are read from tables and only the vertices going through the cache are rescored after each triangle,
+		// the triangles of a vertex are stored contiguously and the emitted ones are moved out of the live range
 		class VertexCacheOptimizer
 		{
 			public:
-				enum Result
-				{
-					Success,
-					Fail_BadIndex,
-					Fail_NoVerts
-				};
-
 				VertexCacheOptimizer()
 				{
-					// initialize constants
-					m_cacheDecayPower = 1.5f;
-					m_lastTriScore = 0.75f;
-					m_valenceBoostScale = 2.0f;
-					m_valenceBoostPower = 0.5f;
-
-					m_bestTri = 0;
+					// Points for being high in the cache, the vertices of the last triangle all have the same score
+					// (otherwise the order of the vertices of a triangle would change the result)
+					for (unsigned int i = 0; i < CacheSize; ++i)
+						m_cacheScores[i] = (i < 3) ? LastTriangleScore : std::pow(1.f - static_cast<float>(i - 3) / (CacheSize - 3), CacheDecayPower);
+
+					// Bonus points for having a low number of triangles still to use the vertex, so we get rid of lone vertices quickly
+					m_valenceScores[0] = 0.f;
+					for (unsigned int i = 1; i <= MaxValence; ++i)
+						m_valenceScores[i] = ValenceBoostScale * std::pow(static_cast<float>(i), -ValenceBoostPower);
 				}
 
 				// stores new indices in place
-				Result Optimize(IndexIterator indices, unsigned int indexCount)
+				bool Optimize(IndexIterator indices, unsigned int indexCount)
 				{
-					if (indexCount == 0)
-						return Fail_NoVerts;
+					if (indexCount == 0 || indexCount % 3 != 0)
+						return false;
 
-					// find vertex count
-					int max_vert = *std::max_element(indices, indices + indexCount);
+					unsigned int triangleCount = indexCount / 3;
 
-					Result res = Init(indices, indexCount, max_vert + 1);
-					if (res != Success)
-						return res;
+					m_indices.resize(indexCount);
+					for (unsigned int i = 0; i < indexCount; ++i)
+						m_indices[i] = indices[i];
 
-					// iterate until Iterate returns false
-					while (Iterate());
+					unsigned int vertexCount = *std::max_element(m_indices.begin(), m_indices.end()) + 1;
 
-					// rewrite optimized index list
-					for (int index : m_drawList)
-					{
-						*indices++ = m_triangles[index].verts[0];
-						*indices++ = m_triangles[index].verts[1];
-						*indices++ = m_triangles[index].verts[2];
-					}
+					// Triangles of each vertex, the first liveTriangles[v] of them are not emitted yet
+					m_liveTriangles.assign(vertexCount, 0);
+					for (UInt32 index : m_indices)
+						m_liveTriangles[index]++;
 
-					return Success;
-				}
+					m_adjacencyOffsets.resize(vertexCount + 1);
+					m_adjacencyOffsets[0] = 0;
+					for (unsigned int i = 0; i < vertexCount; ++i)
+						m_adjacencyOffsets[i + 1] = m_adjacencyOffsets[i] + m_liveTriangles[i];
 
-			private:
-				float CalculateVertexScore(unsigned int vertex) const
-				{
-					const VertexCacheData* v = &m_vertices[vertex];
-					if (v->remaining_valence <= 0)
-						// No tri needs this vertex!
-						return -1.0f;
+					// The offsets are used as cursors while filling, and then moved back
+					m_adjacency.resize(indexCount);
+					for (unsigned int i = 0; i < indexCount; ++i)
+						m_adjacency[m_adjacencyOffsets[m_indices[i]]++] = i / 3;
 
-					float ret = 0.0f;
-					if (v->position_in_cache < 0)
+					m_vertexScores.resize(vertexCount);
+					for (unsigned int i = 0; i < vertexCount; ++i)
 					{
-						// Vertex is not in FIFO cache - no score.
+						m_adjacencyOffsets[i] -= m_liveTriangles[i];
+						m_vertexScores[i] = GetVertexScore(-1, m_liveTriangles[i]);
 					}
-					else
+
+					m_triangleScores.resize(triangleCount);
+					for (unsigned int i = 0; i < triangleCount; ++i)
+						m_triangleScores[i] = m_vertexScores[m_indices[i * 3]] + m_vertexScores[m_indices[i * 3 + 1]] + m_vertexScores[m_indices[i * 3 + 2]];
+
+					m_emitted.assign(triangleCount, false);
+
+					unsigned int cacheCount = 0;
+					unsigned int inputCursor = 0;
+					unsigned int bestTriangle = static_cast<unsigned int>(std::max_element(m_triangleScores.begin(), m_triangleScores.end()) - m_triangleScores.begin());
+					while (bestTriangle != InvalidTriangle)
 					{
-						if (v->position_in_cache < 3)
-						{
-							// This vertex was used in the last triangle,
-							// so it has a fixed score, whichever of the three
-							// it's in. Otherwise, you can get very different
-							// answers depending on whether you add
-							// the triangle 1,2,3 or 3,1,2 - which is silly.
-							ret = m_lastTriScore;
-						}
-						else
+						const UInt32* triangle = &m_indices[bestTriangle * 3];
+						*indices++ = triangle[0];
+						*indices++ = triangle[1];
+						*indices++ = triangle[2];
+
+						m_emitted[bestTriangle] = true;
+
+						// The vertices of the triangle go on top of the cache, the others are pushed down (and maybe out)
+						unsigned int newCacheCount = 0;
+						for (unsigned int i = 0; i < 3; ++i)
+							m_newCache[newCacheCount++] = triangle[i];
+
+						for (unsigned int i = 0; i < cacheCount; ++i)
 						{
-							// Points for being high in the cache.
-							const float Scaler = 1.0f / (32  - 3);
-							ret = 1.0f - (v->position_in_cache - 3) * Scaler;
-							ret = std::pow(ret, m_cacheDecayPower);
+							UInt32 vertex = m_cache[i];
+							if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2])
+								m_newCache[newCacheCount++] = vertex;
 						}
-					}
 
-					// Bonus points for having a low number of tris still to
-					// use the vert, so we get rid of lone verts quickly.
-					float valence_boost = std::pow(static_cast<float>(v->remaining_valence), -m_valenceBoostPower);
-					ret += m_valenceBoostScale * valence_boost;
-
-					return ret;
-				}
+						for (unsigned int i = 0; i < 3; ++i)
+						{
+							UInt32 vertex = triangle[i];
+							UInt32* triangles = &m_adjacency[m_adjacencyOffsets[vertex]];
+							UInt32 liveCount = m_liveTriangles[vertex];
 
-				// returns the index of the triangle with the highest score
-				// (or -1, if there aren't any active triangles)
-				int FullScoreRecalculation()
-				{
-					// calculate score for all vertices
-					for (unsigned int i = 0; i < m_vertices.size(); ++i)
-						m_vertices[i].current_score = CalculateVertexScore(i);
+							// The triangle is swapped with the last live one (a degenerated triangle is referenced once per occurrence)
+							UInt32* it = std::find(triangles, triangles + liveCount, bestTriangle);
+							NazaraAssert(it != triangles + liveCount, "Triangle not found");
 
-					// calculate scores for all active triangles
-					float max_score = std::numeric_limits<float>::lowest();
-					int max_score_tri = -1;
+							std::swap(*it, triangles[liveCount - 1]);
+							m_liveTriangles[vertex]--;
+						}
 
-					for (unsigned int i = 0; i < m_triangles.size(); ++i)
-					{
-						if (m_triangles[i].rendered)
-							continue;
+						// Rescoring of the vertices whose position in the cache or valence changed, their live triangles get the difference
+						for (unsigned int i = 0; i < newCacheCount; ++i)
+						{
+							UInt32 vertex = m_newCache[i];
+							float score = GetVertexScore((i < CacheSize) ? static_cast<int>(i) : -1, m_liveTriangles[vertex]);
+							float delta = score - m_vertexScores[vertex];
+							m_vertexScores[vertex] = score;
+
+							const UInt32* triangles = &m_adjacency[m_adjacencyOffsets[vertex]];
+							for (UInt32 j = 0; j < m_liveTriangles[vertex]; ++j)
+								m_triangleScores[triangles[j]] += delta;
+						}
 
-						// sum the score of all the triangle's vertices
-						float sc = m_vertices[m_triangles[i].verts[0]].current_score +
-								   m_vertices[m_triangles[i].verts[1]].current_score +
-								   m_vertices[m_triangles[i].verts[2]].current_score;
+						cacheCount = std::min(newCacheCount, CacheSize);
+						std::copy(m_newCache.begin(), m_newCache.begin() + cacheCount, m_cache.begin());
 
-						m_triangles[i].current_score = sc;
+						// The next triangle is the best one using a vertex of the cache (once all scores are updated)
+						bestTriangle = InvalidTriangle;
+						float bestScore = std::numeric_limits<float>::lowest();
+						for (unsigned int i = 0; i < cacheCount; ++i)
+						{
+							UInt32 vertex = m_cache[i];
+							const UInt32* triangles = &m_adjacency[m_adjacencyOffsets[vertex]];
+							for (UInt32 j = 0; j < m_liveTriangles[vertex]; ++j)
+							{
+								UInt32 triangleIndex = triangles[j];
+								if (m_triangleScores[triangleIndex] > bestScore)
+								{
+									bestScore = m_triangleScores[triangleIndex];
+									bestTriangle = triangleIndex;
+								}
+							}
+						}
 
-						if (sc > max_score)
+						// Dead end: we continue with the next triangle of the input order
+						if (bestTriangle == InvalidTriangle)
 						{
-							max_score = sc;
-							max_score_tri = i;
+							while (inputCursor < triangleCount && m_emitted[inputCursor])
+								inputCursor++;
+
+							if (inputCursor < triangleCount)
+								bestTriangle = inputCursor;
 						}
 					}
 
-					return max_score_tri;
+					return true;
 				}
 
-				Result InitialPass()
+			private:
+				float GetVertexScore(int cachePosition, UInt32 liveTriangleCount) const
 				{
-					for (unsigned int i = 0; i < m_indices.size(); ++i)
-					{
-						int index = m_indices[i];
-						if (index < 0 || index >= static_cast<int>(m_vertices.size()))
-							return Fail_BadIndex;
+					// No triangle needs this vertex anymore
+					if (liveTriangleCount == 0)
+						return -1.f;
 
-						m_vertices[index].total_valence++;
-						m_vertices[index].remaining_valence++;
+					float score = (cachePosition >= 0) ? m_cacheScores[cachePosition] : 0.f;
+					return score + m_valenceScores[std::min(liveTriangleCount, MaxValence)];
+				}
 
-						m_vertices[index].tri_indices.push_back(i/3);
-					}
+				std::array<UInt32, CacheSize> m_cache;
+				std::array<UInt32, CacheSize + 3> m_newCache;
+				std::array<float, CacheSize> m_cacheScores;
+				std::array<float, MaxValence + 1> m_valenceScores;
+				std::vector<bool> m_emitted;
+				std::vector<float> m_triangleScores;
+				std::vector<float> m_vertexScores;
+				std::vector<UInt32> m_adjacency;
+				std::vector<UInt32> m_adjacencyOffsets;
+				std::vector<UInt32> m_indices;
+				std::vector<UInt32> m_liveTriangles;
+		};
 
-					m_bestTri = FullScoreRecalculation();
+		// Constants of the mesh simplifier
+		constexpr float AttributeWeight = 0.01f; // Weight of the normal and texture coordinates differences in the cost of a collapse
+		constexpr float FlipThreshold = 0.25f; // Minimal cosine between the normals of a triangle before and after a collapse
 
-					return Success;
-				}
+		struct Quadric
+		{
+			void AddPlane(const Vector3d& normal, double distance, double weight)
+			{
+				a00 += weight * normal.x * normal.x;
+				a01 += weight * normal.x * normal.y;
+				a02 += weight * normal.x * normal.z;
+				a11 += weight * normal.y * normal.y;
+				a12 += weight * normal.y * normal.z;
+				a22 += weight * normal.z * normal.z;
+				b0 += weight * normal.x * distance;
+				b1 += weight * normal.y * distance;
+				b2 += weight * normal.z * distance;
+				c += weight * distance * distance;
+				w += weight;
+			}
 
-				Result Init(IndexIterator indices, unsigned int indexCount, int vertex_count)
-				{
-					// clear the draw list
-					m_drawList.clear();
+			// Mean squared distance of the point to the planes of the quadric
+			double Evaluate(const Vector3f& point) const
+			{
+				if (w <= 0.0)
+					return 0.0;
 
-					// allocate and initialize vertices and triangles
-					m_vertices.clear(); // Pour reconstruire tous les éléments
-					m_vertices.resize(vertex_count);
+				double x = point.x;
+				double y = point.y;
+				double z = point.z;
 
-					m_triangles.clear();
-					for (unsigned int i = 0; i < indexCount; i += 3)
-					{
-						TriangleCacheData dat;
-						for (unsigned int j = 0; j < 3; ++j)
-							dat.verts[j] = indices[i + j];
+				double error = a00 * x * x + 2.0 * a01 * x * y + 2.0 * a02 * x * z + a11 * y * y + 2.0 * a12 * y * z + a22 * z * z +
+				               2.0 * (b0 * x + b1 * y + b2 * z) + c;
 
-						m_triangles.push_back(dat);
-					}
+				return std::max(error / w, 0.0);
+			}
 
-					// copy the indices
+			Quadric& operator+=(const Quadric& quadric)
+			{
+				a00 += quadric.a00; a01 += quadric.a01; a02 += quadric.a02;
+				a11 += quadric.a11; a12 += quadric.a12; a22 += quadric.a22;
+				b0 += quadric.b0; b1 += quadric.b1; b2 += quadric.b2;
+				c += quadric.c;
+				w += quadric.w;
+
+				return *this;
+			}
+
+			double a00 = 0.0, a01 = 0.0, a02 = 0.0, a11 = 0.0, a12 = 0.0, a22 = 0.0;
+			double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+			double c = 0.0;
+			double w = 0.0;
+		};
+
+		// Edge collapse simplification guided by quadric error metrics (Garland & Heckbert), a vertex is only collapsed onto one
+		// of its neighbours so that the simplified indices keep using the same vertices
+		// Vertices on a border, a seam (sharing their position with another vertex) or a non-manifold edge are locked
+		class MeshSimplifier
+		{
+			public:
+				unsigned int Simplify(IndexIterator indices, unsigned int indexCount, unsigned int vertexCount, SparsePtr<const Vector3f> positionPtr, SparsePtr<const Vector3f> normalPtr, SparsePtr<const Vector2f> uvPtr, unsigned int targetIndexCount, float maxError, float* resultError)
+				{
 					m_indices.resize(indexCount);
 					for (unsigned int i = 0; i < indexCount; ++i)
+					{
 						m_indices[i] = indices[i];
+						NazaraAssert(m_indices[i] < vertexCount, "Index out of vertex range");
+					}
 
-					m_vertexCache.Clear();
-					m_bestTri = -1;
+					if (resultError)
+						*resultError = 0.f;
 
-					return InitialPass();
-				}
+					// Errors are computed on positions scaled to an unit box, making them relative to the size of the mesh
+					Boxf aabb = ComputeAABB(positionPtr, vertexCount);
+					float extent = std::max({aabb.width, aabb.height, aabb.depth});
+					if (extent <= 0.f || indexCount <= targetIndexCount)
+						return indexCount;
 
-				void AddTriangleToDrawList(int tri)
-				{
-					// reset all cache positions
-					for (unsigned int i = 0; i < 32; ++i)
-					{
-						int ind = m_vertexCache.GetVertex(i);
-						if (ind < 0)
-							continue;
+					Vector3f origin = aabb.GetPosition();
+					float invExtent = 1.f / extent;
 
-						m_vertices[ind].position_in_cache = -1;
-					}
+					m_positions.resize(vertexCount);
+					for (unsigned int i = 0; i < vertexCount; ++i)
+						m_positions[i] = (positionPtr[i] - origin) * invExtent;
 
-					TriangleCacheData* t = &m_triangles[tri];
-					if (t->rendered)
-						return; // triangle is already in the draw list
+					m_normalPtr = normalPtr;
+					m_uvPtr = uvPtr;
 
-					for (unsigned int i = 0; i < 3; ++i)
+					BuildPositionRemap(positionPtr, vertexCount);
+					LockBorders();
+					BuildQuadrics(vertexCount);
+
+					double maxErrorSquared = static_cast<double>(maxError) * maxError;
+					double collapseErrorSquared = 0.0;
+
+					unsigned int targetTriangleCount = targetIndexCount / 3;
+					unsigned int triangleCount = indexCount / 3;
+					while (triangleCount > targetTriangleCount)
 					{
-						// add all triangle vertices to the cache
-						m_vertexCache.AddVertex(t->verts[i]);
+						unsigned int collapseGoal = (triangleCount - targetTriangleCount + 1) / 2; // An edge collapse removes two triangles
+						if (!CollapseEdges(vertexCount, collapseGoal, maxErrorSquared, &collapseErrorSquared))
+							break;
 
-						VertexCacheData *v = &m_vertices[t->verts[i]];
+						// Removal of the degenerated triangles
+						unsigned int newIndexCount = 0;
+						for (unsigned int i = 0; i < triangleCount; ++i)
+						{
+							if (m_deadTriangles[i])
+								continue;
 
-						// decrease remaining velence
-						v->remaining_valence--;
+							for (unsigned int j = 0; j < 3; ++j)
+								m_indices[newIndexCount++] = m_indices[i * 3 + j];
+						}
 
-						// move the added triangle to the end of the vertex's
-						// triangle index list, so that the first 'remaining_valence'
-						// triangles in the list are the active ones
-						v->MoveTriangleToEnd(tri);
+						m_indices.resize(newIndexCount);
+						triangleCount = newIndexCount / 3;
 					}
 
-					m_drawList.push_back(tri);
+					for (std::size_t i = 0; i < m_indices.size(); ++i)
+						indices[i] = m_indices[i];
 
-					t->rendered = true;
+					if (resultError)
+						*resultError = static_cast<float>(std::sqrt(collapseErrorSquared));
 
-					// update all vertex cache positions
-					for (unsigned int i = 0; i < 32; ++i)
+					return static_cast<unsigned int>(m_indices.size());
+				}
+
+			private:
+				struct Collapse
+				{
+					double cost;
+					double error;
+					UInt32 source;
+					UInt32 target;
+				};
+
+				void BuildPositionRemap(SparsePtr<const Vector3f> positionPtr, unsigned int vertexCount)
+				{
+					// Vertices sharing the same position are grouped (and represented by the first of them)
+					std::vector<UInt32> order(vertexCount);
+					std::iota(order.begin(), order.end(), 0U);
+					auto PositionKey = [&positionPtr](UInt32 vertex)
 					{
-						int ind = m_vertexCache.GetVertex(i);
-						if (ind < 0)
-							continue;
+						const Vector3f& position = positionPtr[vertex];
+						return std::tie(position.x, position.y, position.z);
+					};
+
+					std::stable_sort(order.begin(), order.end(), [&PositionKey](UInt32 lhs, UInt32 rhs)
+					{
+						return PositionKey(lhs) < PositionKey(rhs);
+					});
 
-						m_vertices[ind].position_in_cache = i;
+					m_positionRemap.resize(vertexCount);
+					m_locked.assign(vertexCount, false);
+					for (unsigned int i = 0; i < vertexCount;)
+					{
+						unsigned int groupEnd = i + 1;
+						while (groupEnd < vertexCount && PositionKey(order[groupEnd]) == PositionKey(order[i]))
+							groupEnd++;
+
+						// The attributes of a seam are discontinuous, it is kept as is
+						bool seam = (groupEnd - i > 1);
+						for (unsigned int j = i; j < groupEnd; ++j)
+						{
+							m_positionRemap[order[j]] = order[i];
+							m_locked[order[j]] = seam;
+						}
+
+						i = groupEnd;
 					}
 				}
 
-				// Optimization: to avoid duplicate calculations durind the same iteration,
-				// both vertices and triangles have a 'calculated' flag. This flag
-				// must be cleared at the beginning of the iteration to all *active* triangles
-				// that have one or more of their vertices currently cached, and all their
-				// other vertices.
-				// If there aren't any active triangles in the cache, the function returns
-				// false and full recalculation is performed.
-				bool CleanCalculationFlags()
+				void BuildQuadrics(unsigned int vertexCount)
 				{
-					bool ret = false;
-					for (unsigned int i = 0; i < 32; ++i)
+					m_quadrics.assign(vertexCount, Quadric());
+					for (std::size_t i = 0; i < m_indices.size(); i += 3)
 					{
-						int vert = m_vertexCache.GetVertex(i);
-						if (vert < 0)
+						Vector3d p0(m_positions[m_indices[i]]);
+						Vector3d p1(m_positions[m_indices[i + 1]]);
+						Vector3d p2(m_positions[m_indices[i + 2]]);
+
+						Vector3d normal = Vector3d::CrossProduct(p1 - p0, p2 - p0);
+						double length = normal.GetLength();
+						if (length <= 0.0)
 							continue;
 
-						VertexCacheData *v = &m_vertices[vert];
+						normal *= 1.0 / length;
+
+						// Weighted by the area of the triangle
+						for (unsigned int j = 0; j < 3; ++j)
+							m_quadrics[m_indices[i + j]].AddPlane(normal, -normal.DotProduct(p0), length * 0.5);
+					}
+				}
+
+				bool CollapseEdges(unsigned int vertexCount, unsigned int collapseGoal, double maxErrorSquared, double* collapseErrorSquared)
+				{
+					unsigned int triangleCount = static_cast<unsigned int>(m_indices.size() / 3);
 
-						for (int j = 0; j < v->remaining_valence; j++)
+					// Best collapse of each vertex
+					m_bestCollapses.assign(vertexCount, Collapse{std::numeric_limits<double>::infinity(), 0.0, 0, InvalidTriangle});
+					for (unsigned int i = 0; i < triangleCount; ++i)
+					{
+						for (unsigned int j = 0; j < 3; ++j)
 						{
-							TriangleCacheData *t = &m_triangles[v->tri_indices[j]];
+							UInt32 a = m_indices[i * 3 + j];
+							UInt32 b = m_indices[i * 3 + (j + 1) % 3];
 
-							// we actually found a triangle to process
-							ret = true;
+							EvaluateCollapse(a, b);
+							EvaluateCollapse(b, a);
+						}
+					}
+
+					m_collapses.clear();
+					for (const Collapse& collapse : m_bestCollapses)
+					{
+						if (collapse.target != InvalidTriangle && collapse.error <= maxErrorSquared)
+							m_collapses.push_back(collapse);
+					}
+
+					if (m_collapses.empty())
+						return false;
+
+					std::sort(m_collapses.begin(), m_collapses.end(), [](const Collapse& lhs, const Collapse& rhs)
+					{
+						return std::tie(lhs.cost, lhs.source) < std::tie(rhs.cost, rhs.source);
+					});
 
-							// clear triangle flag
-							t->calculated = false;
+					// Only the cheapest collapses are done in this pass, the others are evaluated again after them
+					double costLimit = m_collapses[std::min<std::size_t>(collapseGoal, m_collapses.size()) - 1].cost;
 
-							// clear vertex flags
-							for (unsigned int k = 0; k < 3; ++k)
-								m_vertices[t->verts[k]].calculated = false;
+					// Triangles of each vertex
+					m_adjacencyOffsets.assign(vertexCount + 1, 0);
+					for (UInt32 index : m_indices)
+						m_adjacencyOffsets[index + 1]++;
+
+					for (unsigned int i = 0; i < vertexCount; ++i)
+						m_adjacencyOffsets[i + 1] += m_adjacencyOffsets[i];
+
+					m_adjacency.resize(m_indices.size());
+					m_adjacencyCursors.assign(m_adjacencyOffsets.begin(), m_adjacencyOffsets.end() - 1);
+					for (std::size_t i = 0; i < m_indices.size(); ++i)
+						m_adjacency[m_adjacencyCursors[m_indices[i]]++] = static_cast<UInt32>(i / 3);
+
+					m_deadTriangles.assign(triangleCount, false);
+					m_touched.assign(vertexCount, false);
+
+					unsigned int collapseCount = 0;
+					unsigned int removedTriangleCount = 0;
+					for (const Collapse& collapse : m_collapses)
+					{
+						if (collapse.cost > costLimit)
+							break;
+
+						// The neighbourhood of a collapsed vertex changed, it will be evaluated again in the next pass
+						if (m_touched[collapse.source] || m_touched[collapse.target] || Flips(collapse.source, collapse.target))
+							continue;
+
+						for (UInt32 i = m_adjacencyOffsets[collapse.source]; i < m_adjacencyOffsets[collapse.source + 1]; ++i)
+						{
+							UInt32 triangle = m_adjacency[i];
+							if (m_deadTriangles[triangle])
+								continue;
+
+							UInt32* triangleIndices = &m_indices[triangle * 3];
+							for (unsigned int j = 0; j < 3; ++j)
+							{
+								if (triangleIndices[j] == collapse.source)
+									triangleIndices[j] = collapse.target;
+							}
+
+							UInt32 a = m_positionRemap[triangleIndices[0]];
+							UInt32 b = m_positionRemap[triangleIndices[1]];
+							UInt32 c = m_positionRemap[triangleIndices[2]];
+							if (a == b || b == c || c == a)
+							{
+								m_deadTriangles[triangle] = true;
+								removedTriangleCount++;
+							}
 						}
+
+						m_quadrics[collapse.target] += m_quadrics[collapse.source];
+						m_touched[collapse.source] = true;
+						m_touched[collapse.target] = true;
+
+						*collapseErrorSquared = std::max(*collapseErrorSquared, collapse.error);
+						collapseCount++;
+
+						if (removedTriangleCount >= collapseGoal * 2)
+							break;
 					}
 
-					return ret;
+					return collapseCount > 0;
 				}
 
-				void TriangleScoreRecalculation(int tri)
+				void EvaluateCollapse(UInt32 source, UInt32 target)
 				{
-					TriangleCacheData* t = &m_triangles[tri];
+					if (m_locked[source] || m_positionRemap[source] == m_positionRemap[target])
+						return;
+
+					const Vector3f& targetPosition = m_positions[target];
+					double error = m_quadrics[source].Evaluate(targetPosition);
+
+					double penalty = 0.0;
+					if (m_normalPtr)
+						penalty += m_normalPtr[source].SquaredDistance(m_normalPtr[target]);
 
-					// calculate vertex scores
-					float sum = 0.f;
-					for (unsigned int i = 0; i < 3; ++i)
+					if (m_uvPtr)
+						penalty += m_uvPtr[source].SquaredDistance(m_uvPtr[target]);
+
+					double cost = error + AttributeWeight * penalty;
+
+					Collapse& collapse = m_bestCollapses[source];
+					if (cost < collapse.cost)
 					{
-						VertexCacheData* v = &m_vertices[t->verts[i]];
-						float sc = v->current_score;
-						if (!v->calculated)
-							sc = CalculateVertexScore(t->verts[i]);
-
-						v->current_score = sc;
-						v->calculated = true;
-						sum += sc;
+						collapse.cost = cost;
+						collapse.error = error;
+						collapse.source = source;
+						collapse.target = target;
 					}
-
-					t->current_score = sum;
-					t->calculated = true;
 				}
 
-				int PartialScoreRecalculation()
+				bool Flips(UInt32 source, UInt32 target) const
 				{
-					// iterate through all the vertices of the cache
-					float max_score = std::numeric_limits<float>::lowest();
-					int max_score_tri = -1;
+					const Vector3f& sourcePosition = m_positions[source];
+					const Vector3f& targetPosition = m_positions[target];
 
-					for (unsigned int i = 0; i < 32; ++i)
+					for (UInt32 i = m_adjacencyOffsets[source]; i < m_adjacencyOffsets[source + 1]; ++i)
 					{
-						int vert = m_vertexCache.GetVertex(i);
-						if (vert < 0)
+						UInt32 triangle = m_adjacency[i];
+						if (m_deadTriangles[triangle])
 							continue;
 
-						const VertexCacheData* v = &m_vertices[vert];
+						// The two other vertices, in order
+						const UInt32* triangleIndices = &m_indices[triangle * 3];
+						unsigned int sourceCorner = (triangleIndices[0] == source) ? 0 : (triangleIndices[1] == source) ? 1 : 2;
+						UInt32 b = triangleIndices[(sourceCorner + 1) % 3];
+						UInt32 c = triangleIndices[(sourceCorner + 2) % 3];
 
-						// iterate through all *active* triangles of this vertex
-						for (int j = 0; j < v->remaining_valence; j++)
-						{
-							int tri = v->tri_indices[j];
-							TriangleCacheData* t = &m_triangles[tri];
-							if (!t->calculated)
-								// calculate triangle score
-								TriangleScoreRecalculation(tri);
+						// This triangle will disappear
+						if (m_positionRemap[b] == m_positionRemap[target] || m_positionRemap[c] == m_positionRemap[target])
+							continue;
 
-							float sc = t->current_score;
+						const Vector3f& positionB = m_positions[b];
+						const Vector3f& positionC = m_positions[c];
 
-							// we actually found a triangle to process
-							if (sc > max_score)
-							{
-								max_score = sc;
-								max_score_tri = tri;
-							}
-						}
+						Vector3f normal = Vector3f::CrossProduct(positionB - sourcePosition, positionC - sourcePosition);
+						Vector3f newNormal = Vector3f::CrossProduct(positionB - targetPosition, positionC - targetPosition);
+
+						// A triangle becoming degenerated is rejected as well (but an already degenerated one doesn't matter)
+						float length = normal.GetLength();
+						if (length > 0.f && normal.DotProduct(newNormal) <= FlipThreshold * length * newNormal.GetLength())
+							return true;
 					}
 
-					return max_score_tri;
+					return false;
 				}
 
-				// returns true while there are more steps to take
-				// false when optimization is complete
-				bool Iterate()
+				void LockBorders()
 				{
-					if (m_drawList.size() == m_triangles.size())
-						return false;
+					// An edge (of positions) without its opposite is a border, and it is non-manifold if it appears more than once
+					m_edges.clear();
+					for (std::size_t i = 0; i < m_indices.size(); i += 3)
+					{
+						for (unsigned int j = 0; j < 3; ++j)
+						{
+							UInt64 a = m_positionRemap[m_indices[i + j]];
+							UInt64 b = m_positionRemap[m_indices[i + (j + 1) % 3]];
+							if (a != b)
+								m_edges.push_back((a << 32) | b);
+						}
+					}
 
-					// add the selected triangle to the draw list
-					AddTriangleToDrawList(m_bestTri);
+					std::sort(m_edges.begin(), m_edges.end());
 
-					// recalculate vertex and triangle scores and
-					// select the best triangle for the next iteration
-					m_bestTri = (CleanCalculationFlags()) ? PartialScoreRecalculation() : FullScoreRecalculation();
+					for (auto it = m_edges.begin(); it != m_edges.end();)
+					{
+						auto next = std::upper_bound(it, m_edges.end(), *it);
 
-					return true;
+						UInt32 a = static_cast<UInt32>(*it >> 32);
+						UInt32 b = static_cast<UInt32>(*it & 0xFFFFFFFF);
+						UInt64 opposite = (static_cast<UInt64>(b) << 32) | a;
+
+						auto range = std::equal_range(m_edges.begin(), m_edges.end(), opposite);
+						if (next - it > 1 || range.second - range.first != 1)
+						{
+							m_locked[a] = true;
+							m_locked[b] = true;
+						}
+
+						it = next;
+					}
+
+					// Locking is done on the representative of each position
+					for (std::size_t i = 0; i < m_locked.size(); ++i)
+					{
+						if (m_locked[m_positionRemap[i]])
+							m_locked[i] = true;
+					}
 				}
 
-				std::vector<VertexCacheData> m_vertices;
-				std::vector<TriangleCacheData> m_triangles;
-				std::vector<int> m_indices;
-				int m_bestTri; // the next triangle to add to the render list
-				VertexCache m_vertexCache;
-				std::vector<int> m_drawList;
-
-				// CalculateVertexScore constants
-				float m_cacheDecayPower;
-				float m_lastTriScore;
-				float m_valenceBoostScale;
-				float m_valenceBoostPower;
+				SparsePtr<const Vector3f> m_normalPtr;
+				SparsePtr<const Vector2f> m_uvPtr;
+				std::vector<bool> m_deadTriangles;
+				std::vector<bool> m_locked;
+				std::vector<bool> m_touched;
+				std::vector<Collapse> m_bestCollapses;
+				std::vector<Collapse> m_collapses;
+				std::vector<Quadric> m_quadrics;
+				std::vector<UInt32> m_adjacency;
+				std::vector<UInt32> m_adjacencyCursors;
+				std::vector<UInt32> m_adjacencyOffsets;
+				std::vector<UInt32> m_indices;
+				std::vector<UInt32> m_positionRemap;
+				std::vector<UInt64> m_edges;
+				std::vector<Vector3f> m_positions;
 		};
 	}
 
@@ -636,7 +853,7 @@ namespace Nz
 		if (vertexCount > 0)
 		{
 			aabb.Set(positionPtr->x, positionPtr->y, positionPtr->z, 0.f, 0.f, 0.f);
-			--positionPtr;
+			++positionPtr;
 
 			for (unsigned int i = 1; i < vertexCount; ++i)
 				aabb.ExtendTo(*positionPtr++);
@@ -1046,10 +1263,211 @@ namespace Nz
 	void OptimizeIndices(IndexIterator indices, unsigned int indexCount)
 	{
 		VertexCacheOptimizer optimizer;
-		if (optimizer.Optimize(indices, indexCount) != VertexCacheOptimizer::Success)
+		if (!optimizer.Optimize(indices, indexCount))
 			NazaraWarning("Indices optimizer failed");
 	}
 
+	void OptimizeOverdraw(IndexIterator indices, unsigned int indexCount, SparsePtr<const Vector3f> positionPtr, float threshold)
+	{
+		///DOC: Réordonne des clusters de triangles (de préférence après OptimizeIndices) afin de dessiner en premier ceux tournés
+		///DOC: vers l'extérieur du mesh, qui cachent les autres, threshold indique la dégradation (ratio) tolérée du cache de sommets
+		NazaraAssert(indexCount % 3 == 0, "Index count must be a multiple of three");
+		NazaraAssert(threshold >= 1.f, "Threshold must be greater or equal to one");
+
+		// Small cache, so that the clusters stay small enough to be sorted usefully
+		const UInt32 cacheSize = 16;
+
+		unsigned int triangleCount = indexCount / 3;
+		if (triangleCount < 2)
+			return;
+
+		std::vector<UInt32> source(indexCount);
+		for (unsigned int i = 0; i < indexCount; ++i)
+			source[i] = indices[i];
+
+		unsigned int vertexCount = *std::max_element(source.begin(), source.end()) + 1;
+
+		// FIFO cache simulation: a vertex is in the cache if less than cacheSize misses occurred since it was loaded
+		std::vector<UInt32> timestamps(vertexCount, 0);
+		UInt32 timestamp = cacheSize + 1;
+
+		auto ProcessTriangle = [&](unsigned int triangle) -> unsigned int
+		{
+			unsigned int misses = 0;
+			for (unsigned int i = 0; i < 3; ++i)
+			{
+				UInt32 vertex = source[triangle * 3 + i];
+				if (timestamp - timestamps[vertex] > cacheSize)
+				{
+					timestamps[vertex] = timestamp++;
+					misses++;
+				}
+			}
+
+			return misses;
+		};
+
+		auto FlushCache = [&]()
+		{
+			timestamp += cacheSize + 1;
+		};
+
+		// Hard boundaries: the cache is entirely flushed by the triangle, the order of what follows doesn't matter for the cache
+		std::vector<unsigned int> hardClusters;
+		for (unsigned int i = 0; i < triangleCount; ++i)
+		{
+			unsigned int misses = ProcessTriangle(i);
+			if (i == 0 || misses == 3)
+				hardClusters.push_back(i);
+		}
+		hardClusters.push_back(triangleCount);
+
+		// Soft boundaries: a cluster is cut as soon as the cost of restarting with an empty cache stays below the threshold
+		std::vector<unsigned int> clusters;
+		for (std::size_t i = 0; i + 1 < hardClusters.size(); ++i)
+		{
+			unsigned int start = hardClusters[i];
+			unsigned int end = hardClusters[i + 1];
+
+			FlushCache();
+
+			unsigned int clusterMisses = 0;
+			for (unsigned int triangle = start; triangle < end; ++triangle)
+				clusterMisses += ProcessTriangle(triangle);
+
+			float clusterThreshold = threshold * clusterMisses / (end - start);
+
+			FlushCache();
+
+			clusters.push_back(start);
+
+			unsigned int clusterStart = start;
+			unsigned int misses = 0;
+			for (unsigned int triangle = start; triangle < end; ++triangle)
+			{
+				misses += ProcessTriangle(triangle);
+
+				if (triangle + 1 < end && misses <= clusterThreshold * (triangle + 1 - clusterStart))
+				{
+					clusterStart = triangle + 1;
+					clusters.push_back(clusterStart);
+
+					misses = 0;
+					FlushCache();
+				}
+			}
+		}
+		clusters.push_back(triangleCount);
+
+		std::size_t clusterCount = clusters.size() - 1;
+
+		// Sort key of each cluster: how much its (area weighted) normal faces away from the center of the mesh
+		std::vector<Vector3f> clusterCentroids(clusterCount, Vector3f::Zero());
+		std::vector<Vector3f> clusterNormals(clusterCount, Vector3f::Zero());
+		std::vector<float> clusterAreas(clusterCount, 0.f);
+
+		Vector3f meshCentroid = Vector3f::Zero();
+		float meshArea = 0.f;
+		for (std::size_t i = 0; i < clusterCount; ++i)
+		{
+			for (unsigned int triangle = clusters[i]; triangle < clusters[i + 1]; ++triangle)
+			{
+				const Vector3f& a = positionPtr[source[triangle * 3 + 0]];
+				const Vector3f& b = positionPtr[source[triangle * 3 + 1]];
+				const Vector3f& c = positionPtr[source[triangle * 3 + 2]];
+
+				Vector3f normal = Vector3f::CrossProduct(b - a, c - a);
+				float area = normal.GetLength();
+
+				clusterCentroids[i] += (a + b + c) * (area / 3.f);
+				clusterNormals[i] += normal;
+				clusterAreas[i] += area;
+			}
+
+			meshCentroid += clusterCentroids[i];
+			meshArea += clusterAreas[i];
+		}
+
+		// The areas may be small enough for the division operators to consider them null
+		if (meshArea > 0.f)
+			meshCentroid *= 1.f / meshArea;
+
+		std::vector<float> sortKeys(clusterCount);
+		for (std::size_t i = 0; i < clusterCount; ++i)
+		{
+			Vector3f centroid = (clusterAreas[i] > 0.f) ? clusterCentroids[i] * (1.f / clusterAreas[i]) : clusterCentroids[i];
+			float normalLength = clusterNormals[i].GetLength();
+			Vector3f normal = (normalLength > 0.f) ? clusterNormals[i] * (1.f / normalLength) : Vector3f::Zero();
+
+			sortKeys[i] = normal.DotProduct(centroid - meshCentroid);
+		}
+
+		// A stable sort keeps the result deterministic
+		std::vector<unsigned int> clusterOrder(clusterCount);
+		std::iota(clusterOrder.begin(), clusterOrder.end(), 0U);
+		std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&sortKeys](unsigned int lhs, unsigned int rhs)
+		{
+			return sortKeys[lhs] > sortKeys[rhs];
+		});
+
+		for (unsigned int cluster : clusterOrder)
+		{
+			for (unsigned int i = clusters[cluster] * 3; i < clusters[cluster + 1] * 3; ++i)
+				*indices++ = source[i];
+		}
+	}
+
+	unsigned int OptimizeVertexFetch(IndexIterator indices, unsigned int indexCount, void* vertices, unsigned int vertexCount, unsigned int vertexStride)
+	{
+		///DOC: Réordonne les sommets selon leur première utilisation par les indices (qui sont modifiés en conséquence)
+		///DOC: Les sommets inutilisés sont placés à la fin, leur nombre est déduit du nombre de sommets renvoyé (utilisés)
+		NazaraAssert(vertices || vertexCount == 0, "Invalid vertices");
+
+		const UInt32 unassigned = std::numeric_limits<UInt32>::max();
+
+		std::vector<UInt32> remap(vertexCount, unassigned);
+		UInt32 nextVertex = 0;
+		for (unsigned int i = 0; i < indexCount; ++i)
+		{
+			UInt32 index = indices[i];
+			NazaraAssert(index < vertexCount, "Index out of vertex range");
+
+			if (remap[index] == unassigned)
+				remap[index] = nextVertex++;
+
+			indices[i] = remap[index];
+		}
+
+		unsigned int usedVertexCount = nextVertex;
+		for (UInt32& newIndex : remap)
+		{
+			if (newIndex == unassigned)
+				newIndex = nextVertex++;
+		}
+
+		UInt8* data = static_cast<UInt8*>(vertices);
+		std::vector<UInt8> source(data, data + vertexCount * vertexStride);
+		for (unsigned int i = 0; i < vertexCount; ++i)
+			std::memcpy(&data[remap[i] * vertexStride], &source[i * vertexStride], vertexStride);
+
+		return usedVertexCount;
+	}
+
+	/**********************************Simplify*********************************/
+
+	unsigned int SimplifyIndices(IndexIterator indices, unsigned int indexCount, unsigned int vertexCount, SparsePtr<const Vector3f> positionPtr, SparsePtr<const Vector3f> normalPtr, SparsePtr<const Vector2f> uvPtr, unsigned int targetIndexCount, float maxError, float* resultError)
+	{
+		///DOC: Les indices simplifiés sont écrits au début de la liste, leur nombre est retourné
+		///DOC: Les erreurs (maxError et resultError) sont relatives à la plus grande dimension de la boîte englobante
+		///DOC: Les sommets ne sont pas modifiés, les indices simplifiés peuvent partager le buffer de sommets original
+		///DOC: Les pointeurs de normales et de coordonnées de texture sont optionnels
+		NazaraAssert(indexCount % 3 == 0, "Index count must be a multiple of three");
+		NazaraAssert(positionPtr, "Invalid position pointer");
+
+		MeshSimplifier simplifier;
+		return simplifier.Simplify(indices, indexCount, vertexCount, positionPtr, normalPtr, uvPtr, targetIndexCount, maxError, resultError);
+	}
+
 	/************************************Skin***********************************/
 
 	void SkinPosition(const SkinningData& skinningInfos, unsigned int startVertex, unsigned int vertexCount)
@@ -1064,7 +1482,7 @@ namespace Nz
 
 			for (int j = 0; j < inputVertex->weightCount; ++j)
 			{
-				Matrix4f mat(skinningInfos.joints[inputVertex->jointIndexes[j]].GetSkinningMatrix());
+				Matrix4f mat(skinningInfos.skinningMatrices[inputVertex->jointIndexes[j]]);
 				mat *= inputVertex->weights[j];
 
 				finalPosition += mat.Transform(inputVertex->position);
@@ -1091,7 +1509,7 @@ namespace Nz
 
 			for (int j = 0; j < inputVertex->weightCount; ++j)
 			{
-				Matrix4f mat(skinningInfos.joints[inputVertex->jointIndexes[j]].GetSkinningMatrix());
+				Matrix4f mat(skinningInfos.skinningMatrices[inputVertex->jointIndexes[j]]);
 				mat *= inputVertex->weights[j];
 
 				finalPosition += mat.Transform(inputVertex->position);
@@ -1123,7 +1541,7 @@ namespace Nz
 
 			for (int j = 0; j < inputVertex->weightCount; ++j)
 			{
-				Matrix4f mat(skinningInfos.joints[inputVertex->jointIndexes[j]].GetSkinningMatrix());
+				Matrix4f mat(skinningInfos.skinningMatrices[inputVertex->jointIndexes[j]]);
 				mat *= inputVertex->weights[j];
 
 				finalPosition += mat.Transform(inputVertex->position);
@@ -4,14 +4,61 @@
 
 #include <Nazara/Utility/Animation.hpp>
 #include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
 #include <Nazara/Utility/Config.hpp>
 #include <Nazara/Utility/Skeleton.hpp>
+#include <Nazara/Utility/SkeletonPose.hpp>
 #include <vector>
 #include <unordered_map>
 #include <Nazara/Utility/Debug.hpp>
 
 namespace Nz
 {
+	namespace
+	{
+		void ProcessAnimationJob(const SkeletonAnimationJob& job, SkeletonPose& jobPose, SkeletonPose& layerPose, SkeletonPose& referencePose)
+		{
+			SkeletonPose& pose = (job.pose) ? *job.pose : jobPose;
+			pose.Resize(job.skeleton->GetJointCount());
+
+			for (unsigned int i = 0; i < job.layerCount; ++i)
+			{
+				const AnimationLayer& layer = job.layers[i];
+
+				// The first layer is usually a full override, it can then be sampled in place
+				if (i == 0 && layer.blendMode == AnimationBlendMode_Override && layer.weight >= 1.f && !layer.jointWeights)
+				{
+					layer.animation->Sample(&pose, layer.frameA, layer.frameB, layer.interpolation);
+					continue;
+				}
+
+				if (i == 0)
+					pose.MakeIdentity();
+
+				layer.animation->Sample(&layerPose, layer.frameA, layer.frameB, layer.interpolation);
+
+				switch (layer.blendMode)
+				{
+					case AnimationBlendMode_Additive:
+						layer.animation->Sample(&referencePose, layer.referenceFrame, layer.referenceFrame, 0.f);
+
+						layerPose.MakeAdditive(referencePose);
+						pose.ApplyAdditive(layerPose, layer.weight, layer.jointWeights);
+						break;
+
+					case AnimationBlendMode_Override:
+						pose.Blend(layerPose, layer.weight, layer.jointWeights);
+						break;
+				}
+			}
+
+			if (job.layerCount == 0)
+				pose.MakeIdentity();
+
+			job.skeleton->ComputeSkinningMatrices(pose, job.skinningMatrices);
+		}
+	}
+
 	struct AnimationImpl
 	{
 		std::unordered_map<String, unsigned int> sequenceMap;
@@ -156,6 +203,104 @@ namespace Nz
 		}
 	}
 
+	void Animation::AnimateSkeleton(Skeleton* targetSkeleton, unsigned int frameA, unsigned int frameB, float interpolation, const unsigned int* indices, unsigned int indiceCount) const
+	{
+		///DOC: N'anime que les joints dont l'indice est fourni, les autres gardent leur transformation actuelle
+		#if NAZARA_UTILITY_SAFE
+		if (!m_impl)
+		{
+			NazaraError("Animation not created");
+			return;
+		}
+
+		if (m_impl->type != AnimationType_Skeletal)
+		{
+			NazaraError("Animation is not skeletal");
+			return;
+		}
+
+		if (!targetSkeleton || !targetSkeleton->IsValid())
+		{
+			NazaraError("Target skeleton is invalid");
+			return;
+		}
+
+		if (targetSkeleton->GetJointCount() != m_impl->jointCount)
+		{
+			NazaraError("Target skeleton joint count must match animation joint count");
+			return;
+		}
+
+		if (frameA >= m_impl->frameCount)
+		{
+			NazaraError("Frame A is out of range (" + String::Number(frameA) + " >= " + String::Number(m_impl->frameCount) + ')');
+			return;
+		}
+
+		if (frameB >= m_impl->frameCount)
+		{
+			NazaraError("Frame B is out of range (" + String::Number(frameB) + " >= " + String::Number(m_impl->frameCount) + ')');
+			return;
+		}
+		#endif
+
+		#ifdef NAZARA_DEBUG
+		if (interpolation < 0.f || interpolation > 1.f)
+		{
+			NazaraError("Interpolation must be in range [0..1] (Got " + String::Number(interpolation) + ')');
+			return;
+		}
+		#endif
+
+		for (unsigned int i = 0; i < indiceCount; ++i)
+		{
+			unsigned int index = indices[i];
+
+			#if NAZARA_UTILITY_SAFE
+			if (index >= m_impl->jointCount)
+			{
+				NazaraError("Index #" + String::Number(i) + " out of range (" + String::Number(index) + " >= " + String::Number(m_impl->jointCount) + ')');
+				return;
+			}
+			#endif
+
+			Joint* joint = targetSkeleton->GetJoint(index);
+
+			SequenceJoint& sequenceJointA = m_impl->sequenceJoints[frameA*m_impl->jointCount + index];
+			SequenceJoint& sequenceJointB = m_impl->sequenceJoints[frameB*m_impl->jointCount + index];
+
+			joint->SetPosition(Vector3f::Lerp(sequenceJointA.position, sequenceJointB.position, interpolation));
+			joint->SetRotation(Quaternionf::Slerp(sequenceJointA.rotation, sequenceJointB.rotation, interpolation));
+			joint->SetScale(Vector3f::Lerp(sequenceJointA.scale, sequenceJointB.scale, interpolation));
+		}
+	}
+
+	void Animation::AnimateSkeletons(const SkeletonAnimationJob* jobs, std::size_t jobCount, bool parallel)
+	{
+		///DOC: Échantillonne et mélange les couches de chaque tâche, puis calcule les matrices de skinning de leur squelette
+		///DOC: Les joints des squelettes ne sont pas modifiés, les tâches sont réparties entre les workers du TaskScheduler
+		NazaraAssert(jobs || jobCount == 0, "Invalid jobs");
+
+		if (jobCount == 0)
+			return;
+
+		// The joint data of the skeletons is cached beforehand, it is then only read by the tasks
+		for (std::size_t i = 0; i < jobCount; ++i)
+			jobs[i].skeleton->EnsureSkinningDataUpdate();
+
+		TaskScheduler::ParallelFor(jobCount, (parallel) ? jobCount : 1, [jobs](std::size_t first, std::size_t last, unsigned int taskIndex)
+		{
+			NazaraUnused(taskIndex);
+
+			// Temporary poses are kept between the jobs of a task, avoiding an allocation per job
+			SkeletonPose jobPose;
+			SkeletonPose layerPose;
+			SkeletonPose referencePose;
+			for (std::size_t i = first; i < last; ++i)
+				ProcessAnimationJob(jobs[i], jobPose, layerPose, referencePose);
+		});
+	}
+
 	bool Animation::CreateSkeletal(unsigned int frameCount, unsigned int jointCount)
 	{
 		Destroy();
@@ -512,6 +657,80 @@ namespace Nz
 		m_impl->sequences.erase(it);
 	}
 
+	void Animation::Sample(SkeletonPose* pose, unsigned int frameA, unsigned int frameB, float interpolation) const
+	{
+		///DOC: Équivalent à AnimateSkeleton, mais écrit dans une pose plutôt que dans les joints d'un squelette
+		///DOC: Les rotations sont interpolées linéairement puis normalisées (nlerp) plutôt que sphériquement
+		#if NAZARA_UTILITY_SAFE
+		if (!m_impl)
+		{
+			NazaraError("Animation not created");
+			return;
+		}
+
+		if (m_impl->type != AnimationType_Skeletal)
+		{
+			NazaraError("Animation is not skeletal");
+			return;
+		}
+
+		if (!pose)
+		{
+			NazaraError("Invalid pose");
+			return;
+		}
+
+		if (frameA >= m_impl->frameCount)
+		{
+			NazaraError("Frame A is out of range (" + String::Number(frameA) + " >= " + String::Number(m_impl->frameCount) + ')');
+			return;
+		}
+
+		if (frameB >= m_impl->frameCount)
+		{
+			NazaraError("Frame B is out of range (" + String::Number(frameB) + " >= " + String::Number(m_impl->frameCount) + ')');
+			return;
+		}
+		#endif
+
+		#ifdef NAZARA_DEBUG
+		if (interpolation < 0.f || interpolation > 1.f)
+		{
+			NazaraError("Interpolation must be in range [0..1] (Got " + String::Number(interpolation) + ')');
+			return;
+		}
+		#endif
+
+		unsigned int jointCount = m_impl->jointCount;
+		pose->Resize(jointCount);
+
+		Vector3f* positions = pose->GetPositions();
+		Quaternionf* rotations = pose->GetRotations();
+		Vector3f* scales = pose->GetScales();
+		const SequenceJoint* jointsA = &m_impl->sequenceJoints[frameA*jointCount];
+		const SequenceJoint* jointsB = &m_impl->sequenceJoints[frameB*jointCount];
+
+		float weightA = 1.f - interpolation;
+		for (unsigned int i = 0; i < jointCount; ++i)
+		{
+			const SequenceJoint& jointA = jointsA[i];
+			const SequenceJoint& jointB = jointsB[i];
+
+			positions[i] = jointA.position + (jointB.position - jointA.position) * interpolation;
+			scales[i] = jointA.scale + (jointB.scale - jointA.scale) * interpolation;
+
+			// The shortest path is taken
+			const Quaternionf& rotationA = jointA.rotation;
+			const Quaternionf& rotationB = jointB.rotation;
+			float weightB = (rotationA.DotProduct(rotationB) < 0.f) ? -interpolation : interpolation;
+
+			rotations[i].Set(rotationA.w * weightA + rotationB.w * weightB, rotationA.x * weightA + rotationB.x * weightB,
+			                 rotationA.y * weightA + rotationB.y * weightB, rotationA.z * weightA + rotationB.z * weightB);
+		}
+
+		Quaternionf::Normalize(rotations, rotations, jointCount);
+	}
+
 	bool Animation::Initialize()
 	{
 		if (!AnimationLibrary::Initialize())
@@ -136,9 +136,6 @@ namespace Nz
 
 			indexMapper.Unmap();
 
-			if (parameters.optimizeIndexBuffers)
-				indexBuffer->Optimize();
-
 			/// Lecture des coordonnées de texture
 			std::vector<MD2_TexCoord> texCoords(header.num_st);
 
@@ -230,6 +227,9 @@ namespace Nz
 
 			mesh->AddSubMesh(subMesh);
 
+			// Les sommets sont indexés de la même façon dans toutes les frames du fichier, nous conservons leur ordre
+			mesh->Optimize(parameters.GetOptimizationFlags() & ~MeshOptimization_VertexFetch);
+
 			if (parameters.center)
 				mesh->Recenter();
 
@@ -107,9 +107,6 @@ namespace Nz
 
 					indexMapper.Unmap();
 
-					if (parameters.optimizeIndexBuffers)
-						indexBuffer->Optimize();
-
 					// Vertex buffer
 					struct Weight
 					{
@@ -210,6 +207,9 @@ namespace Nz
 							mesh->SetAnimation(path);
 					}
 				}
+
+				// Les sous-meshs sont optimisés ensemble (en parallèle)
+				mesh->Optimize(parameters.GetOptimizationFlags());
 			}
 			else
 			{
@@ -272,9 +272,6 @@ namespace Nz
 					StaticMeshRef subMesh = StaticMesh::New(mesh);
 					subMesh->Create(vertexBuffer);
 
-					if (parameters.optimizeIndexBuffers)
-						indexBuffer->Optimize();
-
 					subMesh->SetIndexBuffer(indexBuffer);
 					subMesh->GenerateAABB();
 					subMesh->GenerateNormalsAndTangents();
@@ -286,6 +283,9 @@ namespace Nz
 					mesh->SetMaterial(i, baseDir + md5Mesh.shader);
 				}
 
+				// Les sous-meshs sont optimisés ensemble (en parallèle)
+				mesh->Optimize(parameters.GetOptimizationFlags());
+
 				if (parameters.center)
 					mesh->Recenter();
 			}
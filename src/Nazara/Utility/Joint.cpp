@@ -61,6 +61,8 @@ namespace Nz
 	{
 		m_inverseBindMatrix = matrix;
 		m_skinningMatrixUpdated = false;
+
+		m_skeleton->InvalidateSkinningData();
 	}
 
 	void Joint::SetName(const String& name)
@@ -75,6 +77,8 @@ namespace Nz
 		Node::InvalidateNode();
 
 		m_skinningMatrixUpdated = false;
+
+		m_skeleton->InvalidateSkinningData();
 	}
 
 	void Joint::UpdateSkinningMatrix() const
@@ -6,6 +6,7 @@
 #include <Nazara/Core/Enums.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/PrimitiveList.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
 #include <Nazara/Math/Algorithm.hpp>
 #include <Nazara/Utility/Algorithm.hpp>
 #include <Nazara/Utility/Animation.hpp>
@@ -31,6 +32,18 @@ namespace Nz
 			storage = DataStorage_Software;
 	}
 
+	UInt32 MeshParams::GetOptimizationFlags() const
+	{
+		UInt32 flags = MeshOptimization_None;
+		if (optimizeIndexBuffers)
+			flags |= MeshOptimization_Overdraw | MeshOptimization_VertexCache;
+
+		if (optimizeVertexBuffers)
+			flags |= MeshOptimization_VertexFetch;
+
+		return flags;
+	}
+
 	bool MeshParams::IsValid() const
 	{
 		if (!Buffer::IsStorageSupported(storage))
@@ -387,6 +400,24 @@ namespace Nz
 		}
 	}
 
+	void Mesh::GenerateLods(unsigned int lodCount, float reductionFactor, float maxError)
+	{
+		///DOC: Seuls les sous-meshs indexés en liste de triangles sont simplifiés
+		#if NAZARA_UTILITY_SAFE
+		if (!m_impl)
+		{
+			NazaraError("Mesh not created");
+			return;
+		}
+		#endif
+
+		for (SubMesh* subMesh : m_impl->subMeshes)
+		{
+			if (subMesh->GetPrimitiveMode() == PrimitiveMode_TriangleList && subMesh->GetIndexBuffer())
+				subMesh->GenerateLods(lodCount, reductionFactor, maxError);
+		}
+	}
+
 	void Mesh::GenerateNormals()
 	{
 		#if NAZARA_UTILITY_SAFE
@@ -800,6 +831,172 @@ namespace Nz
 		return MeshLoader::LoadFromStream(this, stream, params);
 	}
 
+	void Mesh::Optimize(UInt32 optimizationFlags, bool parallel)
+	{
+		///DOC: Optimise les sous-meshs (listes de triangles indexées), répartis entre les workers du TaskScheduler si parallel vaut true
+		///DOC: Les index buffers (pouvant être partagés) sont remplacés par des copies optimisées, un vertex buffer n'est
+		///DOC: réordonné (MeshOptimization_VertexFetch) que s'il n'est utilisé que par un seul sous-mesh
+		#if NAZARA_UTILITY_SAFE
+		if (!m_impl)
+		{
+			NazaraError("Mesh not created");
+			return;
+		}
+		#endif
+
+		if ((optimizationFlags & MeshOptimization_All) == 0)
+			return;
+
+		struct VertexBufferData
+		{
+			UInt8* vertices = nullptr;
+			UInt32 storage;
+			unsigned int useCount = 0;
+			bool hasLods = false;
+			bool reorder = false;
+		};
+
+		struct SubMeshJob
+		{
+			IndexBufferRef indexBuffer;
+			std::unique_ptr<IndexMapper> indexMapper;
+			SparsePtr<const Vector3f> positionPtr;
+			SubMesh* subMesh;
+			VertexBufferData* vertexBufferData;
+			VertexBuffer* vertexBuffer;
+		};
+
+		auto GetVertexBuffer = [this](SubMesh* subMesh) -> VertexBuffer*
+		{
+			if (m_impl->animationType == AnimationType_Static)
+				return static_cast<StaticMesh*>(subMesh)->GetVertexBuffer();
+			else
+				return static_cast<SkeletalMesh*>(subMesh)->GetVertexBuffer();
+		};
+
+		std::unordered_map<VertexBuffer*, VertexBufferData> vertexBuffers;
+		std::vector<SubMeshJob> jobs;
+		for (SubMesh* subMesh : m_impl->subMeshes)
+		{
+			if (subMesh->GetPrimitiveMode() != PrimitiveMode_TriangleList || !subMesh->GetIndexBuffer())
+				continue;
+
+			VertexBuffer* vertexBuffer = GetVertexBuffer(subMesh);
+			VertexBufferData& data = vertexBuffers[vertexBuffer];
+			data.useCount++;
+
+			// The levels of detail index the current vertices
+			if (subMesh->GetLodCount() > 1)
+				data.hasLods = true;
+
+			SubMeshJob job;
+			job.subMesh = subMesh;
+			job.vertexBuffer = vertexBuffer;
+
+			jobs.emplace_back(std::move(job));
+		}
+
+		if (jobs.empty())
+			return;
+
+		// The buffers are only mapped here (a buffer can't be mapped twice), the tasks then work on their memory
+		for (auto& pair : vertexBuffers)
+		{
+			VertexBuffer* vertexBuffer = pair.first;
+			VertexBufferData& data = pair.second;
+
+			// A vertex buffer referenced outside of this mesh can't be reordered
+			data.reorder = (optimizationFlags & MeshOptimization_VertexFetch) && data.useCount == 1 && !data.hasLods && vertexBuffer->GetReferenceCount() == 1;
+			data.storage = vertexBuffer->GetBuffer()->GetStorage();
+
+			if (data.reorder && data.storage != DataStorage_Software && !vertexBuffer->SetStorage(DataStorage_Software))
+			{
+				NazaraWarning("Failed to switch vertex buffer to software storage, vertices won't be reordered");
+				data.reorder = false;
+			}
+
+			if (data.reorder || (optimizationFlags & MeshOptimization_Overdraw))
+				data.vertices = static_cast<UInt8*>((data.reorder) ? vertexBuffer->Map(BufferAccess_ReadWrite) : static_cast<const VertexBuffer*>(vertexBuffer)->Map(BufferAccess_ReadOnly));
+		}
+
+		for (SubMeshJob& job : jobs)
+		{
+			const IndexBuffer* indexBuffer = job.subMesh->GetIndexBuffer();
+			unsigned int indexCount = indexBuffer->GetIndexCount();
+
+			job.indexBuffer = IndexBuffer::New(indexBuffer->HasLargeIndices(), indexCount, DataStorage_Software, indexBuffer->GetBuffer()->GetUsage());
+			std::memcpy(job.indexBuffer->Map(BufferAccess_DiscardAndWrite), indexBuffer->Map(BufferAccess_ReadOnly), indexCount * indexBuffer->GetStride());
+			indexBuffer->Unmap();
+			job.indexBuffer->Unmap();
+
+			job.indexMapper.reset(new IndexMapper(job.indexBuffer, BufferAccess_ReadWrite));
+
+			job.vertexBufferData = &vertexBuffers[job.vertexBuffer];
+			if (job.vertexBufferData->vertices)
+			{
+				bool enabled;
+				ComponentType type;
+				std::size_t offset;
+				job.vertexBuffer->GetVertexDeclaration()->GetComponent(VertexComponent_Position, &enabled, &type, &offset);
+
+				if (enabled && type == ComponentType_Float3)
+					job.positionPtr.Reset(job.vertexBufferData->vertices + offset, job.vertexBuffer->GetStride());
+			}
+		}
+
+		TaskScheduler::ParallelFor(jobs.size(), (parallel) ? jobs.size() : 1, [&jobs, optimizationFlags](std::size_t first, std::size_t last, unsigned int taskIndex)
+		{
+			NazaraUnused(taskIndex);
+
+			for (std::size_t i = first; i < last; ++i)
+			{
+				SubMeshJob& job = jobs[i];
+				IndexIterator indices = job.indexMapper->begin();
+				unsigned int indexCount = job.indexMapper->GetIndexCount();
+
+				if (optimizationFlags & MeshOptimization_VertexCache)
+					OptimizeIndices(indices, indexCount);
+
+				if ((optimizationFlags & MeshOptimization_Overdraw) && job.positionPtr)
+					OptimizeOverdraw(indices, indexCount, job.positionPtr);
+
+				if (job.vertexBufferData->reorder)
+					OptimizeVertexFetch(indices, indexCount, job.vertexBufferData->vertices, job.vertexBuffer->GetVertexCount(), job.vertexBuffer->GetStride());
+			}
+		});
+
+		for (auto& pair : vertexBuffers)
+		{
+			VertexBuffer* vertexBuffer = pair.first;
+			VertexBufferData& data = pair.second;
+
+			if (data.vertices)
+				vertexBuffer->Unmap();
+
+			if (data.reorder && data.storage != DataStorage_Software && !vertexBuffer->SetStorage(data.storage))
+				NazaraWarning("Failed to restore vertex buffer storage");
+		}
+
+		for (SubMeshJob& job : jobs)
+		{
+			job.indexMapper.reset();
+
+			UInt32 storage = job.subMesh->GetIndexBuffer()->GetBuffer()->GetStorage();
+			if (storage != DataStorage_Software && !job.indexBuffer->SetStorage(storage))
+				NazaraWarning("Failed to restore index buffer storage");
+
+			// Same triangles on the same vertices (which were not reordered if there are levels of detail), these stay valid
+			std::vector<SubMesh::Lod> lods = std::move(job.subMesh->m_lods);
+
+			if (m_impl->animationType == AnimationType_Static)
+				static_cast<StaticMesh*>(job.subMesh)->SetIndexBuffer(job.indexBuffer);
+			else
+				static_cast<SkeletalMesh*>(job.subMesh)->SetIndexBuffer(job.indexBuffer);
+
+			job.subMesh->m_lods = std::move(lods);
+		}
+	}
+
 	void Mesh::Recenter()
 	{
 		#if NAZARA_UTILITY_SAFE
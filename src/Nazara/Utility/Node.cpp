@@ -3,6 +3,7 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Utility/Node.hpp>
+#include <Nazara/Utility/TransformHierarchy.hpp>
 #include <Nazara/Utility/Debug.hpp>
 
 namespace Nz
@@ -15,6 +16,8 @@ namespace Nz
 	m_position(Vector3f::Zero()),
 	m_scale(Vector3f(1.f, 1.f, 1.f)),
 	m_parent(nullptr),
+	m_hierarchy(nullptr),
+	m_hierarchyHandle(TransformHierarchy::InvalidHandle),
 	m_derivedUpdated(false),
 	m_inheritPosition(true),
 	m_inheritRotation(true),
@@ -31,6 +34,8 @@ namespace Nz
 	m_position(node.m_position),
 	m_scale(node.m_scale),
 	m_parent(nullptr),
+	m_hierarchy(nullptr),
+	m_hierarchyHandle(TransformHierarchy::InvalidHandle),
 	m_derivedUpdated(false),
 	m_inheritPosition(node.m_inheritPosition),
 	m_inheritRotation(node.m_inheritRotation),
@@ -44,6 +49,10 @@ namespace Nz
 	{
 		OnNodeRelease(this);
 
+		// Nos enfants restent dans la hiérarchie, en tant que racines
+		if (m_hierarchy)
+			m_hierarchy->Destroy(m_hierarchyHandle);
+
 		for (Node* child : m_childs)
 		{
 			// child->SetParent(nullptr); serait problématique car elle nous appellerait
@@ -96,6 +105,11 @@ namespace Nz
 		return m_derivedRotation * Vector3f::Forward();
 	}
 
+	TransformHierarchy* Node::GetHierarchy() const
+	{
+		return m_hierarchy;
+	}
+
 	bool Node::GetInheritPosition() const
 	{
 		return m_inheritPosition;
@@ -465,6 +479,15 @@ namespace Nz
 			InvalidateNode();
 		}
 
+		if (m_hierarchy)
+		{
+			// Un parent hors de notre hiérarchie est lu par TransformHierarchy::Update
+			if (m_parent && m_parent->m_hierarchy == m_hierarchy)
+				m_hierarchy->SetParent(m_hierarchyHandle, m_parent->m_hierarchyHandle);
+			else
+				m_hierarchy->SetParent(m_hierarchyHandle, TransformHierarchy::InvalidHandle);
+		}
+
 		OnParenting(node);
 	}
 
@@ -654,8 +677,15 @@ namespace Nz
 		m_derivedUpdated = false;
 		m_transformMatrixUpdated = false;
 
+		if (m_hierarchy)
+			m_hierarchy->Invalidate(m_hierarchyHandle);
+
 		for (Node* node : m_childs)
-			node->InvalidateNode();
+		{
+			// Un enfant déjà invalidé l'a été avec tous ses descendants, inutile de les parcourir (et de signaler) à nouveau
+			if (node->m_derivedUpdated || node->m_transformMatrixUpdated)
+				node->InvalidateNode();
+		}
 
 		OnNodeInvalidation(this);
 	}
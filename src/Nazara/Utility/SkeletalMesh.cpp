@@ -45,6 +45,7 @@ namespace Nz
 		{
 			OnSkeletalMeshDestroy(this);
 
+			ClearLods();
 			m_indexBuffer.Reset();
 			m_vertexBuffer.Reset();
 		}
@@ -97,6 +98,9 @@ namespace Nz
 
 	void SkeletalMesh::SetIndexBuffer(const IndexBuffer* indexBuffer)
 	{
+		///DOC: Les niveaux de détail sont supprimés, ils ne correspondent plus à la géométrie
+		ClearLods();
+
 		m_indexBuffer = indexBuffer;
 	}
 }
@@ -3,18 +3,45 @@
 // For conditions of distribution and use, see copyright notice in Config.hpp
 
 #include <Nazara/Utility/Skeleton.hpp>
+#include <Nazara/Utility/SkeletonPose.hpp>
+#include <algorithm>
+#include <functional>
 #include <unordered_map>
 #include <Nazara/Utility/Debug.hpp>
 
 namespace Nz
 {
+	namespace
+	{
+		enum InheritFlag : UInt8
+		{
+			InheritFlag_Position = 0x01,
+			InheritFlag_Rotation = 0x02,
+			InheritFlag_Scale    = 0x04
+		};
+
+		// Derived transforms of the joints, only needed during ComputeSkinningMatrices (which may run on several threads at once)
+		thread_local std::vector<Quaternionf> s_derivedRotations;
+		thread_local std::vector<Vector3f> s_derivedPositions;
+		thread_local std::vector<Vector3f> s_derivedScales;
+	}
+
 	struct SkeletonImpl
 	{
 		std::unordered_map<String, unsigned int> jointMap;
 		std::vector<Joint> joints;
+		std::vector<Matrix4f> inverseBindMatrices;
+		std::vector<Quaternionf> initialRotations;
+		std::vector<UInt8> inheritFlags;
+		std::vector<Vector3f> initialPositions;
+		std::vector<Vector3f> initialScales;
+		std::vector<const Node*> externalParents; //< Parents outside of the skeleton, empty if there is none
+		std::vector<int> parentIndices;
+		std::vector<unsigned int> skinningOrder; //< Parents before their children
 		Boxf aabb;
 		bool aabbUpdated = false;
 		bool jointMapUpdated = false;
+		bool skinningDataUpdated = false;
 	};
 
 	Skeleton::Skeleton(const Skeleton& skeleton) :
@@ -31,6 +58,132 @@ namespace Nz
 		Destroy();
 	}
 
+	void Skeleton::ApplyPose(const SkeletonPose& pose)
+	{
+		#if NAZARA_UTILITY_SAFE
+		if (!m_impl)
+		{
+			NazaraError("Skeleton not created");
+			return;
+		}
+
+		if (pose.GetJointCount() != m_impl->joints.size())
+		{
+			NazaraError("Pose joint count must match skeleton joint count");
+			return;
+		}
+		#endif
+
+		const Vector3f* positions = pose.GetPositions();
+		const Quaternionf* rotations = pose.GetRotations();
+		const Vector3f* scales = pose.GetScales();
+		for (unsigned int i = 0; i < m_impl->joints.size(); ++i)
+		{
+			Joint& joint = m_impl->joints[i];
+			joint.SetPosition(positions[i]);
+			joint.SetRotation(rotations[i]);
+			joint.SetScale(scales[i]);
+		}
+
+		InvalidateJoints();
+	}
+
+	void Skeleton::ComputeSkinningMatrices(const SkeletonPose& pose, Matrix4f* skinningMatrices) const
+	{
+		///DOC: Calcule en une passe les matrices de skinning de la pose (comme le ferait Joint::GetSkinningMatrix), sans modifier les joints
+		///DOC: Peut être appelé depuis plusieurs threads à la fois, si EnsureSkinningDataUpdate a été appelé au préalable
+		///DOC: (et si les parents extérieurs au squelette ne sont pas modifiés entre temps)
+		#if NAZARA_UTILITY_SAFE
+		if (!m_impl)
+		{
+			NazaraError("Skeleton not created");
+			return;
+		}
+
+		if (pose.GetJointCount() != m_impl->joints.size())
+		{
+			NazaraError("Pose joint count must match skeleton joint count");
+			return;
+		}
+		#endif
+
+		if (!m_impl->skinningDataUpdated)
+			UpdateSkinningData();
+
+		unsigned int jointCount = m_impl->joints.size();
+		s_derivedPositions.resize(jointCount);
+		s_derivedRotations.resize(jointCount);
+		s_derivedScales.resize(jointCount);
+
+		Vector3f* derivedPositions = s_derivedPositions.data();
+		Quaternionf* derivedRotations = s_derivedRotations.data();
+		Vector3f* derivedScales = s_derivedScales.data();
+
+		const Vector3f* positions = pose.GetPositions();
+		const Quaternionf* rotations = pose.GetRotations();
+		const Vector3f* scales = pose.GetScales();
+		const Matrix4f* inverseBindMatrices = m_impl->inverseBindMatrices.data();
+		const Quaternionf* initialRotations = m_impl->initialRotations.data();
+		const UInt8* inheritFlags = m_impl->inheritFlags.data();
+		const Vector3f* initialPositions = m_impl->initialPositions.data();
+		const Vector3f* initialScales = m_impl->initialScales.data();
+		const Node* const* externalParents = (!m_impl->externalParents.empty()) ? m_impl->externalParents.data() : nullptr;
+		const int* parentIndices = m_impl->parentIndices.data();
+		const unsigned int* skinningOrder = m_impl->skinningOrder.data();
+
+		// Parents are processed before their children, a single pass is enough (the derivation is the same as Node::UpdateDerived)
+		for (unsigned int j = 0; j < jointCount; ++j)
+		{
+			unsigned int i = skinningOrder[j];
+
+			Vector3f position = initialPositions[i] + positions[i];
+			Quaternionf rotation = initialRotations[i] * rotations[i];
+			Vector3f scale = initialScales[i] * scales[i];
+
+			Vector3f parentPosition;
+			Quaternionf parentRotation;
+			Vector3f parentScale;
+
+			bool hasParent = true;
+			int parent = parentIndices[i];
+			if (parent >= 0)
+			{
+				parentPosition = derivedPositions[parent];
+				parentRotation = derivedRotations[parent];
+				parentScale = derivedScales[parent];
+			}
+			else if (externalParents && externalParents[i])
+			{
+				parentPosition = externalParents[i]->GetPosition(CoordSys_Global);
+				parentRotation = externalParents[i]->GetRotation(CoordSys_Global);
+				parentScale = externalParents[i]->GetScale(CoordSys_Global);
+			}
+			else
+				hasParent = false;
+
+			if (hasParent)
+			{
+				if (inheritFlags[i] & InheritFlag_Position)
+					position = parentRotation * (parentScale * position) + parentPosition;
+
+				if (inheritFlags[i] & InheritFlag_Rotation)
+				{
+					rotation = parentRotation * rotation;
+					rotation.Normalize();
+				}
+
+				if (inheritFlags[i] & InheritFlag_Scale)
+					scale *= parentScale;
+			}
+
+			derivedPositions[i] = position;
+			derivedRotations[i] = rotation;
+			derivedScales[i] = scale;
+
+			skinningMatrices[i] = Matrix4f::ConcatenateAffine(inverseBindMatrices[i], Matrix4f::Transform(position, rotation, scale));
+		}
+	}
+
 	bool Skeleton::Create(unsigned int jointCount)
 	{
 		#if NAZARA_UTILITY_SAFE
@@ -58,6 +211,27 @@ namespace Nz
 		}
 	}
 
+	void Skeleton::EnsureSkinningDataUpdate() const
+	{
+		#if NAZARA_UTILITY_SAFE
+		if (!m_impl)
+		{
+			NazaraError("Skeleton not created");
+			return;
+		}
+		#endif
+
+		if (!m_impl->skinningDataUpdated)
+			UpdateSkinningData();
+
+		// Their derived transforms are then only read
+		for (const Node* parent : m_impl->externalParents)
+		{
+			if (parent)
+				parent->EnsureDerivedUpdate();
+		}
+	}
+
 	const Boxf& Skeleton::GetAABB() const
 	{
 		#if NAZARA_UTILITY_SAFE
@@ -248,6 +422,34 @@ namespace Nz
 		return it->second;
 	}
 
+	void Skeleton::GetPose(SkeletonPose* pose) const
+	{
+		///DOC: Inverse de ApplyPose, récupère les transformations locales des joints
+		NazaraAssert(pose, "Invalid pose");
+
+		#if NAZARA_UTILITY_SAFE
+		if (!m_impl)
+		{
+			NazaraError("Skeleton not created");
+			return;
+		}
+		#endif
+
+		unsigned int jointCount = m_impl->joints.size();
+		pose->Resize(jointCount);
+
+		Vector3f* positions = pose->GetPositions();
+		Quaternionf* rotations = pose->GetRotations();
+		Vector3f* scales = pose->GetScales();
+		for (unsigned int i = 0; i < jointCount; ++i)
+		{
+			const Joint& joint = m_impl->joints[i];
+			positions[i] = joint.GetPosition(CoordSys_Local);
+			rotations[i] = joint.GetRotation(CoordSys_Local);
+			scales[i] = joint.GetScale(CoordSys_Local);
+		}
+	}
+
 	void Skeleton::Interpolate(const Skeleton& skeletonA, const Skeleton& skeletonB, float interpolation)
 	{
 		#if NAZARA_UTILITY_SAFE
@@ -395,6 +597,19 @@ namespace Nz
 		m_impl->jointMapUpdated = false;
 	}
 
+	void Skeleton::InvalidateSkinningData()
+	{
+		#ifdef NAZARA_DEBUG
+		if (!m_impl)
+		{
+			NazaraError("Invalid skeleton");
+			return;
+		}
+		#endif
+
+		m_impl->skinningDataUpdated = false;
+	}
+
 	void Skeleton::UpdateJointMap() const
 	{
 		#ifdef NAZARA_DEBUG
@@ -427,6 +642,84 @@ namespace Nz
 		m_impl->jointMapUpdated = true;
 	}
 
+	void Skeleton::UpdateSkinningData() const
+	{
+		#ifdef NAZARA_DEBUG
+		if (!m_impl)
+		{
+			NazaraError("Invalid skeleton");
+			return;
+		}
+		#endif
+
+		unsigned int jointCount = m_impl->joints.size();
+		m_impl->inverseBindMatrices.resize(jointCount);
+		m_impl->initialPositions.resize(jointCount);
+		m_impl->initialRotations.resize(jointCount);
+		m_impl->initialScales.resize(jointCount);
+		m_impl->inheritFlags.resize(jointCount);
+		m_impl->parentIndices.resize(jointCount);
+
+		m_impl->externalParents.clear();
+
+		const Joint* firstJoint = m_impl->joints.data();
+		const Joint* lastJoint = firstJoint + jointCount;
+		std::less<const Node*> less;
+
+		for (unsigned int i = 0; i < jointCount; ++i)
+		{
+			const Joint& joint = m_impl->joints[i];
+
+			// A parent outside of the skeleton is read as it is when the matrices are computed
+			int parentIndex = -1;
+			const Node* parent = joint.GetParent();
+			if (parent && !less(parent, firstJoint) && less(parent, lastJoint))
+				parentIndex = static_cast<int>(static_cast<const Joint*>(parent) - firstJoint);
+			else if (parent)
+			{
+				m_impl->externalParents.resize(jointCount, nullptr);
+				m_impl->externalParents[i] = parent;
+			}
+
+			UInt8 flags = 0;
+			if (joint.GetInheritPosition())
+				flags |= InheritFlag_Position;
+
+			if (joint.GetInheritRotation())
+				flags |= InheritFlag_Rotation;
+
+			if (joint.GetInheritScale())
+				flags |= InheritFlag_Scale;
+
+			m_impl->inverseBindMatrices[i] = joint.GetInverseBindMatrix();
+			m_impl->initialPositions[i] = joint.GetInitialPosition();
+			m_impl->initialRotations[i] = joint.GetInitialRotation();
+			m_impl->initialScales[i] = joint.GetInitialScale();
+			m_impl->inheritFlags[i] = flags;
+			m_impl->parentIndices[i] = parentIndex;
+		}
+
+		// Joints may be parented in any order, parents have to be processed first
+		m_impl->skinningOrder.clear();
+		m_impl->skinningOrder.reserve(jointCount);
+
+		std::vector<bool> ordered(jointCount, false);
+		for (unsigned int i = 0; i < jointCount; ++i)
+		{
+			// Goes up to the first ancestor not yet ordered, then back down along the branch
+			unsigned int first = m_impl->skinningOrder.size();
+			for (int index = static_cast<int>(i); index >= 0 && !ordered[index]; index = m_impl->parentIndices[index])
+			{
+				ordered[index] = true;
+				m_impl->skinningOrder.push_back(index);
+			}
+
+			std::reverse(m_impl->skinningOrder.begin() + first, m_impl->skinningOrder.end());
+		}
+
+		m_impl->skinningDataUpdated = true;
+	}
+
 	bool Skeleton::Initialize()
 	{
 		if (!SkeletonLibrary::Initialize())
@@ -0,0 +1,115 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Utility/SkeletonPose.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <algorithm>
+#include <Nazara/Utility/Debug.hpp>
+
+namespace Nz
+{
+	void SkeletonPose::ApplyAdditive(const SkeletonPose& additivePose, float weight, const float* jointWeights)
+	{
+		///DOC: La pose additive doit avoir été obtenue par MakeAdditive, elle est appliquée à hauteur de weight
+		///DOC: (multiplié par le poids de chaque joint, si fournis)
+		NazaraAssert(additivePose.GetJointCount() == GetJointCount(), "Poses must have the same joint count");
+
+		std::size_t count = m_positions.size();
+
+		Vector3f* positions = m_positions.data();
+		Quaternionf* rotations = m_rotations.data();
+		Vector3f* scales = m_scales.data();
+		const Vector3f* additivePositions = additivePose.m_positions.data();
+		const Quaternionf* additiveRotations = additivePose.m_rotations.data();
+		const Vector3f* additiveScales = additivePose.m_scales.data();
+
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			float jointWeight = (jointWeights) ? weight * jointWeights[i] : weight;
+
+			positions[i] += additivePositions[i] * jointWeight;
+			scales[i] *= Vector3f::Unit() + (additiveScales[i] - Vector3f::Unit()) * jointWeight;
+
+			// Part of the rotation to apply, interpolated from the identity (and normalized with the final rotation)
+			const Quaternionf& delta = additiveRotations[i];
+			float deltaWeight = (delta.w < 0.f) ? -jointWeight : jointWeight;
+
+			Quaternionf partialDelta(1.f - jointWeight + delta.w * deltaWeight, delta.x * deltaWeight, delta.y * deltaWeight, delta.z * deltaWeight);
+			rotations[i] = rotations[i] * partialDelta;
+		}
+
+		Quaternionf::Normalize(rotations, rotations, count);
+	}
+
+	void SkeletonPose::Blend(const SkeletonPose& pose, float weight, const float* jointWeights)
+	{
+		///DOC: Interpole chaque joint vers la pose à hauteur de weight (multiplié par le poids de chaque joint, si fournis)
+		///DOC: Les rotations sont interpolées linéairement puis normalisées, ce qui est suffisant entre des poses proches
+		NazaraAssert(pose.GetJointCount() == GetJointCount(), "Poses must have the same joint count");
+
+		std::size_t count = m_positions.size();
+
+		Vector3f* positions = m_positions.data();
+		Quaternionf* rotations = m_rotations.data();
+		Vector3f* scales = m_scales.data();
+		const Vector3f* targetPositions = pose.m_positions.data();
+		const Quaternionf* targetRotations = pose.m_rotations.data();
+		const Vector3f* targetScales = pose.m_scales.data();
+
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			float jointWeight = (jointWeights) ? weight * jointWeights[i] : weight;
+
+			positions[i] += (targetPositions[i] - positions[i]) * jointWeight;
+			scales[i] += (targetScales[i] - scales[i]) * jointWeight;
+
+			// The shortest path is taken
+			const Quaternionf& from = rotations[i];
+			const Quaternionf& to = targetRotations[i];
+			float fromWeight = 1.f - jointWeight;
+			float toWeight = (from.DotProduct(to) < 0.f) ? -jointWeight : jointWeight;
+
+			rotations[i].Set(from.w * fromWeight + to.w * toWeight, from.x * fromWeight + to.x * toWeight,
+			                 from.y * fromWeight + to.y * toWeight, from.z * fromWeight + to.z * toWeight);
+		}
+
+		Quaternionf::Normalize(rotations, rotations, count);
+	}
+
+	void SkeletonPose::MakeAdditive(const SkeletonPose& referencePose)
+	{
+		///DOC: Transforme la pose en la différence entre elle et la pose de référence, pour ApplyAdditive
+		NazaraAssert(referencePose.GetJointCount() == GetJointCount(), "Poses must have the same joint count");
+
+		std::size_t count = m_positions.size();
+
+		Vector3f* positions = m_positions.data();
+		Quaternionf* rotations = m_rotations.data();
+		Vector3f* scales = m_scales.data();
+		const Vector3f* referencePositions = referencePose.m_positions.data();
+		const Quaternionf* referenceRotations = referencePose.m_rotations.data();
+		const Vector3f* referenceScales = referencePose.m_scales.data();
+
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			positions[i] -= referencePositions[i];
+			rotations[i] = referenceRotations[i].GetConjugate() * rotations[i];
+			scales[i] /= referenceScales[i];
+		}
+	}
+
+	void SkeletonPose::MakeIdentity()
+	{
+		std::fill(m_positions.begin(), m_positions.end(), Vector3f::Zero());
+		std::fill(m_rotations.begin(), m_rotations.end(), Quaternionf::Identity());
+		std::fill(m_scales.begin(), m_scales.end(), Vector3f::Unit());
+	}
+
+	void SkeletonPose::Resize(unsigned int jointCount)
+	{
+		m_positions.resize(jointCount, Vector3f::Zero());
+		m_rotations.resize(jointCount, Quaternionf::Identity());
+		m_scales.resize(jointCount, Vector3f::Unit());
+	}
+}
@@ -63,6 +63,7 @@ namespace Nz
 		{
 			OnStaticMeshDestroy(this);
 
+			ClearLods();
 			m_indexBuffer.Reset();
 			m_vertexBuffer.Reset();
 		}
@@ -124,6 +125,9 @@ namespace Nz
 
 	void StaticMesh::SetIndexBuffer(const IndexBuffer* indexBuffer)
 	{
+		///DOC: Les niveaux de détail sont supprimés, ils ne correspondent plus à la géométrie
+		ClearLods();
+
 		m_indexBuffer = indexBuffer;
 }
 }
@@ -5,10 +5,16 @@
 #include <Nazara/Utility/SubMesh.hpp>
 #include <Nazara/Core/Error.hpp>
 #include <Nazara/Core/String.hpp>
+#include <Nazara/Utility/Algorithm.hpp>
 #include <Nazara/Utility/Config.hpp>
+#include <Nazara/Utility/IndexMapper.hpp>
 #include <Nazara/Utility/Mesh.hpp>
+#include <Nazara/Utility/SkeletalMesh.hpp>
+#include <Nazara/Utility/StaticMesh.hpp>
 #include <Nazara/Utility/TriangleIterator.hpp>
 #include <Nazara/Utility/VertexMapper.hpp>
+#include <algorithm>
+#include <cstring>
 #include <stdexcept>
 #include <Nazara/Utility/Debug.hpp>
 
@@ -27,6 +33,128 @@ namespace Nz
 		OnSubMeshRelease(this);
 	}
 
+	void SubMesh::ClearLods()
+	{
+		m_lods.clear();
+	}
+
+	bool SubMesh::GenerateLods(unsigned int lodCount, float reductionFactor, float maxError)
+	{
+		///DOC: Génère jusqu'à lodCount niveaux de détail (en comptant le niveau original), chacun ayant environ reductionFactor fois
+		///DOC: les triangles du précédent, tant que l'erreur cumulée (relative à la taille du sous-mesh) ne dépasse pas maxError
+		///DOC: Les niveaux partagent les sommets du sous-mesh, ils doivent être régénérés si sa géométrie est modifiée
+		ClearLods();
+
+		#if NAZARA_UTILITY_SAFE
+		if (m_primitiveMode != PrimitiveMode_TriangleList)
+		{
+			NazaraError("Only triangle lists can be simplified");
+			return false;
+		}
+
+		if (reductionFactor <= 0.f || reductionFactor >= 1.f)
+		{
+			NazaraError("Reduction factor must be between 0 and 1 (exclusive)");
+			return false;
+		}
+		#endif
+
+		const IndexBuffer* indexBuffer = GetIndexBuffer();
+		if (!indexBuffer)
+		{
+			NazaraError("Sub-mesh must have an index buffer");
+			return false;
+		}
+
+		const VertexBuffer* vertexBuffer;
+		if (GetAnimationType() == AnimationType_Static)
+			vertexBuffer = static_cast<const StaticMesh*>(this)->GetVertexBuffer();
+		else
+			vertexBuffer = static_cast<const SkeletalMesh*>(this)->GetVertexBuffer();
+
+		const VertexDeclaration* declaration = vertexBuffer->GetVertexDeclaration();
+		auto HasComponent = [declaration](VertexComponent component, ComponentType expectedType)
+		{
+			bool enabled;
+			ComponentType type;
+			std::size_t offset;
+			declaration->GetComponent(component, &enabled, &type, &offset);
+
+			return enabled && type == expectedType;
+		};
+
+		if (!HasComponent(VertexComponent_Position, ComponentType_Float3))
+		{
+			NazaraError("Sub-mesh positions must be Float3");
+			return false;
+		}
+
+		// Les normales et coordonnées de texture, si présentes, limitent l'écrasement des attributs
+		VertexMapper mapper(this, BufferAccess_ReadOnly);
+		SparsePtr<const Vector3f> positionPtr = mapper.GetComponentPtr<const Vector3f>(VertexComponent_Position);
+
+		SparsePtr<const Vector3f> normalPtr;
+		if (HasComponent(VertexComponent_Normal, ComponentType_Float3))
+			normalPtr = mapper.GetComponentPtr<const Vector3f>(VertexComponent_Normal);
+
+		SparsePtr<const Vector2f> uvPtr;
+		if (HasComponent(VertexComponent_TexCoord, ComponentType_Float2))
+			uvPtr = mapper.GetComponentPtr<const Vector2f>(VertexComponent_TexCoord);
+
+		unsigned int vertexCount = GetVertexCount();
+		Boxf aabb = ComputeAABB(positionPtr, vertexCount);
+		float extent = std::max({aabb.width, aabb.height, aabb.depth});
+
+		// Chaque niveau est simplifié à partir du précédent, dans un buffer de travail
+		bool largeIndices = indexBuffer->HasLargeIndices();
+		unsigned int indexCount = indexBuffer->GetIndexCount();
+		UInt32 storage = indexBuffer->GetBuffer()->GetStorage();
+		BufferUsage usage = indexBuffer->GetBuffer()->GetUsage();
+
+		IndexBufferRef workBuffer = IndexBuffer::New(largeIndices, indexCount, DataStorage_Software, BufferUsage_Static);
+		std::memcpy(workBuffer->Map(BufferAccess_DiscardAndWrite), indexBuffer->Map(BufferAccess_ReadOnly), indexCount * indexBuffer->GetStride());
+		indexBuffer->Unmap();
+		workBuffer->Unmap();
+
+		IndexMapper workMapper(workBuffer, BufferAccess_ReadWrite);
+
+		float relativeError = 0.f;
+		for (unsigned int lod = 1; lod < lodCount; ++lod)
+		{
+			float remainingError = maxError - relativeError;
+			if (remainingError <= 0.f)
+				break;
+
+			unsigned int targetIndexCount = static_cast<unsigned int>(indexCount * reductionFactor) / 3 * 3;
+
+			float lodError;
+			unsigned int lodIndexCount = SimplifyIndices(workMapper.begin(), indexCount, vertexCount, positionPtr, normalPtr, uvPtr, targetIndexCount, remainingError, &lodError);
+
+			// Un niveau trop proche du précédent n'apporterait rien
+			if (lodIndexCount == 0 || lodIndexCount > indexCount - indexCount / 20)
+				break;
+
+			IndexBufferRef lodBuffer = IndexBuffer::New(largeIndices, lodIndexCount, DataStorage_Software, usage);
+			{
+				IndexMapper lodMapper(lodBuffer, BufferAccess_ReadWrite);
+				for (unsigned int i = 0; i < lodIndexCount; ++i)
+					lodMapper.Set(i, workMapper.Get(i));
+
+				OptimizeIndices(lodMapper.begin(), lodIndexCount);
+			}
+
+			if (storage != DataStorage_Software && !lodBuffer->SetStorage(storage))
+				NazaraWarning("Failed to set LOD index buffer storage");
+
+			relativeError += lodError;
+			indexCount = lodIndexCount;
+
+			m_lods.push_back(Lod{lodBuffer, relativeError * extent});
+		}
+
+		return true;
+	}
+
 	void SubMesh::GenerateNormals()
 	{
 		VertexMapper mapper(this);
@@ -156,6 +284,26 @@ namespace Nz
 		while (iterator.Advance());
 	}
 
+	unsigned int SubMesh::GetLodCount() const
+	{
+		// Le niveau original est compté
+		return static_cast<unsigned int>(m_lods.size()) + 1;
+	}
+
+	float SubMesh::GetLodError(unsigned int lod) const
+	{
+		NazaraAssert(lod < GetLodCount(), "LOD out of range");
+
+		return (lod == 0) ? 0.f : m_lods[lod - 1].error;
+	}
+
+	const IndexBuffer* SubMesh::GetLodIndexBuffer(unsigned int lod) const
+	{
+		NazaraAssert(lod < GetLodCount(), "LOD out of range");
+
+		return (lod == 0) ? GetIndexBuffer() : m_lods[lod - 1].indexBuffer.Get();
+	}
+
 	const Mesh* SubMesh::GetParent() const
 	{
 		return m_parent;
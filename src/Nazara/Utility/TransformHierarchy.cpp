@@ -0,0 +1,534 @@
+// Copyright (C) 2015 Jérôme Leclercq
+// This file is part of the "Nazara Engine - Utility module"
+// For conditions of distribution and use, see copyright notice in Config.hpp
+
+#include <Nazara/Utility/TransformHierarchy.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Nazara/Utility/Node.hpp>
+#include <algorithm>
+#include <Nazara/Utility/Debug.hpp>
+
+namespace Nz
+{
+	namespace
+	{
+		// order[newIndex] = oldIndex
+		template<typename T>
+		void Permute(std::vector<T>& values, const std::vector<UInt32>& order)
+		{
+			std::vector<T> permutedValues;
+			permutedValues.reserve(order.size());
+
+			for (UInt32 index : order)
+				permutedValues.push_back(values[index]);
+
+			values = std::move(permutedValues);
+		}
+	}
+
+	constexpr TransformHierarchy::Handle TransformHierarchy::InvalidHandle;
+	constexpr UInt32 TransformHierarchy::InvalidIndex;
+	constexpr std::size_t TransformHierarchy::ParallelThreshold;
+
+	TransformHierarchy::TransformHierarchy() :
+	m_aliveCount(0),
+	m_orderInvalidated(false)
+	{
+	}
+
+	TransformHierarchy::~TransformHierarchy()
+	{
+		Clear();
+	}
+
+	TransformHierarchy::Handle TransformHierarchy::AddNode(Node* node)
+	{
+		///DOC: Ajoute aussi les enfants du node, un node appartenant à une autre hiérarchie en est retiré
+		NazaraAssert(node, "Invalid node");
+
+		Handle parent = InvalidHandle;
+		if (node->m_parent && node->m_parent->m_hierarchy == this)
+			parent = node->m_parent->m_hierarchyHandle;
+
+		if (node->m_hierarchy == this)
+		{
+			// Its parent may have been added after it
+			SetParent(node->m_hierarchyHandle, parent);
+			return node->m_hierarchyHandle;
+		}
+
+		if (node->m_hierarchy)
+			node->m_hierarchy->RemoveNode(node);
+
+		Handle handle = Create(parent);
+		m_nodes[m_indices[handle]] = node;
+
+		node->m_hierarchy = this;
+		node->m_hierarchyHandle = handle;
+
+		for (Node* child : node->m_childs)
+			AddNode(child);
+
+		return handle;
+	}
+
+	void TransformHierarchy::Clear()
+	{
+		for (Node* node : m_nodes)
+		{
+			if (node)
+			{
+				node->m_hierarchy = nullptr;
+				node->m_hierarchyHandle = InvalidHandle;
+			}
+		}
+
+		m_flags.clear();
+		m_freeHandles.clear();
+		m_handles.clear();
+		m_indices.clear();
+		m_localPositions.clear();
+		m_localRotations.clear();
+		m_localScales.clear();
+		m_nodes.clear();
+		m_parentIndices.clear();
+		m_rootIndices.clear();
+		m_worldMatrices.clear();
+		m_worldPositions.clear();
+		m_worldRotations.clear();
+		m_worldScales.clear();
+		m_aliveCount = 0;
+		m_orderInvalidated = false;
+	}
+
+	TransformHierarchy::Handle TransformHierarchy::Create(Handle parent)
+	{
+		NazaraAssert(parent == InvalidHandle || IsValid(parent), "Invalid parent handle");
+
+		UInt32 index = static_cast<UInt32>(m_flags.size());
+
+		m_flags.push_back(Flag_Alive | Flag_Dirty | Flag_InheritPosition | Flag_InheritRotation | Flag_InheritScale);
+		m_localPositions.push_back(Vector3f::Zero());
+		m_localRotations.push_back(Quaternionf::Identity());
+		m_localScales.push_back(Vector3f::Unit());
+		m_nodes.push_back(nullptr);
+		m_parentIndices.push_back((parent != InvalidHandle) ? m_indices[parent] : InvalidIndex);
+		m_worldMatrices.push_back(Matrix4f::Identity());
+		m_worldPositions.push_back(Vector3f::Zero());
+		m_worldRotations.push_back(Quaternionf::Identity());
+		m_worldScales.push_back(Vector3f::Unit());
+
+		Handle handle = AllocateHandle(index);
+		m_handles.push_back(handle);
+
+		m_aliveCount++;
+		m_orderInvalidated = true;
+
+		return handle;
+	}
+
+	void TransformHierarchy::Destroy(Handle handle)
+	{
+		///DOC: Les enfants deviennent des racines (lors du prochain Update)
+		UInt32 index = GetIndex(handle);
+
+		if (Node* node = m_nodes[index])
+		{
+			node->m_hierarchy = nullptr;
+			node->m_hierarchyHandle = InvalidHandle;
+		}
+
+		// The slot itself is only reclaimed by the next reordering
+		m_flags[index] = 0;
+		m_nodes[index] = nullptr;
+
+		m_indices[handle] = InvalidIndex;
+		m_freeHandles.push_back(handle);
+
+		m_aliveCount--;
+		m_orderInvalidated = true;
+	}
+
+	TransformHierarchy::Handle TransformHierarchy::GetHandle(const Node* node) const
+	{
+		NazaraAssert(node, "Invalid node");
+
+		return (node->m_hierarchy == this) ? node->m_hierarchyHandle : InvalidHandle;
+	}
+
+	void TransformHierarchy::RemoveNode(Node* node)
+	{
+		///DOC: Retire aussi les enfants du node
+		NazaraAssert(node, "Invalid node");
+
+		if (node->m_hierarchy != this)
+		{
+			NazaraError("Node does not belong to this hierarchy");
+			return;
+		}
+
+		Destroy(node->m_hierarchyHandle);
+
+		for (Node* child : node->m_childs)
+		{
+			if (child->m_hierarchy == this)
+				RemoveNode(child);
+		}
+	}
+
+	void TransformHierarchy::SetInheritPosition(Handle handle, bool inheritPosition)
+	{
+		SetFlag(handle, Flag_InheritPosition, inheritPosition);
+	}
+
+	void TransformHierarchy::SetInheritRotation(Handle handle, bool inheritRotation)
+	{
+		SetFlag(handle, Flag_InheritRotation, inheritRotation);
+	}
+
+	void TransformHierarchy::SetInheritScale(Handle handle, bool inheritScale)
+	{
+		SetFlag(handle, Flag_InheritScale, inheritScale);
+	}
+
+	void TransformHierarchy::SetLocalPosition(Handle handle, const Vector3f& position)
+	{
+		///DOC: Le transform local d'un node est lu depuis celui-ci, c'est donc le node qui doit être modifié
+		UInt32 index = GetIndex(handle);
+
+		m_localPositions[index] = position;
+		m_flags[index] |= Flag_Dirty;
+	}
+
+	void TransformHierarchy::SetLocalRotation(Handle handle, const Quaternionf& rotation)
+	{
+		UInt32 index = GetIndex(handle);
+
+		m_localRotations[index] = rotation;
+		m_flags[index] |= Flag_Dirty;
+	}
+
+	void TransformHierarchy::SetLocalScale(Handle handle, const Vector3f& scale)
+	{
+		UInt32 index = GetIndex(handle);
+
+		m_localScales[index] = scale;
+		m_flags[index] |= Flag_Dirty;
+	}
+
+	void TransformHierarchy::SetParent(Handle handle, Handle parent)
+	{
+		///DOC: Le parent d'un node est celui du node (Node::SetParent)
+		UInt32 index = GetIndex(handle);
+		UInt32 parentIndex = (parent != InvalidHandle) ? GetIndex(parent) : InvalidIndex;
+
+		#if NAZARA_UTILITY_SAFE
+		UInt32 ancestorIndex = parentIndex;
+		while (ancestorIndex != InvalidIndex && (m_flags[ancestorIndex] & Flag_Alive))
+		{
+			if (ancestorIndex == index)
+			{
+				NazaraError("A transform cannot be its own parent");
+				return;
+			}
+
+			ancestorIndex = m_parentIndices[ancestorIndex];
+		}
+		#endif
+
+		if (m_parentIndices[index] == parentIndex)
+			return;
+
+		m_parentIndices[index] = parentIndex;
+		m_flags[index] |= Flag_Dirty;
+
+		m_orderInvalidated = true;
+	}
+
+	void TransformHierarchy::Update(bool parallel)
+	{
+		///DOC: Met à jour les transforms invalidés depuis le dernier appel, ainsi que leurs descendants
+		///DOC: Les sous-arbres des racines sont indépendants et peuvent être répartis entre les workers du TaskScheduler
+		if (m_orderInvalidated)
+			Reorder();
+
+		if (m_rootIndices.empty())
+			return;
+
+		// The parents of the nodes which are outside of the hierarchy are updated beforehand, they are only read during the update
+		for (UInt32 rootIndex : m_rootIndices)
+		{
+			if ((m_flags[rootIndex] & Flag_Dirty) && m_nodes[rootIndex] && m_nodes[rootIndex]->m_parent)
+				m_nodes[rootIndex]->m_parent->EnsureDerivedUpdate();
+		}
+
+		std::size_t count = m_flags.size();
+		std::size_t taskCount = (parallel) ? std::min<std::size_t>(TaskScheduler::GetWorkerCount(), count / ParallelThreshold) : 1;
+		if (taskCount <= 1)
+		{
+			UpdateRange(0, count);
+			return;
+		}
+
+		// Tasks get whole subtrees, of about the same total size
+		std::size_t taskSize = count / taskCount;
+		std::vector<std::size_t> bounds(1, 0);
+		for (std::size_t i = 1; i <= m_rootIndices.size(); ++i)
+		{
+			std::size_t last = (i < m_rootIndices.size()) ? m_rootIndices[i] : count;
+			if (last - bounds.back() >= taskSize || last == count)
+				bounds.push_back(last);
+		}
+
+		TaskScheduler::ParallelFor(bounds.size() - 1, bounds.size() - 1, [this, &bounds](std::size_t first, std::size_t last, unsigned int taskIndex)
+		{
+			NazaraUnused(taskIndex);
+
+			for (std::size_t i = first; i < last; ++i)
+				UpdateRange(bounds[i], bounds[i + 1]);
+		});
+	}
+
+	TransformHierarchy::Handle TransformHierarchy::AllocateHandle(UInt32 index)
+	{
+		Handle handle;
+		if (!m_freeHandles.empty())
+		{
+			handle = m_freeHandles.back();
+			m_freeHandles.pop_back();
+
+			m_indices[handle] = index;
+		}
+		else
+		{
+			handle = static_cast<Handle>(m_indices.size());
+			m_indices.push_back(index);
+		}
+
+		return handle;
+	}
+
+	void TransformHierarchy::Reorder()
+	{
+		// Children of each transform, a transform whose parent has been destroyed becomes a root
+		std::size_t slotCount = m_flags.size();
+		std::vector<UInt32> childOffsets(slotCount + 1, 0);
+		std::vector<UInt32> roots;
+
+		for (UInt32 i = 0; i < slotCount; ++i)
+		{
+			if ((m_flags[i] & Flag_Alive) == 0)
+				continue;
+
+			UInt32 parentIndex = m_parentIndices[i];
+			if (parentIndex != InvalidIndex && (m_flags[parentIndex] & Flag_Alive) == 0)
+			{
+				m_parentIndices[i] = InvalidIndex;
+				m_flags[i] |= Flag_Dirty;
+
+				parentIndex = InvalidIndex;
+			}
+
+			if (parentIndex != InvalidIndex)
+				childOffsets[parentIndex + 1]++;
+			else
+				roots.push_back(i);
+		}
+
+		for (std::size_t i = 1; i <= slotCount; ++i)
+			childOffsets[i] += childOffsets[i - 1];
+
+		std::vector<UInt32> children(childOffsets[slotCount]);
+		std::vector<UInt32> cursors(childOffsets.begin(), childOffsets.end() - 1);
+		for (UInt32 i = 0; i < slotCount; ++i)
+		{
+			if ((m_flags[i] & Flag_Alive) && m_parentIndices[i] != InvalidIndex)
+				children[cursors[m_parentIndices[i]]++] = i;
+		}
+
+		// Depth-first order, every subtree is then a contiguous range beginning with its root
+		std::vector<UInt32> order; //< New index => old index
+		std::vector<UInt32> newIndices(slotCount, InvalidIndex); //< Old index => new index
+		std::vector<UInt32> pending;
+		order.reserve(m_aliveCount);
+
+		m_rootIndices.clear();
+		for (UInt32 root : roots)
+		{
+			m_rootIndices.push_back(static_cast<UInt32>(order.size()));
+
+			pending.push_back(root);
+			while (!pending.empty())
+			{
+				UInt32 index = pending.back();
+				pending.pop_back();
+
+				newIndices[index] = static_cast<UInt32>(order.size());
+				order.push_back(index);
+
+				// Reversed, to keep the siblings in their order
+				for (UInt32 i = childOffsets[index + 1]; i > childOffsets[index]; --i)
+					pending.push_back(children[i - 1]);
+			}
+		}
+
+		NazaraAssert(order.size() == m_aliveCount, "Alive transform count mismatch");
+
+		for (UInt32& parentIndex : m_parentIndices)
+		{
+			if (parentIndex != InvalidIndex)
+				parentIndex = newIndices[parentIndex];
+		}
+
+		Permute(m_flags, order);
+		Permute(m_handles, order);
+		Permute(m_localPositions, order);
+		Permute(m_localRotations, order);
+		Permute(m_localScales, order);
+		Permute(m_nodes, order);
+		Permute(m_parentIndices, order);
+		Permute(m_worldMatrices, order);
+		Permute(m_worldPositions, order);
+		Permute(m_worldRotations, order);
+		Permute(m_worldScales, order);
+
+		for (UInt32 i = 0; i < m_aliveCount; ++i)
+			m_indices[m_handles[i]] = i;
+
+		m_orderInvalidated = false;
+	}
+
+	void TransformHierarchy::SetFlag(Handle handle, UInt8 flag, bool enabled)
+	{
+		UInt32 index = GetIndex(handle);
+
+		if (enabled)
+			m_flags[index] |= flag;
+		else
+			m_flags[index] &= ~flag;
+
+		m_flags[index] |= Flag_Dirty;
+	}
+
+	void TransformHierarchy::UpdateRange(std::size_t firstIndex, std::size_t lastIndex)
+	{
+		// Flags are bytes, which may alias anything: without these locals, the arrays would be reloaded after each write
+		UInt8* flagArray = m_flags.data();
+		Node* const* nodes = m_nodes.data();
+		const UInt32* parentIndices = m_parentIndices.data();
+		Vector3f* localPositions = m_localPositions.data();
+		Quaternionf* localRotations = m_localRotations.data();
+		Vector3f* localScales = m_localScales.data();
+		Matrix4f* worldMatrices = m_worldMatrices.data();
+		Vector3f* worldPositions = m_worldPositions.data();
+		Quaternionf* worldRotations = m_worldRotations.data();
+		Vector3f* worldScales = m_worldScales.data();
+
+		for (std::size_t i = firstIndex; i < lastIndex; ++i)
+		{
+			UInt32 parentIndex = parentIndices[i];
+
+			UInt8 flags = flagArray[i];
+			if (parentIndex != InvalidIndex)
+				flags |= flagArray[parentIndex] & Flag_Dirty;
+
+			if ((flags & Flag_Dirty) == 0)
+				continue;
+
+			Node* node = nodes[i];
+			if (node)
+			{
+				localPositions[i] = node->m_initialPosition + node->m_position;
+				localRotations[i] = node->m_initialRotation * node->m_rotation;
+				localScales[i] = node->m_initialScale * node->m_scale;
+
+				flags &= ~(Flag_InheritPosition | Flag_InheritRotation | Flag_InheritScale);
+				if (node->m_inheritPosition)
+					flags |= Flag_InheritPosition;
+
+				if (node->m_inheritRotation)
+					flags |= Flag_InheritRotation;
+
+				if (node->m_inheritScale)
+					flags |= Flag_InheritScale;
+			}
+
+			flagArray[i] = flags;
+
+			// Same computation as Node::UpdateDerived
+			Vector3f position;
+			Quaternionf rotation;
+			Vector3f scale;
+			if (parentIndex != InvalidIndex)
+			{
+				// The world matrix of the parent already combines its position, rotation and scale
+				if (flags & Flag_InheritPosition)
+					position = worldMatrices[parentIndex].Transform(localPositions[i]);
+				else
+					position = localPositions[i];
+
+				if (flags & Flag_InheritRotation)
+				{
+					rotation = worldRotations[parentIndex] * localRotations[i];
+					rotation.Normalize();
+				}
+				else
+					rotation = localRotations[i];
+
+				scale = localScales[i];
+				if (flags & Flag_InheritScale)
+					scale *= worldScales[parentIndex];
+			}
+			else if (node && node->m_parent)
+			{
+				const Node* parent = node->m_parent;
+
+				if (flags & Flag_InheritPosition)
+					position = parent->m_derivedRotation * (parent->m_derivedScale * localPositions[i]) + parent->m_derivedPosition;
+				else
+					position = localPositions[i];
+
+				if (flags & Flag_InheritRotation)
+				{
+					rotation = parent->m_derivedRotation * localRotations[i];
+					rotation.Normalize();
+				}
+				else
+					rotation = localRotations[i];
+
+				scale = localScales[i];
+				if (flags & Flag_InheritScale)
+					scale *= parent->m_derivedScale;
+			}
+			else
+			{
+				position = localPositions[i];
+				rotation = localRotations[i];
+				scale = localScales[i];
+			}
+
+			Matrix4f& worldMatrix = worldMatrices[i];
+			worldMatrix.MakeTransform(position, rotation, scale);
+
+			worldPositions[i] = position;
+			worldRotations[i] = rotation;
+			worldScales[i] = scale;
+
+			if (node)
+			{
+				node->m_derivedPosition = position;
+				node->m_derivedRotation = rotation;
+				node->m_derivedScale = scale;
+				node->m_derivedUpdated = true;
+
+				node->m_transformMatrix = worldMatrix;
+				node->m_transformMatrixUpdated = true;
+			}
+		}
+
+		// Dirty flags were kept during the pass so that the children of an updated transform were updated too
+		for (std::size_t i = firstIndex; i < lastIndex; ++i)
+			flagArray[i] &= ~Flag_Dirty;
+	}
+}
@@ -0,0 +1,333 @@
+#include <Nazara/Audio/SoftwareMixer.hpp>
+#include <Nazara/Audio/Audio.hpp>
+#include <Nazara/Audio/Sound.hpp>
+#include <Nazara/Audio/SoundBuffer.hpp>
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/ErrorFlags.hpp>
+#include <Nazara/Core/MemoryStream.hpp>
+#include <Catch/catch.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+	unsigned int CreateConstantBuffer(Nz::SoftwareMixer& mixer, unsigned int channelCount, unsigned int frameCount, Nz::Int16 value, unsigned int sampleRate = 44100)
+	{
+		std::vector<Nz::Int16> samples(frameCount * channelCount, value);
+
+		unsigned int buffer = mixer.CreateBuffer();
+		REQUIRE(mixer.UpdateBuffer(buffer, channelCount, samples.data(), static_cast<Nz::UInt32>(samples.size()), sampleRate));
+
+		return buffer;
+	}
+}
+
+SCENARIO("SoftwareMixer", "[AUDIO][SOFTWAREMIXER]")
+{
+	GIVEN("A mixer and a mono buffer of 100 frames at half the full scale")
+	{
+		Nz::SoftwareMixer mixer(44100);
+
+		unsigned int buffer = CreateConstantBuffer(mixer, 1, 100, 16384);
+		unsigned int source = mixer.CreateSource();
+		REQUIRE(mixer.SetSourceBuffer(source, buffer));
+
+		std::vector<float> output(200 * Nz::SoftwareMixer::ChannelCount);
+		const float centerGain = std::cos(float(M_PI) / 4.f);
+
+		WHEN("The source is played on the listener")
+		{
+			mixer.PlaySource(source);
+			mixer.Render(output.data(), 50);
+
+			THEN("Both channels are mixed at the same level")
+			{
+				CHECK(mixer.GetSourceStatus(source) == Nz::SoundStatus_Playing);
+				CHECK(output[0] == Approx(0.5f * centerGain));
+				CHECK(output[1] == Approx(0.5f * centerGain));
+				CHECK(output[99] == Approx(0.5f * centerGain));
+				CHECK(mixer.GetSourceOffset(source) == Approx(50.f / 44100.f));
+			}
+
+			AND_THEN("It stops at the end of the buffer")
+			{
+				mixer.Render(output.data(), 200);
+
+				CHECK(output[49 * 2] == Approx(0.5f * centerGain));
+				CHECK(output[50 * 2] == 0.f);
+				CHECK(output[199 * 2 + 1] == 0.f);
+				CHECK(mixer.GetSourceStatus(source) == Nz::SoundStatus_Stopped);
+				CHECK(mixer.GetRenderedFrameCount() == 250);
+			}
+		}
+
+		WHEN("The source is on the right of the listener")
+		{
+			Nz::SoftwareMixer::SourceParameters parameters;
+			parameters.position.Set(2.f, 0.f, 0.f);
+			mixer.SetSourceParameters(source, parameters);
+
+			mixer.PlaySource(source);
+			mixer.Render(output.data(), 10);
+
+			THEN("It is only heard on the right channel and attenuated by the distance")
+			{
+				CHECK(std::abs(output[0]) < 0.0001f);
+				CHECK(output[1] == Approx(0.25f));
+			}
+
+			AND_WHEN("It is relative to the listener which moved away")
+			{
+				parameters.spatialized = false;
+				mixer.SetSourceParameters(source, parameters);
+
+				Nz::SoftwareMixer::ListenerParameters listener;
+				listener.position.Set(100.f, 0.f, 0.f);
+				mixer.SetListener(listener);
+
+				mixer.Render(output.data(), 10);
+
+				THEN("Nothing changes")
+				{
+					CHECK(output[1] == Approx(0.25f));
+				}
+			}
+		}
+
+		WHEN("The source is looping and pitched up")
+		{
+			Nz::SoftwareMixer::SourceParameters parameters;
+			parameters.looping = true;
+			parameters.pitch = 2.f;
+			mixer.SetSourceParameters(source, parameters);
+
+			mixer.PlaySource(source);
+			mixer.Render(output.data(), 200);
+
+			THEN("It goes twice as fast and never stops")
+			{
+				CHECK(mixer.GetSourceStatus(source) == Nz::SoundStatus_Playing);
+				CHECK(output[199 * 2] == Approx(0.5f * centerGain));
+				CHECK(std::abs(mixer.GetSourceOffset(source)) < 0.0001f);
+			}
+		}
+
+		WHEN("The source is paused")
+		{
+			mixer.PlaySource(source);
+			mixer.Render(output.data(), 30);
+			mixer.PauseSource(source);
+			mixer.Render(output.data(), 30);
+
+			THEN("It is not mixed until played again")
+			{
+				CHECK(output[0] == 0.f);
+				CHECK(mixer.GetSourceOffset(source) == Approx(30.f / 44100.f));
+
+				mixer.PlaySource(source);
+				mixer.Render(output.data(), 100);
+
+				CHECK(output[69 * 2] == Approx(0.5f * centerGain));
+				CHECK(output[70 * 2] == 0.f);
+			}
+		}
+
+		WHEN("We destroy a buffer which is used by a source")
+		{
+			THEN("It fails")
+			{
+				Nz::ErrorFlags flags(Nz::ErrorFlag_Silent);
+
+				CHECK_FALSE(mixer.DestroyBuffer(buffer));
+				REQUIRE(mixer.SetSourceBuffer(source, Nz::SoftwareMixer::InvalidId));
+				CHECK(mixer.DestroyBuffer(buffer));
+				CHECK_FALSE(mixer.IsBuffer(buffer));
+			}
+		}
+	}
+
+	GIVEN("A source with two queued buffers of different sample rates")
+	{
+		Nz::SoftwareMixer mixer(44100);
+
+		unsigned int buffers[2];
+		buffers[0] = CreateConstantBuffer(mixer, 2, 64, 8192);
+		buffers[1] = CreateConstantBuffer(mixer, 2, 32, -8192, 22050);
+
+		unsigned int source = mixer.CreateSource();
+		REQUIRE(mixer.QueueSourceBuffers(source, 2, buffers));
+
+		WHEN("We play the first one")
+		{
+			std::vector<float> output(80 * Nz::SoftwareMixer::ChannelCount);
+			mixer.PlaySource(source);
+			mixer.Render(output.data(), 80);
+
+			THEN("It can be unqueued while the second one is playing")
+			{
+				CHECK(output[63 * 2] == Approx(0.25f));
+				CHECK(output[64 * 2 + 1] == Approx(-0.25f));
+				CHECK(mixer.GetSourceProcessedBufferCount(source) == 1);
+
+				unsigned int unqueued[2];
+				{
+					Nz::ErrorFlags flags(Nz::ErrorFlag_Silent);
+					CHECK_FALSE(mixer.UnqueueSourceBuffers(source, 2, unqueued));
+				}
+
+				REQUIRE(mixer.UnqueueSourceBuffers(source, 1, unqueued));
+				CHECK(unqueued[0] == buffers[0]);
+				CHECK(mixer.GetSourceQueuedBufferCount(source) == 1);
+				CHECK(mixer.GetSourceProcessedBufferCount(source) == 0);
+			}
+
+			AND_THEN("The second buffer is resampled")
+			{
+				mixer.Render(output.data(), 80);
+
+				// 32 frames at 22050Hz take 64 frames at 44100Hz, 16 of them were mixed in the first render
+				CHECK(output[47 * 2] == Approx(-0.25f));
+				CHECK(output[48 * 2] == 0.f);
+				CHECK(mixer.GetSourceStatus(source) == Nz::SoundStatus_Stopped);
+				CHECK(mixer.GetSourceProcessedBufferCount(source) == 2);
+			}
+		}
+	}
+
+	GIVEN("A mixer rendering a WAV file")
+	{
+		Nz::SoftwareMixer mixer(22050);
+
+		unsigned int buffer = CreateConstantBuffer(mixer, 2, 10000, 1000, 22050);
+		unsigned int source = mixer.CreateSource();
+		REQUIRE(mixer.SetSourceBuffer(source, buffer));
+		mixer.PlaySource(source);
+
+		Nz::ByteArray byteArray;
+		Nz::MemoryStream stream(&byteArray);
+		REQUIRE(mixer.RenderToStream(stream, 5000));
+
+		THEN("It has a valid header followed by the samples")
+		{
+			REQUIRE(byteArray.GetSize() == 44 + 5000 * 4);
+			CHECK(std::memcmp(byteArray.GetConstBuffer(), "RIFF", 4) == 0);
+			CHECK(std::memcmp(byteArray.GetConstBuffer() + 8, "WAVEfmt ", 8) == 0);
+			CHECK(std::memcmp(byteArray.GetConstBuffer() + 36, "data", 4) == 0);
+			CHECK(byteArray[24] == (22050 & 0xFF));
+			CHECK(byteArray[25] == (22050 >> 8));
+
+			Nz::Int16 lastSample = byteArray[44 + 5000 * 4 - 2] | (byteArray[44 + 5000 * 4 - 1] << 8);
+			CHECK(std::abs(lastSample - 1000) <= 1);
+		}
+	}
+}
+
+SCENARIO("Audio software backend", "[AUDIO][SOFTWAREMIXER]")
+{
+	GIVEN("The audio module initialized without any device")
+	{
+		REQUIRE(Nz::Audio::Initialize(Nz::AudioBackend_Software));
+
+		Nz::SoftwareMixer* mixer = Nz::Audio::GetSoftwareMixer();
+		REQUIRE(mixer);
+		CHECK(Nz::Audio::GetBackend() == Nz::AudioBackend_Software);
+
+		WHEN("We play a sound")
+		{
+			std::vector<Nz::Int16> samples(mixer->GetSampleRate() / 10, 16384); // 100ms
+			Nz::SoundBufferRef soundBuffer = Nz::SoundBuffer::New(Nz::AudioFormat_Mono, static_cast<unsigned int>(samples.size()), mixer->GetSampleRate(), samples.data());
+			{
+				Nz::Sound sound(soundBuffer);
+				sound.SetVolume(50.f);
+				sound.SetPosition(-1.f, 0.f, 0.f);
+				sound.Play();
+
+				Nz::Audio::SetListenerPosition(0.f, 0.f, 0.f);
+				Nz::Audio::SetGlobalVolume(100.f);
+
+				std::vector<float> output(mixer->GetSampleRate() / 20 * Nz::SoftwareMixer::ChannelCount);
+				mixer->Render(output.data(), mixer->GetSampleRate() / 20);
+
+				THEN("It is mixed from the emitter attributes")
+				{
+					CHECK(sound.GetStatus() == Nz::SoundStatus_Playing);
+					CHECK(sound.GetPlayingOffset() == 50);
+					CHECK(sound.GetVolume() == Approx(50.f));
+					CHECK(sound.GetPosition() == Nz::Vector3f(-1.f, 0.f, 0.f));
+					CHECK(output[0] == Approx(0.25f));
+					CHECK(std::abs(output[1]) < 0.0001f);
+
+					mixer->Render(output.data(), mixer->GetSampleRate() / 20);
+					CHECK(sound.GetStatus() == Nz::SoundStatus_Stopped);
+				}
+
+				AND_THEN("The listener can be read back")
+				{
+					Nz::Audio::SetListenerPosition(1.f, 2.f, 3.f);
+					Nz::Audio::SetListenerDirection(Nz::Vector3f::Left());
+
+					CHECK(Nz::Audio::GetListenerPosition() == Nz::Vector3f(1.f, 2.f, 3.f));
+					CHECK(Nz::Audio::GetListenerDirection() == Nz::Vector3f::Left());
+					CHECK(Nz::Audio::GetGlobalVolume() == Approx(100.f));
+
+					Nz::Audio::SetListenerPosition(Nz::Vector3f::Zero());
+					Nz::Audio::SetListenerDirection(Nz::Vector3f::Forward());
+				}
+			}
+		}
+
+		Nz::Audio::Uninitialize();
+	}
+}
+
+// Not run by default, use "[.benchmark]" on the command line to measure the mixing throughput
+TEST_CASE("SoftwareMixer throughput", "[AUDIO][SOFTWAREMIXER][.benchmark]")
+{
+	const unsigned int voiceCount = 64;
+	const Nz::UInt32 frameCount = 44100;
+
+	Nz::SoftwareMixer mixer(44100);
+
+	std::vector<Nz::Int16> samples(frameCount);
+	for (std::size_t i = 0; i < samples.size(); ++i)
+		samples[i] = static_cast<Nz::Int16>(std::sin(i * 0.05f) * 20000.f);
+
+	unsigned int buffer = mixer.CreateBuffer();
+	REQUIRE(mixer.UpdateBuffer(buffer, 1, samples.data(), frameCount, 44100));
+
+	for (float pitch : {1.f, 1.3f})
+	{
+		std::vector<unsigned int> sources;
+		for (unsigned int i = 0; i < voiceCount; ++i)
+		{
+			unsigned int source = mixer.CreateSource();
+			REQUIRE(mixer.SetSourceBuffer(source, buffer));
+
+			Nz::SoftwareMixer::SourceParameters parameters;
+			parameters.looping = true;
+			parameters.pitch = pitch;
+			parameters.position.Set(std::cos(i * 0.1f) * 5.f, 0.f, std::sin(i * 0.1f) * 5.f);
+			mixer.SetSourceParameters(source, parameters);
+			mixer.PlaySource(source);
+
+			sources.push_back(source);
+		}
+
+		std::vector<float> output(1024 * Nz::SoftwareMixer::ChannelCount);
+
+		Nz::Clock clock;
+		for (Nz::UInt32 i = 0; i < frameCount; i += 1024)
+			mixer.Render(output.data(), 1024);
+
+		Nz::UInt64 elapsed = std::max<Nz::UInt64>(clock.GetMicroseconds(), 1);
+
+		// One second of audio has been mixed for each voice
+		WARN("Pitch " << pitch << ": " << voiceCount * 1000000.0 / elapsed << " voice-ms mixed per ms (" << elapsed << "us for " << voiceCount << " voices)");
+
+		for (unsigned int source : sources)
+			mixer.DestroySource(source);
+	}
+}
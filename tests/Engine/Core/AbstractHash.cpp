@@ -0,0 +1,117 @@
+#include <Nazara/Core/AbstractHash.hpp>
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/Hash/CRC32.hpp>
+#include <Nazara/Core/Hash/XXHash64.hpp>
+#include <Catch/catch.hpp>
+
+#include <algorithm>
+#include <array>
+
+namespace
+{
+	Nz::ByteArray ComputeDigest(Nz::HashType type, const Nz::ByteArray& data)
+	{
+		std::unique_ptr<Nz::AbstractHash> hash = Nz::AbstractHash::Get(type);
+		hash->Begin();
+		hash->Append(data.GetConstBuffer(), data.GetSize());
+
+		return hash->End();
+	}
+}
+
+SCENARIO("AbstractHash", "[CORE][ABSTRACTHASH]")
+{
+	GIVEN("The standard check string")
+	{
+		Nz::ByteArray data("123456789", 9);
+
+		WHEN("We compute its checksums")
+		{
+			THEN("They match the reference values")
+			{
+				CHECK(ComputeDigest(Nz::HashType_CRC32, data).ToHex() == "cbf43926");
+				CHECK(ComputeDigest(Nz::HashType_CRC32C, data).ToHex() == "e3069283");
+			}
+		}
+
+		WHEN("We use the software CRC32 with a custom polynomial")
+		{
+			Nz::HashCRC32 crc(0x1edc6f41);
+			crc.Begin();
+			crc.Append(data.GetConstBuffer(), data.GetSize());
+
+			THEN("It gives the same result as CRC32C")
+			{
+				CHECK(crc.End().ToHex() == "e3069283");
+			}
+		}
+	}
+
+	GIVEN("Some strings")
+	{
+		THEN("xxHash64 matches the reference values")
+		{
+			CHECK(Nz::HashXXHash64::Hash("", 0) == 0xEF46DB3751D8E999ULL);
+			CHECK(Nz::HashXXHash64::Hash("abc", 3) == 0x44BC2CF5AD770999ULL);
+			CHECK(ComputeDigest(Nz::HashType_XXHash64, Nz::ByteArray("abc", 3)).ToHex() == "44bc2cf5ad770999");
+		}
+
+		WHEN("A string is longer than a stripe of 32 bytes")
+		{
+			const char text[] = "Nobody inspects the spammish repetition";
+			const std::size_t length = sizeof(text) - 1;
+
+			THEN("xxHash64 matches the reference value")
+			{
+				CHECK(Nz::HashXXHash64::Hash(text, length) == 0xFBCEA83C8A378BF1ULL);
+				CHECK(ComputeDigest(Nz::HashType_XXHash64, Nz::ByteArray(text, length)).ToHex() == "fbcea83c8a378bf1");
+			}
+
+			AND_THEN("Appending it in parts gives the same value")
+			{
+				// The first part doesn't fill a stripe, the second one completes it and starts the next one
+				Nz::HashXXHash64 hash;
+				hash.Begin();
+				hash.Append(reinterpret_cast<const Nz::UInt8*>(text), 5);
+				hash.Append(reinterpret_cast<const Nz::UInt8*>(text) + 5, 30);
+				hash.Append(reinterpret_cast<const Nz::UInt8*>(text) + 35, length - 35);
+
+				CHECK(hash.End().ToHex() == "fbcea83c8a378bf1");
+			}
+		}
+	}
+
+	GIVEN("A buffer bigger than the internal blocks")
+	{
+		std::array<Nz::UInt8, 1000> buffer;
+		for (std::size_t i = 0; i < buffer.size(); ++i)
+			buffer[i] = static_cast<Nz::UInt8>(i * 31 + 7);
+
+		Nz::ByteArray data(buffer.data(), buffer.size());
+
+		WHEN("We hash it in multiple unaligned chunks")
+		{
+			THEN("The result is the same as a single append")
+			{
+				for (Nz::HashType type : {Nz::HashType_CRC32, Nz::HashType_CRC32C, Nz::HashType_XXHash64})
+				{
+					std::unique_ptr<Nz::AbstractHash> hash = Nz::AbstractHash::Get(type);
+					hash->Begin();
+
+					std::size_t offset = 0;
+					std::size_t chunkSize = 1;
+					while (offset < buffer.size())
+					{
+						std::size_t size = std::min(chunkSize, buffer.size() - offset);
+						hash->Append(&buffer[offset], size);
+
+						offset += size;
+						chunkSize += 7;
+					}
+
+					CHECK(hash->End() == ComputeDigest(type, data));
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,240 @@
+#include <Nazara/Core/Bitset.hpp>
+#include <Nazara/Core/Clock.hpp>
+#include <Catch/catch.hpp>
+
+#include <random>
+#include <vector>
+
+namespace
+{
+	template<typename Block>
+	std::vector<unsigned int> GetSetBits(const Nz::Bitset<Block>& bitset)
+	{
+		std::vector<unsigned int> bits;
+		for (unsigned int i = bitset.FindFirst(); i != bitset.npos; i = bitset.FindNext(i))
+			bits.push_back(i);
+
+		return bits;
+	}
+
+	template<typename Block>
+	std::vector<unsigned int> GetSetBitsFromCallback(const Nz::Bitset<Block>& bitset)
+	{
+		std::vector<unsigned int> bits;
+		bitset.ForEachSetBit([&bits](unsigned int bit)
+		{
+			bits.push_back(bit);
+		});
+
+		return bits;
+	}
+
+	template<typename Block>
+	Nz::Bitset<Block> MakeBitset(unsigned int bitCount, const std::vector<unsigned int>& setBits)
+	{
+		Nz::Bitset<Block> bitset(bitCount);
+		for (unsigned int bit : setBits)
+			bitset.Set(bit);
+
+		return bitset;
+	}
+
+	template<typename Block>
+	void CheckScanning()
+	{
+		// Bits around the 32th one and at the edges of the blocks
+		std::vector<unsigned int> setBits = {0, 7, 8, 31, 32, 33, 63, 64, 100, 127, 128, 199};
+		Nz::Bitset<Block> bitset = MakeBitset<Block>(200, setBits);
+
+		CHECK(bitset.Count() == setBits.size());
+		CHECK(GetSetBits(bitset) == setBits);
+		CHECK(GetSetBitsFromCallback(bitset) == setBits);
+
+		CHECK(bitset.FindNext(31) == 32);
+		CHECK(bitset.FindNext(33) == 63);
+		CHECK(bitset.FindNext(128) == 199);
+		CHECK(bitset.FindNext(199) == bitset.npos);
+
+		Nz::Bitset<Block> emptyBitset(200);
+		CHECK(emptyBitset.FindFirst() == emptyBitset.npos);
+		CHECK(GetSetBitsFromCallback(emptyBitset).empty());
+	}
+
+	template<typename Block>
+	void CheckOperations()
+	{
+		// Operands of different sizes, for the blocks past the smallest one
+		Nz::Bitset<Block> a = MakeBitset<Block>(300, {1, 32, 64, 150, 299});
+		Nz::Bitset<Block> b = MakeBitset<Block>(160, {1, 33, 64, 159});
+
+		CHECK(GetSetBits(a & b) == std::vector<unsigned int>({1, 64}));
+		CHECK(GetSetBits(a | b) == std::vector<unsigned int>({1, 32, 33, 64, 150, 159, 299}));
+		CHECK(GetSetBits(a ^ b) == std::vector<unsigned int>({32, 33, 150, 159, 299}));
+
+		Nz::Bitset<Block> result;
+		result.PerformsANDNOT(a, b);
+		CHECK(GetSetBits(result) == std::vector<unsigned int>({32, 150, 299}));
+
+		result.PerformsANDNOT(b, a);
+		CHECK(GetSetBits(result) == std::vector<unsigned int>({33, 159}));
+		CHECK(result.GetSize() == 300);
+
+		// In-place operations
+		result = a;
+		result &= b;
+		CHECK(GetSetBits(result) == std::vector<unsigned int>({1, 64}));
+
+		result = b;
+		result.PerformsANDNOT(result, a);
+		CHECK(GetSetBits(result) == std::vector<unsigned int>({33, 159}));
+
+		result = b;
+		result |= a;
+		CHECK(result == (a | b));
+
+		CHECK(a.Intersects(b));
+		CHECK(b.Intersects(a));
+		CHECK_FALSE((a ^ b).Intersects(a & b));
+		CHECK(MakeBitset<Block>(300, {299}).Intersects(a));
+		CHECK_FALSE(MakeBitset<Block>(300, {299}).Intersects(b));
+	}
+}
+
+SCENARIO("Bitset", "[CORE][BITSET]")
+{
+	GIVEN("Bitsets of various block types")
+	{
+		WHEN("We scan their set bits")
+		{
+			THEN("FindFirst/FindNext and ForEachSetBit return every bit in order")
+			{
+				CheckScanning<Nz::UInt8>();
+				CheckScanning<Nz::UInt32>();
+				CheckScanning<Nz::UInt64>();
+			}
+		}
+
+		WHEN("We combine them")
+		{
+			THEN("The bitwise operations are applied to every block")
+			{
+				CheckOperations<Nz::UInt8>();
+				CheckOperations<Nz::UInt32>();
+				CheckOperations<Nz::UInt64>();
+			}
+		}
+	}
+
+	GIVEN("A bitset being filled during the iteration")
+	{
+		Nz::Bitset<Nz::UInt64> bitset = MakeBitset<Nz::UInt64>(128, {2, 70});
+
+		WHEN("The callback sets other bits")
+		{
+			std::vector<unsigned int> bits;
+			bitset.ForEachSetBit([&](unsigned int bit)
+			{
+				bits.push_back(bit);
+				if (bit == 2)
+				{
+					bitset.Set(1U);  // Already visited
+					bitset.Set(40U); // Following bit in the same block
+					bitset.Set(100U);
+				}
+			});
+
+			THEN("The following bits are visited, as with FindNext")
+			{
+				CHECK(bits == std::vector<unsigned int>({2, 40, 70, 100}));
+			}
+		}
+	}
+
+	GIVEN("A bitset with all its bits set")
+	{
+		WHEN("Its size is a multiple of the block size")
+		{
+			Nz::Bitset<Nz::UInt32> bitset(64, true);
+
+			THEN("TestAll is true until one bit is reset")
+			{
+				CHECK(bitset.TestAll());
+				bitset.Reset(63);
+				CHECK_FALSE(bitset.TestAll());
+			}
+		}
+
+		WHEN("Its last block is incomplete")
+		{
+			Nz::Bitset<Nz::UInt32> bitset(70, true);
+
+			THEN("TestAll is true until one bit is reset")
+			{
+				CHECK(bitset.TestAll());
+				bitset.Reset(3);
+				CHECK_FALSE(bitset.TestAll());
+			}
+		}
+	}
+}
+
+// Not run by default, use "[.benchmark]" or "[BITSET]" on the command line to compare the scanning methods
+TEST_CASE("Bitset throughput", "[CORE][BITSET][.benchmark]")
+{
+	const unsigned int bitCount = 1000000;
+	const unsigned int iterationCount = 100;
+
+	std::mt19937 generator(42);
+	std::bernoulli_distribution distribution(0.05);
+
+	Nz::Bitset<Nz::UInt64> a(bitCount);
+	Nz::Bitset<Nz::UInt64> b(bitCount);
+	for (unsigned int i = 0; i < bitCount; ++i)
+	{
+		a.Set(i, distribution(generator));
+		b.Set(i, distribution(generator));
+	}
+
+	Nz::UInt64 sum = 0;
+
+	Nz::Clock clock;
+	for (unsigned int i = 0; i < iterationCount; ++i)
+	{
+		for (unsigned int bit = a.FindFirst(); bit != a.npos; bit = a.FindNext(bit))
+			sum += bit;
+	}
+	Nz::UInt64 findNextElapsed = clock.GetMicroseconds() / iterationCount;
+
+	Nz::UInt64 callbackSum = 0;
+
+	clock.Restart();
+	for (unsigned int i = 0; i < iterationCount; ++i)
+		a.ForEachSetBit([&callbackSum](unsigned int bit) { callbackSum += bit; });
+
+	Nz::UInt64 forEachElapsed = clock.GetMicroseconds() / iterationCount;
+
+	unsigned int count = 0;
+
+	clock.Restart();
+	for (unsigned int i = 0; i < iterationCount; ++i)
+		count += a.Count();
+
+	Nz::UInt64 countElapsed = clock.GetMicroseconds() / iterationCount;
+
+	Nz::Bitset<Nz::UInt64> result;
+
+	clock.Restart();
+	for (unsigned int i = 0; i < iterationCount; ++i)
+	{
+		result.PerformsAND(a, b);
+		result.PerformsOR(result, a);
+		result.PerformsANDNOT(result, b);
+	}
+	Nz::UInt64 operationElapsed = clock.GetMicroseconds() / iterationCount;
+
+	CHECK(sum == callbackSum);
+
+	WARN(bitCount << " bits, " << count / iterationCount << " set");
+	WARN("Scanning: " << findNextElapsed << "us (FindNext) / " << forEachElapsed << "us (ForEachSetBit)");
+	WARN("Count: " << countElapsed << "us, AND+OR+ANDNOT: " << operationElapsed << "us");
+}
@@ -0,0 +1,215 @@
+#include <Nazara/Core/FrameAllocator.hpp>
+#include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/Thread.hpp>
+#include <Catch/catch.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+SCENARIO("FrameAllocator", "[CORE][FRAMEALLOCATOR]")
+{
+	GIVEN("A frame allocator with 1 KiB regions")
+	{
+		Nz::FrameAllocator allocator(1024);
+
+		CHECK(allocator.GetRegionSize() == 1024);
+		CHECK(allocator.GetCapacity() == 0);
+
+		WHEN("We allocate a few blocks")
+		{
+			void* first = allocator.Allocate(10);
+			void* second = allocator.Allocate(32, 32);
+			double* third = allocator.New<double>(42.0);
+
+			THEN("They are aligned, distinct and counted")
+			{
+				CHECK(reinterpret_cast<std::uintptr_t>(first) % alignof(std::max_align_t) == 0);
+				CHECK(reinterpret_cast<std::uintptr_t>(second) % 32 == 0);
+				CHECK(static_cast<Nz::UInt8*>(second) >= static_cast<Nz::UInt8*>(first) + 10);
+				CHECK(*third == 42.0);
+
+				CHECK(allocator.GetAllocationCount() == 3);
+				CHECK(allocator.GetAllocatedSize() == 10 + 32 + sizeof(double));
+				CHECK(allocator.GetHeapAllocationCount() == 1);
+			}
+
+			AND_WHEN("We reset it")
+			{
+				allocator.Reset();
+
+				THEN("The memory is given again")
+				{
+					CHECK(allocator.GetAllocationCount() == 0);
+					CHECK(allocator.Allocate(10) == first);
+					CHECK(allocator.GetHeapAllocationCount() == 1);
+				}
+			}
+		}
+
+		WHEN("A frame needs more than a region")
+		{
+			for (unsigned int i = 0; i < 100; ++i)
+				std::memset(allocator.Allocate(100), 0xFF, 100);
+
+			Nz::UInt64 heapAllocations = allocator.GetHeapAllocationCount();
+			CHECK(heapAllocations > 1);
+
+			THEN("Next frames of the same size only need a single region")
+			{
+				allocator.Reset();
+				for (unsigned int i = 0; i < 100; ++i)
+					allocator.Allocate(100);
+
+				CHECK(allocator.GetHeapAllocationCount() == heapAllocations + 1);
+				CHECK(allocator.GetCapacity() >= 100 * 100);
+
+				for (unsigned int frame = 0; frame < 10; ++frame)
+				{
+					allocator.Reset();
+					for (unsigned int i = 0; i < 100; ++i)
+						allocator.Allocate(100);
+				}
+
+				CHECK(allocator.GetHeapAllocationCount() == heapAllocations + 1);
+			}
+		}
+
+		WHEN("We allocate a block bigger than a region")
+		{
+			void* big = allocator.Allocate(10000);
+			std::memset(big, 0, 10000);
+
+			THEN("It gets its own region")
+			{
+				CHECK(allocator.GetCapacity() >= 10000);
+			}
+		}
+
+		WHEN("We release it")
+		{
+			allocator.Allocate(100);
+			allocator.Release();
+
+			THEN("It owns no memory anymore")
+			{
+				CHECK(allocator.GetCapacity() == 0);
+				CHECK(allocator.GetAllocationCount() == 0);
+			}
+		}
+	}
+
+	GIVEN("Several threads allocating from the same frame allocator")
+	{
+		Nz::FrameAllocator allocator(4096);
+		std::vector<std::vector<int*>> threadBlocks(4);
+
+		std::vector<Nz::Thread> threads;
+		for (unsigned int t = 0; t < threadBlocks.size(); ++t)
+		{
+			threads.emplace_back([&allocator, &threadBlocks, t]()
+			{
+				for (int i = 0; i < 10000; ++i)
+				{
+					int* value = allocator.New<int>(static_cast<int>(t * 100000) + i);
+					threadBlocks[t].push_back(value);
+				}
+			});
+		}
+
+		for (Nz::Thread& thread : threads)
+			thread.Join();
+
+		THEN("No allocation overlaps")
+		{
+			CHECK(allocator.GetAllocationCount() == 40000);
+
+			bool intact = true;
+			for (unsigned int t = 0; t < threadBlocks.size(); ++t)
+			{
+				for (int i = 0; i < 10000; ++i)
+					intact &= (*threadBlocks[t][i] == static_cast<int>(t * 100000) + i);
+			}
+			CHECK(intact);
+		}
+	}
+
+	GIVEN("A vector using the STL adaptor")
+	{
+		Nz::FrameAllocator allocator;
+
+		WHEN("We fill it for a few frames")
+		{
+			Nz::UInt64 heapAllocations = 0;
+			for (unsigned int frame = 0; frame < 5; ++frame)
+			{
+				allocator.Reset();
+
+				Nz::FrameVector<int> values{Nz::FrameAllocatorAdaptor<int>(allocator)};
+				for (int i = 0; i < 1000; ++i)
+					values.push_back(i);
+
+				CHECK(values[999] == 999);
+
+				if (frame == 1)
+					heapAllocations = allocator.GetHeapAllocationCount();
+			}
+
+			THEN("The heap is not touched anymore after the first frames")
+			{
+				CHECK(allocator.GetHeapAllocationCount() == heapAllocations);
+			}
+		}
+
+		WHEN("The adaptor is default constructed")
+		{
+			Nz::FrameVector<int> values;
+			values.assign(100, 7);
+
+			THEN("It uses the global allocator")
+			{
+				CHECK(values.get_allocator().GetAllocator() == nullptr);
+				CHECK(values.back() == 7);
+				CHECK(allocator.GetAllocationCount() == 0);
+			}
+		}
+	}
+}
+
+// Not run by default, use "[.benchmark]" or "[FRAMEALLOCATOR]" on the command line to compare rebuilding per-frame containers
+TEST_CASE("FrameAllocator throughput", "[CORE][FRAMEALLOCATOR][.benchmark]")
+{
+	const unsigned int frameCount = 1000;
+	const unsigned int containerCount = 100;
+	const unsigned int elementCount = 100;
+
+	Nz::Clock clock;
+	for (unsigned int frame = 0; frame < frameCount; ++frame)
+	{
+		for (unsigned int c = 0; c < containerCount; ++c)
+		{
+			std::vector<Nz::UInt64> values;
+			for (unsigned int i = 0; i < elementCount; ++i)
+				values.push_back(i);
+		}
+	}
+	Nz::UInt64 heapElapsed = clock.GetMicroseconds();
+
+	Nz::FrameAllocator allocator;
+
+	clock.Restart();
+	for (unsigned int frame = 0; frame < frameCount; ++frame)
+	{
+		allocator.Reset();
+		for (unsigned int c = 0; c < containerCount; ++c)
+		{
+			Nz::FrameVector<Nz::UInt64> values{Nz::FrameAllocatorAdaptor<Nz::UInt64>(allocator)};
+			for (unsigned int i = 0; i < elementCount; ++i)
+				values.push_back(i);
+		}
+	}
+	Nz::UInt64 frameElapsed = clock.GetMicroseconds();
+
+	WARN("std::vector: " << heapElapsed / frameCount << "us/frame");
+	WARN("FrameVector: " << frameElapsed / frameCount << "us/frame, " << allocator.GetHeapAllocationCount() << " heap allocations for " << frameCount << " frames");
+}
@@ -0,0 +1,356 @@
+#include <Nazara/Core/MemoryPool.hpp>
+#include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/ObjectPool.hpp>
+#include <Nazara/Core/PoolAllocator.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Nazara/Core/Thread.hpp>
+#include <Catch/catch.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <list>
+#include <set>
+#include <vector>
+
+namespace
+{
+	struct Tracked
+	{
+		Tracked(int v, int* counter) :
+		value(v),
+		liveCounter(counter)
+		{
+			(*liveCounter)++;
+		}
+
+		~Tracked()
+		{
+			(*liveCounter)--;
+		}
+
+		int value;
+		int* liveCounter;
+	};
+}
+
+SCENARIO("MemoryPool", "[CORE][MEMORYPOOL]")
+{
+	GIVEN("A pool of 16 bytes blocks, 64 blocks per chunk")
+	{
+		Nz::MemoryPool pool(16, 64);
+
+		CHECK(pool.GetBlockSize() == 16);
+		CHECK(pool.GetSize() == 64);
+		CHECK(pool.GetChunkCount() == 1);
+		CHECK(pool.GetFreeBlocks() == 64);
+
+		WHEN("We allocate more blocks than a chunk holds")
+		{
+			std::vector<void*> blocks;
+			for (unsigned int i = 0; i < 1000; ++i)
+			{
+				void* block = pool.Allocate(16);
+				std::memset(block, static_cast<int>(i & 0xFF), 16);
+				blocks.push_back(block);
+			}
+
+			THEN("Every block is distinct and the pool grew")
+			{
+				std::vector<void*> sorted(blocks);
+				std::sort(sorted.begin(), sorted.end());
+				CHECK(std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end());
+
+				CHECK(pool.GetChunkCount() >= 1000 / 64);
+
+				bool intact = true;
+				for (unsigned int i = 0; i < blocks.size(); ++i)
+				{
+					const Nz::UInt8* bytes = static_cast<const Nz::UInt8*>(blocks[i]);
+					intact &= (bytes[0] == (i & 0xFF) && bytes[15] == (i & 0xFF));
+				}
+				CHECK(intact);
+			}
+
+			AND_WHEN("We free them and trim the pool")
+			{
+				for (void* block : blocks)
+					pool.Free(block);
+
+				pool.Trim();
+
+				THEN("Only a spare chunk is kept")
+				{
+					CHECK(pool.GetChunkCount() == 1);
+					CHECK(pool.GetFreeBlocks() == 64);
+				}
+			}
+		}
+
+		WHEN("We free a block and allocate again")
+		{
+			void* block = pool.Allocate(8);
+			pool.Free(block);
+
+			THEN("The same block is given back")
+			{
+				void* sameBlock = pool.Allocate(8);
+				CHECK(sameBlock == block);
+				pool.Free(sameBlock);
+			}
+		}
+
+		WHEN("We ask for a block bigger than the block size")
+		{
+			void* big = pool.Allocate(100);
+			std::memset(big, 0xAB, 100);
+
+			THEN("It is allocated outside of the pool and can be freed")
+			{
+				CHECK(pool.GetFreeBlocks() == 64);
+				pool.Free(big);
+			}
+		}
+	}
+
+	GIVEN("A pool which cannot grow")
+	{
+		Nz::MemoryPool pool(32, 4, false);
+
+		WHEN("We allocate more blocks than it has")
+		{
+			std::vector<void*> blocks;
+			for (unsigned int i = 0; i < 10; ++i)
+				blocks.push_back(pool.Allocate(32));
+
+			THEN("The extra blocks are allocated outside of the pool")
+			{
+				CHECK(pool.GetChunkCount() == 1);
+				CHECK(pool.GetFreeBlocks() == 0);
+
+				for (void* block : blocks)
+					pool.Free(block);
+
+				CHECK(pool.GetFreeBlocks() == 4);
+			}
+		}
+	}
+
+	GIVEN("Blocks allocated by a thread")
+	{
+		Nz::MemoryPool pool(24, 128);
+
+		std::vector<void*> blocks;
+		for (unsigned int i = 0; i < 5000; ++i)
+			blocks.push_back(pool.Allocate(24));
+
+		WHEN("Another thread frees them")
+		{
+			Nz::Thread thread([&]()
+			{
+				for (void* block : blocks)
+					pool.Free(block);
+			});
+			thread.Join();
+
+			THEN("They are available again, and the chunks in excess were released")
+			{
+				CHECK(pool.GetChunkCount() < 5000 / 128);
+
+				for (unsigned int i = 0; i < 5000; ++i)
+					blocks[i] = pool.Allocate(24);
+
+				std::vector<void*> sorted(blocks);
+				std::sort(sorted.begin(), sorted.end());
+				CHECK(std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end());
+
+				for (void* block : blocks)
+					pool.Free(block);
+			}
+		}
+	}
+
+	GIVEN("Many threads sharing a pool")
+	{
+		Nz::MemoryPool pool(sizeof(unsigned int), 256);
+		std::atomic_uint corruptedBlocks(0);
+
+		WHEN("They allocate and free blocks concurrently")
+		{
+			std::vector<Nz::Thread> threads;
+			for (unsigned int t = 0; t < 4; ++t)
+			{
+				threads.emplace_back([&pool, &corruptedBlocks, t]()
+				{
+					std::vector<unsigned int*> blocks;
+					for (unsigned int round = 0; round < 50; ++round)
+					{
+						for (unsigned int i = 0; i < 500; ++i)
+						{
+							unsigned int* block = static_cast<unsigned int*>(pool.Allocate(sizeof(unsigned int)));
+							*block = t * 1000 + i;
+							blocks.push_back(block);
+						}
+
+						for (unsigned int i = 0; i < blocks.size(); ++i)
+						{
+							if (*blocks[i] != t * 1000 + i)
+								corruptedBlocks++;
+
+							pool.Free(blocks[i]);
+						}
+						blocks.clear();
+					}
+				});
+			}
+
+			for (Nz::Thread& thread : threads)
+				thread.Join();
+
+			THEN("No block was given to two threads at once")
+			{
+				CHECK(corruptedBlocks == 0);
+			}
+		}
+	}
+}
+
+SCENARIO("ObjectPool", "[CORE][MEMORYPOOL]")
+{
+	GIVEN("A pool of objects")
+	{
+		Nz::ObjectPool<Tracked> pool(16);
+		int liveCount = 0;
+
+		WHEN("We create and delete objects")
+		{
+			std::vector<Tracked*> objects;
+			for (int i = 0; i < 100; ++i)
+				objects.push_back(pool.New(i, &liveCount));
+
+			THEN("They are constructed with the arguments and destroyed")
+			{
+				CHECK(liveCount == 100);
+				CHECK(objects[42]->value == 42);
+
+				for (Tracked* object : objects)
+					pool.Delete(object);
+
+				CHECK(liveCount == 0);
+				CHECK(pool.GetFreeObjects() > 0);
+				CHECK(pool.GetChunkCount() < 100 / 16);
+			}
+		}
+	}
+}
+
+SCENARIO("PoolAllocator", "[CORE][MEMORYPOOL]")
+{
+	GIVEN("Node based containers using the pool allocator")
+	{
+		std::set<int, std::less<int>, Nz::PoolAllocator<int>> set;
+		std::list<int, Nz::PoolAllocator<int>> list;
+
+		WHEN("We fill them")
+		{
+			for (int i = 0; i < 1000; ++i)
+			{
+				set.insert(999 - i);
+				list.push_back(i);
+			}
+
+			THEN("They behave like the default ones")
+			{
+				CHECK(set.size() == 1000);
+				CHECK(*set.begin() == 0);
+				CHECK(*set.rbegin() == 999);
+				CHECK(list.front() == 0);
+				CHECK(list.back() == 999);
+
+				set.erase(500);
+				list.pop_front();
+				CHECK(set.count(500) == 0);
+				CHECK(list.size() == 999);
+			}
+		}
+	}
+}
+
+SCENARIO("TaskScheduler pooled tasks", "[CORE][MEMORYPOOL]")
+{
+	GIVEN("Many tasks of different sizes")
+	{
+		std::atomic_int sum(0);
+
+		for (int i = 0; i < 1000; ++i)
+			Nz::TaskScheduler::AddTask([&sum, i]() { sum += i; });
+
+		// Captures bigger than a block of the task pool
+		std::array<int, 32> values;
+		values.fill(1);
+		for (int i = 0; i < 10; ++i)
+			Nz::TaskScheduler::AddTask([&sum, values]() { sum += values[31]; });
+
+		WHEN("We run them")
+		{
+			Nz::TaskScheduler::Run();
+			Nz::TaskScheduler::WaitForTasks();
+
+			THEN("Every task ran once")
+			{
+				CHECK(sum == 999 * 1000 / 2 + 10);
+			}
+		}
+	}
+}
+
+// Not run by default, use "[.benchmark]" or "[MEMORYPOOL]" on the command line to compare the pool to the global allocator
+TEST_CASE("MemoryPool throughput", "[CORE][MEMORYPOOL][.benchmark]")
+{
+	const unsigned int blockCount = 1000;
+	const unsigned int roundCount = 2000;
+	const unsigned int threadCount = 4;
+
+	Nz::MemoryPool pool(48, 1024);
+
+	auto Run = [&](bool usePool)
+	{
+		std::vector<void*> blocks(blockCount);
+		for (unsigned int round = 0; round < roundCount; ++round)
+		{
+			for (unsigned int i = 0; i < blockCount; ++i)
+				blocks[i] = (usePool) ? pool.Allocate(48) : ::operator new(48);
+
+			for (unsigned int i = 0; i < blockCount; ++i)
+			{
+				if (usePool)
+					pool.Free(blocks[i]);
+				else
+					::operator delete(blocks[i]);
+			}
+		}
+	};
+
+	for (bool usePool : {false, true})
+	{
+		const char* name = (usePool) ? "MemoryPool" : "new/delete";
+
+		Nz::Clock clock;
+		Run(usePool);
+		Nz::UInt64 elapsed = clock.GetMicroseconds();
+
+		WARN(name << " (1 thread): " << (blockCount * roundCount * 1000ULL) / std::max<Nz::UInt64>(elapsed, 1) << " allocations/ms");
+
+		clock.Restart();
+		std::vector<Nz::Thread> threads;
+		for (unsigned int t = 0; t < threadCount; ++t)
+			threads.emplace_back(Run, usePool);
+
+		for (Nz::Thread& thread : threads)
+			thread.Join();
+
+		elapsed = clock.GetMicroseconds();
+
+		WARN(name << " (" << threadCount << " threads): " << (threadCount * blockCount * roundCount * 1000ULL) / std::max<Nz::UInt64>(elapsed, 1) << " allocations/ms");
+	}
+}
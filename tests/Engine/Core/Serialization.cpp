@@ -0,0 +1,173 @@
+#include <Nazara/Core/Algorithm.hpp>
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/MemoryStream.hpp>
+#include <Nazara/Core/MemoryWriter.hpp>
+#include <Catch/catch.hpp>
+
+#include <array>
+
+SCENARIO("Serialization", "[CORE][SERIALIZATION]")
+{
+	GIVEN("A context writing to a memory stream")
+	{
+		Nz::ByteArray byteArray;
+		Nz::MemoryStream stream(&byteArray);
+
+		Nz::SerializationContext context;
+		context.stream = &stream;
+
+		WHEN("We serialize an array of integers")
+		{
+			std::array<Nz::UInt32, 1000> values;
+			for (std::size_t i = 0; i < values.size(); ++i)
+				values[i] = static_cast<Nz::UInt32>(i * 0x01020304);
+
+			REQUIRE(Nz::Serialize(context, values.data(), values.size()));
+
+			THEN("It matches the value by value serialization")
+			{
+				Nz::ByteArray expected;
+				Nz::MemoryStream expectedStream(&expected);
+
+				Nz::SerializationContext expectedContext;
+				expectedContext.stream = &expectedStream;
+
+				for (Nz::UInt32 value : values)
+					Nz::Serialize(expectedContext, value);
+
+				REQUIRE(byteArray == expected);
+			}
+
+			AND_THEN("We can unserialize it")
+			{
+				stream.SetCursorPos(0);
+
+				std::array<Nz::UInt32, 1000> readValues;
+				REQUIRE(Nz::Unserialize(context, readValues.data(), readValues.size()));
+				CHECK(readValues == values);
+			}
+		}
+
+		WHEN("We serialize variable-length integers")
+		{
+			REQUIRE(Nz::SerializeVarInt(context, Nz::UInt32(42)));
+			REQUIRE(Nz::SerializeVarInt(context, Nz::UInt64(0xFFFFFFFFFFFFFFFFULL)));
+			REQUIRE(Nz::SerializeVarInt(context, Nz::Int32(-3)));
+			REQUIRE(Nz::SerializeVarInt(context, Nz::Int64(-9000000000LL)));
+
+			THEN("Small values take few bytes and are read back")
+			{
+				CHECK(byteArray[0] == 42);
+				CHECK(byteArray.GetSize() == 1 + 10 + 1 + 5);
+
+				stream.SetCursorPos(0);
+
+				Nz::UInt32 smallValue;
+				Nz::UInt64 bigValue;
+				Nz::Int32 negativeValue;
+				Nz::Int64 bigNegativeValue;
+				REQUIRE(Nz::UnserializeVarInt(context, &smallValue));
+				REQUIRE(Nz::UnserializeVarInt(context, &bigValue));
+				REQUIRE(Nz::UnserializeVarInt(context, &negativeValue));
+				REQUIRE(Nz::UnserializeVarInt(context, &bigNegativeValue));
+
+				CHECK(smallValue == 42);
+				CHECK(bigValue == 0xFFFFFFFFFFFFFFFFULL);
+				CHECK(negativeValue == -3);
+				CHECK(bigNegativeValue == -9000000000LL);
+			}
+
+			AND_THEN("Values too big for the destination type are refused")
+			{
+				stream.SetCursorPos(1);
+
+				Nz::UInt8 value;
+				CHECK_FALSE(Nz::UnserializeVarInt(context, &value));
+			}
+		}
+
+		WHEN("We pack bits and quantized floats")
+		{
+			REQUIRE(Nz::Serialize(context, true));
+			REQUIRE(Nz::SerializeBits(context, 5, 3));
+			REQUIRE(Nz::SerializeQuantized(context, 0.25f, -1.f, 1.f, 10));
+			REQUIRE(Nz::SerializeBits(context, 0x123456789ULL, 36));
+			REQUIRE(Nz::Serialize<Nz::UInt8>(context, 7));
+
+			THEN("They take as few bytes as possible and are read back")
+			{
+				CHECK(byteArray.GetSize() == 8); // 1 + 3 + 10 + 36 bits => 50 bits => 7 bytes, then one byte
+
+				stream.SetCursorPos(0);
+
+				bool flag;
+				Nz::UInt64 smallValue;
+				float quantized;
+				Nz::UInt64 bigValue;
+				Nz::UInt8 byte;
+				REQUIRE(Nz::Unserialize(context, &flag));
+				REQUIRE(Nz::UnserializeBits(context, &smallValue, 3));
+				REQUIRE(Nz::UnserializeQuantized(context, &quantized, -1.f, 1.f, 10));
+				REQUIRE(Nz::UnserializeBits(context, &bigValue, 36));
+				REQUIRE(Nz::Unserialize(context, &byte));
+
+				CHECK(flag);
+				CHECK(smallValue == 5);
+				CHECK(quantized == Approx(0.25f).epsilon(1.f / 1023.f));
+				CHECK(bigValue == 0x123456789ULL);
+				CHECK(byte == 7);
+			}
+		}
+	}
+
+	GIVEN("A memory writer")
+	{
+		std::array<Nz::UInt8, 64> buffer;
+		Nz::MemoryWriter writer(buffer.data(), buffer.size());
+
+		WHEN("We write the same values than with a serialization context")
+		{
+			const float floats[] = {1.f, -2.5f, 42.f};
+
+			writer << Nz::UInt16(0xBEEF) << true << false << Nz::Int32(-1);
+			writer.Write(floats, 3);
+			writer.WriteVarInt(Nz::Int16(-300));
+			writer.WriteBits(3, 2);
+			writer.FlushBits();
+
+			Nz::ByteArray expected;
+			Nz::MemoryStream expectedStream(&expected);
+
+			Nz::SerializationContext context;
+			context.stream = &expectedStream;
+
+			Nz::Serialize(context, Nz::UInt16(0xBEEF));
+			Nz::Serialize(context, true);
+			Nz::Serialize(context, false);
+			Nz::Serialize(context, Nz::Int32(-1));
+			Nz::Serialize(context, floats, 3);
+			Nz::SerializeVarInt(context, Nz::Int16(-300));
+			Nz::SerializeBits(context, 3, 2);
+			context.currentBitPos = 8; //< Flush bits
+			Nz::Serialize<Nz::UInt8>(context, context.currentByte);
+
+			THEN("The output is the same")
+			{
+				REQUIRE(writer.GetCursorPos() == expected.GetSize());
+				CHECK(Nz::ByteArray(buffer.data(), writer.GetCursorPos()) == expected);
+			}
+		}
+
+		WHEN("We write past the end of the buffer")
+		{
+			std::array<Nz::UInt64, 9> values = {};
+
+			THEN("It fails")
+			{
+				CHECK_FALSE(writer.Write(values.data(), values.size()));
+				CHECK(writer.HasOverflowed());
+				CHECK(writer.GetCursorPos() == 0);
+			}
+		}
+	}
+}
@@ -1,6 +1,8 @@
 #include <Nazara/Core/String.hpp>
 #include <Catch/catch.hpp>
 
+#include <cstring>
+
 SCENARIO("String", "[CORE][STRING]")
 {
 	GIVEN("One string 'a'")
@@ -82,6 +84,74 @@ SCENARIO("String", "[CORE][STRING]")
 		}
 	}
 
+	GIVEN("A short and a long string")
+	{
+		Nz::String shortString("Short");
+		Nz::String longString("A string too long to be stored inline");
+
+		WHEN("We copy and modify them")
+		{
+			Nz::String shortCopy(shortString);
+			Nz::String longCopy(longString);
+
+			shortCopy[0] = 's';
+			longCopy[0] = 'a';
+
+			THEN("The originals are untouched")
+			{
+				CHECK(shortString == "Short");
+				CHECK(shortCopy == "short");
+				CHECK(longString == "A string too long to be stored inline");
+				CHECK(longCopy == "a string too long to be stored inline");
+			}
+		}
+
+		WHEN("We swap and move them")
+		{
+			shortString.Swap(longString);
+
+			Nz::String moved(std::move(shortString));
+			Nz::String movedShort;
+			movedShort = std::move(longString);
+
+			THEN("The content follows")
+			{
+				CHECK(moved == "A string too long to be stored inline");
+				CHECK(movedShort == "Short");
+				CHECK(shortString.IsEmpty());
+				CHECK(longString.IsEmpty());
+			}
+		}
+
+		WHEN("We grow a short string past the inline capacity")
+		{
+			Nz::String copy(shortString);
+			for (unsigned int i = 0; i < 100; ++i)
+				shortString += 'x';
+
+			THEN("It keeps its content and the copy is untouched")
+			{
+				CHECK(shortString.GetSize() == 105);
+				CHECK(shortString.StartsWith("Shortxxx"));
+				CHECK(shortString.GetCapacity() >= 105);
+				CHECK(copy == "Short");
+			}
+		}
+
+		WHEN("We reserve and clear")
+		{
+			shortString.Reserve(64);
+			shortString.Clear(true);
+
+			THEN("The buffer is kept")
+			{
+				CHECK(shortString.IsEmpty());
+				CHECK(shortString.GetCapacity() >= 64);
+				CHECK(std::strlen(shortString.GetConstBuffer()) == 0);
+			}
+		}
+	}
+
 	/* TODO
 	GIVEN("One unicode string")
 	{
@@ -0,0 +1,119 @@
+#include <Nazara/Core/StringId.hpp>
+#include <Nazara/Core/ParameterList.hpp>
+#include <Catch/catch.hpp>
+
+SCENARIO("StringId", "[CORE][STRINGID]")
+{
+	GIVEN("Two identifiers built from the same name")
+	{
+		Nz::StringId first("StringIdTest_Name");
+		Nz::StringId second(Nz::String("StringIdTest_Name"));
+
+		THEN("They share the same entry")
+		{
+			CHECK(first == second);
+			CHECK(first.GetHash() == second.GetHash());
+			CHECK(&first.GetString() == &second.GetString());
+			CHECK(first.GetString() == "StringIdTest_Name");
+			CHECK(first.GetHash() == std::hash<Nz::String>()("StringIdTest_Name"));
+		}
+
+		AND_THEN("They differ from another name")
+		{
+			Nz::StringId other("StringIdTest_Other");
+			CHECK(first != other);
+			CHECK_FALSE(other.IsEmpty());
+		}
+	}
+
+	GIVEN("An empty identifier")
+	{
+		Nz::StringId empty;
+
+		THEN("It matches the empty string")
+		{
+			CHECK(empty.IsEmpty());
+			CHECK(empty.GetString().IsEmpty());
+			CHECK(empty == Nz::StringId(""));
+		}
+	}
+
+	GIVEN("A name which was never interned")
+	{
+		WHEN("We look for it")
+		{
+			Nz::StringId id;
+
+			THEN("It is not found, until we intern it")
+			{
+				CHECK_FALSE(Nz::StringId::Find("StringIdTest_Unknown", &id));
+
+				Nz::StringId interned("StringIdTest_Unknown");
+				REQUIRE(Nz::StringId::Find("StringIdTest_Unknown", &id));
+				CHECK(id == interned);
+			}
+		}
+	}
+
+	GIVEN("A parameter list")
+	{
+		Nz::ParameterList parameters;
+		Nz::StringId name("StringIdTest_Parameter");
+
+		WHEN("We set a parameter by identifier")
+		{
+			parameters.SetParameter(name, 42);
+
+			THEN("It can be read back by identifier or by string")
+			{
+				int value;
+				REQUIRE(parameters.GetIntegerParameter(name, &value));
+				CHECK(value == 42);
+
+				REQUIRE(parameters.GetIntegerParameter("StringIdTest_Parameter", &value));
+				CHECK(value == 42);
+
+				CHECK(parameters.HasParameter("StringIdTest_Parameter"));
+				CHECK_FALSE(parameters.HasParameter("StringIdTest_Missing"));
+			}
+		}
+
+		WHEN("We set a parameter by string")
+		{
+			parameters.SetParameter("StringIdTest_StringParameter", 42);
+
+			THEN("It can be read back by identifier, without the name being interned by the list")
+			{
+				Nz::StringId id;
+				CHECK_FALSE(Nz::StringId::Find("StringIdTest_StringParameter", &id));
+
+				int value;
+				REQUIRE(parameters.GetIntegerParameter(Nz::StringId("StringIdTest_StringParameter"), &value));
+				CHECK(value == 42);
+			}
+		}
+
+		WHEN("We copy the list, then replace and remove its parameters through the other kind of name")
+		{
+			parameters.SetParameter(name, 1);
+			parameters.SetParameter("StringIdTest_CopiedParameter", 2);
+
+			Nz::ParameterList copy(parameters);
+			copy.SetParameter("StringIdTest_Parameter", 3);
+			copy.RemoveParameter(Nz::StringId("StringIdTest_CopiedParameter"));
+
+			THEN("Each name still designates a single parameter")
+			{
+				int value;
+				REQUIRE(copy.GetIntegerParameter(name, &value));
+				CHECK(value == 3);
+				CHECK_FALSE(copy.HasParameter("StringIdTest_CopiedParameter"));
+
+				REQUIRE(parameters.GetIntegerParameter(name, &value));
+				CHECK(value == 1);
+				REQUIRE(parameters.GetIntegerParameter("StringIdTest_CopiedParameter", &value));
+				CHECK(value == 2);
+			}
+		}
+	}
+}
@@ -0,0 +1,82 @@
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Catch/catch.hpp>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+SCENARIO("TaskScheduler", "[CORE][TASKSCHEDULER]")
+{
+	GIVEN("A range to process in parallel")
+	{
+		const std::size_t count = 1000;
+
+		std::vector<std::atomic_int> visits(count);
+		for (std::atomic_int& visit : visits)
+			visit = 0;
+
+		std::atomic_uint taskCount(0);
+		std::atomic_bool validTaskIndices(true);
+
+		auto Process = [&](std::size_t first, std::size_t last, unsigned int taskIndex)
+		{
+			if (taskIndex >= Nz::TaskScheduler::GetWorkerCount() && taskIndex != 0)
+				validTaskIndices = false;
+
+			for (std::size_t i = first; i < last; ++i)
+				visits[i]++;
+
+			taskCount++;
+		};
+
+		WHEN("We split it between the workers")
+		{
+			Nz::TaskScheduler::ParallelFor(count, count, Process);
+
+			THEN("Every index is processed once, by at most one task per worker")
+			{
+				bool once = true;
+				for (std::atomic_int& visit : visits)
+					once &= (visit == 1);
+
+				CHECK(once);
+				CHECK(validTaskIndices);
+				CHECK(taskCount >= 1);
+				CHECK(taskCount <= std::max(Nz::TaskScheduler::GetWorkerCount(), 1U));
+			}
+		}
+
+		WHEN("We limit the number of tasks")
+		{
+			Nz::TaskScheduler::ParallelFor(count, 1, Process);
+
+			THEN("A single call processes the whole range")
+			{
+				CHECK(taskCount == 1);
+				CHECK(visits.front() == 1);
+				CHECK(visits.back() == 1);
+			}
+		}
+
+		WHEN("The range is smaller than the number of workers")
+		{
+			Nz::TaskScheduler::ParallelFor(1, count, Process);
+
+			THEN("No task gets an empty range")
+			{
+				CHECK(taskCount == 1);
+				CHECK(visits.front() == 1);
+				CHECK(visits[1] == 0);
+			}
+		}
+
+		WHEN("The range is empty")
+		{
+			Nz::TaskScheduler::ParallelFor(0, count, Process);
+
+			THEN("Nothing is called")
+			{
+				CHECK(taskCount == 0);
+			}
+		}
+	}
+}
@@ -0,0 +1,251 @@
+#include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/StringStream.hpp>
+#include <Nazara/Lua/LuaClass.hpp>
+#include <Nazara/Lua/LuaInstance.hpp>
+#include <Catch/catch.hpp>
+#include <cmath>
+
+namespace
+{
+	struct Point
+	{
+		double Length() const
+		{
+			return std::sqrt(x * x + y * y);
+		}
+
+		double x;
+		double y;
+	};
+}
+
+namespace Nz
+{
+	template<> struct LuaInlineStorage<Point> : std::true_type {};
+}
+
+namespace
+{
+	struct Counter
+	{
+		virtual ~Counter() = default;
+
+		void Add(int value)
+		{
+			count += value;
+		}
+
+		int GetCount() const
+		{
+			return count;
+		}
+
+		int count = 0;
+	};
+
+	struct NamedCounter : Counter
+	{
+		Nz::String GetName() const
+		{
+			return "named";
+		}
+	};
+
+	void RegisterCounters(Nz::LuaInstance& lua, Nz::LuaClass<Counter>& counterClass, Nz::LuaClass<NamedCounter>& namedCounterClass)
+	{
+		counterClass.SetConstructor([] (Nz::LuaInstance& /*lua*/) -> Counter*
+		{
+			return new Counter;
+		});
+		counterClass.SetMethod("Add", &Counter::Add);
+		counterClass.SetMethod("GetCount", &Counter::GetCount);
+
+		namedCounterClass.Inherit(counterClass);
+		namedCounterClass.SetConstructor([] (Nz::LuaInstance& /*lua*/) -> NamedCounter*
+		{
+			return new NamedCounter;
+		});
+		namedCounterClass.SetMethod("GetName", &NamedCounter::GetName);
+
+		counterClass.Register(lua);
+		namedCounterClass.Register(lua);
+	}
+
+	void RegisterPoint(Nz::LuaInstance& lua, Nz::LuaClass<Point>& pointClass)
+	{
+		pointClass.SetConstructor([] (Nz::LuaInstance& lua, Point* point) -> bool
+		{
+			point->x = lua.CheckNumber(1, 0.0);
+			point->y = lua.CheckNumber(2, 0.0);
+			return true;
+		});
+		pointClass.SetMethod("Length", &Point::Length);
+
+		pointClass.Register(lua);
+	}
+}
+
+SCENARIO("LuaClass", "[LUA][LUACLASS]")
+{
+	GIVEN("A Lua instance with a class and a derived class")
+	{
+		Nz::LuaInstance lua;
+		Nz::LuaClass<Counter> counterClass("Counter");
+		Nz::LuaClass<NamedCounter> namedCounterClass("NamedCounter");
+		RegisterCounters(lua, counterClass, namedCounterClass);
+
+		WHEN("We call methods on an instance")
+		{
+			REQUIRE(lua.Execute("local c = Counter() c:Add(2) c:Add(3) result = c:GetCount()"));
+
+			THEN("They are dispatched to it")
+			{
+				CHECK(lua.CheckGlobal<int>("result") == 5);
+			}
+		}
+
+		WHEN("We call inherited methods on a derived instance")
+		{
+			REQUIRE(lua.Execute("local c = NamedCounter() c:Add(4) result = c:GetCount() name = c:GetName()"));
+
+			THEN("They are dispatched to it")
+			{
+				CHECK(lua.CheckGlobal<int>("result") == 4);
+				CHECK(lua.CheckGlobal<Nz::String>("name") == "named");
+			}
+		}
+
+		WHEN("We call a method on something else than an instance")
+		{
+			THEN("It raises an error instead of crashing")
+			{
+				CHECK_FALSE(lua.Execute("local c = Counter() c.Add({}, 1)"));
+				CHECK_FALSE(lua.Execute("local c = Counter() c.Add(NamedCounter, 1)"));
+
+				// Tables given the metatable of an instance
+				CHECK_FALSE(lua.Execute("local c = Counter() setmetatable({}, getmetatable(c)):Add(1)"));
+				CHECK_FALSE(lua.Execute("local c = NamedCounter() setmetatable({}, getmetatable(c)):Add(1)"));
+			}
+		}
+	}
+}
+
+SCENARIO("LuaClass with inline storage", "[LUA][LUACLASS]")
+{
+	GIVEN("A Lua instance with a value type stored inline")
+	{
+		Nz::LuaInstance lua;
+		Nz::LuaClass<Point> pointClass("Point");
+		RegisterPoint(lua, pointClass);
+
+		WHEN("We create instances from Lua")
+		{
+			REQUIRE(lua.Execute("local p = Point(3, 4) length = p:Length()"));
+
+			THEN("Their methods work on the inline value")
+			{
+				CHECK(lua.CheckGlobal<double>("length") == Approx(5.0));
+			}
+		}
+
+		WHEN("We push an instance from C++")
+		{
+			lua.PushInstance<Point>("Point", Point{6.0, 8.0});
+			lua.SetGlobal("point");
+
+			THEN("It is stored in its userdata")
+			{
+				REQUIRE(lua.Execute("length = point:Length()"));
+				CHECK(lua.CheckGlobal<double>("length") == Approx(10.0));
+
+				lua.GetGlobal("point");
+				Point* point = static_cast<Point*>(lua.ToUserdata(-1));
+				CHECK(point->x == 6.0);
+				CHECK(point->y == 8.0);
+				lua.Pop();
+			}
+		}
+
+		WHEN("We create a lot of temporary instances")
+		{
+			REQUIRE(lua.Execute("for i = 1, 10000 do local p = Point(i, i) end collectgarbage()"));
+
+			THEN("They are collected without any finalizer")
+			{
+				CHECK(lua.Execute("sum = 0 for i = 1, 100 do sum = sum + Point(i, 0):Length() end"));
+				CHECK(lua.CheckGlobal<double>("sum") == Approx(5050.0));
+			}
+		}
+
+		WHEN("We call a method on a table given the metatable of an instance")
+		{
+			THEN("It raises an error instead of reading the table as a value")
+			{
+				CHECK_FALSE(lua.Execute("local p = Point(3, 4) setmetatable({}, getmetatable(p)):Length()"));
+			}
+		}
+	}
+}
+
+// Not run by default, use "[.benchmark]" or "[LUACLASS]" on the command line to measure the method dispatch
+TEST_CASE("LuaClass method dispatch throughput", "[LUA][LUACLASS][.benchmark]")
+{
+	Nz::LuaInstance lua;
+	Nz::LuaClass<Counter> counterClass("Counter");
+	Nz::LuaClass<NamedCounter> namedCounterClass("NamedCounter");
+	RegisterCounters(lua, counterClass, namedCounterClass);
+
+	lua.SetTimeLimit(0);
+
+	const int callCount = 1000000;
+	lua.PushInteger(callCount);
+	lua.SetGlobal("callCount");
+
+	for (const char* className : {"Counter", "NamedCounter"})
+	{
+		Nz::StringStream code;
+		code << "local c = " << className << "() for i = 1, callCount do c:Add(1) end result = c:GetCount()";
+
+		Nz::Clock clock;
+		bool succeeded = lua.Execute(code);
+		Nz::UInt64 elapsed = clock.GetMicroseconds();
+
+		INFO(lua.GetLastError());
+		REQUIRE(succeeded);
+
+		CHECK(lua.CheckGlobal<int>("result") == callCount);
+
+		WARN(className << ": " << (callCount * 1000000ULL) / std::max<Nz::UInt64>(elapsed, 1) << " calls/s");
+	}
+}
+
+TEST_CASE("LuaClass temporary instances throughput", "[LUA][LUACLASS][.benchmark]")
+{
+	Nz::LuaInstance lua;
+	Nz::LuaClass<Counter> counterClass("Counter");
+	Nz::LuaClass<NamedCounter> namedCounterClass("NamedCounter");
+	Nz::LuaClass<Point> pointClass("Point");
+	RegisterCounters(lua, counterClass, namedCounterClass);
+	RegisterPoint(lua, pointClass);
+
+	lua.SetTimeLimit(0);
+
+	const int instanceCount = 1000000;
+	lua.PushInteger(instanceCount);
+	lua.SetGlobal("instanceCount");
+
+	for (const char* className : {"Counter", "Point"})
+	{
+		Nz::StringStream code;
+		code << "for i = 1, instanceCount do local instance = " << className << "() end collectgarbage()";
+
+		Nz::Clock clock;
+		bool succeeded = lua.Execute(code);
+		Nz::UInt64 elapsed = clock.GetMicroseconds();
+
+		INFO(lua.GetLastError());
+		REQUIRE(succeeded);
+
+		WARN(className << ": " << (instanceCount * 1000000ULL) / std::max<Nz::UInt64>(elapsed, 1) << " instances/s");
+	}
+}
@@ -0,0 +1,178 @@
+#include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/Directory.hpp>
+#include <Nazara/Core/File.hpp>
+#include <Nazara/Lua/LuaInstance.hpp>
+#include <Catch/catch.hpp>
+
+namespace
+{
+	const char* s_allocatingScript = R"(
+		local objects = {}
+		for i = 1, 20000 do
+			objects[i % 1000 + 1] = { name = "object" .. i, value = i, child = { i, i * 2 } }
+		end
+		result = #objects
+		collectgarbage()
+	)";
+}
+
+SCENARIO("LuaInstance memory pools", "[LUA][LUAINSTANCE]")
+{
+	GIVEN("Two Lua instances, with and without memory pools")
+	{
+		Nz::LuaInstance pooledLua(true);
+		Nz::LuaInstance lua;
+
+		WHEN("We run the same allocating script on both")
+		{
+			REQUIRE(pooledLua.Execute(s_allocatingScript));
+			REQUIRE(lua.Execute(s_allocatingScript));
+
+			THEN("They behave and account memory the same way")
+			{
+				// Lua seeds its string hashes with addresses, collisions then change when tables are rehashed and so the GC pace
+				// The script ends with a full collection, so that the memory usage doesn't depend on where the GC cycle stopped
+				CHECK(pooledLua.CheckGlobal<int>("result") == 1000);
+				CHECK(pooledLua.GetMemoryUsage() == Approx(lua.GetMemoryUsage()).epsilon(0.01));
+				CHECK(pooledLua.GetPeakMemoryUsage() == Approx(lua.GetPeakMemoryUsage()).epsilon(0.01));
+				CHECK(pooledLua.GetPeakMemoryUsage() >= pooledLua.GetMemoryUsage());
+			}
+
+			AND_THEN("Only the pooled instance reports fragmentation")
+			{
+				CHECK(lua.GetMemoryFragmentation() == 0.f);
+				CHECK(pooledLua.GetMemoryFragmentation() > 0.f);
+				CHECK(pooledLua.GetMemoryFragmentation() < 1.f);
+			}
+		}
+
+		WHEN("We limit the memory of the pooled instance")
+		{
+			pooledLua.SetMemoryLimit(pooledLua.GetMemoryUsage() + 64 * 1024);
+
+			THEN("Scripts allocating too much memory fail")
+			{
+				CHECK_FALSE(pooledLua.Execute("local t = {} for i = 1, 100000 do t[i] = {i} end"));
+				CHECK(pooledLua.GetMemoryUsage() <= pooledLua.GetMemoryLimit());
+			}
+		}
+	}
+}
+
+SCENARIO("LuaInstance bytecode cache", "[LUA][LUAINSTANCE]")
+{
+	GIVEN("A script file and a Lua instance with a bytecode cache")
+	{
+		const Nz::String cacheDirectory = "LuaBytecodeCache";
+		const Nz::String scriptPath = "LuaBytecodeCacheTest.lua";
+
+		Nz::File script(scriptPath, Nz::OpenMode_WriteOnly | Nz::OpenMode_Truncate);
+		script.Write("value = 1 executions = (executions or 0) + 1");
+		script.Close();
+
+		Nz::LuaInstance lua;
+		lua.SetBytecodeCacheDirectory(cacheDirectory);
+
+		WHEN("We execute the script twice")
+		{
+			REQUIRE(lua.ExecuteFromFile(scriptPath));
+			REQUIRE(lua.ExecuteFromFile(scriptPath));
+
+			THEN("The compiled script is cached and behaves the same")
+			{
+				CHECK(lua.CheckGlobal<int>("value") == 1);
+				CHECK(lua.CheckGlobal<int>("executions") == 2);
+
+				Nz::Directory directory(cacheDirectory);
+				directory.SetPattern("*.luac");
+				REQUIRE(directory.Open());
+				CHECK(directory.NextResult());
+			}
+
+			AND_WHEN("The script changes")
+			{
+				script.Open(Nz::OpenMode_WriteOnly | Nz::OpenMode_Truncate);
+				script.Write("value = 2");
+				script.Close();
+
+				REQUIRE(lua.ExecuteFromFile(scriptPath));
+
+				THEN("The new version is executed")
+				{
+					CHECK(lua.CheckGlobal<int>("value") == 2);
+				}
+			}
+
+			AND_WHEN("The cache is corrupted")
+			{
+				Nz::Directory directory(cacheDirectory);
+				directory.SetPattern("*.luac");
+				REQUIRE(directory.Open());
+				while (directory.NextResult())
+				{
+					Nz::File cacheFile(directory.GetResultPath(), Nz::OpenMode_ReadWrite);
+					cacheFile.SetCursorPos(cacheFile.GetSize() / 2);
+					cacheFile.Write("garbage");
+				}
+				directory.Close();
+
+				THEN("The source is compiled again")
+				{
+					REQUIRE(lua.ExecuteFromFile(scriptPath));
+					CHECK(lua.CheckGlobal<int>("executions") == 3);
+				}
+			}
+		}
+
+		Nz::File::Delete(scriptPath);
+		Nz::Directory::Remove(cacheDirectory, true);
+	}
+}
+
+// Not run by default, use "[.benchmark]" on the command line to compare the allocators
+TEST_CASE("LuaInstance allocation throughput", "[LUA][LUAINSTANCE][.benchmark]")
+{
+	for (bool useMemoryPools : {false, true})
+	{
+		Nz::LuaInstance lua(useMemoryPools);
+		lua.SetTimeLimit(0);
+
+		Nz::Clock clock;
+		for (unsigned int i = 0; i < 20; ++i)
+			REQUIRE(lua.Execute(s_allocatingScript));
+
+		Nz::UInt64 elapsed = clock.GetMicroseconds();
+
+		WARN(((useMemoryPools) ? "Memory pools: " : "realloc: ") << elapsed / 1000 << "ms, peak memory usage: " << lua.GetPeakMemoryUsage() << " bytes, fragmentation: " << lua.GetMemoryFragmentation());
+	}
+}
+
+TEST_CASE("LuaInstance bytecode cache loading time", "[LUA][LUAINSTANCE][.benchmark]")
+{
+	const Nz::String cacheDirectory = "LuaBytecodeCache";
+	const Nz::String scriptPath = "LuaBytecodeCacheBenchmark.lua";
+
+	Nz::File script(scriptPath, Nz::OpenMode_WriteOnly | Nz::OpenMode_Truncate);
+	for (unsigned int i = 0; i < 2000; ++i)
+		script.Write("function f" + Nz::String::Number(i) + "(a, b) local t = {a, b, \"str\"} if a > b then return t[1] * 2 else return #t + b end end\n");
+	script.Close();
+
+	for (bool useCache : {false, true})
+	{
+		Nz::LuaInstance lua;
+		if (useCache)
+		{
+			lua.SetBytecodeCacheDirectory(cacheDirectory);
+			REQUIRE(lua.ExecuteFromFile(scriptPath)); //< Fill the cache
+		}
+
+		Nz::Clock clock;
+		for (unsigned int i = 0; i < 20; ++i)
+			REQUIRE(lua.ExecuteFromFile(scriptPath));
+
+		WARN(((useCache) ? "Bytecode cache: " : "Source: ") << clock.GetMicroseconds() / 20 << "us per execution");
+	}
+
+	Nz::File::Delete(scriptPath);
+	Nz::Directory::Remove(cacheDirectory, true);
+}
@@ -0,0 +1,210 @@
+#include <Nazara/Core/ErrorFlags.hpp>
+#include <Nazara/Lua/LuaInstance.hpp>
+#include <Nazara/Lua/LuaScheduler.hpp>
+#include <Catch/catch.hpp>
+
+SCENARIO("LuaScheduler", "[LUA][LUASCHEDULER]")
+{
+	GIVEN("A Lua instance with a few script functions")
+	{
+		Nz::LuaInstance lua;
+		REQUIRE(lua.Execute(R"(
+			loopCount = 0
+			stepCount = 0
+
+			function Loop()
+				while true do
+					loopCount = loopCount + 1
+				end
+			end
+
+			function Steps(count)
+				for i = 1, count do
+					stepCount = stepCount + 1
+					coroutine.yield()
+				end
+			end
+
+			function Fail()
+				error("expected failure")
+			end
+
+			function FailWithTable()
+				error({})
+			end
+
+			function KillSelf()
+				KillCurrent()
+				while true do
+					loopCount = loopCount + 1
+				end
+			end
+
+			function CallDouble(value)
+				coroutine.yield()
+				doubled = Double(value)
+			end
+		)"));
+
+		Nz::LuaScheduler scheduler(lua, 1000);
+
+		WHEN("We spawn a coroutine which never ends")
+		{
+			lua.GetGlobal("Loop");
+			unsigned int id = scheduler.Spawn();
+
+			THEN("It is yielded when its budget is spent, instead of being aborted")
+			{
+				CHECK(scheduler.Update(1000) == 1);
+				CHECK(scheduler.Update(1000) == 1);
+				CHECK(scheduler.IsAlive(id));
+
+				long long loopCount = lua.CheckGlobal<long long>("loopCount");
+				CHECK(loopCount > 0);
+
+				Nz::LuaScheduler::CoroutineStats stats;
+				REQUIRE(scheduler.GetCoroutineStats(id, &stats));
+				CHECK(stats.resumeCount == 2);
+				CHECK(stats.budgetExhaustionCount == 2);
+				CHECK(stats.instructionCount == 2000);
+
+				CHECK(scheduler.Kill(id));
+				CHECK_FALSE(scheduler.IsAlive(id));
+				CHECK(scheduler.GetCoroutineCount() == 0);
+			}
+		}
+
+		WHEN("We spawn coroutines yielding by themselves")
+		{
+			lua.GetGlobal("Steps");
+			lua.PushInteger(3);
+			unsigned int first = scheduler.Spawn(1);
+
+			lua.GetGlobal("Steps");
+			lua.PushInteger(1);
+			unsigned int second = scheduler.Spawn(1);
+
+			THEN("They are resumed in turn until they end")
+			{
+				CHECK(scheduler.Update(1000) == 2);
+				CHECK(lua.CheckGlobal<int>("stepCount") == 2);
+
+				CHECK(scheduler.Update(1000) == 2);
+				CHECK_FALSE(scheduler.IsAlive(second));
+				CHECK(lua.CheckGlobal<int>("stepCount") == 3);
+
+				scheduler.Update(1000);
+				scheduler.Update(1000);
+				CHECK_FALSE(scheduler.IsAlive(first));
+				CHECK(lua.CheckGlobal<int>("stepCount") == 4);
+				CHECK(scheduler.GetCoroutineCount() == 0);
+				CHECK(lua.GetStackTop() == 0);
+			}
+		}
+
+		WHEN("A coroutine fails")
+		{
+			lua.GetGlobal("Fail");
+			unsigned int id = scheduler.Spawn();
+
+			THEN("It is removed without affecting the others")
+			{
+				lua.GetGlobal("Loop");
+				unsigned int loopId = scheduler.Spawn();
+
+				Nz::ErrorFlags flags(Nz::ErrorFlag_Silent);
+				CHECK(scheduler.Update(1000) == 2);
+				CHECK_FALSE(scheduler.IsAlive(id));
+				CHECK(scheduler.IsAlive(loopId));
+			}
+		}
+
+		WHEN("A coroutine fails with an error object which is not a string")
+		{
+			lua.GetGlobal("FailWithTable");
+			unsigned int id = scheduler.Spawn();
+
+			THEN("It is removed like any other failing coroutine")
+			{
+				Nz::ErrorFlags flags(Nz::ErrorFlag_Silent);
+				CHECK(scheduler.Update(1000) == 1);
+				CHECK_FALSE(scheduler.IsAlive(id));
+			}
+		}
+
+		WHEN("A coroutine kills itself from a C++ function")
+		{
+			unsigned int id = Nz::LuaScheduler::InvalidId;
+			lua.PushFunction([&](Nz::LuaInstance& /*instance*/) -> int
+			{
+				CHECK(scheduler.Kill(id));
+				CHECK_FALSE(scheduler.IsAlive(id));
+				return 0;
+			});
+			lua.SetGlobal("KillCurrent");
+
+			lua.GetGlobal("KillSelf");
+			id = scheduler.Spawn(0, 1000000);
+
+			lua.GetGlobal("Steps");
+			lua.PushInteger(2);
+			unsigned int stepsId = scheduler.Spawn(1);
+
+			THEN("It is interrupted and released once resumed, the other coroutines keep running")
+			{
+				CHECK(scheduler.Update(1000000) == 2);
+				CHECK_FALSE(scheduler.IsAlive(id));
+				CHECK(scheduler.IsAlive(stepsId));
+				CHECK(scheduler.GetCoroutineCount() == 1);
+				CHECK(lua.CheckGlobal<int>("loopCount") < 1000000);
+			}
+		}
+
+		WHEN("A coroutine calls a C++ function")
+		{
+			lua.PushFunction([](Nz::LuaInstance& instance) -> int
+			{
+				instance.PushInteger(instance.CheckInteger(1) * 2);
+				return 1;
+			});
+			lua.SetGlobal("Double");
+
+			lua.GetGlobal("CallDouble");
+			lua.PushInteger(21);
+			scheduler.Spawn(1);
+
+			THEN("The function works on the stack of the coroutine")
+			{
+				scheduler.Update(1000);
+				scheduler.Update(1000);
+				CHECK(scheduler.GetCoroutineCount() == 0);
+				CHECK(lua.CheckGlobal<int>("doubled") == 42);
+			}
+		}
+
+		WHEN("We spawn more coroutines than the time budget allows to run")
+		{
+			for (unsigned int i = 0; i < 50; ++i)
+			{
+				lua.GetGlobal("Loop");
+				scheduler.Spawn(0, 200000);
+			}
+
+			THEN("Each update only resumes some of them, but all of them end up being resumed")
+			{
+				unsigned int resumedCount = scheduler.Update(500);
+				CHECK(resumedCount >= 1);
+				CHECK(resumedCount < 50);
+
+				unsigned int totalResumed = resumedCount;
+				while (totalResumed < 50)
+					totalResumed += scheduler.Update(500);
+
+				Nz::LuaScheduler::CoroutineStats stats;
+				REQUIRE(scheduler.GetCoroutineStats(50, &stats));
+				CHECK(stats.resumeCount >= 1);
+				CHECK(stats.executionTime > 0);
+			}
+		}
+	}
+}
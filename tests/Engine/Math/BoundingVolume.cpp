@@ -100,6 +100,35 @@ SCENARIO("BoundingVolume", "[MATH][BOUNDINGVOLUME]")
 			}
 		}
 
+		WHEN("We update several of them at once")
+		{
+			Nz::BoundingVolumef volumes[3] = {firstCenterAndUnit, secondCenterAndUnit, Nz::BoundingVolumef::Infinite()};
+			Nz::Matrix4f matrices[3] = {
+				Nz::Matrix4f::Transform(Nz::Vector3f(1.f, 2.f, 3.f), Nz::EulerAnglesf(30.f, 45.f, 60.f), Nz::Vector3f(2.f, 1.f, 0.5f)),
+				Nz::Matrix4f::Translate(Nz::Vector3f(-5.f, 0.f, 0.f)),
+				Nz::Matrix4f::Identity()
+			};
+			Nz::BoundingVolumef::Update(volumes, matrices, 3);
+
+			THEN("The result is the same as updating them one by one")
+			{
+				firstCenterAndUnit.Update(matrices[0]);
+				secondCenterAndUnit.Update(matrices[1]);
+
+				Nz::BoundingVolumef* references[2] = {&firstCenterAndUnit, &secondCenterAndUnit};
+				for (unsigned int i = 0; i < 2; ++i)
+				{
+					const Nz::Boxf& aabb = volumes[i].aabb;
+					const Nz::Boxf& reference = references[i]->aabb;
+					CHECK(aabb.GetMinimum().SquaredDistance(reference.GetMinimum()) < 0.0001f);
+					CHECK(aabb.GetMaximum().SquaredDistance(reference.GetMaximum()) < 0.0001f);
+					CHECK(volumes[i].obb(Nz::BoxCorner_FarLeftTop) == (*references[i]).obb(Nz::BoxCorner_FarLeftTop));
+				}
+
+				CHECK(volumes[2].IsInfinite());
+			}
+		}
+
 		WHEN("We try to lerp")
 		{
 			THEN("Compilation should be fine")
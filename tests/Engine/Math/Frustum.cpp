@@ -1,5 +1,35 @@
 #include <Nazara/Math/Frustum.hpp>
+#include <Nazara/Core/Clock.hpp>
 #include <Catch/catch.hpp>
+#include <random>
+#include <vector>
+
+namespace
+{
+	// Volumes stored as structure of arrays, as expected by the batch culling functions
+	struct Volumes
+	{
+		Volumes(std::size_t count, float range)
+		{
+			std::mt19937 generator(42);
+			std::uniform_real_distribution<float> positions(-range, range);
+			std::uniform_real_distribution<float> sizes(0.f, 10.f);
+
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				x.push_back(positions(generator));
+				y.push_back(positions(generator));
+				z.push_back(positions(generator));
+				radii.push_back(sizes(generator));
+				maxX.push_back(x.back() + sizes(generator));
+				maxY.push_back(y.back() + sizes(generator));
+				maxZ.push_back(z.back() + sizes(generator));
+			}
+		}
+
+		std::vector<float> x, y, z, radii, maxX, maxY, maxZ;
+	};
+}
 
 SCENARIO("Frustum", "[MATH][FRUSTUM]")
 {
@@ -92,4 +122,131 @@ SCENARIO("Frustum", "[MATH][FRUSTUM]")
 			}
 		}
 	}
+	GIVEN("Arrays of volumes around the frustum")
+	{
+		Nz::Frustumf frustum;
+		frustum.Build(Nz::FromDegrees(70.f), 1.5f, 1.f, 500.f, Nz::Vector3f::Zero(), Nz::Vector3f(1.f, 0.5f, 0.f));
+
+		// A count which is not a multiple of the SIMD width nor of the bitset blocks
+		Volumes volumes(1003, 600.f);
+
+		WHEN("We cull them at once")
+		{
+			Nz::Bitset<> sphereVisibility;
+			frustum.CullSpheres(volumes.x.data(), volumes.y.data(), volumes.z.data(), volumes.radii.data(), volumes.x.size(), &sphereVisibility);
+
+			Nz::Bitset<> boxVisibility(2000, true);
+			frustum.CullBoxes(volumes.x.data(), volumes.y.data(), volumes.z.data(), volumes.maxX.data(), volumes.maxY.data(), volumes.maxZ.data(), volumes.x.size(), &boxVisibility);
+
+			THEN("Each volume gets the result of Contains")
+			{
+				REQUIRE(sphereVisibility.GetSize() == 1003);
+				REQUIRE(boxVisibility.GetSize() == 1003);
+
+				unsigned int sphereErrors = 0;
+				unsigned int boxErrors = 0;
+				for (unsigned int i = 0; i < volumes.x.size(); ++i)
+				{
+					Nz::Vector3f min(volumes.x[i], volumes.y[i], volumes.z[i]);
+					Nz::Vector3f max(volumes.maxX[i], volumes.maxY[i], volumes.maxZ[i]);
+
+					if (sphereVisibility.Test(i) != frustum.Contains(Nz::Spheref(min, volumes.radii[i])))
+						sphereErrors++;
+
+					if (boxVisibility.Test(i) != frustum.Contains(Nz::Boxf(min, max)))
+						boxErrors++;
+				}
+
+				CHECK(sphereErrors == 0);
+				CHECK(boxErrors == 0);
+				CHECK(sphereVisibility.TestAny());
+				CHECK(sphereVisibility.Count() < 1003);
+			}
+		}
+
+		WHEN("We cull them with the generic version")
+		{
+			Nz::Frustumd frustumd(frustum);
+
+			std::vector<double> x(volumes.x.begin(), volumes.x.end());
+			std::vector<double> y(volumes.y.begin(), volumes.y.end());
+			std::vector<double> z(volumes.z.begin(), volumes.z.end());
+			std::vector<double> radii(volumes.radii.begin(), volumes.radii.end());
+
+			Nz::Bitset<> visibility;
+			frustumd.CullSpheres(x.data(), y.data(), z.data(), radii.data(), x.size(), &visibility);
+
+			THEN("The results are the same as the float version")
+			{
+				Nz::Bitset<> floatVisibility;
+				frustum.CullSpheres(volumes.x.data(), volumes.y.data(), volumes.z.data(), volumes.radii.data(), volumes.x.size(), &floatVisibility);
+
+				CHECK(visibility.GetSize() == floatVisibility.GetSize());
+				CHECK((visibility ^ floatVisibility).Count() <= 1);
+			}
+		}
+	}
+}
+
+// Not run by default, use "[.benchmark]" or "[FRUSTUM]" on the command line to compare the batch culling to Contains
+TEST_CASE("Frustum culling throughput", "[MATH][FRUSTUM][.benchmark]")
+{
+	const unsigned int iterationCount = 100;
+
+	Nz::Frustumf frustum;
+	frustum.Build(Nz::FromDegrees(70.f), 1.5f, 1.f, 500.f, Nz::Vector3f::Zero(), Nz::Vector3f::UnitX());
+
+	Volumes volumes(100000, 600.f);
+	std::size_t count = volumes.x.size();
+
+	std::vector<Nz::Spheref> spheres;
+	std::vector<Nz::Boxf> boxes;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		Nz::Vector3f min(volumes.x[i], volumes.y[i], volumes.z[i]);
+		spheres.emplace_back(min, volumes.radii[i]);
+		boxes.emplace_back(min, Nz::Vector3f(volumes.maxX[i], volumes.maxY[i], volumes.maxZ[i]));
+	}
+
+	unsigned int visibleCount = 0;
+
+	Nz::Clock clock;
+	for (unsigned int i = 0; i < iterationCount; ++i)
+	{
+		for (const Nz::Spheref& sphere : spheres)
+			visibleCount += (frustum.Contains(sphere)) ? 1 : 0;
+	}
+	Nz::UInt64 sphereElapsed = clock.GetMicroseconds() / iterationCount;
+
+	clock.Restart();
+	for (unsigned int i = 0; i < iterationCount; ++i)
+	{
+		for (const Nz::Boxf& box : boxes)
+			visibleCount += (frustum.Contains(box)) ? 1 : 0;
+	}
+	Nz::UInt64 boxElapsed = clock.GetMicroseconds() / iterationCount;
+
+	Nz::Bitset<> visibility;
+
+	clock.Restart();
+	for (unsigned int i = 0; i < iterationCount; ++i)
+	{
+		frustum.CullSpheres(volumes.x.data(), volumes.y.data(), volumes.z.data(), volumes.radii.data(), count, &visibility);
+		visibleCount += visibility.Count();
+	}
+	Nz::UInt64 batchSphereElapsed = clock.GetMicroseconds() / iterationCount;
+
+	clock.Restart();
+	for (unsigned int i = 0; i < iterationCount; ++i)
+	{
+		frustum.CullBoxes(volumes.x.data(), volumes.y.data(), volumes.z.data(), volumes.maxX.data(), volumes.maxY.data(), volumes.maxZ.data(), count, &visibility);
+		visibleCount += visibility.Count();
+	}
+	Nz::UInt64 batchBoxElapsed = clock.GetMicroseconds() / iterationCount;
+
+	CHECK(visibleCount > 0);
+
+	WARN(count << " volumes, " << visibility.Count() << " visible boxes");
+	WARN("Spheres: " << sphereElapsed << "us (Contains) / " << batchSphereElapsed << "us (CullSpheres)");
+	WARN("Boxes: " << boxElapsed << "us (Contains) / " << batchBoxElapsed << "us (CullBoxes)");
 }
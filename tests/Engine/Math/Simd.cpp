@@ -0,0 +1,313 @@
+#include <Nazara/Math/Matrix4.hpp>
+#include <Nazara/Math/Quaternion.hpp>
+#include <Nazara/Core/Clock.hpp>
+#include <Catch/catch.hpp>
+#include <random>
+#include <vector>
+
+// The float specializations of Matrix4 and Quaternion use SSE/AVX when available, the double versions are the generic ones:
+// these tests compare both
+
+namespace
+{
+	bool MatrixEquals(const Nz::Matrix4f& lhs, const Nz::Matrix4d& rhs, double epsilon = 0.001)
+	{
+		for (unsigned int i = 0; i < 16; ++i)
+		{
+			if (!Nz::NumberEquals(static_cast<double>(lhs[i]), rhs[i], epsilon))
+				return false;
+		}
+
+		return true;
+	}
+
+	bool QuaternionEquals(const Nz::Quaternionf& lhs, const Nz::Quaterniond& rhs)
+	{
+		return Nz::NumberEquals(static_cast<double>(lhs.w), rhs.w, 0.001) && Nz::NumberEquals(static_cast<double>(lhs.x), rhs.x, 0.001) &&
+		       Nz::NumberEquals(static_cast<double>(lhs.y), rhs.y, 0.001) && Nz::NumberEquals(static_cast<double>(lhs.z), rhs.z, 0.001);
+	}
+
+	template<typename V>
+	bool VectorEquals(const V& lhs, const V& rhs)
+	{
+		for (unsigned int i = 0; i < sizeof(V) / sizeof(float); ++i)
+		{
+			if (!Nz::NumberEquals(lhs[i], rhs[i], 0.001f))
+				return false;
+		}
+
+		return true;
+	}
+
+	Nz::Quaternionf RandomRotation(std::mt19937& generator)
+	{
+		std::uniform_real_distribution<float> angles(-180.f, 180.f);
+		return Nz::EulerAnglesf(angles(generator), angles(generator), angles(generator));
+	}
+
+	Nz::Matrix4f RandomAffine(std::mt19937& generator)
+	{
+		std::uniform_real_distribution<float> values(-10.f, 10.f);
+		std::uniform_real_distribution<float> scales(0.5f, 2.f);
+
+		Nz::Vector3f translation(values(generator), values(generator), values(generator));
+		Nz::Vector3f scale(scales(generator), scales(generator), scales(generator));
+
+		return Nz::Matrix4f::Transform(translation, RandomRotation(generator), scale);
+	}
+
+	Nz::Matrix4f RandomMatrix(std::mt19937& generator)
+	{
+		std::uniform_real_distribution<float> values(-2.f, 2.f);
+
+		Nz::Matrix4f matrix;
+		for (unsigned int i = 0; i < 16; ++i)
+			matrix[i] = values(generator);
+
+		return matrix;
+	}
+}
+
+SCENARIO("Math SIMD", "[MATH][SIMD]")
+{
+	std::mt19937 generator(42);
+
+	GIVEN("Random matrices")
+	{
+		std::vector<Nz::Matrix4f> affines;
+		std::vector<Nz::Matrix4f> matrices;
+		for (unsigned int i = 0; i < 37; ++i)
+		{
+			affines.push_back(RandomAffine(generator));
+			matrices.push_back(RandomMatrix(generator));
+		}
+
+		WHEN("We concatenate them")
+		{
+			bool identical = true;
+			for (unsigned int i = 0; i + 1 < matrices.size(); ++i)
+			{
+				Nz::Matrix4d reference = Nz::Matrix4d::Concatenate(Nz::Matrix4d(matrices[i]), Nz::Matrix4d(matrices[i + 1]));
+				identical &= MatrixEquals(Nz::Matrix4f::Concatenate(matrices[i], matrices[i + 1]), reference);
+
+				Nz::Matrix4d affineReference = Nz::Matrix4d::ConcatenateAffine(Nz::Matrix4d(affines[i]), Nz::Matrix4d(affines[i + 1]));
+				identical &= MatrixEquals(Nz::Matrix4f::ConcatenateAffine(affines[i], affines[i + 1]), affineReference);
+			}
+
+			THEN("The results match the generic version")
+			{
+				CHECK(identical);
+			}
+		}
+
+		WHEN("We concatenate arrays of them")
+		{
+			std::vector<Nz::Matrix4f> results(matrices.size());
+			Nz::Matrix4f::Concatenate(matrices.data(), affines.data(), results.data(), matrices.size());
+
+			std::vector<Nz::Matrix4f> affineResults(affines);
+			Nz::Matrix4f::ConcatenateAffine(affines.data(), affineResults.data(), affineResults.data(), affines.size());
+
+			THEN("Each result is the product of a pair, even in place")
+			{
+				bool identical = true;
+				for (unsigned int i = 0; i < matrices.size(); ++i)
+				{
+					identical &= MatrixEquals(results[i], Nz::Matrix4d::Concatenate(Nz::Matrix4d(matrices[i]), Nz::Matrix4d(affines[i])));
+					identical &= MatrixEquals(affineResults[i], Nz::Matrix4d::ConcatenateAffine(Nz::Matrix4d(affines[i]), Nz::Matrix4d(affines[i])));
+				}
+
+				CHECK(identical);
+			}
+		}
+
+		WHEN("We invert affine matrices")
+		{
+			bool identical = true;
+			for (const Nz::Matrix4f& affine : affines)
+			{
+				Nz::Matrix4f inverse;
+				REQUIRE(affine.GetInverseAffine(&inverse));
+
+				Nz::Matrix4d reference;
+				REQUIRE(Nz::Matrix4d(affine).GetInverseAffine(&reference));
+
+				identical &= MatrixEquals(inverse, reference);
+				identical &= MatrixEquals(Nz::Matrix4f::ConcatenateAffine(affine, inverse), Nz::Matrix4d::Identity());
+			}
+
+			THEN("The results match the generic version")
+			{
+				CHECK(identical);
+			}
+
+			AND_THEN("A singular matrix can not be inverted")
+			{
+				Nz::Matrix4f singular = Nz::Matrix4f::Scale(Nz::Vector3f(1.f, 0.f, 1.f));
+
+				Nz::Matrix4f inverse;
+				CHECK_FALSE(singular.GetInverseAffine(&inverse));
+			}
+		}
+
+		WHEN("We transform arrays of vectors")
+		{
+			std::uniform_real_distribution<float> values(-100.f, 100.f);
+
+			// An odd count checks the remaining vectors are handled
+			std::vector<Nz::Vector3f> vectors3;
+			std::vector<Nz::Vector4f> vectors4;
+			for (unsigned int i = 0; i < 23; ++i)
+			{
+				vectors3.emplace_back(values(generator), values(generator), values(generator));
+				vectors4.emplace_back(values(generator), values(generator), values(generator), values(generator));
+			}
+
+			const Nz::Matrix4f& matrix = matrices[0];
+
+			std::vector<Nz::Vector3f> results3(vectors3.size());
+			matrix.Transform(vectors3.data(), results3.data(), vectors3.size(), 0.5f);
+
+			std::vector<Nz::Vector4f> results4(vectors4);
+			matrix.Transform(results4.data(), results4.data(), results4.size());
+
+			THEN("Each vector is transformed as it would be alone")
+			{
+				Nz::Matrix4d reference(matrix);
+
+				bool identical = true;
+				for (unsigned int i = 0; i < vectors3.size(); ++i)
+				{
+					identical &= VectorEquals(results3[i], Nz::Vector3f(reference.Transform(Nz::Vector3d(vectors3[i]), 0.5)));
+					identical &= VectorEquals(results4[i], Nz::Vector4f(reference.Transform(Nz::Vector4d(vectors4[i]))));
+					identical &= VectorEquals(matrix.Transform(vectors4[i]), results4[i]);
+				}
+
+				CHECK(identical);
+			}
+		}
+	}
+
+	GIVEN("Random quaternions")
+	{
+		std::uniform_real_distribution<float> values(-5.f, 5.f);
+
+		std::vector<Nz::Quaternionf> left;
+		std::vector<Nz::Quaternionf> right;
+		for (unsigned int i = 0; i < 19; ++i)
+		{
+			left.emplace_back(values(generator), values(generator), values(generator), values(generator));
+			right.push_back(RandomRotation(generator));
+		}
+		left[5] = Nz::Quaternionf::Zero();
+
+		WHEN("We multiply and normalize arrays of them")
+		{
+			std::vector<Nz::Quaternionf> products(left.size());
+			Nz::Quaternionf::Multiply(left.data(), right.data(), products.data(), left.size());
+
+			std::vector<Nz::Quaternionf> normals(left);
+			Nz::Quaternionf::Normalize(normals.data(), normals.data(), normals.size());
+
+			THEN("The results match the generic version")
+			{
+				bool identical = true;
+				for (unsigned int i = 0; i < left.size(); ++i)
+				{
+					identical &= QuaternionEquals(products[i], Nz::Quaterniond(left[i]) * Nz::Quaterniond(right[i]));
+					identical &= QuaternionEquals(normals[i], Nz::Quaterniond(left[i]).GetNormal());
+				}
+
+				CHECK(identical);
+				CHECK(normals[5] == Nz::Quaternionf::Zero());
+			}
+		}
+	}
+}
+
+// Not run by default, use "[.benchmark]" or "[SIMD]" on the command line to compare scalar loops to the batch functions
+TEST_CASE("Math SIMD throughput", "[MATH][SIMD][.benchmark]")
+{
+	const unsigned int count = 10000;
+	const unsigned int iterationCount = 100;
+
+	std::mt19937 generator(42);
+
+	std::vector<Nz::Matrix4f> left;
+	std::vector<Nz::Matrix4f> right;
+	std::vector<Nz::Matrix4f> results(count);
+	std::vector<Nz::Quaternionf> rotations;
+	std::vector<Nz::Quaternionf> rotationResults(count);
+	std::vector<Nz::Vector3f> positions;
+	std::vector<Nz::Vector3f> positionResults(count);
+	for (unsigned int i = 0; i < count; ++i)
+	{
+		left.push_back(RandomAffine(generator));
+		right.push_back(RandomAffine(generator));
+		rotations.push_back(RandomRotation(generator));
+		positions.emplace_back(static_cast<float>(i), 1.f, 2.f);
+	}
+
+	// Returns the elapsed time per iteration of both functions
+	auto Compare = [&](const char* name, auto scalar, auto batch)
+	{
+		Nz::Clock clock;
+		for (unsigned int i = 0; i < iterationCount; ++i)
+			scalar();
+		Nz::UInt64 scalarElapsed = clock.GetMicroseconds() / iterationCount;
+
+		clock.Restart();
+		for (unsigned int i = 0; i < iterationCount; ++i)
+			batch();
+		Nz::UInt64 batchElapsed = clock.GetMicroseconds() / iterationCount;
+
+		WARN(name << ": " << scalarElapsed << "us (scalar) / " << batchElapsed << "us (batch) for " << count);
+	};
+
+	Compare("Matrix4f::Concatenate", [&]()
+	{
+		for (unsigned int i = 0; i < count; ++i)
+		{
+			const float* a = &left[i].m11;
+			const float* b = &right[i].m11;
+			float* r = &results[i].m11;
+			for (unsigned int row = 0; row < 4; ++row)
+			{
+				for (unsigned int column = 0; column < 4; ++column)
+					r[row * 4 + column] = a[row * 4] * b[column] + a[row * 4 + 1] * b[4 + column] + a[row * 4 + 2] * b[8 + column] + a[row * 4 + 3] * b[12 + column];
+			}
+		}
+	},
+	[&]()
+	{
+		Nz::Matrix4f::Concatenate(left.data(), right.data(), results.data(), count);
+	});
+
+	Compare("Matrix4f::Transform(Vector3f)", [&]()
+	{
+		const Nz::Matrix4f& m = left[0];
+		for (unsigned int i = 0; i < count; ++i)
+		{
+			const Nz::Vector3f& v = positions[i];
+			positionResults[i].Set(m.m11 * v.x + m.m21 * v.y + m.m31 * v.z + m.m41,
+			                       m.m12 * v.x + m.m22 * v.y + m.m32 * v.z + m.m42,
+			                       m.m13 * v.x + m.m23 * v.y + m.m33 * v.z + m.m43);
+		}
+	},
+	[&]()
+	{
+		left[0].Transform(positions.data(), positionResults.data(), count);
+	});
+
+	Compare("Quaternionf::Multiply", [&]()
+	{
+		for (unsigned int i = 0; i < count; ++i)
+			rotationResults[i] = rotations[i] * rotations[count - i - 1];
+	},
+	[&]()
+	{
+		Nz::Quaternionf::Multiply(rotations.data(), rotations.data(), rotationResults.data(), count);
+	});
+
+	CHECK(results[count - 1].IsAffine());
+}
@@ -0,0 +1,440 @@
+#include <Nazara/Utility/Algorithm.hpp>
+#include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/File.hpp>
+#include <Nazara/Core/Initializer.hpp>
+#include <Nazara/Core/Primitive.hpp>
+#include <Nazara/Utility/IndexBuffer.hpp>
+#include <Nazara/Utility/IndexMapper.hpp>
+#include <Nazara/Utility/Mesh.hpp>
+#include <Nazara/Utility/StaticMesh.hpp>
+#include <Nazara/Utility/Utility.hpp>
+#include <Nazara/Utility/VertexBuffer.hpp>
+#include <Catch/catch.hpp>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+	struct IndexedGeometry
+	{
+		std::vector<Nz::Vector3f> positions;
+		std::vector<Nz::UInt32> indices;
+	};
+
+	using Triangle = std::array<float, 9>;
+
+	std::vector<Nz::UInt32> GetIndices(const Nz::IndexBuffer* indexBuffer)
+	{
+		std::vector<Nz::UInt32> indices;
+
+		Nz::IndexMapper mapper(indexBuffer);
+		for (unsigned int i = 0; i < mapper.GetIndexCount(); ++i)
+			indices.push_back(mapper.Get(i));
+
+		return indices;
+	}
+
+	IndexedGeometry BuildGeometry(const Nz::Primitive& primitive)
+	{
+		Nz::MeshParams params;
+		params.optimizeIndexBuffers = false;
+		params.storage = Nz::DataStorage_Software;
+
+		Nz::MeshRef mesh = Nz::Mesh::New();
+		mesh->CreateStatic();
+
+		Nz::StaticMesh* subMesh = static_cast<Nz::StaticMesh*>(mesh->BuildSubMesh(primitive, params));
+
+		IndexedGeometry geometry;
+		geometry.indices = GetIndices(subMesh->GetIndexBuffer());
+
+		const Nz::VertexBuffer* vertexBuffer = subMesh->GetVertexBuffer();
+		const Nz::MeshVertex* vertices = static_cast<const Nz::MeshVertex*>(vertexBuffer->Map(Nz::BufferAccess_ReadOnly));
+		for (unsigned int i = 0; i < vertexBuffer->GetVertexCount(); ++i)
+			geometry.positions.push_back(vertices[i].position);
+
+		vertexBuffer->Unmap();
+
+		return geometry;
+	}
+
+	// Triangles as positions, starting by their smallest vertex so that the winding is kept
+	std::vector<Triangle> GetTriangles(const std::vector<Nz::Vector3f>& positions, const std::vector<Nz::UInt32>& indices)
+	{
+		std::vector<Triangle> triangles;
+		for (std::size_t i = 0; i < indices.size(); i += 3)
+		{
+			std::array<Nz::Vector3f, 3> vertices = {positions[indices[i]], positions[indices[i + 1]], positions[indices[i + 2]]};
+			auto first = std::min_element(vertices.begin(), vertices.end(), [](const Nz::Vector3f& lhs, const Nz::Vector3f& rhs)
+			{
+				return std::lexicographical_compare(&lhs.x, &lhs.x + 3, &rhs.x, &rhs.x + 3);
+			});
+			std::rotate(vertices.begin(), first, vertices.end());
+
+			Triangle triangle;
+			for (unsigned int j = 0; j < 3; ++j)
+				std::copy(&vertices[j].x, &vertices[j].x + 3, &triangle[j * 3]);
+
+			triangles.push_back(triangle);
+		}
+
+		std::sort(triangles.begin(), triangles.end());
+		return triangles;
+	}
+
+	// Runs an index algorithm over a copy of the indices stored in a software index buffer
+	template<typename F>
+	std::vector<Nz::UInt32> Process(const std::vector<Nz::UInt32>& indices, F func)
+	{
+		Nz::IndexBufferRef indexBuffer = Nz::IndexBuffer::New(true, static_cast<unsigned int>(indices.size()), Nz::DataStorage_Software, Nz::BufferUsage_Static);
+		indexBuffer->Fill(indices.data(), 0, static_cast<unsigned int>(indices.size()));
+
+		Nz::IndexMapper mapper(indexBuffer);
+		func(mapper.begin(), mapper.GetIndexCount());
+
+		std::vector<Nz::UInt32> result(indices.size());
+		for (unsigned int i = 0; i < mapper.GetIndexCount(); ++i)
+			result[i] = mapper.Get(i);
+
+		return result;
+	}
+
+	float ComputeACMR(const std::vector<Nz::UInt32>& indices)
+	{
+		unsigned int missCount = 0;
+		Process(indices, [&](Nz::IndexIterator it, unsigned int indexCount)
+		{
+			missCount = Nz::ComputeCacheMissCount(it, indexCount);
+		});
+
+		return static_cast<float>(missCount) / (indices.size() / 3);
+	}
+
+	void ShuffleTriangles(std::vector<Nz::UInt32>& indices, unsigned int seed)
+	{
+		std::vector<std::array<Nz::UInt32, 3>> triangles(indices.size() / 3);
+		std::memcpy(triangles.data(), indices.data(), indices.size() * sizeof(Nz::UInt32));
+		std::shuffle(triangles.begin(), triangles.end(), std::mt19937(seed));
+		std::memcpy(indices.data(), triangles.data(), indices.size() * sizeof(Nz::UInt32));
+	}
+
+	Nz::MeshRef BuildShuffledMesh(unsigned int subMeshCount)
+	{
+		Nz::MeshParams params;
+		params.optimizeIndexBuffers = false;
+		params.storage = Nz::DataStorage_Software;
+
+		Nz::MeshRef mesh = Nz::Mesh::New();
+		mesh->CreateStatic();
+
+		for (unsigned int i = 0; i < subMeshCount; ++i)
+		{
+			Nz::SubMesh* subMesh = mesh->BuildSubMesh(Nz::Primitive::UVSphere(1.f, 20 + i, 15 + i, Nz::Vector3f(i * 3.f, 0.f, 0.f)), params);
+
+			std::vector<Nz::UInt32> indices = GetIndices(subMesh->GetIndexBuffer());
+			ShuffleTriangles(indices, i);
+
+			unsigned int indexCount = static_cast<unsigned int>(indices.size());
+			Nz::IndexBufferRef indexBuffer = Nz::IndexBuffer::New(true, indexCount, Nz::DataStorage_Software, Nz::BufferUsage_Static);
+			indexBuffer->Fill(indices.data(), 0, indexCount);
+			static_cast<Nz::StaticMesh*>(subMesh)->SetIndexBuffer(indexBuffer);
+		}
+
+		return mesh;
+	}
+
+	std::vector<Nz::UInt8> GetMeshData(const Nz::Mesh& mesh)
+	{
+		std::vector<Nz::UInt8> data;
+		for (unsigned int i = 0; i < mesh.GetSubMeshCount(); ++i)
+		{
+			const Nz::StaticMesh* subMesh = static_cast<const Nz::StaticMesh*>(mesh.GetSubMesh(i));
+
+			std::vector<Nz::UInt32> indices = GetIndices(subMesh->GetIndexBuffer());
+			const Nz::UInt8* indexData = reinterpret_cast<const Nz::UInt8*>(indices.data());
+			data.insert(data.end(), indexData, indexData + indices.size() * sizeof(Nz::UInt32));
+
+			// Tangents are not generated, only the other components are compared
+			const Nz::VertexBuffer* vertexBuffer = subMesh->GetVertexBuffer();
+			const Nz::MeshVertex* vertices = static_cast<const Nz::MeshVertex*>(vertexBuffer->Map(Nz::BufferAccess_ReadOnly));
+			for (unsigned int j = 0; j < vertexBuffer->GetVertexCount(); ++j)
+			{
+				const Nz::UInt8* position = reinterpret_cast<const Nz::UInt8*>(&vertices[j].position);
+				const Nz::UInt8* normal = reinterpret_cast<const Nz::UInt8*>(&vertices[j].normal);
+				const Nz::UInt8* uv = reinterpret_cast<const Nz::UInt8*>(&vertices[j].uv);
+				data.insert(data.end(), position, position + sizeof(Nz::Vector3f));
+				data.insert(data.end(), normal, normal + sizeof(Nz::Vector3f));
+				data.insert(data.end(), uv, uv + sizeof(Nz::Vector2f));
+			}
+			vertexBuffer->Unmap();
+		}
+
+		return data;
+	}
+}
+
+SCENARIO("Mesh optimization", "[UTILITY][MESHOPTIMIZATION]")
+{
+	Nz::Initializer<Nz::Utility> utility;
+	REQUIRE(utility);
+
+	GIVEN("A sphere whose triangles are shuffled")
+	{
+		IndexedGeometry sphere = BuildGeometry(Nz::Primitive::UVSphere(1.f, 32, 24));
+		ShuffleTriangles(sphere.indices, 42);
+
+		std::vector<Triangle> triangles = GetTriangles(sphere.positions, sphere.indices);
+		float acmr = ComputeACMR(sphere.indices);
+
+		WHEN("We optimize it for the vertex cache")
+		{
+			std::vector<Nz::UInt32> indices = Process(sphere.indices, Nz::OptimizeIndices);
+
+			THEN("The triangles are the same, with a better cache usage")
+			{
+				CHECK(GetTriangles(sphere.positions, indices) == triangles);
+				CHECK(ComputeACMR(indices) < 0.8f);
+				CHECK(ComputeACMR(indices) < acmr * 0.5f);
+			}
+
+			AND_THEN("The result is the same each time")
+			{
+				CHECK(Process(sphere.indices, Nz::OptimizeIndices) == indices);
+			}
+		}
+
+		WHEN("We then sort the clusters of triangles for overdraw")
+		{
+			std::vector<Nz::UInt32> cacheIndices = Process(sphere.indices, Nz::OptimizeIndices);
+			std::vector<Nz::UInt32> indices = Process(cacheIndices, [&](Nz::IndexIterator it, unsigned int indexCount)
+			{
+				Nz::OptimizeOverdraw(it, indexCount, sphere.positions.data(), 1.05f);
+			});
+
+			THEN("The triangles are the same and the cache usage stays close")
+			{
+				CHECK(GetTriangles(sphere.positions, indices) == triangles);
+				CHECK(ComputeACMR(indices) <= ComputeACMR(cacheIndices) * 1.15f);
+			}
+		}
+
+		WHEN("We reorder the vertices for the fetch")
+		{
+			std::vector<Nz::Vector3f> positions(sphere.positions);
+			positions.push_back(Nz::Vector3f(100.f)); // Unused vertex
+
+			unsigned int usedVertexCount = 0;
+			std::vector<Nz::UInt32> indices = Process(sphere.indices, [&](Nz::IndexIterator it, unsigned int indexCount)
+			{
+				usedVertexCount = Nz::OptimizeVertexFetch(it, indexCount, positions.data(), static_cast<unsigned int>(positions.size()), sizeof(Nz::Vector3f));
+			});
+
+			THEN("Vertices are in their order of first use, the unused one being last")
+			{
+				CHECK(usedVertexCount == sphere.positions.size());
+				CHECK(positions.back() == Nz::Vector3f(100.f));
+				CHECK(GetTriangles(positions, indices) == triangles);
+
+				Nz::UInt32 nextVertex = 0;
+				bool ordered = true;
+				for (Nz::UInt32 index : indices)
+				{
+					if (index == nextVertex)
+						nextVertex++;
+					else
+						ordered &= (index < nextVertex);
+				}
+
+				CHECK(ordered);
+			}
+		}
+	}
+
+	GIVEN("A mesh of many submeshes")
+	{
+		Nz::MeshRef serialMesh = BuildShuffledMesh(6);
+		Nz::MeshRef parallelMesh = BuildShuffledMesh(6);
+
+		// A shared index buffer must not be modified
+		Nz::IndexBufferConstRef sharedIndexBuffer = serialMesh->GetSubMesh(0)->GetIndexBuffer();
+		std::vector<Nz::UInt32> sharedIndices = GetIndices(sharedIndexBuffer);
+		std::vector<Nz::UInt8> originalData = GetMeshData(*serialMesh);
+
+		WHEN("We optimize them in parallel and serially")
+		{
+			serialMesh->Optimize(Nz::MeshOptimization_All, false);
+			parallelMesh->Optimize(Nz::MeshOptimization_All, true);
+
+			THEN("The results are identical")
+			{
+				CHECK(GetMeshData(*serialMesh) == GetMeshData(*parallelMesh));
+				CHECK(GetMeshData(*serialMesh) != originalData);
+			}
+
+			AND_THEN("Index buffers were replaced")
+			{
+				CHECK(serialMesh->GetSubMesh(0)->GetIndexBuffer() != sharedIndexBuffer.Get());
+				CHECK(GetIndices(sharedIndexBuffer) == sharedIndices);
+			}
+		}
+	}
+}
+
+namespace
+{
+	// Minimal OBJ reader (positions and faces only), the OBJ loader being part of the Graphics module
+	bool LoadObjGeometry(const Nz::String& filePath, IndexedGeometry* geometry)
+	{
+		std::ifstream file(filePath.GetConstBuffer());
+		if (!file)
+			return false;
+
+		std::string line;
+		std::vector<Nz::UInt32> face;
+		while (std::getline(file, line))
+		{
+			std::istringstream stream(line);
+			std::string keyword;
+			stream >> keyword;
+
+			if (keyword == "v")
+			{
+				Nz::Vector3f position;
+				stream >> position.x >> position.y >> position.z;
+				geometry->positions.push_back(position);
+			}
+			else if (keyword == "f")
+			{
+				face.clear();
+
+				std::string vertex;
+				while (stream >> vertex)
+				{
+					long index = std::stol(vertex);
+					face.push_back(static_cast<Nz::UInt32>((index < 0) ? geometry->positions.size() + index : index - 1));
+				}
+
+				for (std::size_t i = 2; i < face.size(); ++i)
+				{
+					geometry->indices.push_back(face[0]);
+					geometry->indices.push_back(face[i - 1]);
+					geometry->indices.push_back(face[i]);
+				}
+			}
+		}
+
+		return !geometry->indices.empty();
+	}
+
+	Nz::String FindResource(const Nz::String& fileName)
+	{
+		for (const char* directory : {"resources/", "../examples/bin/resources/", "../../examples/bin/resources/", "examples/bin/resources/"})
+		{
+			Nz::String filePath = Nz::String(directory) + fileName;
+			if (Nz::File::Exists(filePath))
+				return filePath;
+		}
+
+		return Nz::String();
+	}
+}
+
+// Not run by default, use "[.benchmark]" or "[MESHOPTIMIZATION]" on the command line
+TEST_CASE("Mesh optimization statistics", "[UTILITY][MESHOPTIMIZATION][.benchmark]")
+{
+	Nz::Initializer<Nz::Utility> utility;
+	REQUIRE(utility);
+
+	// ACMR: cache misses per triangle (0.5 at best), ATVR: cache misses per vertex (1 at best)
+	auto Report = [](const char* name, const IndexedGeometry& geometry)
+	{
+		std::vector<Nz::UInt32> sourceIndices(geometry.indices);
+		ShuffleTriangles(sourceIndices, 0);
+
+		std::size_t triangleCount = geometry.indices.size() / 3;
+		auto Statistics = [&](const std::vector<Nz::UInt32>& indices)
+		{
+			float acmr = ComputeACMR(indices);
+			std::ostringstream stream;
+			stream << "ACMR " << acmr << ", ATVR " << acmr * triangleCount / geometry.positions.size();
+			return stream.str();
+		};
+
+		Nz::Clock clock;
+		std::vector<Nz::UInt32> cacheIndices = Process(geometry.indices, Nz::OptimizeIndices);
+		Nz::UInt64 cacheElapsed = clock.GetMicroseconds();
+
+		std::vector<Nz::UInt32> shuffledIndices = Process(sourceIndices, Nz::OptimizeIndices);
+
+		clock.Restart();
+		std::vector<Nz::UInt32> overdrawIndices = Process(cacheIndices, [&](Nz::IndexIterator it, unsigned int indexCount)
+		{
+			Nz::OptimizeOverdraw(it, indexCount, geometry.positions.data());
+		});
+		Nz::UInt64 overdrawElapsed = clock.GetMicroseconds();
+
+		WARN(name << " (" << triangleCount << " triangles, " << geometry.positions.size() << " vertices)\n"
+		     << "  source: " << Statistics(geometry.indices) << "\n"
+		     << "  shuffled: " << Statistics(sourceIndices) << " -> " << Statistics(shuffledIndices) << "\n"
+		     << "  vertex cache: " << Statistics(cacheIndices) << " in " << cacheElapsed << "us\n"
+		     << "  overdraw: " << Statistics(overdrawIndices) << " in " << overdrawElapsed << "us");
+	};
+
+	Report("UV sphere", BuildGeometry(Nz::Primitive::UVSphere(1.f, 128, 96)));
+	Report("Ico sphere", BuildGeometry(Nz::Primitive::IcoSphere(1.f, 6)));
+	Report("Plane", BuildGeometry(Nz::Primitive::Plane(Nz::Vector2f(10.f), Nz::Vector2ui(8))));
+
+	Nz::String spaceshipPath = FindResource("Spaceship/spaceship.obj");
+	IndexedGeometry spaceship;
+	if (!spaceshipPath.IsEmpty() && LoadObjGeometry(spaceshipPath, &spaceship))
+		Report("Spaceship", spaceship);
+	else
+		WARN("Spaceship/spaceship.obj not found");
+
+	Nz::String drfreakPath = FindResource("drfreak.md2");
+	Nz::MeshParams params;
+	params.optimizeIndexBuffers = false;
+	params.storage = Nz::DataStorage_Software;
+
+	Nz::MeshRef drfreak = Nz::Mesh::New();
+	if (!drfreakPath.IsEmpty() && drfreak->LoadFromFile(drfreakPath, params))
+	{
+		const Nz::StaticMesh* subMesh = static_cast<const Nz::StaticMesh*>(drfreak->GetSubMesh(0));
+
+		IndexedGeometry geometry;
+		geometry.indices = GetIndices(subMesh->GetIndexBuffer());
+
+		geometry.positions.resize(subMesh->GetVertexCount());
+		const Nz::MeshVertex* vertices = static_cast<const Nz::MeshVertex*>(subMesh->GetVertexBuffer()->Map(Nz::BufferAccess_ReadOnly));
+		for (unsigned int i = 0; i < subMesh->GetVertexCount(); ++i)
+			geometry.positions[i] = vertices[i].position;
+
+		subMesh->GetVertexBuffer()->Unmap();
+
+		Report("drfreak", geometry);
+	}
+	else
+		WARN("drfreak.md2 not found");
+
+	// Parallel processing of the submeshes
+	Nz::MeshRef serialMesh = BuildShuffledMesh(32);
+	Nz::MeshRef parallelMesh = BuildShuffledMesh(32);
+
+	Nz::Clock clock;
+	serialMesh->Optimize(Nz::MeshOptimization_All, false);
+	Nz::UInt64 serialElapsed = clock.GetMicroseconds();
+
+	clock.Restart();
+	parallelMesh->Optimize(Nz::MeshOptimization_All, true);
+	Nz::UInt64 parallelElapsed = clock.GetMicroseconds();
+
+	WARN("Mesh::Optimize (" << serialMesh->GetSubMeshCount() << " submeshes, " << serialMesh->GetTriangleCount() << " triangles): "
+	     << serialElapsed << "us (serial) / " << parallelElapsed << "us (parallel)");
+
+	CHECK(GetMeshData(*serialMesh) == GetMeshData(*parallelMesh));
+}
@@ -0,0 +1,277 @@
+#include <Nazara/Utility/Algorithm.hpp>
+#include <Nazara/Core/Initializer.hpp>
+#include <Nazara/Core/Primitive.hpp>
+#include <Nazara/Utility/IndexBuffer.hpp>
+#include <Nazara/Utility/IndexMapper.hpp>
+#include <Nazara/Utility/Mesh.hpp>
+#include <Nazara/Utility/StaticMesh.hpp>
+#include <Nazara/Utility/Utility.hpp>
+#include <Nazara/Utility/VertexBuffer.hpp>
+#include <Catch/catch.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+	struct Geometry
+	{
+		std::vector<Nz::Vector3f> normals;
+		std::vector<Nz::Vector3f> positions;
+		std::vector<Nz::Vector2f> uvs;
+		std::vector<Nz::UInt32> indices;
+	};
+
+	std::vector<Nz::UInt32> GetIndices(const Nz::IndexBuffer* indexBuffer)
+	{
+		std::vector<Nz::UInt32> indices;
+
+		Nz::IndexMapper mapper(indexBuffer);
+		for (unsigned int i = 0; i < mapper.GetIndexCount(); ++i)
+			indices.push_back(mapper.Get(i));
+
+		return indices;
+	}
+
+	Nz::StaticMesh* BuildSubMesh(Nz::Mesh* mesh, const Nz::Primitive& primitive)
+	{
+		Nz::MeshParams params;
+		params.storage = Nz::DataStorage_Software;
+
+		return static_cast<Nz::StaticMesh*>(mesh->BuildSubMesh(primitive, params));
+	}
+
+	Geometry GetGeometry(const Nz::StaticMesh* subMesh)
+	{
+		Geometry geometry;
+		geometry.indices = GetIndices(subMesh->GetIndexBuffer());
+
+		const Nz::VertexBuffer* vertexBuffer = subMesh->GetVertexBuffer();
+		const Nz::MeshVertex* vertices = static_cast<const Nz::MeshVertex*>(vertexBuffer->Map(Nz::BufferAccess_ReadOnly));
+		for (unsigned int i = 0; i < vertexBuffer->GetVertexCount(); ++i)
+		{
+			geometry.normals.push_back(vertices[i].normal);
+			geometry.positions.push_back(vertices[i].position);
+			geometry.uvs.push_back(vertices[i].uv);
+		}
+
+		vertexBuffer->Unmap();
+
+		return geometry;
+	}
+
+	std::vector<Nz::UInt32> Simplify(const Geometry& geometry, unsigned int targetIndexCount, float maxError, float* resultError)
+	{
+		Nz::IndexBufferRef indexBuffer = Nz::IndexBuffer::New(true, static_cast<unsigned int>(geometry.indices.size()), Nz::DataStorage_Software, Nz::BufferUsage_Static);
+		indexBuffer->Fill(geometry.indices.data(), 0, static_cast<unsigned int>(geometry.indices.size()));
+
+		Nz::IndexMapper mapper(indexBuffer);
+		Nz::SparsePtr<const Nz::Vector2f> uvPtr;
+		if (!geometry.uvs.empty())
+			uvPtr = geometry.uvs.data();
+
+		unsigned int indexCount = Nz::SimplifyIndices(mapper.begin(), mapper.GetIndexCount(), static_cast<unsigned int>(geometry.positions.size()), geometry.positions.data(), geometry.normals.data(), uvPtr, targetIndexCount, maxError, resultError);
+
+		std::vector<Nz::UInt32> result(indexCount);
+		for (unsigned int i = 0; i < indexCount; ++i)
+			result[i] = mapper.Get(i);
+
+		return result;
+	}
+
+	float ComputeArea(const std::vector<Nz::Vector3f>& positions, const std::vector<Nz::UInt32>& indices)
+	{
+		float area = 0.f;
+		for (std::size_t i = 0; i < indices.size(); i += 3)
+		{
+			const Nz::Vector3f& p0 = positions[indices[i]];
+			area += (positions[indices[i + 1]] - p0).CrossProduct(positions[indices[i + 2]] - p0).GetLength() * 0.5f;
+		}
+
+		return area;
+	}
+
+	float ComputeVolume(const std::vector<Nz::Vector3f>& positions, const std::vector<Nz::UInt32>& indices)
+	{
+		float volume = 0.f;
+		for (std::size_t i = 0; i < indices.size(); i += 3)
+			volume += positions[indices[i]].DotProduct(positions[indices[i + 1]].CrossProduct(positions[indices[i + 2]])) / 6.f;
+
+		return volume;
+	}
+
+	// Number of triangles facing the center of the sphere
+	unsigned int CountFlippedTriangles(const std::vector<Nz::Vector3f>& positions, const std::vector<Nz::UInt32>& indices)
+	{
+		unsigned int flippedCount = 0;
+		for (std::size_t i = 0; i < indices.size(); i += 3)
+		{
+			const Nz::Vector3f& p0 = positions[indices[i]];
+			const Nz::Vector3f& p1 = positions[indices[i + 1]];
+			const Nz::Vector3f& p2 = positions[indices[i + 2]];
+
+			Nz::Vector3f normal = (p1 - p0).CrossProduct(p2 - p0);
+			if (normal.DotProduct(p0 + p1 + p2) <= 0.f)
+				flippedCount++;
+		}
+
+		return flippedCount;
+	}
+}
+
+SCENARIO("Mesh simplification", "[UTILITY][MESHSIMPLIFICATION]")
+{
+	Nz::Initializer<Nz::Utility> utility;
+	REQUIRE(utility);
+
+	Nz::MeshRef mesh = Nz::Mesh::New();
+	mesh->CreateStatic();
+
+	GIVEN("A sphere")
+	{
+		Geometry sphere = GetGeometry(BuildSubMesh(mesh, Nz::Primitive::IcoSphere(2.f, 4)));
+		sphere.uvs.clear(); // Not generated for ico spheres
+		unsigned int triangleCount = static_cast<unsigned int>(sphere.indices.size() / 3);
+
+		WHEN("We simplify it to a quarter of its triangles")
+		{
+			float error;
+			std::vector<Nz::UInt32> indices = Simplify(sphere, triangleCount / 4 * 3, 0.05f, &error);
+
+			THEN("The triangle count is reduced within the error bound")
+			{
+				CHECK(indices.size() / 3 <= triangleCount / 2);
+				CHECK(indices.size() / 3 >= triangleCount / 8);
+				CHECK(error > 0.f);
+				CHECK(error <= 0.05f);
+			}
+
+			THEN("The shape of the sphere is kept")
+			{
+				CHECK(CountFlippedTriangles(sphere.positions, indices) == 0);
+
+				float volume = ComputeVolume(sphere.positions, sphere.indices);
+				CHECK(ComputeVolume(sphere.positions, indices) == Approx(volume).epsilon(0.05f));
+			}
+
+			THEN("The simplification is deterministic")
+			{
+				float otherError;
+				CHECK(Simplify(sphere, triangleCount / 4 * 3, 0.05f, &otherError) == indices);
+				CHECK(otherError == error);
+			}
+		}
+
+		WHEN("We forbid any error")
+		{
+			float error;
+			std::vector<Nz::UInt32> indices = Simplify(sphere, 0, 0.f, &error);
+
+			THEN("No triangle is removed")
+			{
+				CHECK(indices == sphere.indices);
+				CHECK(error == 0.f);
+			}
+		}
+	}
+
+	GIVEN("A subdivided plane")
+	{
+		Nz::StaticMesh* subMesh = BuildSubMesh(mesh, Nz::Primitive::Plane(Nz::Vector2f(4.f, 2.f), Nz::Vector2ui(4U, 3U)));
+		Geometry plane = GetGeometry(subMesh);
+
+		WHEN("We generate its levels of detail")
+		{
+			REQUIRE(subMesh->GenerateLods(4, 0.25f));
+
+			THEN("Its inner vertices collapse without any error and its outline is kept")
+			{
+				REQUIRE(subMesh->GetLodCount() > 1);
+
+				float area = ComputeArea(plane.positions, plane.indices);
+				for (unsigned int i = 1; i < subMesh->GetLodCount(); ++i)
+				{
+					std::vector<Nz::UInt32> indices = GetIndices(subMesh->GetLodIndexBuffer(i));
+
+					CHECK(indices.size() < plane.indices.size());
+					CHECK(subMesh->GetLodError(i) == Approx(0.f));
+					CHECK(ComputeArea(plane.positions, indices) == Approx(area));
+				}
+			}
+		}
+	}
+
+	GIVEN("A mesh")
+	{
+		Nz::StaticMesh* subMesh = BuildSubMesh(mesh, Nz::Primitive::UVSphere(1.f, 40, 30));
+
+		WHEN("We generate its levels of detail")
+		{
+			mesh->GenerateLods(5, 0.5f, 0.05f);
+
+			THEN("They form a chain of fewer triangles and larger errors")
+			{
+				REQUIRE(subMesh->GetLodCount() > 2);
+				CHECK(subMesh->GetLodIndexBuffer(0) == subMesh->GetIndexBuffer());
+				CHECK(subMesh->GetLodError(0) == 0.f);
+
+				float extent = 2.f;
+				for (unsigned int i = 1; i < subMesh->GetLodCount(); ++i)
+				{
+					const Nz::IndexBuffer* indexBuffer = subMesh->GetLodIndexBuffer(i);
+					const Nz::IndexBuffer* previousIndexBuffer = subMesh->GetLodIndexBuffer(i - 1);
+
+					CHECK(indexBuffer->GetIndexCount() < previousIndexBuffer->GetIndexCount());
+					CHECK(subMesh->GetLodError(i) >= subMesh->GetLodError(i - 1));
+					CHECK(subMesh->GetLodError(i) <= 0.05f * extent + 0.0001f);
+
+					std::vector<Nz::UInt32> indices = GetIndices(indexBuffer);
+					CHECK(*std::max_element(indices.begin(), indices.end()) < subMesh->GetVertexCount());
+				}
+			}
+
+			AND_WHEN("We optimize the mesh")
+			{
+				unsigned int lodCount = subMesh->GetLodCount();
+				std::vector<Nz::Vector3f> positions = GetGeometry(subMesh).positions;
+				mesh->Optimize();
+
+				THEN("The vertices used by the levels of detail are not reordered")
+				{
+					CHECK(subMesh->GetLodCount() == lodCount);
+					CHECK(GetGeometry(subMesh).positions == positions);
+				}
+			}
+
+			AND_WHEN("We clear them")
+			{
+				subMesh->ClearLods();
+
+				THEN("Only the original level remains")
+				{
+					CHECK(subMesh->GetLodCount() == 1);
+				}
+			}
+
+			AND_WHEN("We replace its index buffer")
+			{
+				Nz::IndexBufferConstRef indexBuffer = subMesh->GetIndexBuffer();
+				subMesh->SetIndexBuffer(indexBuffer);
+
+				THEN("The levels of detail are discarded with the previous geometry")
+				{
+					CHECK(subMesh->GetLodCount() == 1);
+				}
+			}
+
+			AND_WHEN("We destroy it")
+			{
+				subMesh->Destroy();
+
+				THEN("The levels of detail are released")
+				{
+					CHECK(subMesh->GetLodCount() == 1);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,432 @@
+#include <Nazara/Utility/SkeletonPose.hpp>
+#include <Nazara/Core/Clock.hpp>
+#include <Nazara/Utility/Animation.hpp>
+#include <Nazara/Utility/Joint.hpp>
+#include <Nazara/Utility/Skeleton.hpp>
+#include <Catch/catch.hpp>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+	bool MatrixEquals(const Nz::Matrix4f& lhs, const Nz::Matrix4f& rhs)
+	{
+		for (unsigned int i = 0; i < 16; ++i)
+		{
+			if (!Nz::NumberEquals(lhs[i], rhs[i], 0.001f))
+				return false;
+		}
+
+		return true;
+	}
+
+	bool PoseEquals(const Nz::SkeletonPose& lhs, const Nz::SkeletonPose& rhs)
+	{
+		for (unsigned int i = 0; i < lhs.GetJointCount(); ++i)
+		{
+			const Nz::Vector3f& positionA = lhs.GetPositions()[i];
+			const Nz::Vector3f& positionB = rhs.GetPositions()[i];
+			const Nz::Quaternionf& rotationA = lhs.GetRotations()[i];
+			const Nz::Quaternionf& rotationB = rhs.GetRotations()[i];
+
+			// q and -q are the same rotation
+			if (!Nz::NumberEquals(std::abs(rotationA.DotProduct(rotationB)), 1.f, 0.001f))
+				return false;
+
+			for (unsigned int j = 0; j < 3; ++j)
+			{
+				if (!Nz::NumberEquals(positionA[j], positionB[j], 0.001f) || !Nz::NumberEquals(lhs.GetScales()[i][j], rhs.GetScales()[i][j], 0.001f))
+					return false;
+			}
+		}
+
+		return lhs.GetJointCount() == rhs.GetJointCount();
+	}
+
+	// A binary tree of joints, each parent coming before its children (as skeletons are loaded)
+	void CreateSkeleton(Nz::Skeleton* skeleton, unsigned int jointCount)
+	{
+		skeleton->Create(jointCount);
+		for (unsigned int i = 0; i < jointCount; ++i)
+		{
+			Nz::Joint* joint = skeleton->GetJoint(i);
+			if (i > 0)
+				joint->SetParent(skeleton->GetJoint((i - 1) / 2));
+
+			joint->SetInitialPosition(Nz::Vector3f(0.f, 1.f, 0.1f * (i % 3)));
+			joint->SetInitialRotation(Nz::EulerAnglesf(0.f, 10.f * (i % 4), 0.f));
+		}
+
+		for (unsigned int i = 0; i < jointCount; ++i)
+		{
+			Nz::Joint* joint = skeleton->GetJoint(i);
+
+			Nz::Matrix4f inverseBindMatrix;
+			joint->GetTransformMatrix().GetInverseAffine(&inverseBindMatrix);
+			joint->SetInverseBindMatrix(inverseBindMatrix);
+		}
+	}
+
+	void CreateAnimation(Nz::Animation* animation, unsigned int frameCount, unsigned int jointCount, std::mt19937& generator)
+	{
+		std::uniform_real_distribution<float> angles(-45.f, 45.f);
+		std::uniform_real_distribution<float> offsets(-0.5f, 0.5f);
+		std::uniform_real_distribution<float> scales(0.8f, 1.2f);
+
+		animation->CreateSkeletal(frameCount, jointCount);
+		for (unsigned int frame = 0; frame < frameCount; ++frame)
+		{
+			Nz::SequenceJoint* sequenceJoints = animation->GetSequenceJoints(frame);
+			for (unsigned int i = 0; i < jointCount; ++i)
+			{
+				sequenceJoints[i].position.Set(offsets(generator), offsets(generator), offsets(generator));
+				sequenceJoints[i].rotation = Nz::EulerAnglesf(angles(generator), angles(generator), angles(generator));
+				sequenceJoints[i].scale.Set(scales(generator), scales(generator), scales(generator));
+			}
+		}
+	}
+}
+
+SCENARIO("SkeletonPose", "[UTILITY][SKELETONPOSE]")
+{
+	const unsigned int jointCount = 15;
+
+	std::mt19937 generator(42);
+
+	GIVEN("A skeleton and an animation of four frames")
+	{
+		Nz::Skeleton skeleton;
+		CreateSkeleton(&skeleton, jointCount);
+
+		Nz::Animation animation;
+		CreateAnimation(&animation, 4, jointCount, generator);
+
+		Nz::SkeletonPose pose;
+		animation.Sample(&pose, 1, 2, 0.3f);
+
+		WHEN("We compute the skinning matrices of a sampled pose")
+		{
+			std::vector<Nz::Matrix4f> skinningMatrices(jointCount);
+			skeleton.ComputeSkinningMatrices(pose, skinningMatrices.data());
+
+			THEN("They are the ones of the joints once the pose is applied")
+			{
+				skeleton.ApplyPose(pose);
+
+				bool identical = true;
+				for (unsigned int i = 0; i < jointCount; ++i)
+					identical &= MatrixEquals(skinningMatrices[i], skeleton.GetJoint(i)->GetSkinningMatrix());
+
+				CHECK(identical);
+			}
+
+			AND_THEN("A change of the joints is taken into account")
+			{
+				skeleton.GetJoint(3)->SetInheritScale(false);
+				skeleton.GetJoint(4)->SetInitialPosition(Nz::Vector3f(2.f, 0.f, 0.f));
+				skeleton.ComputeSkinningMatrices(pose, skinningMatrices.data());
+				skeleton.ApplyPose(pose);
+
+				bool identical = true;
+				for (unsigned int i = 0; i < jointCount; ++i)
+					identical &= MatrixEquals(skinningMatrices[i], skeleton.GetJoint(i)->GetSkinningMatrix());
+
+				CHECK(identical);
+			}
+
+			AND_THEN("The pose of the joints gives the same matrices (as used by the skinning)")
+			{
+				skeleton.ApplyPose(pose);
+
+				Nz::SkeletonPose jointPose;
+				skeleton.GetPose(&jointPose);
+				CHECK(PoseEquals(jointPose, pose));
+
+				std::vector<Nz::Matrix4f> jointMatrices(jointCount);
+				skeleton.ComputeSkinningMatrices(jointPose, jointMatrices.data());
+
+				bool identical = true;
+				for (unsigned int i = 0; i < jointCount; ++i)
+					identical &= MatrixEquals(jointMatrices[i], skinningMatrices[i]);
+
+				CHECK(identical);
+			}
+		}
+
+		WHEN("We only animate some joints of the skeleton")
+		{
+			std::vector<unsigned int> indices = {0, 1, 2};
+			animation.AnimateSkeleton(&skeleton, 1, 2, 0.3f, indices.data(), indices.size());
+
+			THEN("The other joints keep their transform")
+			{
+				CHECK(skeleton.GetJoint(1)->GetPosition(Nz::CoordSys_Local).Distance(pose.GetPositions()[1]) < 0.001f);
+				CHECK(skeleton.GetJoint(2)->GetPosition(Nz::CoordSys_Local).Distance(pose.GetPositions()[2]) < 0.001f);
+				CHECK(skeleton.GetJoint(3)->GetPosition(Nz::CoordSys_Local) == Nz::Vector3f::Zero());
+			}
+		}
+
+		WHEN("We sample a single frame")
+		{
+			animation.Sample(&pose, 2, 3, 0.f);
+
+			THEN("The pose is the one of the frame")
+			{
+				const Nz::SequenceJoint* sequenceJoints = animation.GetSequenceJoints(2);
+
+				Nz::SkeletonPose framePose(jointCount);
+				for (unsigned int i = 0; i < jointCount; ++i)
+				{
+					framePose.GetPositions()[i] = sequenceJoints[i].position;
+					framePose.GetRotations()[i] = sequenceJoints[i].rotation;
+					framePose.GetScales()[i] = sequenceJoints[i].scale;
+				}
+
+				CHECK(PoseEquals(pose, framePose));
+			}
+		}
+
+		WHEN("We blend or add poses")
+		{
+			Nz::SkeletonPose other;
+			animation.Sample(&other, 3, 3, 0.f);
+
+			THEN("Weights of zero and one give the original poses")
+			{
+				Nz::SkeletonPose blended(pose);
+				blended.Blend(other, 0.f);
+				CHECK(PoseEquals(blended, pose));
+
+				blended.Blend(other, 1.f);
+				CHECK(PoseEquals(blended, other));
+			}
+
+			AND_THEN("A joint mask only blends the selected joints")
+			{
+				std::vector<float> jointWeights(jointCount, 0.f);
+				jointWeights[5] = 1.f;
+
+				Nz::SkeletonPose blended(pose);
+				blended.Blend(other, 1.f, jointWeights.data());
+
+				CHECK(blended.GetPositions()[5].Distance(other.GetPositions()[5]) < 0.001f);
+				CHECK(blended.GetPositions()[4] == pose.GetPositions()[4]);
+			}
+
+			AND_THEN("The difference to a pose, added back to it, gives the original pose")
+			{
+				Nz::SkeletonPose additive(other);
+				additive.MakeAdditive(pose);
+
+				Nz::SkeletonPose result(pose);
+				result.ApplyAdditive(additive, 1.f);
+				CHECK(PoseEquals(result, other));
+
+				result = pose;
+				result.ApplyAdditive(additive, 0.f);
+				CHECK(PoseEquals(result, pose));
+			}
+		}
+
+		WHEN("We animate many skeletons at once")
+		{
+			const unsigned int instanceCount = 37;
+
+			std::vector<float> upperBodyWeights(jointCount, 0.f);
+			for (unsigned int i = 1; i < jointCount; i += 2)
+				upperBodyWeights[i] = 1.f;
+
+			std::vector<Nz::AnimationLayer> layers(instanceCount * 3);
+			for (unsigned int i = 0; i < instanceCount; ++i)
+			{
+				Nz::AnimationLayer& base = layers[i * 3];
+				base.animation = &animation;
+				base.frameA = i % 4;
+				base.frameB = (i + 1) % 4;
+				base.interpolation = (i % 10) / 10.f;
+
+				Nz::AnimationLayer& upperBody = layers[i * 3 + 1];
+				upperBody.animation = &animation;
+				upperBody.frameA = 3;
+				upperBody.frameB = 3;
+				upperBody.jointWeights = upperBodyWeights.data();
+				upperBody.weight = 0.5f;
+
+				Nz::AnimationLayer& additive = layers[i * 3 + 2];
+				additive.animation = &animation;
+				additive.blendMode = Nz::AnimationBlendMode_Additive;
+				additive.frameA = 1;
+				additive.frameB = 1;
+				additive.referenceFrame = 0;
+				additive.weight = 0.25f;
+			}
+
+			std::vector<Nz::Matrix4f> parallelMatrices(instanceCount * jointCount);
+			std::vector<Nz::Matrix4f> serialMatrices(instanceCount * jointCount);
+			std::vector<Nz::SkeletonAnimationJob> jobs(instanceCount);
+			for (unsigned int i = 0; i < instanceCount; ++i)
+			{
+				jobs[i].layers = &layers[i * 3];
+				jobs[i].layerCount = 3;
+				jobs[i].skeleton = &skeleton;
+				jobs[i].skinningMatrices = &parallelMatrices[i * jointCount];
+			}
+
+			Nz::Animation::AnimateSkeletons(jobs.data(), jobs.size());
+
+			for (unsigned int i = 0; i < instanceCount; ++i)
+				jobs[i].skinningMatrices = &serialMatrices[i * jointCount];
+
+			Nz::SkeletonPose lastPose;
+			jobs.back().pose = &lastPose;
+
+			Nz::Animation::AnimateSkeletons(jobs.data(), jobs.size(), false);
+
+			THEN("The tasks give the same results as a serial update")
+			{
+				bool identical = true;
+				for (unsigned int i = 0; i < parallelMatrices.size(); ++i)
+					identical &= MatrixEquals(parallelMatrices[i], serialMatrices[i]);
+
+				CHECK(identical);
+			}
+
+			AND_THEN("The layers are applied in order")
+			{
+				const Nz::AnimationLayer* lastLayers = jobs.back().layers;
+
+				Nz::SkeletonPose expected;
+				animation.Sample(&expected, lastLayers[0].frameA, lastLayers[0].frameB, lastLayers[0].interpolation);
+
+				Nz::SkeletonPose layerPose;
+				animation.Sample(&layerPose, 3, 3, 0.f);
+				expected.Blend(layerPose, 0.5f, upperBodyWeights.data());
+
+				Nz::SkeletonPose referencePose;
+				animation.Sample(&layerPose, 1, 1, 0.f);
+				animation.Sample(&referencePose, 0, 0, 0.f);
+				layerPose.MakeAdditive(referencePose);
+				expected.ApplyAdditive(layerPose, 0.25f);
+
+				CHECK(PoseEquals(lastPose, expected));
+			}
+		}
+	}
+
+	GIVEN("A skeleton whose first joint is the child of the second one")
+	{
+		Nz::Skeleton skeleton;
+		skeleton.Create(2);
+		skeleton.GetJoint(0u)->SetParent(skeleton.GetJoint(1u));
+		skeleton.GetJoint(0u)->SetPosition(Nz::Vector3f(0.f, 1.f, 0.f));
+		skeleton.GetJoint(1u)->SetPosition(Nz::Vector3f(10.f, 0.f, 0.f));
+		skeleton.GetJoint(1u)->SetRotation(Nz::EulerAnglesf(0.f, 90.f, 0.f));
+
+		auto CheckSkinningMatrices = [&skeleton]()
+		{
+			Nz::SkeletonPose jointPose;
+			skeleton.GetPose(&jointPose);
+
+			std::vector<Nz::Matrix4f> skinningMatrices(2);
+			skeleton.ComputeSkinningMatrices(jointPose, skinningMatrices.data());
+
+			CHECK(MatrixEquals(skinningMatrices[0], skeleton.GetJoint(0u)->GetSkinningMatrix()));
+			CHECK(MatrixEquals(skinningMatrices[1], skeleton.GetJoint(1u)->GetSkinningMatrix()));
+			CHECK(skinningMatrices[0].GetTranslation().Distance(skeleton.GetJoint(0u)->GetPosition()) < 0.001f);
+		};
+
+		WHEN("We compute its skinning matrices")
+		{
+			THEN("They are the ones of the joints")
+			{
+				CHECK(skeleton.GetJoint(0u)->GetPosition().Distance(Nz::Vector3f(10.f, 1.f, 0.f)) < 0.001f);
+				CheckSkinningMatrices();
+			}
+		}
+
+		WHEN("Its root joint is attached to a node outside of the skeleton")
+		{
+			Nz::Node node;
+			node.SetPosition(Nz::Vector3f(0.f, 0.f, 5.f));
+			node.SetScale(2.f);
+			skeleton.GetJoint(1u)->SetParent(node);
+
+			THEN("The transform of this node is taken into account")
+			{
+				CheckSkinningMatrices();
+			}
+
+			skeleton.GetJoint(1u)->SetParent(nullptr);
+		}
+	}
+}
+
+// Not run by default, use "[.benchmark]" or "[SKELETONPOSE]" on the command line to compare joint animation to pose animation
+TEST_CASE("SkeletonPose throughput", "[UTILITY][SKELETONPOSE][.benchmark]")
+{
+	const unsigned int characterCount = 500;
+	const unsigned int jointCount = 60;
+	const unsigned int frameCount = 20;
+
+	std::mt19937 generator(42);
+
+	Nz::Animation animation;
+	CreateAnimation(&animation, 30, jointCount, generator);
+
+	std::vector<Nz::Skeleton> skeletons(characterCount);
+	for (Nz::Skeleton& skeleton : skeletons)
+		CreateSkeleton(&skeleton, jointCount);
+
+	std::vector<Nz::Matrix4f> skinningMatrices(characterCount * jointCount);
+
+	Nz::Clock clock;
+	for (unsigned int frame = 0; frame < frameCount; ++frame)
+	{
+		for (unsigned int i = 0; i < characterCount; ++i)
+		{
+			animation.AnimateSkeleton(&skeletons[i], (frame + i) % 30, (frame + i + 1) % 30, 0.5f);
+			for (unsigned int j = 0; j < jointCount; ++j)
+				skinningMatrices[i * jointCount + j] = skeletons[i].GetJoint(j)->GetSkinningMatrix();
+		}
+	}
+	Nz::UInt64 jointElapsed = clock.GetMicroseconds() / frameCount;
+
+	std::vector<Nz::AnimationLayer> layers(characterCount);
+	std::vector<Nz::SkeletonAnimationJob> jobs(characterCount);
+	for (unsigned int i = 0; i < characterCount; ++i)
+	{
+		layers[i].animation = &animation;
+		layers[i].interpolation = 0.5f;
+
+		jobs[i].layers = &layers[i];
+		jobs[i].layerCount = 1;
+		jobs[i].skeleton = &skeletons[0];
+		jobs[i].skinningMatrices = &skinningMatrices[i * jointCount];
+	}
+
+	auto RunJobs = [&](bool parallel)
+	{
+		Nz::Clock jobClock;
+		for (unsigned int frame = 0; frame < frameCount; ++frame)
+		{
+			for (unsigned int i = 0; i < characterCount; ++i)
+			{
+				layers[i].frameA = (frame + i) % 30;
+				layers[i].frameB = (frame + i + 1) % 30;
+			}
+
+			Nz::Animation::AnimateSkeletons(jobs.data(), jobs.size(), parallel);
+		}
+
+		return jobClock.GetMicroseconds() / frameCount;
+	};
+
+	Nz::UInt64 serialElapsed = RunJobs(false);
+	Nz::UInt64 parallelElapsed = RunJobs(true);
+
+	WARN("Skinning " << characterCount << " characters of " << jointCount << " joints: " << jointElapsed << "us (joints) / "
+	     << serialElapsed << "us (poses) / " << parallelElapsed << "us (poses, parallel)");
+
+	CHECK(skinningMatrices.back().IsAffine());
+}
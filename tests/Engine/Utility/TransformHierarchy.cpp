@@ -0,0 +1,300 @@
+#include <Nazara/Utility/TransformHierarchy.hpp>
+#include <Nazara/Core/Clock.hpp>
+#include <Nazara/Core/TaskScheduler.hpp>
+#include <Nazara/Utility/Node.hpp>
+#include <Catch/catch.hpp>
+#include <memory>
+#include <vector>
+
+namespace
+{
+	bool MatrixEquals(const Nz::Matrix4f& lhs, const Nz::Matrix4f& rhs)
+	{
+		for (unsigned int i = 0; i < 16; ++i)
+		{
+			if (!Nz::NumberEquals(lhs[i], rhs[i], 0.001f))
+				return false;
+		}
+
+		return true;
+	}
+
+	bool VectorEquals(const Nz::Vector3f& lhs, const Nz::Vector3f& rhs)
+	{
+		return Nz::NumberEquals(lhs.x, rhs.x, 0.001f) && Nz::NumberEquals(lhs.y, rhs.y, 0.001f) && Nz::NumberEquals(lhs.z, rhs.z, 0.001f);
+	}
+
+	// Reference world matrix, computed from the local transforms by the lazy Node path
+	Nz::Matrix4f ComputeReference(const Nz::Node& node)
+	{
+		Nz::Node copy;
+		copy.SetPosition(node.GetPosition(), Nz::CoordSys_Global);
+		copy.SetRotation(node.GetRotation(), Nz::CoordSys_Global);
+		copy.SetScale(node.GetScale(), Nz::CoordSys_Global);
+
+		return copy.GetTransformMatrix();
+	}
+}
+
+SCENARIO("TransformHierarchy", "[UTILITY][TRANSFORMHIERARCHY]")
+{
+	GIVEN("A hierarchy of three transforms")
+	{
+		Nz::TransformHierarchy hierarchy;
+
+		Nz::TransformHierarchy::Handle root = hierarchy.Create();
+		Nz::TransformHierarchy::Handle child = hierarchy.Create(root);
+		Nz::TransformHierarchy::Handle grandChild = hierarchy.Create(child);
+
+		hierarchy.SetLocalPosition(root, Nz::Vector3f(1.f, 0.f, 0.f));
+		hierarchy.SetLocalScale(root, Nz::Vector3f(2.f));
+		hierarchy.SetLocalRotation(child, Nz::EulerAnglesf(0.f, 90.f, 0.f));
+		hierarchy.SetLocalPosition(grandChild, Nz::Vector3f(0.f, 0.f, -1.f));
+
+		hierarchy.Update();
+
+		THEN("World transforms are combined from the root")
+		{
+			CHECK(hierarchy.GetCount() == 3);
+			CHECK(hierarchy.GetRootCount() == 1);
+			CHECK(hierarchy.GetParent(grandChild) == child);
+			CHECK(hierarchy.GetWorldScale(grandChild) == Nz::Vector3f(2.f));
+			CHECK(VectorEquals(hierarchy.GetWorldPosition(grandChild), Nz::Vector3f(-1.f, 0.f, 0.f)));
+			CHECK(VectorEquals(hierarchy.GetWorldMatrix(grandChild).GetTranslation(), Nz::Vector3f(-1.f, 0.f, 0.f)));
+		}
+
+		WHEN("We move the root")
+		{
+			hierarchy.SetLocalPosition(root, Nz::Vector3f(0.f, 5.f, 0.f));
+			hierarchy.Update();
+
+			THEN("Its descendants follow it")
+			{
+				CHECK(VectorEquals(hierarchy.GetWorldPosition(grandChild), Nz::Vector3f(-2.f, 5.f, 0.f)));
+			}
+		}
+
+		WHEN("We disable the inheritance of the scale")
+		{
+			hierarchy.SetInheritScale(child, false);
+			hierarchy.Update();
+
+			THEN("The subtree is not scaled anymore")
+			{
+				CHECK(hierarchy.GetWorldScale(child) == Nz::Vector3f(1.f));
+				CHECK(VectorEquals(hierarchy.GetWorldPosition(grandChild), Nz::Vector3f(0.f, 0.f, 0.f)));
+			}
+		}
+
+		WHEN("We reparent the root under a new transform and destroy the middle one")
+		{
+			Nz::TransformHierarchy::Handle newRoot = hierarchy.Create();
+			hierarchy.SetLocalPosition(newRoot, Nz::Vector3f(10.f, 0.f, 0.f));
+			hierarchy.SetParent(root, newRoot);
+
+			hierarchy.Destroy(child);
+			hierarchy.Update();
+
+			THEN("The order is rebuilt and the orphan becomes a root")
+			{
+				CHECK(hierarchy.GetCount() == 3);
+				CHECK(hierarchy.GetRootCount() == 2);
+				CHECK_FALSE(hierarchy.IsValid(child));
+				CHECK(hierarchy.GetParent(grandChild) == Nz::TransformHierarchy::InvalidHandle);
+				CHECK(VectorEquals(hierarchy.GetWorldPosition(grandChild), Nz::Vector3f(0.f, 0.f, -1.f)));
+				CHECK(VectorEquals(hierarchy.GetWorldPosition(root), Nz::Vector3f(11.f, 0.f, 0.f)));
+			}
+		}
+	}
+
+	GIVEN("A chain of nodes bound to a hierarchy")
+	{
+		Nz::Node external;
+		external.SetPosition(Nz::Vector3f(0.f, 0.f, 3.f));
+
+		std::vector<std::unique_ptr<Nz::Node>> nodes;
+		for (unsigned int i = 0; i < 10; ++i)
+		{
+			nodes.emplace_back(new Nz::Node);
+			nodes.back()->SetParent((i > 0) ? nodes[i - 1].get() : &external);
+			nodes.back()->SetPosition(Nz::Vector3f(1.f, 0.f, 0.f));
+			nodes.back()->SetRotation(Nz::EulerAnglesf(0.f, 10.f * i, 0.f));
+			nodes.back()->SetScale(1.1f);
+		}
+		nodes[4]->SetInheritRotation(false);
+
+		Nz::TransformHierarchy hierarchy;
+		hierarchy.AddNode(nodes[0].get());
+
+		hierarchy.Update();
+
+		THEN("Every node is bound and up to date")
+		{
+			CHECK(hierarchy.GetCount() == 10);
+			CHECK(hierarchy.GetRootCount() == 1);
+			CHECK(nodes[9]->GetHierarchy() == &hierarchy);
+
+			bool identical = true;
+			for (const auto& node : nodes)
+				identical &= MatrixEquals(node->GetTransformMatrix(), ComputeReference(*node));
+
+			CHECK(identical);
+		}
+
+		WHEN("We move nodes of the chain")
+		{
+			external.Move(Nz::Vector3f(0.f, 1.f, 0.f));
+			nodes[6]->Rotate(Nz::EulerAnglesf(45.f, 0.f, 0.f));
+			hierarchy.Update();
+
+			THEN("The hierarchy computes the same transforms as the nodes")
+			{
+				bool identical = true;
+				for (const auto& node : nodes)
+				{
+					Nz::TransformHierarchy::Handle handle = hierarchy.GetHandle(node.get());
+					identical &= MatrixEquals(hierarchy.GetWorldMatrix(handle), ComputeReference(*node));
+				}
+
+				CHECK(identical);
+			}
+		}
+
+		WHEN("We reparent and destroy nodes")
+		{
+			nodes[7]->SetParent(nodes[2].get());
+			nodes[3].reset();
+			hierarchy.Update();
+
+			THEN("The hierarchy follows the nodes")
+			{
+				CHECK(hierarchy.GetCount() == 9);
+				CHECK(hierarchy.GetParent(hierarchy.GetHandle(nodes[7].get())) == hierarchy.GetHandle(nodes[2].get()));
+				CHECK(hierarchy.GetParent(hierarchy.GetHandle(nodes[4].get())) == Nz::TransformHierarchy::InvalidHandle);
+
+				bool identical = true;
+				for (const auto& node : nodes)
+				{
+					if (node)
+						identical &= MatrixEquals(node->GetTransformMatrix(), ComputeReference(*node));
+				}
+
+				CHECK(identical);
+			}
+		}
+
+		WHEN("We remove the chain from the hierarchy")
+		{
+			hierarchy.RemoveNode(nodes[5].get());
+
+			THEN("The node and its children are not bound anymore")
+			{
+				CHECK(hierarchy.GetCount() == 5);
+				CHECK(nodes[5]->GetHierarchy() == nullptr);
+				CHECK(nodes[9]->GetHierarchy() == nullptr);
+				CHECK(nodes[4]->GetHierarchy() == &hierarchy);
+			}
+		}
+	}
+}
+
+// Not run by default, use "[.benchmark]" or "[TRANSFORMHIERARCHY]" on the command line to compare the lazy node update to the hierarchy
+TEST_CASE("TransformHierarchy throughput", "[UTILITY][TRANSFORMHIERARCHY][.benchmark]")
+{
+	const unsigned int rootCount = 200;
+	const unsigned int chainLength = 50;
+	const unsigned int frameCount = 100;
+
+	std::vector<std::unique_ptr<Nz::Node>> nodes;
+	std::vector<Nz::Node*> roots;
+	for (unsigned int r = 0; r < rootCount; ++r)
+	{
+		for (unsigned int i = 0; i < chainLength; ++i)
+		{
+			nodes.emplace_back(new Nz::Node);
+			if (i > 0)
+				nodes.back()->SetParent(nodes[nodes.size() - 2].get());
+			else
+				roots.push_back(nodes.back().get());
+
+			nodes.back()->SetPosition(Nz::Vector3f(0.f, 1.f, 0.f));
+			nodes.back()->SetRotation(Nz::EulerAnglesf(0.f, 5.f, 0.f));
+		}
+	}
+
+	// Moves the roots (or every node, as an animation would) then reads every transform matrix
+	auto RunFrames = [&](Nz::TransformHierarchy* hierarchy, bool moveEveryNode)
+	{
+		float sum = 0.f;
+
+		Nz::Clock clock;
+		for (unsigned int frame = 0; frame < frameCount; ++frame)
+		{
+			if (moveEveryNode)
+			{
+				for (const auto& node : nodes)
+					node->Move(Nz::Vector3f(0.01f, 0.f, 0.f));
+			}
+			else
+			{
+				for (Nz::Node* root : roots)
+					root->Move(Nz::Vector3f(0.01f, 0.f, 0.f));
+			}
+
+			if (hierarchy)
+				hierarchy->Update();
+
+			for (const auto& node : nodes)
+				sum += node->GetTransformMatrix().GetTranslation().x;
+		}
+
+		Nz::UInt64 elapsed = clock.GetMicroseconds();
+		CHECK(sum != 0.f);
+
+		return elapsed / frameCount;
+	};
+
+	Nz::UInt64 lazyElapsed = RunFrames(nullptr, false);
+	Nz::UInt64 lazyAnimatedElapsed = RunFrames(nullptr, true);
+
+	Nz::TransformHierarchy nodeHierarchy;
+	for (Nz::Node* root : roots)
+		nodeHierarchy.AddNode(root);
+
+	Nz::UInt64 boundElapsed = RunFrames(&nodeHierarchy, false);
+	nodeHierarchy.Clear();
+
+	// Same transforms, without nodes
+	Nz::TransformHierarchy hierarchy;
+	std::vector<Nz::TransformHierarchy::Handle> rootHandles;
+	for (unsigned int r = 0; r < rootCount; ++r)
+	{
+		Nz::TransformHierarchy::Handle parent = Nz::TransformHierarchy::InvalidHandle;
+		for (unsigned int i = 0; i < chainLength; ++i)
+		{
+			Nz::TransformHierarchy::Handle handle = hierarchy.Create(parent);
+			hierarchy.SetLocalPosition(handle, Nz::Vector3f(0.f, 1.f, 0.f));
+			hierarchy.SetLocalRotation(handle, Nz::EulerAnglesf(0.f, 5.f, 0.f));
+
+			if (i == 0)
+				rootHandles.push_back(handle);
+
+			parent = handle;
+		}
+	}
+
+	Nz::Clock clock;
+	for (unsigned int frame = 0; frame < frameCount; ++frame)
+	{
+		for (Nz::TransformHierarchy::Handle root : rootHandles)
+			hierarchy.SetLocalPosition(root, Nz::Vector3f(0.01f * frame, 1.f, 0.f));
+
+		hierarchy.Update(true);
+	}
+	Nz::UInt64 handleElapsed = clock.GetMicroseconds() / frameCount;
+
+	WARN(nodes.size() << " transforms, " << rootCount << " chains of " << chainLength);
+	WARN("Node (lazy): " << lazyElapsed << "us/frame, " << lazyAnimatedElapsed << "us/frame when every node moves");
+	WARN("Node bound to a TransformHierarchy: " << boundElapsed << "us/frame");
+	WARN("TransformHierarchy handles: " << handleElapsed << "us/frame (" << Nz::TaskScheduler::GetWorkerCount() << " workers)");
+}
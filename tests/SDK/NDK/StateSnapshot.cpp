@@ -0,0 +1,201 @@
+#include <NDK/StateSnapshot.hpp>
+#include <Nazara/Core/ByteArray.hpp>
+#include <Nazara/Core/Error.hpp>
+#include <Nazara/Core/ErrorFlags.hpp>
+#include <Nazara/Core/Initializer.hpp>
+#include <NDK/Components/NodeComponent.hpp>
+#include <NDK/Components/VelocityComponent.hpp>
+#include <NDK/ReplicationReceiver.hpp>
+#include <NDK/Sdk.hpp>
+#include <NDK/World.hpp>
+#include <Catch/catch.hpp>
+
+namespace
+{
+	Nz::ByteArray WriteSnapshot(const Ndk::StateSnapshot& snapshot, const Ndk::StateSnapshot* baseline)
+	{
+		Nz::ByteArray data;
+		{
+			Nz::ByteStream stream(&data, Nz::OpenMode_WriteOnly);
+			REQUIRE(snapshot.WriteDelta(stream, baseline));
+		}
+
+		return data;
+	}
+
+	bool ReadSnapshot(const Nz::ByteArray& data, std::size_t size, const Ndk::StateSnapshot* baseline, Ndk::StateSnapshot* snapshot)
+	{
+		Nz::ByteStream stream(data.GetConstBuffer(), size);
+
+		Ndk::SnapshotId baselineId;
+		Ndk::SnapshotId snapshotId;
+		if (!Ndk::StateSnapshot::ReadHeader(stream, &snapshotId, &baselineId))
+			return false;
+
+		snapshot->SetId(snapshotId);
+		return snapshot->ReadDelta(stream, baseline);
+	}
+
+	void CheckStates(const Ndk::StateSnapshot& lhs, const Ndk::StateSnapshot& rhs)
+	{
+		REQUIRE(lhs.GetEntities().size() == rhs.GetEntities().size());
+		for (std::size_t i = 0; i < lhs.GetEntities().size(); ++i)
+		{
+			const Ndk::StateSnapshot::EntityState& lhsState = lhs.GetEntities()[i];
+			const Ndk::StateSnapshot::EntityState& rhsState = rhs.GetEntities()[i];
+
+			CHECK(lhsState.id == rhsState.id);
+			CHECK(lhsState.generation == rhsState.generation);
+			CHECK(lhsState.components == rhsState.components);
+			CHECK(lhsState.position == rhsState.position);
+			CHECK(lhsState.rotation == rhsState.rotation);
+			CHECK(lhsState.scale == rhsState.scale);
+			CHECK(lhsState.linearVelocity == rhsState.linearVelocity);
+		}
+	}
+}
+
+SCENARIO("StateSnapshot", "[NDK][STATESNAPSHOT]")
+{
+	Nz::Initializer<Ndk::Sdk> sdk;
+	REQUIRE(sdk);
+
+	Ndk::World world(false);
+
+	Ndk::EntityHandle first = world.CreateEntity();
+	first->AddComponent<Ndk::NodeComponent>().SetPosition(Nz::Vector3f(1.f, 2.f, 3.f));
+
+	Ndk::EntityHandle second = world.CreateEntity();
+	second->AddComponent<Ndk::NodeComponent>().SetRotation(Nz::EulerAnglesf(0.f, 90.f, 0.f));
+	second->AddComponent<Ndk::VelocityComponent>().linearVelocity = Nz::Vector3f(0.f, -9.81f, 0.f);
+
+	Ndk::StateSnapshot baseline(1);
+	baseline.Capture(first, 0);
+	baseline.Capture(second, 0);
+	baseline.Sort();
+
+	GIVEN("A full snapshot")
+	{
+		Nz::ByteArray data = WriteSnapshot(baseline, nullptr);
+
+		WHEN("We read it back")
+		{
+			Ndk::StateSnapshot snapshot;
+			REQUIRE(ReadSnapshot(data, data.GetSize(), nullptr, &snapshot));
+
+			THEN("Every entity state is restored")
+			{
+				CHECK(snapshot.GetId() == baseline.GetId());
+				CheckStates(snapshot, baseline);
+			}
+		}
+
+		WHEN("We read a truncated version of it")
+		{
+			Nz::ErrorFlags flags(Nz::ErrorFlag_Silent);
+
+			THEN("Reading fails whatever the cut")
+			{
+				for (std::size_t size = 0; size < data.GetSize(); ++size)
+				{
+					Ndk::StateSnapshot snapshot;
+					CHECK_FALSE(ReadSnapshot(data, size, nullptr, &snapshot));
+				}
+			}
+		}
+	}
+
+	GIVEN("A delta from a baseline")
+	{
+		first->GetComponent<Ndk::NodeComponent>().Move(Nz::Vector3f::UnitX());
+		second->RemoveComponent<Ndk::VelocityComponent>();
+
+		Ndk::StateSnapshot current(2);
+		current.Capture(first, 0);
+		current.Capture(second, 0);
+		current.Sort();
+
+		Nz::ByteArray data = WriteSnapshot(current, &baseline);
+
+		WHEN("We read it back with the same baseline")
+		{
+			Ndk::StateSnapshot snapshot;
+			REQUIRE(ReadSnapshot(data, data.GetSize(), &baseline, &snapshot));
+
+			THEN("It matches the current state")
+			{
+				CheckStates(snapshot, current);
+			}
+		}
+
+		WHEN("We read a truncated version of it")
+		{
+			Nz::ErrorFlags flags(Nz::ErrorFlag_Silent);
+
+			THEN("Reading fails whatever the cut")
+			{
+				for (std::size_t size = 0; size < data.GetSize(); ++size)
+				{
+					Ndk::StateSnapshot snapshot;
+					CHECK_FALSE(ReadSnapshot(data, size, &baseline, &snapshot));
+				}
+			}
+		}
+	}
+
+	GIVEN("Malformed packets")
+	{
+		Nz::ErrorFlags flags(Nz::ErrorFlag_Silent);
+
+		Ndk::World remoteWorld(false);
+		Ndk::ReplicationReceiver receiver(remoteWorld);
+
+		WHEN("The entry count cannot fit in the packet")
+		{
+			Nz::ByteArray data;
+			{
+				Nz::ByteStream stream(&data, Nz::OpenMode_WriteOnly);
+				stream << Ndk::SnapshotId(1) << Ndk::StateSnapshot::InvalidId << Nz::UInt32(0xFFFFFFFF);
+			}
+
+			THEN("The snapshot is rejected")
+			{
+				Nz::ByteStream stream(data.GetConstBuffer(), data.GetSize());
+				CHECK_FALSE(receiver.ReadSnapshot(stream));
+				CHECK(receiver.GetLastSnapshotId() == Ndk::StateSnapshot::InvalidId);
+			}
+		}
+
+		WHEN("An entity id is out of bounds")
+		{
+			Nz::ByteArray data;
+			{
+				// A single full state, without any component
+				Nz::ByteStream stream(&data, Nz::OpenMode_WriteOnly);
+				stream << Ndk::SnapshotId(1) << Ndk::StateSnapshot::InvalidId << Nz::UInt32(1);
+				stream << Ndk::EntityId(0xFFFFFFFF) << false << true << false << false << Nz::UInt16(0);
+			}
+
+			THEN("The snapshot is rejected without creating any entity")
+			{
+				Nz::ByteStream stream(data.GetConstBuffer(), data.GetSize());
+				CHECK_FALSE(receiver.ReadSnapshot(stream));
+				CHECK(receiver.GetLastSnapshotId() == Ndk::StateSnapshot::InvalidId);
+				CHECK(remoteWorld.GetEntities().empty());
+			}
+		}
+
+		WHEN("The entity id is in bounds")
+		{
+			Nz::ByteArray data = WriteSnapshot(baseline, nullptr);
+
+			THEN("The entities are replicated")
+			{
+				Nz::ByteStream stream(data.GetConstBuffer(), data.GetSize());
+				CHECK(receiver.ReadSnapshot(stream));
+				CHECK(receiver.GetEntity(first->GetId()).IsValid());
+				CHECK(receiver.GetEntity(second->GetId())->HasComponent<Ndk::VelocityComponent>());
+			}
+		}
+	}
+}